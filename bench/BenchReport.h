@@ -0,0 +1,736 @@
+#pragma once
+
+// BenchReport.h — Machine-readable benchmark results and baseline comparison
+//
+// Shared by benchmark.cpp and macro_benchmark.cpp. Console output stays the
+// primary human-facing report; this adds a JSON file per run so results can
+// be archived, diffed and used to gate upgrades in CI.
+//
+// Output (--json PATH):
+//
+//   {
+//     "schema": 1,
+//     "suite": "fatp_ecs vs EnTT",
+//     "timestamp": "2026-02-25T10:00:00Z",
+//     "compiler": "GCC 13.2.0", "cpu": "...", "platform": "linux-x64",
+//     "build": "Release",
+//     "config": { "warmup_runs": 3, "measured_runs": 50, "seed": 12345 },
+//     "cases": [
+//       { "section": "1. CREATE ENTITIES", "case": "N=1000", "n": 1000,
+//         "results": [
+//           { "library": "fatp_ecs", "median_ns": 4.1, "mad_ns": 0.2,
+//             "mean_ns": 4.3, "min_ns": 3.9, "samples": 50,
+//             "allocs_per_op": 0.0,
+//             "counters": { "cycles": 5.2, "instructions": 14.0, ... } },
+//           ... ] }, ... ]
+//   }
+//
+// "allocs_per_op" is present only when the binary was built with
+// FATP_ECS_TRACK_ALLOCATIONS (see AllocationTracker.h). "counters" holds
+// hardware events per operation and is present only when they were
+// requested and available (see PerfCounters.h); --compare ignores it.
+//
+// All times are nanoseconds per operation. MAD is the median absolute
+// deviation of the per-run samples — a robust noise estimate that, unlike
+// stddev, is not inflated by the occasional preempted run.
+//
+// Comparison (--compare BASELINE CURRENT [--threshold PCT] [--library NAME]):
+// cases are matched by (section, case, library). A case regresses when its
+// median grows by more than PCT percent (default 10) AND by more than the
+// combined MAD of both runs, so a noisy case does not fail the gate on
+// jitter alone. When both files carry allocs_per_op, any increase is also a
+// regression — allocation counts are deterministic. A baseline case absent
+// from CURRENT also fails the gate. Exit status:
+// 0 = no regressions, 1 = regression or missing case, 2 = usage or file error.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fat_p/JsonLite.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+namespace fatp_ecs::bench
+{
+
+// ============================================================================
+// Sample statistics
+// ============================================================================
+
+struct SampleSummary
+{
+    double median = 0.0;
+    double mad = 0.0;
+    double mean = 0.0;
+    double min = 0.0;
+    std::size_t count = 0;
+};
+
+inline double medianOfSorted(const std::vector<double>& sorted)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    const std::size_t mid = sorted.size() / 2;
+    return (sorted.size() % 2 != 0) ? sorted[mid] : 0.5 * (sorted[mid - 1] + sorted[mid]);
+}
+
+inline SampleSummary summarize(std::vector<double> samples)
+{
+    SampleSummary s;
+    s.count = samples.size();
+    if (samples.empty())
+    {
+        return s;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    s.median = medianOfSorted(samples);
+    s.min = samples.front();
+
+    double sum = 0.0;
+    for (double v : samples)
+    {
+        sum += v;
+    }
+    s.mean = sum / static_cast<double>(samples.size());
+
+    for (double& v : samples)
+    {
+        v = std::fabs(v - s.median);
+    }
+    std::sort(samples.begin(), samples.end());
+    s.mad = medianOfSorted(samples);
+    return s;
+}
+
+// ============================================================================
+// Environment description
+// ============================================================================
+
+inline std::string compilerDescription()
+{
+    char buf[64];
+#if defined(__clang__)
+    std::snprintf(buf, sizeof(buf), "Clang %d.%d.%d",
+                  __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+    std::snprintf(buf, sizeof(buf), "GCC %d.%d.%d",
+                  __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#elif defined(_MSC_VER)
+    std::snprintf(buf, sizeof(buf), "MSVC %d", _MSC_FULL_VER);
+#else
+    std::snprintf(buf, sizeof(buf), "unknown");
+#endif
+    return buf;
+}
+
+inline std::string platformDescription()
+{
+#if defined(_WIN32)
+    const char* os = "windows";
+#elif defined(__APPLE__)
+    const char* os = "macos";
+#elif defined(__linux__)
+    const char* os = "linux";
+#else
+    const char* os = "unknown";
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+    const char* arch = "x64";
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    const char* arch = "arm64";
+#elif defined(__i386__) || defined(_M_IX86)
+    const char* arch = "x86";
+#else
+    const char* arch = "unknown";
+#endif
+
+    return std::string(os) + "-" + arch;
+}
+
+// CPU brand string from CPUID leaves 0x80000002..4 on x86; "model name" from
+// /proc/cpuinfo elsewhere on Linux.
+inline std::string cpuDescription()
+{
+    std::string brand;
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    unsigned regs[12] = {};
+    bool ok = true;
+    for (unsigned leaf = 0; leaf < 3 && ok; ++leaf)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int r[4];
+        __cpuid(r, static_cast<int>(0x80000002u + leaf));
+        for (int k = 0; k < 4; ++k)
+        {
+            regs[leaf * 4 + static_cast<unsigned>(k)] = static_cast<unsigned>(r[k]);
+        }
+#else
+        ok = __get_cpuid(0x80000002u + leaf, &regs[leaf * 4], &regs[leaf * 4 + 1],
+                         &regs[leaf * 4 + 2], &regs[leaf * 4 + 3]) != 0;
+#endif
+    }
+    if (ok)
+    {
+        char text[sizeof(regs) + 1] = {};
+        std::memcpy(text, regs, sizeof(regs));
+        brand = text;
+    }
+#endif
+
+#if defined(__linux__)
+    if (brand.empty())
+    {
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line))
+        {
+            if (line.rfind("model name", 0) == 0 || line.rfind("Model", 0) == 0)
+            {
+                const auto colon = line.find(':');
+                if (colon != std::string::npos)
+                {
+                    brand = line.substr(colon + 1);
+                }
+                break;
+            }
+        }
+    }
+#endif
+
+    // Trim the padding some vendors put around the brand string.
+    const auto first = brand.find_first_not_of(' ');
+    if (first == std::string::npos)
+    {
+        return "unknown";
+    }
+    const auto last = brand.find_last_not_of(' ');
+    return brand.substr(first, last - first + 1);
+}
+
+inline std::string utcTimestamp()
+{
+    const std::time_t now = std::time(nullptr);
+    std::tm utc{};
+#if defined(_WIN32)
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return buf;
+}
+
+// ============================================================================
+// JsonReport — collects cases during a run and writes them at the end
+// ============================================================================
+
+class JsonReport
+{
+public:
+    explicit JsonReport(std::string suite = {})
+        : mSuite(std::move(suite))
+    {
+    }
+
+    void setSuite(std::string suite) { mSuite = std::move(suite); }
+
+    /// Subsequent cases are filed under this section title.
+    void beginSection(std::string title) { mSection = std::move(title); }
+
+    /// Extra run parameters, written under "config".
+    void setConfig(const std::string& key, double value) { mConfig[key] = value; }
+
+    /// Record one case: per-library ns/op samples, in the same order as names.
+    /// allocsPerOp is empty when allocations were not measured.
+    void addCase(const std::string& caseName,
+                 std::size_t n,
+                 const std::vector<std::string>& names,
+                 const std::vector<std::vector<double>>& samples,
+                 const std::vector<double>& allocsPerOp = {})
+    {
+        Case c{mSection, caseName, n, {}};
+        for (std::size_t i = 0; i < names.size() && i < samples.size(); ++i)
+        {
+            c.results.push_back({names[i], summarize(samples[i]),
+                                 i < allocsPerOp.size() ? allocsPerOp[i] : -1.0, {}});
+        }
+        mCases.push_back(std::move(c));
+    }
+
+    /// Record one case from an already-computed summary.
+    void addResult(const std::string& caseName, std::size_t n,
+                   const std::string& library, const SampleSummary& summary,
+                   double allocsPerOp = -1.0)
+    {
+        mCases.push_back({mSection, caseName, n, {{library, summary, allocsPerOp, {}}}});
+    }
+
+    /// Attach per-operation counter values to @p library in the most recent
+    /// case. Ignored if that case has no result for @p library.
+    void addCounters(const std::string& library,
+                     std::vector<std::pair<std::string, double>> counters)
+    {
+        if (mCases.empty())
+        {
+            return;
+        }
+        for (Result& r : mCases.back().results)
+        {
+            if (r.library == library)
+            {
+                r.counters = std::move(counters);
+                return;
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t caseCount() const noexcept { return mCases.size(); }
+
+    [[nodiscard]] std::string toJson() const
+    {
+        std::ostringstream os;
+        os << "{\n";
+        os << "  \"schema\": 1,\n";
+        os << "  \"suite\": " << quote(mSuite) << ",\n";
+        os << "  \"timestamp\": " << quote(utcTimestamp()) << ",\n";
+        os << "  \"compiler\": " << quote(compilerDescription()) << ",\n";
+        os << "  \"cpu\": " << quote(cpuDescription()) << ",\n";
+        os << "  \"platform\": " << quote(platformDescription()) << ",\n";
+#if defined(NDEBUG)
+        os << "  \"build\": \"Release\",\n";
+#else
+        os << "  \"build\": \"Debug\",\n";
+#endif
+        os << "  \"config\": {";
+        bool first = true;
+        for (const auto& [key, value] : mConfig)
+        {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.17g", value);
+            os << (first ? " " : ", ") << quote(key) << ": " << buf;
+            first = false;
+        }
+        os << (first ? "},\n" : " },\n");
+
+        os << "  \"cases\": [";
+        for (std::size_t ci = 0; ci < mCases.size(); ++ci)
+        {
+            const Case& c = mCases[ci];
+            os << (ci == 0 ? "\n" : ",\n");
+            os << "    { \"section\": " << quote(c.section)
+               << ", \"case\": " << quote(c.name)
+               << ", \"n\": " << c.n << ",\n";
+            os << "      \"results\": [";
+            for (std::size_t ri = 0; ri < c.results.size(); ++ri)
+            {
+                const Result& r = c.results[ri];
+                const SampleSummary& s = r.stats;
+                os << (ri == 0 ? "\n" : ",\n");
+                os << "        { \"library\": " << quote(r.library)
+                   << ", \"median_ns\": " << number(s.median)
+                   << ", \"mad_ns\": " << number(s.mad)
+                   << ", \"mean_ns\": " << number(s.mean)
+                   << ", \"min_ns\": " << number(s.min)
+                   << ", \"samples\": " << s.count;
+                if (r.allocsPerOp >= 0.0)
+                {
+                    os << ", \"allocs_per_op\": " << number(r.allocsPerOp);
+                }
+                if (!r.counters.empty())
+                {
+                    os << ",\n          \"counters\": {";
+                    for (std::size_t k = 0; k < r.counters.size(); ++k)
+                    {
+                        os << (k == 0 ? " " : ", ") << quote(r.counters[k].first)
+                           << ": " << number(r.counters[k].second);
+                    }
+                    os << " }";
+                }
+                os << " }";
+            }
+            os << "\n      ] }";
+        }
+        os << "\n  ]\n}\n";
+        return os.str();
+    }
+
+    /// Write the report to @p path. Returns false (and prints why) on failure.
+    bool write(const std::string& path) const
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+        {
+            std::fprintf(stderr, "error: cannot open '%s' for writing\n", path.c_str());
+            return false;
+        }
+        out << toJson();
+        return static_cast<bool>(out);
+    }
+
+private:
+    struct Result
+    {
+        std::string library;
+        SampleSummary stats;
+        double allocsPerOp = -1.0; // < 0: not measured
+        std::vector<std::pair<std::string, double>> counters; // empty: not measured
+    };
+
+    struct Case
+    {
+        std::string section;
+        std::string name;
+        std::size_t n;
+        std::vector<Result> results;
+    };
+
+    static std::string quote(const std::string& s)
+    {
+        std::string out = "\"";
+        for (char c : s)
+        {
+            switch (c)
+            {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) >= 0x20)
+                {
+                    out += c;
+                }
+                break;
+            }
+        }
+        out += '"';
+        return out;
+    }
+
+    // Round-trip precision, so tiny values such as an occasional allocation
+    // (allocs_per_op of 1e-6) survive. Always emit a fractional part or an
+    // exponent so readers see a floating-point value.
+    static std::string number(double v)
+    {
+        if (!std::isfinite(v))
+        {
+            return "0.0";
+        }
+        char buf[48];
+        std::snprintf(buf, sizeof(buf), "%.17g", v);
+        std::string out = buf;
+        if (out.find_first_of(".e") == std::string::npos)
+        {
+            out += ".0";
+        }
+        return out;
+    }
+
+    std::string mSuite;
+    std::string mSection;
+    std::map<std::string, double> mConfig;
+    std::vector<Case> mCases;
+};
+
+// ============================================================================
+// Baseline comparison
+// ============================================================================
+
+struct CompareOptions
+{
+    double thresholdPct = 10.0;
+    std::string library; // empty = compare every library
+};
+
+namespace detail
+{
+
+struct CaseResult
+{
+    double median = 0.0;
+    double mad = 0.0;
+    double allocsPerOp = -1.0;
+};
+
+inline double jsonNumber(const fat_p::JsonValue& v)
+{
+    if (const auto* d = std::get_if<double>(&v))
+    {
+        return *d;
+    }
+    if (const auto* i = std::get_if<int64_t>(&v))
+    {
+        return static_cast<double>(*i);
+    }
+    return 0.0;
+}
+
+inline const fat_p::JsonValue* member(const fat_p::JsonObject& obj, const char* key)
+{
+    auto it = obj.find(key);
+    return it == obj.end() ? nullptr : &it->second;
+}
+
+inline std::string memberString(const fat_p::JsonObject& obj, const char* key)
+{
+    const fat_p::JsonValue* v = member(obj, key);
+    if (v != nullptr)
+    {
+        if (const auto* s = std::get_if<std::string>(v))
+        {
+            return *s;
+        }
+    }
+    return {};
+}
+
+// Ordered list of "section | case | library" keys plus their results.
+struct LoadedRun
+{
+    std::string compiler;
+    std::string cpu;
+    std::string timestamp;
+    std::vector<std::string> order;
+    std::map<std::string, CaseResult> results;
+};
+
+inline bool loadRun(const std::string& path, LoadedRun& run)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        std::fprintf(stderr, "error: cannot open '%s'\n", path.c_str());
+        return false;
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+
+    fat_p::JsonValue root;
+    try
+    {
+        root = fat_p::parse_json(text.str());
+    }
+    catch (const std::exception& ex)
+    {
+        std::fprintf(stderr, "error: '%s' is not valid JSON: %s\n", path.c_str(), ex.what());
+        return false;
+    }
+
+    const auto* top = std::get_if<fat_p::JsonObject>(&root);
+    const fat_p::JsonValue* cases = top != nullptr ? member(*top, "cases") : nullptr;
+    const auto* caseList = cases != nullptr ? std::get_if<fat_p::JsonArray>(cases) : nullptr;
+    if (caseList == nullptr)
+    {
+        std::fprintf(stderr, "error: '%s' has no \"cases\" array\n", path.c_str());
+        return false;
+    }
+
+    run.compiler = memberString(*top, "compiler");
+    run.cpu = memberString(*top, "cpu");
+    run.timestamp = memberString(*top, "timestamp");
+
+    for (const auto& c : *caseList)
+    {
+        const auto* co = std::get_if<fat_p::JsonObject>(&c);
+        const fat_p::JsonValue* res = co != nullptr ? member(*co, "results") : nullptr;
+        const auto* resList = res != nullptr ? std::get_if<fat_p::JsonArray>(res) : nullptr;
+        if (resList == nullptr)
+        {
+            continue;
+        }
+        const std::string prefix = memberString(*co, "section") + " | " + memberString(*co, "case");
+        for (const auto& r : *resList)
+        {
+            const auto* ro = std::get_if<fat_p::JsonObject>(&r);
+            if (ro == nullptr)
+            {
+                continue;
+            }
+            const fat_p::JsonValue* median = member(*ro, "median_ns");
+            const fat_p::JsonValue* mad = member(*ro, "mad_ns");
+            const fat_p::JsonValue* allocs = member(*ro, "allocs_per_op");
+            const std::string key = prefix + " | " + memberString(*ro, "library");
+            if (run.results.find(key) == run.results.end())
+            {
+                run.order.push_back(key);
+            }
+            run.results[key] = {median != nullptr ? jsonNumber(*median) : 0.0,
+                                mad != nullptr ? jsonNumber(*mad) : 0.0,
+                                allocs != nullptr ? jsonNumber(*allocs) : -1.0};
+        }
+    }
+    return true;
+}
+
+inline bool keyMatchesLibrary(const std::string& key, const std::string& library)
+{
+    if (library.empty())
+    {
+        return true;
+    }
+    const std::string suffix = " | " + library;
+    return key.size() >= suffix.size() &&
+           key.compare(key.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace detail
+
+/**
+ * Compare CURRENT against BASELINE and print one line per matched case.
+ *
+ * @return 0 if nothing regressed, 1 if any case regressed or is missing from
+ *         CURRENT, 2 on file errors.
+ */
+inline int compareRuns(const std::string& baselinePath,
+                       const std::string& currentPath,
+                       const CompareOptions& opts)
+{
+    detail::LoadedRun base;
+    detail::LoadedRun cur;
+    if (!detail::loadRun(baselinePath, base) || !detail::loadRun(currentPath, cur))
+    {
+        return 2;
+    }
+
+    std::printf("Baseline: %s (%s, %s)\n", baselinePath.c_str(),
+                base.compiler.c_str(), base.timestamp.c_str());
+    std::printf("Current:  %s (%s, %s)\n", currentPath.c_str(),
+                cur.compiler.c_str(), cur.timestamp.c_str());
+    if (base.cpu != cur.cpu)
+    {
+        std::printf("Warning:  CPUs differ (\"%s\" vs \"%s\")\n", base.cpu.c_str(), cur.cpu.c_str());
+    }
+    std::printf("Threshold: +%.1f%% median and beyond combined MAD%s%s\n\n",
+                opts.thresholdPct,
+                opts.library.empty() ? "" : ", library ",
+                opts.library.c_str());
+
+    std::size_t compared = 0;
+    std::size_t regressed = 0;
+    std::size_t improved = 0;
+    std::size_t missing = 0;
+
+    for (const std::string& key : base.order)
+    {
+        if (!detail::keyMatchesLibrary(key, opts.library))
+        {
+            continue;
+        }
+        auto it = cur.results.find(key);
+        if (it == cur.results.end())
+        {
+            ++missing;
+            std::printf("  MISSING    %s\n", key.c_str());
+            continue;
+        }
+
+        const detail::CaseResult& b = base.results[key];
+        const detail::CaseResult& c = it->second;
+        ++compared;
+
+        const double deltaPct = b.median > 0.0 ? (c.median / b.median - 1.0) * 100.0 : 0.0;
+        const double noise = b.mad + c.mad;
+        const bool slower = deltaPct > opts.thresholdPct && c.median - b.median > noise;
+        const bool faster = deltaPct < -opts.thresholdPct && b.median - c.median > noise;
+
+        // Allocation counts are exact and written at round-trip precision,
+        // so any increase is a regression.
+        const bool allocsTracked = b.allocsPerOp >= 0.0 && c.allocsPerOp >= 0.0;
+        const bool moreAllocs = allocsTracked && c.allocsPerOp > b.allocsPerOp;
+
+        const char* status = "ok";
+        if (slower || moreAllocs)
+        {
+            status = "REGRESSED";
+            ++regressed;
+        }
+        else if (faster)
+        {
+            status = "improved";
+            ++improved;
+        }
+
+        std::printf("  %-10s %s: %.3f -> %.3f ns/op (%+.1f%%)",
+                    status, key.c_str(), b.median, c.median, deltaPct);
+        if (allocsTracked)
+        {
+            std::printf(", allocs/op %.6g -> %.6g", b.allocsPerOp, c.allocsPerOp);
+        }
+        std::printf("\n");
+    }
+
+    std::printf("\n%zu compared, %zu regressed, %zu improved, %zu missing from current\n",
+                compared, regressed, improved, missing);
+    // A case that disappeared cannot be shown not to have regressed.
+    return regressed == 0 && missing == 0 ? 0 : 1;
+}
+
+/**
+ * Parse "--compare BASELINE CURRENT [--threshold PCT] [--library NAME]".
+ *
+ * @return true if argv requested compare mode; @p exitCode then holds the
+ *         process exit status.
+ */
+inline bool runCompareFromArgs(int argc, char* argv[], int& exitCode)
+{
+    std::string baseline;
+    std::string current;
+    CompareOptions opts;
+    bool requested = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--compare") == 0)
+        {
+            requested = true;
+            if (i + 2 >= argc)
+            {
+                std::fprintf(stderr, "usage: --compare BASELINE.json CURRENT.json "
+                                     "[--threshold PCT] [--library NAME]\n");
+                exitCode = 2;
+                return true;
+            }
+            baseline = argv[++i];
+            current = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+        {
+            opts.thresholdPct = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--library") == 0 && i + 1 < argc)
+        {
+            opts.library = argv[++i];
+        }
+    }
+
+    if (requested)
+    {
+        exitCode = compareRuns(baseline, current, opts);
+    }
+    return requested;
+}
+
+} // namespace fatp_ecs::bench
@@ -0,0 +1,267 @@
+#pragma once
+
+// PerfCounters.h — Optional hardware performance counters for the benchmarks
+//
+// Timings say how fast a case ran; counters say why. The iteration numbers in
+// the README differ between GCC and Clang mostly through codegen (see the
+// aliasing note in View.h), which shows up directly as instructions and
+// cache misses per entity.
+//
+// Linux only, via perf_event_open(2). Each event is opened as its own
+// user-space-only counter, so a CPU or VM that lacks one event (dTLB misses
+// are often missing under virtualization) still reports the rest. When more
+// events are requested than the PMU has counters the kernel multiplexes
+// them; values are scaled by time_enabled / time_running.
+//
+// Everything degrades to "unavailable" rather than failing: non-Linux
+// builds, containers without the syscall, and kernels with
+// /proc/sys/kernel/perf_event_paranoid > 2 all produce a reason string and
+// the benchmark runs on with timings only.
+//
+// Usage:
+//   PerfCounters counters;
+//   if (counters.open()) { counters.start(); work(); auto v = counters.stop(); }
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace fatp_ecs::bench
+{
+
+enum class PerfEvent : std::size_t
+{
+    Cycles,
+    Instructions,
+    L1dMisses,
+    LlcMisses,
+    DtlbMisses,
+    BranchMisses,
+    Count
+};
+
+inline constexpr std::size_t kPerfEventCount = static_cast<std::size_t>(PerfEvent::Count);
+
+/// Short names used in console output and as JSON keys.
+inline const char* perfEventName(PerfEvent event) noexcept
+{
+    switch (event)
+    {
+    case PerfEvent::Cycles:       return "cycles";
+    case PerfEvent::Instructions: return "instructions";
+    case PerfEvent::L1dMisses:    return "l1d_misses";
+    case PerfEvent::LlcMisses:    return "llc_misses";
+    case PerfEvent::DtlbMisses:   return "dtlb_misses";
+    case PerfEvent::BranchMisses: return "branch_misses";
+    case PerfEvent::Count:        break;
+    }
+    return "?";
+}
+
+/// One measurement. valid[i] is false for events that could not be opened.
+struct PerfSample
+{
+    std::array<double, kPerfEventCount> values{};
+    std::array<bool, kPerfEventCount> valid{};
+
+    [[nodiscard]] bool has(PerfEvent e) const noexcept
+    {
+        return valid[static_cast<std::size_t>(e)];
+    }
+
+    [[nodiscard]] double get(PerfEvent e) const noexcept
+    {
+        return values[static_cast<std::size_t>(e)];
+    }
+
+    /// Every valid value divided by @p n (per entity / per operation).
+    [[nodiscard]] PerfSample perOp(std::size_t n) const noexcept
+    {
+        PerfSample out = *this;
+        if (n > 0)
+        {
+            for (double& v : out.values)
+            {
+                v /= static_cast<double>(n);
+            }
+        }
+        return out;
+    }
+};
+
+class PerfCounters
+{
+public:
+    PerfCounters() { mFds.fill(-1); }
+    ~PerfCounters() { close(); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /// Open every event on the calling thread. Returns true if at least one
+    /// opened; otherwise unavailableReason() says why.
+    bool open()
+    {
+        close();
+#if defined(__linux__)
+        int firstErrno = 0;
+        for (std::size_t i = 0; i < kPerfEventCount; ++i)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            describe(static_cast<PerfEvent>(i), attr);
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            const long fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+            if (fd >= 0)
+            {
+                mFds[i] = static_cast<int>(fd);
+                mAnyOpen = true;
+            }
+            else if (firstErrno == 0)
+            {
+                firstErrno = errno;
+            }
+        }
+        if (!mAnyOpen)
+        {
+            mReason = std::string("perf_event_open failed: ") + std::strerror(firstErrno);
+            if (firstErrno == EACCES || firstErrno == EPERM)
+            {
+                mReason += " (check /proc/sys/kernel/perf_event_paranoid)";
+            }
+        }
+#else
+        mReason = "hardware counters are only supported on Linux";
+#endif
+        return mAnyOpen;
+    }
+
+    [[nodiscard]] bool available() const noexcept { return mAnyOpen; }
+
+    [[nodiscard]] const std::string& unavailableReason() const noexcept { return mReason; }
+
+    /// Reset and enable all open counters.
+    void start() noexcept
+    {
+#if defined(__linux__)
+        for (int fd : mFds)
+        {
+            if (fd >= 0)
+            {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /// Disable all open counters and return the multiplexing-scaled totals
+    /// since start().
+    PerfSample stop() noexcept
+    {
+        PerfSample sample;
+#if defined(__linux__)
+        for (int fd : mFds)
+        {
+            if (fd >= 0)
+            {
+                ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (std::size_t i = 0; i < kPerfEventCount; ++i)
+        {
+            if (mFds[i] < 0)
+            {
+                continue;
+            }
+            uint64_t buf[3] = {0, 0, 0}; // value, time_enabled, time_running
+            if (::read(mFds[i], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)) ||
+                buf[2] == 0)
+            {
+                continue; // never scheduled onto the PMU: no data
+            }
+            sample.values[i] = static_cast<double>(buf[0]) *
+                               (static_cast<double>(buf[1]) / static_cast<double>(buf[2]));
+            sample.valid[i] = true;
+        }
+#endif
+        return sample;
+    }
+
+    void close() noexcept
+    {
+#if defined(__linux__)
+        for (int& fd : mFds)
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+#endif
+        mAnyOpen = false;
+    }
+
+private:
+#if defined(__linux__)
+    static void describe(PerfEvent event, perf_event_attr& attr) noexcept
+    {
+        auto cacheMiss = [&](uint64_t cache)
+        {
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache |
+                          (static_cast<uint64_t>(PERF_COUNT_HW_CACHE_OP_READ) << 8) |
+                          (static_cast<uint64_t>(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16);
+        };
+
+        switch (event)
+        {
+        case PerfEvent::Cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfEvent::Instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfEvent::L1dMisses:
+            cacheMiss(PERF_COUNT_HW_CACHE_L1D);
+            break;
+        case PerfEvent::LlcMisses:
+            cacheMiss(PERF_COUNT_HW_CACHE_LL);
+            break;
+        case PerfEvent::DtlbMisses:
+            cacheMiss(PERF_COUNT_HW_CACHE_DTLB);
+            break;
+        case PerfEvent::BranchMisses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfEvent::Count:
+            break;
+        }
+    }
+#endif
+
+    std::array<int, kPerfEventCount> mFds{};
+    bool mAnyOpen = false;
+    std::string mReason;
+};
+
+} // namespace fatp_ecs::bench
@@ -11,7 +11,19 @@
 // Build: cmake -B build -DFATP_ECS_BUILD_BENCH=ON ...
 //        cmake --build build --config Release --target benchmark
 //
-// Run:   build\Release\benchmark.exe
+// Run:   build\Release\benchmark.exe [--json PATH] [--perf-counters]
+//        build\Release\benchmark.exe --compare BASELINE.json CURRENT.json
+//                                     [--threshold PCT] [--library NAME]
+//
+//        --json also writes every case (median, MAD, per library) plus
+//        compiler/CPU metadata as JSON; --compare diffs two such files and
+//        exits 1 if any case regressed (see BenchReport.h).
+//
+//        --perf-counters (Linux) also reads cycles, instructions, L1d/LLC/
+//        dTLB misses and branch misses per entity from perf_event_open (see
+//        PerfCounters.h), in a few extra untimed passes per library. If the
+//        counters cannot be opened the run prints why and continues with
+//        timings only.
 //
 // Env:   FATP_BENCH_BATCHES=25        (default: 15 Windows, 50 Linux)
 //        FATP_BENCH_WARMUP_RUNS=5     (default: 3)
@@ -19,22 +31,53 @@
 //        FATP_BENCH_NO_SCOPE=1        (skip priority/affinity)
 //        FATP_BENCH_NO_STABILIZE=1    (skip CPU stabilization)
 //        FATP_BENCH_VERBOSE_STATS=1   (show detailed statistics)
+//
+// Allocations: configure with -DFATP_ECS_TRACK_ALLOCATIONS=ON to replace the
+// global operator new (AllocationTracker.h) and print heap allocations per
+// operation for every case. Counting runs in one extra untimed pass per
+// library; timings from tracking builds include a relaxed atomic increment
+// per allocation and should only be compared with other tracking builds.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <random>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <fat_p/FatPBenchmarkRunner.h>
+#include <fatp_ecs/AllocationTracker.h>
+#include <fatp_ecs/ArchetypeRegistry.h>
+#include <fatp_ecs/CommandBuffer.h>
+#include <fatp_ecs/CommandBuffer_Impl.h>
+#include <fatp_ecs/EntityTemplate.h>
+#include <fatp_ecs/EntityTemplate_Impl.h>
+#include <fatp_ecs/FrameAllocator.h>
+#include <fatp_ecs/FrameArena.h>
+#include <fatp_ecs/Hierarchy.h>
+#include <fatp_ecs/Migration.h>
+#include <fatp_ecs/ProcessScheduler.h>
 #include <fatp_ecs/Registry.h>
+#include <fatp_ecs/Scheduler.h>
+#include <fatp_ecs/ShardedRegistry.h>
+#include <fatp_ecs/Snapshot.h>
+#include <fatp_ecs/SpatialHash.h>
+
+#include "BenchReport.h"
+#include "PerfCounters.h"
 
 // ============================================================================
 // EnTT — suppress MSVC warnings from third-party headers
@@ -50,6 +93,10 @@
 #pragma warning(pop)
 #endif
 
+#if defined(FATP_ECS_TRACK_ALLOCATIONS)
+FATP_ECS_INSTALL_ALLOCATION_TRACKER();
+#endif
+
 using namespace fat_p::bench;
 
 // ============================================================================
@@ -68,6 +115,18 @@ inline void snk(uint64_t v) { gSink += v; }
 inline void snk(float v)    { uint32_t b; std::memcpy(&b, &v, 4); gSink += b; }
 inline void snk(int v)      { gSink += static_cast<uint64_t>(static_cast<uint32_t>(v)); }
 
+// ============================================================================
+// JSON report (written at exit when --json is given)
+// ============================================================================
+static fatp_ecs::bench::JsonReport gReport;
+
+// runner.section() plus the JSON section title for the cases that follow.
+decltype(auto) beginSection(BenchmarkRunner& runner, const char* title)
+{
+    gReport.beginSection(title);
+    return runner.section(title);
+}
+
 // ============================================================================
 // Round-robin comparison using runner infrastructure
 //
@@ -78,7 +137,52 @@ inline void snk(int v)      { gSink += static_cast<uint64_t>(static_cast<uint32_
 
 using BenchFn = std::function<void()>;
 
-void roundRobinCompare(
+// Non-null when --perf-counters was given and at least one event opened.
+// Counters follow the main thread only, so multi-threaded cases (section 14)
+// report the calling thread's share.
+static fatp_ecs::bench::PerfCounters* gCounters = nullptr;
+
+// One line of per-entity counters, e.g.
+//   fatp_ecs counters/op: cycles 5.21  instr 14.02  IPC 2.69  L1d 0.126 ...
+// Events the CPU could not provide print as "-".
+void printCounters(const std::string& name, const fatp_ecs::bench::PerfSample& s)
+{
+    using fatp_ecs::bench::PerfEvent;
+    auto field = [&](const char* label, PerfEvent e, int precision)
+    {
+        char buf[48];
+        if (s.has(e))
+        {
+            std::snprintf(buf, sizeof(buf), "  %s %.*f", label, precision, s.get(e));
+        }
+        else
+        {
+            std::snprintf(buf, sizeof(buf), "  %s -", label);
+        }
+        std::cout << buf;
+    };
+
+    std::cout << "    " << name << " counters/op:";
+    field("cycles", PerfEvent::Cycles, 2);
+    field("instr", PerfEvent::Instructions, 2);
+    if (s.has(PerfEvent::Cycles) && s.has(PerfEvent::Instructions) &&
+        s.get(PerfEvent::Cycles) > 0.0)
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "  IPC %.2f",
+                      s.get(PerfEvent::Instructions) / s.get(PerfEvent::Cycles));
+        std::cout << buf;
+    }
+    field("L1d", PerfEvent::L1dMisses, 3);
+    field("LLC", PerfEvent::LlcMisses, 3);
+    field("dTLB", PerfEvent::DtlbMisses, 3);
+    field("br-miss", PerfEvent::BranchMisses, 3);
+    std::cout << "\n";
+}
+
+// Returns the median ns/op of each library, in `names` order, so callers can
+// derive ratios (e.g. scaling speedup) from the same samples that were printed.
+std::vector<double> roundRobinCompare(
     BenchmarkRunner& runner,
     const std::string& caseName,
     const std::vector<std::string>& names,
@@ -127,14 +231,97 @@ void roundRobinCompare(
         }
     }
 
+    // Allocation pass: one untimed run per library, tracking builds only.
+    std::vector<double> allocsPerOp;
+    if (fatp_ecs::AllocationTracker::installed())
+    {
+        for (std::size_t i = 0; i < nLibs; ++i)
+        {
+            setups[i]();
+            fatp_ecs::AllocationScope scope;
+            benches[i]();
+            allocsPerOp.push_back(static_cast<double>(scope.allocations()) /
+                                  static_cast<double>(N));
+        }
+    }
+
+    // Counter passes: untimed, --perf-counters only. Each event is the
+    // median of kCounterPasses runs to damp one-off interrupts and migrations.
+    std::vector<fatp_ecs::bench::PerfSample> countersPerOp;
+    if (gCounters != nullptr)
+    {
+        constexpr std::size_t kCounterPasses = 3;
+        for (std::size_t i = 0; i < nLibs; ++i)
+        {
+            std::array<fatp_ecs::bench::PerfSample, kCounterPasses> passes;
+            for (auto& pass : passes)
+            {
+                setups[i]();
+                gCounters->start();
+                benches[i]();
+                pass = gCounters->stop();
+            }
+
+            fatp_ecs::bench::PerfSample median = passes[0];
+            for (std::size_t e = 0; e < fatp_ecs::bench::kPerfEventCount; ++e)
+            {
+                std::array<double, kCounterPasses> values{};
+                for (std::size_t p = 0; p < kCounterPasses; ++p)
+                {
+                    values[p] = passes[p].values[e];
+                    median.valid[e] = median.valid[e] && passes[p].valid[e];
+                }
+                std::sort(values.begin(), values.end());
+                median.values[e] = values[kCounterPasses / 2];
+            }
+            countersPerOp.push_back(median.perOp(N));
+        }
+    }
+
     // Print results
+    std::vector<double> medians(nLibs, 0.0);
     std::cout << "  " << caseName << ":\n";
     for (std::size_t i = 0; i < nLibs; ++i)
     {
-        auto stats = Statistics::compute(std::move(allSamples[i]));
+        std::vector<double> sorted = allSamples[i];
+        std::sort(sorted.begin(), sorted.end());
+        medians[i] = fatp_ecs::bench::medianOfSorted(sorted);
+
+        auto stats = Statistics::compute(allSamples[i]);
         stats.printComparison(std::cout, names[i].c_str());
     }
+    if (!allocsPerOp.empty())
+    {
+        const auto oldPrecision = std::cout.precision(3);
+        std::cout << "    allocs/op:" << std::fixed;
+        for (std::size_t i = 0; i < nLibs; ++i)
+        {
+            std::cout << "  " << names[i] << "=" << allocsPerOp[i];
+        }
+        std::cout << std::defaultfloat << "\n";
+        std::cout.precision(oldPrecision);
+    }
+    for (std::size_t i = 0; i < countersPerOp.size(); ++i)
+    {
+        printCounters(names[i], countersPerOp[i]);
+    }
     std::cout << "\n";
+    gReport.addCase(caseName, N, names, allSamples, allocsPerOp);
+    for (std::size_t i = 0; i < countersPerOp.size(); ++i)
+    {
+        std::vector<std::pair<std::string, double>> json;
+        for (std::size_t e = 0; e < fatp_ecs::bench::kPerfEventCount; ++e)
+        {
+            const auto event = static_cast<fatp_ecs::bench::PerfEvent>(e);
+            if (countersPerOp[i].has(event))
+            {
+                json.emplace_back(fatp_ecs::bench::perfEventName(event),
+                                  countersPerOp[i].get(event));
+            }
+        }
+        gReport.addCounters(names[i], std::move(json));
+    }
+    return medians;
 }
 
 // ============================================================================
@@ -143,7 +330,7 @@ void roundRobinCompare(
 
 void section1_Create(BenchmarkRunner& runner)
 {
-    runner.section("1. CREATE ENTITIES")
+    beginSection(runner, "1. CREATE ENTITIES")
           .contract("Allocate N entities, no components. Includes entity ID sink to prevent DCE.");
 
     for (auto N : {1'000u, 10'000u, 100'000u, 1'000'000u})
@@ -174,7 +361,7 @@ void section1_Create(BenchmarkRunner& runner)
 
 void section2_Destroy(BenchmarkRunner& runner)
 {
-    runner.section("2. DESTROY ENTITIES")
+    beginSection(runner, "2. DESTROY ENTITIES")
           .contract("Create N entities in setup (untimed), then destroy all. Measures destroy throughput.");
 
     for (auto N : {1'000u, 10'000u, 100'000u, 1'000'000u})
@@ -208,7 +395,7 @@ void section2_Destroy(BenchmarkRunner& runner)
 
 void section3_Add1(BenchmarkRunner& runner)
 {
-    runner.section("3. ADD 1 COMPONENT (Position)")
+    beginSection(runner, "3. ADD 1 COMPONENT (Position)")
           .contract("Create N entities in setup, then add Position to each. Measures component attachment.");
 
     for (auto N : {1'000u, 10'000u, 100'000u, 1'000'000u})
@@ -242,7 +429,7 @@ void section3_Add1(BenchmarkRunner& runner)
 
 void section4_Add3(BenchmarkRunner& runner)
 {
-    runner.section("4. ADD 3 COMPONENTS (Position + Velocity + Health)")
+    beginSection(runner, "4. ADD 3 COMPONENTS (Position + Velocity + Health)")
           .contract("Create N entities in setup, then add Position+Velocity+Health to each.");
 
     for (auto N : {1'000u, 10'000u, 100'000u, 1'000'000u})
@@ -276,7 +463,7 @@ void section4_Add3(BenchmarkRunner& runner)
 
 void section5_Remove(BenchmarkRunner& runner)
 {
-    runner.section("5. REMOVE COMPONENT (Position)")
+    beginSection(runner, "5. REMOVE COMPONENT (Position)")
           .contract("Create N entities with Position in setup, then remove Position from each.");
 
     for (auto N : {1'000u, 10'000u, 100'000u, 1'000'000u})
@@ -310,7 +497,7 @@ void section5_Remove(BenchmarkRunner& runner)
 
 void section6_Get(BenchmarkRunner& runner)
 {
-    runner.section("6. GET COMPONENT (Position)")
+    beginSection(runner, "6. GET COMPONENT (Position)")
           .contract("Create N entities with Position in setup (persistent), then get Position for each. Sink value to prevent DCE.");
 
     for (auto N : {1'000u, 10'000u, 100'000u, 1'000'000u})
@@ -344,7 +531,7 @@ void section6_Get(BenchmarkRunner& runner)
 
 void section7_Iter1(BenchmarkRunner& runner)
 {
-    runner.section("7. 1-COMPONENT ITERATION (Position)")
+    beginSection(runner, "7. 1-COMPONENT ITERATION (Position)")
           .contract("N entities with Position. Iterate via view, update + sink.");
 
     for (auto N : {1'000u, 10'000u, 100'000u, 1'000'000u})
@@ -375,7 +562,7 @@ void section7_Iter1(BenchmarkRunner& runner)
 
 void section8_Iter2(BenchmarkRunner& runner)
 {
-    runner.section("8. 2-COMPONENT ITERATION (Position + Velocity)")
+    beginSection(runner, "8. 2-COMPONENT ITERATION (Position + Velocity)")
           .contract("N entities with Position+Velocity. Apply velocity to position.");
 
     for (auto N : {1'000u, 10'000u, 100'000u, 1'000'000u})
@@ -406,7 +593,7 @@ void section8_Iter2(BenchmarkRunner& runner)
 
 void section9_Sparse(BenchmarkRunner& runner)
 {
-    runner.section("9. 2-COMPONENT SPARSE ITERATION")
+    beginSection(runner, "9. 2-COMPONENT SPARSE ITERATION")
           .contract("N Position, N/2 Velocity (even entities only). Tests sparse join efficiency.");
 
     for (auto N : {1'000u, 10'000u, 100'000u, 1'000'000u})
@@ -458,7 +645,7 @@ void section9_Sparse(BenchmarkRunner& runner)
 
 void section10_Iter3(BenchmarkRunner& runner)
 {
-    runner.section("10. 3-COMPONENT ITERATION (Position + Velocity + Health)")
+    beginSection(runner, "10. 3-COMPONENT ITERATION (Position + Velocity + Health)")
           .contract("N entities with Position+Velocity+Health. Iterate all three.");
 
     for (auto N : {1'000u, 10'000u, 100'000u, 1'000'000u})
@@ -489,7 +676,7 @@ void section10_Iter3(BenchmarkRunner& runner)
 
 void section11_Frag(BenchmarkRunner& runner)
 {
-    runner.section("11. FRAGMENTED ITERATION")
+    beginSection(runner, "11. FRAGMENTED ITERATION")
           .contract("Create 2N, destroy odd indices, iterate remaining N with Position. Tests post-deletion density.");
 
     for (auto N : {10'000u, 100'000u})
@@ -535,8 +722,9 @@ void section11_Frag(BenchmarkRunner& runner)
 
 void section12_Churn(BenchmarkRunner& runner)
 {
-    runner.section("12. MIXED CREATE/DESTROY (churn)")
-          .contract("Pre-create N entities, then create+destroy N more (alternating). Churn stress test.");
+    beginSection(runner, "12. MIXED CREATE/DESTROY (churn)")
+          .contract("Pre-create N entities, then create+destroy N more (alternating). Churn stress test. "
+                    "Then: sparse size and iteration of a spawn wave after random destroys, per SlotRecycling policy.");
 
     for (auto N : {10'000u, 100'000u})
     {
@@ -561,41 +749,1954 @@ void section12_Churn(BenchmarkRunner& runner)
             },
             N);
     }
+
+    // Post-churn layout under each SlotRecycling policy. Setup builds N
+    // Position entities, destroys a random half, then spawns a wave of N/4
+    // entities with Position+Health into the freed slots. Which slots the wave
+    // lands on decides how large Health's sparse array grows and how
+    // scattered the Position probes are when the view drives from Health.
+    // No EnTT equivalent (EnTT always recycles LIFO).
+    const std::vector<std::pair<std::string, fatp_ecs::SlotRecycling>> policies{
+        {"Default", fatp_ecs::SlotRecycling::Default},
+        {"Lifo", fatp_ecs::SlotRecycling::Lifo},
+        {"LowestIndex", fatp_ecs::SlotRecycling::LowestIndex},
+        {"Fifo", fatp_ecs::SlotRecycling::Fifo},
+    };
+
+    for (auto N : {10'000u, 100'000u})
+    {
+        const std::size_t wave = N / 4;
+        std::vector<std::unique_ptr<fatp_ecs::Registry>> regs(policies.size());
+        std::vector<std::size_t> sparseSizes(policies.size(), 0);
+
+        auto churnSetup = [&](std::size_t p) {
+            auto& reg = regs[p];
+            reg = std::make_unique<fatp_ecs::Registry>();
+            reg->setSlotRecycling(policies[p].second);
+
+            std::mt19937 rng(static_cast<unsigned>(runner.config().seed));
+            std::vector<fatp_ecs::Entity> live(N);
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                live[i] = reg->create();
+                reg->add<Position>(live[i], static_cast<float>(i), 0.0f);
+            }
+            std::shuffle(live.begin(), live.end(), rng);
+            for (std::size_t i = 0; i < N / 2; ++i)
+            {
+                reg->destroy(live[i]);
+            }
+            for (std::size_t i = 0; i < wave; ++i)
+            {
+                auto e = reg->create();
+                reg->add<Position>(e, static_cast<float>(i), 0.0f);
+                reg->add<Health>(e);
+            }
+            sparseSizes[p] = reg->storage<Health>()->sparseCount();
+        };
+        auto iterate = [&](std::size_t p) {
+            int sum = 0;
+            regs[p]->view<Health, Position>().each(
+                [&](fatp_ecs::Entity, Health& h, Position& pos) { h.hp -= 1; sum += h.hp + static_cast<int>(pos.x); });
+            snk(sum);
+        };
+
+        std::vector<std::string> names;
+        std::vector<BenchFn> setups;
+        std::vector<BenchFn> benches;
+        for (std::size_t p = 0; p < policies.size(); ++p)
+        {
+            names.push_back(policies[p].first);
+            setups.emplace_back([&, p] { churnSetup(p); });
+            benches.emplace_back([&, p] { iterate(p); });
+        }
+
+        roundRobinCompare(runner, "post-churn wave iter N=" + std::to_string(N), names, setups, benches, wave);
+
+        std::cout << "  post-churn Health sparse size N=" << N << " (wave=" << wave << "):\n";
+        for (std::size_t p = 0; p < policies.size(); ++p)
+        {
+            std::cout << "    " << policies[p].first << ": " << sparseSizes[p] << "\n";
+        }
+        std::cout << "\n";
+    }
 }
 
 // ============================================================================
-// Main
+// 13. Frame Scratch Allocation (FrameAllocator vs FrameArena)
 // ============================================================================
 
-int main()
+// Mirrors the demo's Collision system: K CollisionPair records are produced
+// per frame and discarded at frame end. Both allocators are primed with one
+// full frame in setup so the timed region measures steady-state behaviour,
+// not first-frame block allocation. No EnTT equivalent exists.
+
+struct CollisionPair
 {
-    auto runner = makeRunner("fatp_ecs vs EnTT");
+    fatp_ecs::Entity a{fatp_ecs::NullEntity};
+    fatp_ecs::Entity b{fatp_ecs::NullEntity};
+    float distance = 0.0f;
+};
 
-    std::cout << "\nCompetitors:\n";
-    std::cout << "  [x] fatp_ecs (primary, 64-bit entities)\n";
-    std::cout << "  [x] EnTT (32-bit entities)\n";
-    std::cout << "  [x] EnTT (64-bit entities)\n";
-    std::cout << "\nDesign Invariants:\n";
-    std::cout << "  1. Round-robin execution with randomized order per run\n";
-    std::cout << "  2. Setup/teardown outside timed regions\n";
-    std::cout << "  3. All libraries observe same distribution of machine states\n";
-    std::cout << "  4. Medians are the primary reported statistic\n";
-    std::cout << "\nEntity size: fatp=64-bit, entt-32=32-bit, entt-64=64-bit\n";
-    std::cout.flush();
+void section13_FrameScratch(BenchmarkRunner& runner)
+{
+    beginSection(runner, "13. FRAME SCRATCH ALLOCATION (CollisionPair)")
+          .contract("Allocate K CollisionPair per frame, then release/reset. 16 frames per run, primed pools.");
 
-    section1_Create(runner);
-    section2_Destroy(runner);
-    section3_Add1(runner);
-    section4_Add3(runner);
-    section5_Remove(runner);
-    section6_Get(runner);
-    section7_Iter1(runner);
-    section8_Iter2(runner);
-    section9_Sparse(runner);
-    section10_Iter3(runner);
-    section11_Frag(runner);
-    section12_Churn(runner);
+    constexpr std::size_t kFrames = 16;
 
-    std::cout << "\nDone. (sink=" << gSink << ")\n";
+    for (auto K : {64u, 1'024u, 16'384u})
+    {
+        std::unique_ptr<fatp_ecs::FrameAllocator<CollisionPair>> pool;
+        std::unique_ptr<fatp_ecs::FrameArena> arena;
+
+        auto poolFrame = [&] {
+            for (std::size_t i = 0; i < K; ++i)
+            {
+                auto* p = pool->acquire(fatp_ecs::Entity(i), fatp_ecs::Entity(i + 1), static_cast<float>(i));
+                snk(p->distance);
+            }
+            pool->releaseAll();
+        };
+        auto arenaFrame = [&] {
+            for (std::size_t i = 0; i < K; ++i)
+            {
+                auto* p = arena->make<CollisionPair>(fatp_ecs::Entity(i), fatp_ecs::Entity(i + 1), static_cast<float>(i));
+                snk(p->distance);
+            }
+            arena->reset();
+        };
+
+        roundRobinCompare(runner, "K=" + std::to_string(K),
+            {"FrameAllocator", "FrameArena"},
+            {
+                [&] { pool = std::make_unique<fatp_ecs::FrameAllocator<CollisionPair>>(512); poolFrame(); },
+                [&] { arena = std::make_unique<fatp_ecs::FrameArena>(); arenaFrame(); },
+            },
+            {
+                [&] { for (std::size_t f = 0; f < kFrames; ++f) poolFrame(); },
+                [&] { for (std::size_t f = 0; f < kFrames; ++f) arenaFrame(); },
+            },
+            K * kFrames);
+    }
+}
+
+// ============================================================================
+// 14. Scheduler / parallel_for Scaling
+// ============================================================================
+
+// fatp_ecs only — EnTT has no scheduler. Each case runs the same workload on
+// Schedulers with T = 1, 2, 4, ... worker threads (up to hardware
+// concurrency); one Scheduler per T is built outside the timed region.
+//
+// P is the number of threads that actually run work. run() only waits on its
+// workers, so P = T. parallel_for runs its last chunk on the calling thread,
+// so P counts the caller: it is the number of chunks (workers used + 1).
+//
+//   Strong scaling: fixed total work. speedup = t(1) / t(T).
+//   Weak scaling:   work grows with T.  speedup = T * t(1) / t(T).
+//   efficiency = speedup / (P / P(1)) in both cases.
+//
+// t(T) is the median wall time of one timed run, reconstructed from the
+// median ns/op that roundRobinCompare reports.
+
+template <int I>
+struct Work { float v = 1.0f; };
+
+static std::vector<std::size_t> scalingThreadCounts()
+{
+    const std::size_t hw = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::vector<std::size_t> counts;
+    for (std::size_t t = 1; t < hw; t *= 2)
+    {
+        counts.push_back(t);
+    }
+    counts.push_back(hw);
+    return counts;
+}
+
+// Threads a parallel_for over `count` items runs on: one per chunk, the last
+// chunk on the caller. Mirrors Scheduler::parallel_for's chunking.
+static std::size_t parallelForThreads(std::size_t count, std::size_t workers,
+                                      std::size_t minChunkSize)
+{
+    const std::size_t chunkSize = std::max(minChunkSize, (count + workers - 1) / workers);
+    return (count + chunkSize - 1) / chunkSize;
+}
+
+// P for every scheduler when each run is one parallel_for over `count` items.
+static std::vector<std::size_t> parallelForParticipants(const std::vector<std::size_t>& threads,
+                                                        std::size_t count)
+{
+    std::vector<std::size_t> participants;
+    for (std::size_t t : threads)
+    {
+        participants.push_back(parallelForThreads(count, t, 1'024));
+    }
+    return participants;
+}
+
+static void printScaling(const std::vector<std::size_t>& threads,
+                         const std::vector<std::size_t>& participants,
+                         const std::vector<double>& medianNsPerOp,
+                         std::size_t opsPerRun,
+                         bool weak)
+{
+    const double base = medianNsPerOp[0] * static_cast<double>(opsPerRun);
+    const double baseP = static_cast<double>(participants[0]);
+    std::cout << "    " << std::left << std::setw(8) << "workers"
+              << std::setw(8) << "P"
+              << std::right << std::setw(14) << "median ms"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "efficiency" << "\n";
+    for (std::size_t i = 0; i < threads.size(); ++i)
+    {
+        const double wall = medianNsPerOp[i] * static_cast<double>(opsPerRun);
+        const double T = static_cast<double>(threads[i]);
+        const double P = static_cast<double>(participants[i]);
+        double speedup = (wall > 0.0) ? base / wall : 0.0;
+        if (weak)
+        {
+            speedup *= T;
+        }
+        std::cout << "    " << std::left << std::setw(8) << threads[i]
+                  << std::setw(8) << participants[i]
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(14) << wall / 1.0e6
+                  << std::setprecision(2)
+                  << std::setw(10) << speedup
+                  << std::setw(11) << 100.0 * speedup / (P / baseP) << "%\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    std::cout << "\n";
+}
+
+// Integrates Position += Velocity over every Position, split by parallel_for.
+static void parallelIntegrate(fatp_ecs::Scheduler& sched, fatp_ecs::Registry& reg)
+{
+    auto* posStore = reg.storage<Position>();
+    auto* velStore = reg.storage<Velocity>();
+    const fatp_ecs::Entity* dense = posStore->densePtr();
+    Position* pos = posStore->componentDataPtr();
+
+    sched.parallel_for(posStore->denseCount(),
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const Velocity& v = velStore->getUnchecked(dense[i]);
+                pos[i].x += v.dx * 0.016f;
+                pos[i].y += v.dy * 0.016f;
+            }
+        },
+        1'024);
+}
+
+static void fillPosVel(fatp_ecs::Registry& reg, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto e = reg.create();
+        reg.add<Position>(e, static_cast<float>(i), 0.0f);
+        reg.add<Velocity>(e, 1.0f, 1.0f);
+    }
+}
+
+template <int I>
+static void addWorkSystem(fatp_ecs::Scheduler& sched, fatp_ecs::ComponentMask write)
+{
+    sched.addSystem("Work" + std::to_string(I),
+        [](fatp_ecs::Registry& reg)
+        {
+            reg.view<Work<I>>().each([](fatp_ecs::Entity, Work<I>& w) { w.v = w.v * 0.999f + 0.001f; });
+        },
+        std::move(write));
+}
+
+template <int... Is>
+static void addWorkSystems(fatp_ecs::Scheduler& sched, bool conflicting,
+                           std::integer_sequence<int, Is...>)
+{
+    // Independent: each system writes only its own Work<I>, so all ten form
+    // one batch. Conflicting: every system also declares a write to Position,
+    // which forces ten sequential batches.
+    (addWorkSystem<Is>(sched, conflicting ? fatp_ecs::makeComponentMask<Work<Is>, Position>()
+                                          : fatp_ecs::makeComponentMask<Work<Is>>()), ...);
+}
+
+template <int... Is>
+static void fillWork(fatp_ecs::Registry& reg, std::size_t n, std::integer_sequence<int, Is...>)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto e = reg.create();
+        (reg.add<Work<Is>>(e), ...);
+    }
+}
+
+void section14_Scaling(BenchmarkRunner& runner)
+{
+    beginSection(runner, "14. SCHEDULER / PARALLEL_FOR SCALING")
+          .contract("Same workload on Schedulers with T worker threads. Reports median, speedup, and efficiency per participating thread P (parallel_for counts the caller).");
+
+    const std::vector<std::size_t> threads = scalingThreadCounts();
+    std::vector<std::unique_ptr<fatp_ecs::Scheduler>> scheds;
+    std::vector<std::string> names;
+    for (std::size_t t : threads)
+    {
+        scheds.push_back(std::make_unique<fatp_ecs::Scheduler>(t));
+        names.push_back("T=" + std::to_string(t));
+    }
+    const std::size_t nT = threads.size();
+    const auto workTypes = std::make_integer_sequence<int, 10>{};
+
+    // Times `body(i)` on scheduler i. All state is built up front, so there
+    // is no per-run setup.
+    auto measure = [&](const std::string& caseName,
+                       const std::function<void(std::size_t)>& body,
+                       std::size_t opsPerRun)
+    {
+        std::vector<BenchFn> setups(nT, [] {});
+        std::vector<BenchFn> benches;
+        for (std::size_t i = 0; i < nT; ++i)
+        {
+            benches.emplace_back([&body, i] { body(i); });
+        }
+        return roundRobinCompare(runner, caseName, names, setups, benches, opsPerRun);
+    };
+
+    // --- Strong scaling: parallel view iteration, fixed N ---------------------
+    {
+        constexpr std::size_t N = 1'000'000;
+        fatp_ecs::Registry reg;
+        fillPosVel(reg, N);
+
+        auto med = measure("strong: parallel iter2 N=1000000",
+            [&](std::size_t i) { parallelIntegrate(*scheds[i], reg); snk(reg.storage<Position>()->dataAt(0).x); },
+            N);
+        printScaling(threads, parallelForParticipants(threads, N), med, N, false);
+    }
+
+    // --- Weak scaling: parallel view iteration, N = 250K per thread ----------
+    {
+        constexpr std::size_t kPerThread = 250'000;
+        std::vector<std::unique_ptr<fatp_ecs::Registry>> regs(nT);
+        for (std::size_t i = 0; i < nT; ++i)
+        {
+            regs[i] = std::make_unique<fatp_ecs::Registry>();
+            fillPosVel(*regs[i], kPerThread * threads[i]);
+        }
+
+        // Cases differ in total size, so ns/op is per item of one thread's
+        // share: constant ns/op across T means perfect weak scaling.
+        auto med = measure("weak: parallel iter2 N=250000 per thread",
+            [&](std::size_t i) { parallelIntegrate(*scheds[i], *regs[i]); snk(regs[i]->storage<Position>()->dataAt(0).x); },
+            kPerThread);
+        std::vector<std::size_t> participants;
+        for (std::size_t t : threads)
+        {
+            participants.push_back(parallelForThreads(kPerThread * t, t, 1'024));
+        }
+        printScaling(threads, participants, med, kPerThread, true);
+    }
+
+    // --- Ten independent systems (one batch) and a conflicting chain ---------
+    for (bool conflicting : {false, true})
+    {
+        constexpr std::size_t N = 100'000;
+        fatp_ecs::Registry reg;
+        fillWork(reg, N, workTypes);
+
+        for (auto& s : scheds)
+        {
+            s->clearSystems();
+            addWorkSystems(*s, conflicting, workTypes);
+        }
+
+        auto med = measure(conflicting ? "10 conflicting systems (chain) N=100000 each"
+                                       : "10 independent systems N=100000 each",
+            [&](std::size_t i) { scheds[i]->run(reg); },
+            N * 10);
+        printScaling(threads, threads, med, N * 10, false);
+    }
+
+    // --- Overhead: empty run() and empty parallel_for ------------------------
+    {
+        constexpr std::size_t kReps = 1'000;
+        fatp_ecs::Registry reg;
+        for (auto& s : scheds)
+        {
+            s->clearSystems();
+            for (int k = 0; k < 10; ++k)
+            {
+                s->addSystem("Empty" + std::to_string(k), [](fatp_ecs::Registry&) {});
+            }
+        }
+
+        (void)measure("overhead: run() with 10 empty independent systems (per run)",
+            [&](std::size_t i) { for (std::size_t r = 0; r < kReps; ++r) scheds[i]->run(reg); },
+            kReps);
+
+        std::atomic<std::size_t> touched{0};
+        (void)measure("overhead: empty parallel_for over T chunks (per call)",
+            [&](std::size_t i)
+            {
+                const std::size_t count = threads[i] * 1'024;
+                for (std::size_t r = 0; r < kReps; ++r)
+                {
+                    scheds[i]->parallel_for(count,
+                        [&](std::size_t begin, std::size_t) { if (begin == 0) touched.fetch_add(1, std::memory_order_relaxed); },
+                        1'024);
+                }
+            },
+            kReps);
+        snk(static_cast<uint64_t>(touched.load()));
+
+        for (auto& s : scheds)
+        {
+            s->clearSystems();
+        }
+    }
+}
+
+// ============================================================================
+// 15. Owning Group Iteration
+// ============================================================================
+
+void section15_OwningGroup(BenchmarkRunner& runner)
+{
+    beginSection(runner, "15. OWNING GROUP ITERATION (Position + Velocity)")
+          .contract("N entities with both components, group created in setup. Timed: group each().");
+
+    for (auto N : {10'000u, 100'000u, 1'000'000u})
+    {
+        std::unique_ptr<fatp_ecs::Registry> fReg;
+        std::unique_ptr<entt::registry> e32Reg;
+        std::unique_ptr<entt::basic_registry<uint64_t>> e64Reg;
+
+        roundRobinCompare(runner, "N=" + std::to_string(N),
+            {"fatp_ecs", "entt-32", "entt-64"},
+            {
+                [&] { fReg = std::make_unique<fatp_ecs::Registry>(); for (std::size_t i = 0; i < N; ++i) { auto e = fReg->create(); fReg->add<Position>(e, 1.f, 2.f); fReg->add<Velocity>(e, 0.1f, 0.2f); } (void)fReg->group<Position, Velocity>(); },
+                [&] { e32Reg = std::make_unique<entt::registry>(); for (std::size_t i = 0; i < N; ++i) { auto e = e32Reg->create(); e32Reg->emplace<Position>(e, 1.f, 2.f); e32Reg->emplace<Velocity>(e, 0.1f, 0.2f); } (void)e32Reg->group<Position, Velocity>(); },
+                [&] { e64Reg = std::make_unique<entt::basic_registry<uint64_t>>(); for (std::size_t i = 0; i < N; ++i) { auto e = e64Reg->create(); e64Reg->emplace<Position>(e, 1.f, 2.f); e64Reg->emplace<Velocity>(e, 0.1f, 0.2f); } (void)e64Reg->group<Position, Velocity>(); },
+            },
+            {
+                [&] { fReg->group<Position, Velocity>().each([](fatp_ecs::Entity, Position& p, Velocity& v) { p.x += v.dx; p.y += v.dy; snk(p.x); }); },
+                [&] { e32Reg->group<Position, Velocity>().each([](auto, Position& p, Velocity& v) { p.x += v.dx; p.y += v.dy; snk(p.x); }); },
+                [&] { e64Reg->group<Position, Velocity>().each([](auto, Position& p, Velocity& v) { p.x += v.dx; p.y += v.dy; snk(p.x); }); },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 16. Non-Owning Group Maintenance under Churn
+// ============================================================================
+
+void section16_NonOwningGroupChurn(BenchmarkRunner& runner)
+{
+    beginSection(runner, "16. NON-OWNING GROUP MAINTENANCE (churn)")
+          .contract("N Position+Velocity, non-owning group live. Timed: remove+re-add Velocity on every other entity.");
+
+    for (auto N : {10'000u, 100'000u})
+    {
+        std::unique_ptr<fatp_ecs::Registry> fReg;
+        std::vector<fatp_ecs::Entity> fEnts;
+        std::unique_ptr<entt::registry> e32Reg;
+        std::vector<entt::entity> e32Ents;
+        std::unique_ptr<entt::basic_registry<uint64_t>> e64Reg;
+        std::vector<uint64_t> e64Ents;
+
+        roundRobinCompare(runner, "N=" + std::to_string(N),
+            {"fatp_ecs", "entt-32", "entt-64"},
+            {
+                [&] { fReg = std::make_unique<fatp_ecs::Registry>(); fEnts.resize(N); for (std::size_t i = 0; i < N; ++i) { fEnts[i] = fReg->create(); fReg->add<Position>(fEnts[i], 1.f, 2.f); fReg->add<Velocity>(fEnts[i], 0.1f, 0.2f); } (void)fReg->non_owning_group<Position, Velocity>(); },
+                [&] { e32Reg = std::make_unique<entt::registry>(); e32Ents.resize(N); for (std::size_t i = 0; i < N; ++i) { e32Ents[i] = e32Reg->create(); e32Reg->emplace<Position>(e32Ents[i], 1.f, 2.f); e32Reg->emplace<Velocity>(e32Ents[i], 0.1f, 0.2f); } (void)e32Reg->group<>(entt::get<Position, Velocity>); },
+                [&] { e64Reg = std::make_unique<entt::basic_registry<uint64_t>>(); e64Ents.resize(N); for (std::size_t i = 0; i < N; ++i) { e64Ents[i] = e64Reg->create(); e64Reg->emplace<Position>(e64Ents[i], 1.f, 2.f); e64Reg->emplace<Velocity>(e64Ents[i], 0.1f, 0.2f); } (void)e64Reg->group<>(entt::get<Position, Velocity>); },
+            },
+            {
+                [&] { for (std::size_t i = 0; i < N; i += 2) fReg->remove<Velocity>(fEnts[i]); for (std::size_t i = 0; i < N; i += 2) fReg->add<Velocity>(fEnts[i], 0.1f, 0.2f); snk(static_cast<uint64_t>(fReg->non_owning_group<Position, Velocity>().size())); },
+                [&] { for (std::size_t i = 0; i < N; i += 2) e32Reg->remove<Velocity>(e32Ents[i]); for (std::size_t i = 0; i < N; i += 2) e32Reg->emplace<Velocity>(e32Ents[i], 0.1f, 0.2f); snk(static_cast<uint64_t>(e32Reg->group<>(entt::get<Position, Velocity>).size())); },
+                [&] { for (std::size_t i = 0; i < N; i += 2) e64Reg->remove<Velocity>(e64Ents[i]); for (std::size_t i = 0; i < N; i += 2) e64Reg->emplace<Velocity>(e64Ents[i], 0.1f, 0.2f); snk(static_cast<uint64_t>(e64Reg->group<>(entt::get<Position, Velocity>).size())); },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 17. Observer Marking
+// ============================================================================
+
+// fatp_ecs only: entt::observer has been deprecated and reshaped across EnTT
+// releases, so there is no stable equivalent to pin against. The baseline is
+// the same patch loop with no observer connected; the difference is the cost
+// of marking plus the end-of-frame each()/clear().
+
+void section17_Observer(BenchmarkRunner& runner)
+{
+    beginSection(runner, "17. OBSERVER MARKING (OnUpdated<Position>)")
+          .contract("N entities with Position. Timed: patch every entity, then observer each()+clear().");
+
+    for (auto N : {10'000u, 100'000u})
+    {
+        // Registries persist across runs: patch() leaves the layout unchanged,
+        // and the Observer must stay where observe() returned it because its
+        // signal connections refer to it.
+        fatp_ecs::Registry plainReg;
+        fatp_ecs::Registry obsReg;
+        std::vector<fatp_ecs::Entity> plainEnts(N);
+        std::vector<fatp_ecs::Entity> obsEnts(N);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            plainEnts[i] = plainReg.create(); plainReg.add<Position>(plainEnts[i], 1.f, 2.f);
+            obsEnts[i] = obsReg.create(); obsReg.add<Position>(obsEnts[i], 1.f, 2.f);
+        }
+        auto obs = obsReg.observe(fatp_ecs::OnUpdated<Position>{});
+
+        roundRobinCompare(runner, "N=" + std::to_string(N),
+            {"no observer", "observer"},
+            {
+                [] {},
+                [&] { obs.clear(); },
+            },
+            {
+                [&] { for (auto e : plainEnts) plainReg.patch<Position>(e, [](Position& p) { p.x += 1.f; }); },
+                [&] {
+                    for (auto e : obsEnts) obsReg.patch<Position>(e, [](Position& p) { p.x += 1.f; });
+                    obs.each([](fatp_ecs::Entity e) { snk(e.get()); });
+                    obs.clear();
+                },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 18. Runtime View Iteration
+// ============================================================================
+
+void section18_RuntimeView(BenchmarkRunner& runner)
+{
+    beginSection(runner, "18. RUNTIME VIEW ITERATION (Position + Velocity)")
+          .contract("N Position, N/2 Velocity. Type-erased view built per run; each() reads Position via get().");
+
+    for (auto N : {10'000u, 100'000u, 1'000'000u})
+    {
+        std::unique_ptr<fatp_ecs::Registry> fReg;
+        std::unique_ptr<entt::registry> e32Reg;
+        std::unique_ptr<entt::basic_registry<uint64_t>> e64Reg;
+
+        roundRobinCompare(runner, "N=" + std::to_string(N),
+            {"fatp_ecs", "entt-32", "entt-64"},
+            {
+                [&] { fReg = std::make_unique<fatp_ecs::Registry>(); for (std::size_t i = 0; i < N; ++i) { auto e = fReg->create(); fReg->add<Position>(e, 1.f, 2.f); if (i % 2 == 0) fReg->add<Velocity>(e, 0.1f, 0.2f); } },
+                [&] { e32Reg = std::make_unique<entt::registry>(); for (std::size_t i = 0; i < N; ++i) { auto e = e32Reg->create(); e32Reg->emplace<Position>(e, 1.f, 2.f); if (i % 2 == 0) e32Reg->emplace<Velocity>(e, 0.1f, 0.2f); } },
+                [&] { e64Reg = std::make_unique<entt::basic_registry<uint64_t>>(); for (std::size_t i = 0; i < N; ++i) { auto e = e64Reg->create(); e64Reg->emplace<Position>(e, 1.f, 2.f); if (i % 2 == 0) e64Reg->emplace<Velocity>(e, 0.1f, 0.2f); } },
+            },
+            {
+                [&] {
+                    auto rv = fReg->runtimeView({fatp_ecs::typeId<Position>(), fatp_ecs::typeId<Velocity>()});
+                    rv.each([&](fatp_ecs::Entity e) { snk(fReg->get<Position>(e).x); });
+                },
+                [&] {
+                    entt::runtime_view rv{};
+                    rv.iterate(e32Reg->storage<Position>()).iterate(e32Reg->storage<Velocity>());
+                    rv.each([&](auto e) { snk(e32Reg->get<Position>(e).x); });
+                },
+                [&] {
+                    entt::basic_runtime_view<entt::basic_sparse_set<uint64_t>> rv{};
+                    rv.iterate(e64Reg->storage<Position>()).iterate(e64Reg->storage<Velocity>());
+                    rv.each([&](auto e) { snk(e64Reg->get<Position>(e).x); });
+                },
+            },
+            N / 2);
+    }
+}
+
+// ============================================================================
+// 19. CommandBuffer Record + Flush
+// ============================================================================
+
+// fatp_ecs only: EnTT has no deferred command buffer. The parallel case
+// records from every worker of a Scheduler (built once, outside timing) so
+// the cost of ParallelCommandBuffer's mutex under contention is visible.
+
+void section19_CommandBuffer(BenchmarkRunner& runner)
+{
+    beginSection(runner, "19. COMMAND BUFFER RECORD + FLUSH")
+          .contract("N entities with Position. Timed: record add<Health> for each, then flush().");
+
+    fatp_ecs::Scheduler sched;
+    const std::string parallelName = "ParallelCommandBuffer (" + std::to_string(sched.threadCount()) + " workers)";
+
+    for (auto N : {10'000u, 100'000u})
+    {
+        std::unique_ptr<fatp_ecs::Registry> regs[3];
+        std::vector<fatp_ecs::Entity> ents[3];
+
+        auto fill = [&](std::size_t k) {
+            regs[k] = std::make_unique<fatp_ecs::Registry>();
+            ents[k].resize(N);
+            for (std::size_t i = 0; i < N; ++i) { ents[k][i] = regs[k]->create(); regs[k]->add<Position>(ents[k][i], 1.f, 2.f); }
+        };
+
+        roundRobinCompare(runner, "N=" + std::to_string(N),
+            {"CommandBuffer", "ParallelCommandBuffer (1 thread)", parallelName},
+            {
+                [&] { fill(0); },
+                [&] { fill(1); },
+                [&] { fill(2); },
+            },
+            {
+                [&] {
+                    fatp_ecs::CommandBuffer cb;
+                    for (auto e : ents[0]) cb.add<Health>(e, 50, 100);
+                    cb.flush(*regs[0]);
+                    snk(static_cast<uint64_t>(regs[0]->storage<Health>()->size()));
+                },
+                [&] {
+                    fatp_ecs::ParallelCommandBuffer cb;
+                    for (auto e : ents[1]) (void)cb.add<Health>(e, 50, 100);
+                    cb.flush(*regs[1]);
+                    snk(static_cast<uint64_t>(regs[1]->storage<Health>()->size()));
+                },
+                [&] {
+                    fatp_ecs::ParallelCommandBuffer cb;
+                    sched.parallel_for(N, [&](std::size_t begin, std::size_t end) {
+                        for (std::size_t i = begin; i < end; ++i) (void)cb.add<Health>(ents[2][i], 50, 100);
+                    });
+                    cb.flush(*regs[2]);
+                    snk(static_cast<uint64_t>(regs[2]->storage<Health>()->size()));
+                },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 20. Sort
+// ============================================================================
+
+void section20_Sort(BenchmarkRunner& runner)
+{
+    beginSection(runner, "20. SORT (sort<Position>(cmp), sort<Position, Velocity>())")
+          .contract("N entities, random Position.x. Case 1: sort by x. Case 2: align Velocity to sorted Position.");
+
+    for (auto N : {10'000u, 100'000u})
+    {
+        std::unique_ptr<fatp_ecs::Registry> fReg;
+        std::unique_ptr<entt::registry> e32Reg;
+        std::unique_ptr<entt::basic_registry<uint64_t>> e64Reg;
+
+        std::mt19937 rng(static_cast<unsigned>(runner.config().seed));
+        std::uniform_real_distribution<float> dist(0.f, 1000.f);
+        std::vector<float> xs(N);
+        for (auto& x : xs) x = dist(rng);
+        auto byX = [](const Position& a, const Position& b) { return a.x < b.x; };
+
+        // Velocity is added in reverse entity order so it never starts out
+        // aligned with Position. `sortPivot` pre-sorts Position for case 2.
+        auto setupF = [&](bool sortPivot) {
+            fReg = std::make_unique<fatp_ecs::Registry>();
+            std::vector<fatp_ecs::Entity> ents(N);
+            for (std::size_t i = 0; i < N; ++i) { ents[i] = fReg->create(); fReg->add<Position>(ents[i], xs[i], 0.f); }
+            for (std::size_t i = N; i > 0; --i) fReg->add<Velocity>(ents[i - 1], 0.1f, 0.2f);
+            if (sortPivot) fReg->sort<Position>(byX);
+        };
+        auto setupE = [&](auto& reg, bool sortPivot) {
+            using Reg = typename std::decay_t<decltype(reg)>::element_type;
+            reg = std::make_unique<Reg>();
+            std::vector<typename Reg::entity_type> ents(N);
+            for (std::size_t i = 0; i < N; ++i) { ents[i] = reg->create(); reg->template emplace<Position>(ents[i], xs[i], 0.f); }
+            for (std::size_t i = N; i > 0; --i) reg->template emplace<Velocity>(ents[i - 1], 0.1f, 0.2f);
+            if (sortPivot) reg->template sort<Position>(byX);
+        };
+
+        roundRobinCompare(runner, "sort<Position> N=" + std::to_string(N),
+            {"fatp_ecs", "entt-32", "entt-64"},
+            {
+                [&] { setupF(false); },
+                [&] { setupE(e32Reg, false); },
+                [&] { setupE(e64Reg, false); },
+            },
+            {
+                [&] { fReg->sort<Position>(byX); snk(fReg->storage<Position>()->dataAt(0).x); },
+                [&] { e32Reg->sort<Position>(byX); snk(e32Reg->storage<Position>().begin()->x); },
+                [&] { e64Reg->sort<Position>(byX); snk(e64Reg->storage<Position>().begin()->x); },
+            },
+            N);
+
+        // EnTT's sort<To, From>() reorders To to follow From, i.e. the
+        // argument order is reversed relative to fatp_ecs's sort<Pivot, B>().
+        roundRobinCompare(runner, "sort<Position, Velocity> N=" + std::to_string(N),
+            {"fatp_ecs", "entt-32", "entt-64"},
+            {
+                [&] { setupF(true); },
+                [&] { setupE(e32Reg, true); },
+                [&] { setupE(e64Reg, true); },
+            },
+            {
+                [&] { fReg->sort<Position, Velocity>(); snk(fReg->storage<Velocity>()->dataAt(0).dx); },
+                [&] { e32Reg->sort<Velocity, Position>(); snk(e32Reg->storage<Velocity>().begin()->dx); },
+                [&] { e64Reg->sort<Velocity, Position>(); snk(e64Reg->storage<Velocity>().begin()->dx); },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 21. Snapshot Save / Load
+// ============================================================================
+
+// fatp_ecs only: EnTT's snapshot archive interface differs in shape (the
+// caller supplies an archive functor) and has changed between releases.
+
+static void benchSavePos(fat_p::binary::Encoder& e, const Position& p) { e.writeFloat(p.x); e.writeFloat(p.y); }
+static void benchSaveVel(fat_p::binary::Encoder& e, const Velocity& v) { e.writeFloat(v.dx); e.writeFloat(v.dy); }
+static Position benchLoadPos(fat_p::binary::Decoder& d, const fatp_ecs::EntityMap&) { return {d.readFloat(), d.readFloat()}; }
+static Velocity benchLoadVel(fat_p::binary::Decoder& d, const fatp_ecs::EntityMap&) { return {d.readFloat(), d.readFloat()}; }
+
+void section21_Snapshot(BenchmarkRunner& runner)
+{
+    beginSection(runner, "21. SNAPSHOT SAVE / LOAD (Position + Velocity)")
+          .contract("N entities with both components. Save: full snapshot to a byte buffer. Load: restore into a registry.");
+
+    for (auto N : {10'000u, 100'000u})
+    {
+        fatp_ecs::Registry src;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            auto e = src.create();
+            src.add<Position>(e, static_cast<float>(i), 2.f);
+            src.add<Velocity>(e, 0.1f, 0.2f);
+        }
+
+        auto save = [&](std::vector<uint8_t>& buf) {
+            buf.clear();
+            fat_p::binary::Encoder enc(buf);
+            auto snap = src.snapshot(enc);
+            snap.serializeComponent<Position>(enc, benchSavePos);
+            snap.serializeComponent<Velocity>(enc, benchSaveVel);
+            snap.finalize(enc);
+        };
+
+        std::vector<uint8_t> saveBuf;
+        std::vector<uint8_t> loadBuf;
+        save(loadBuf);
+        std::unique_ptr<fatp_ecs::Registry> dst;
+
+        roundRobinCompare(runner, "N=" + std::to_string(N) + " (" + std::to_string(loadBuf.size() / 1024) + " KiB)",
+            {"save", "load"},
+            {
+                [&] { saveBuf.reserve(loadBuf.size()); },
+                [&] { dst = std::make_unique<fatp_ecs::Registry>(); },
+            },
+            {
+                [&] { save(saveBuf); snk(static_cast<uint64_t>(saveBuf.size())); },
+                [&] {
+                    fat_p::binary::Decoder dec(loadBuf);
+                    auto loader = dst->snapshotLoader(dec);
+                    loader.deserializeComponent<Position>(dec, benchLoadPos);
+                    loader.deserializeComponent<Velocity>(dec, benchLoadVel);
+                    loader.finalize(dec);
+                    snk(static_cast<uint64_t>(dst->entityCount()));
+                },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 22. Spatial Queries: Brute Force vs SpatialHash
+// ============================================================================
+
+// fatp_ecs only: compares the O(Q*N) scan the demo's Collision system used
+// to do with an incrementally maintained SpatialHash<Position>. Entities are
+// spread at constant density (one per 20x20 area) so a radius-20 query hits
+// about three neighbours at every N, and every entity moves each frame so
+// the hash pays for refreshAll() inside the timed region.
+
+void section22_Spatial(BenchmarkRunner& runner)
+{
+    beginSection(runner, "22. SPATIAL QUERIES (brute force vs SpatialHash, radius 20)")
+          .contract("Per frame: move all N, then 1000 radius queries. ns/op is per query; spatial-hash includes refreshAll(). Pairs: all pairs within 20, ns/op per entity.");
+
+    constexpr float kRadius = 20.0f;
+    constexpr std::size_t kQueries = 1'000;
+
+    auto populate = [](fatp_ecs::Registry& reg, std::size_t n, float side)
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> pos(0.0f, side);
+        std::uniform_real_distribution<float> vel(-1.0f, 1.0f);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            auto e = reg.create();
+            reg.add<Position>(e, pos(rng), pos(rng));
+            reg.add<Velocity>(e, vel(rng), vel(rng));
+        }
+    };
+
+    for (auto N : {1'000u, 10'000u, 100'000u})
+    {
+        const float side = std::sqrt(static_cast<float>(N)) * 20.0f;
+        fatp_ecs::Registry reg;
+        populate(reg, N, side);
+        fatp_ecs::SpatialHash<Position> grid(reg, kRadius);
+
+        std::vector<Position> queries(kQueries);
+        std::mt19937 rng(8);
+        std::uniform_real_distribution<float> pos(0.0f, side);
+        for (auto& q : queries) { q = {pos(rng), pos(rng)}; }
+
+        auto move = [&] {
+            reg.view<Position, Velocity>().each([](fatp_ecs::Entity, Position& p, Velocity& v) { p.x += v.dx; p.y += v.dy; });
+        };
+
+        roundRobinCompare(runner, "N=" + std::to_string(N) + " frame",
+            {"brute-force", "spatial-hash"},
+            {[] {}, [] {}},
+            {
+                [&] {
+                    move();
+                    auto view = reg.view<Position>();
+                    uint64_t hits = 0;
+                    for (const auto& q : queries)
+                    {
+                        view.each([&](fatp_ecs::Entity, Position& p) {
+                            const float dx = p.x - q.x;
+                            const float dy = p.y - q.y;
+                            hits += (dx * dx + dy * dy <= kRadius * kRadius) ? 1 : 0;
+                        });
+                    }
+                    snk(hits);
+                },
+                [&] {
+                    move();
+                    grid.refreshAll();
+                    uint64_t hits = 0;
+                    for (const auto& q : queries)
+                    {
+                        grid.queryRadius(q.x, q.y, kRadius, [&](fatp_ecs::Entity) { ++hits; });
+                    }
+                    snk(hits);
+                },
+            },
+            kQueries);
+    }
+
+    for (auto N : {1'000u, 10'000u})
+    {
+        const float side = std::sqrt(static_cast<float>(N)) * 20.0f;
+        fatp_ecs::Registry reg;
+        populate(reg, N, side);
+        fatp_ecs::SpatialHash<Position> grid(reg, kRadius);
+
+        std::vector<Position> dense;
+        reg.view<Position>().each([&](fatp_ecs::Entity, Position& p) { dense.push_back(p); });
+
+        roundRobinCompare(runner, "N=" + std::to_string(N) + " pairs",
+            {"brute-force", "spatial-hash"},
+            {[] {}, [] {}},
+            {
+                [&] {
+                    uint64_t pairs = 0;
+                    for (std::size_t i = 0; i < dense.size(); ++i)
+                    {
+                        for (std::size_t j = i + 1; j < dense.size(); ++j)
+                        {
+                            const float dx = dense[i].x - dense[j].x;
+                            const float dy = dense[i].y - dense[j].y;
+                            pairs += (dx * dx + dy * dy <= kRadius * kRadius) ? 1 : 0;
+                        }
+                    }
+                    snk(pairs);
+                },
+                [&] {
+                    uint64_t pairs = 0;
+                    grid.queryPairs(kRadius, [&](fatp_ecs::Entity, fatp_ecs::Entity) { ++pairs; });
+                    snk(pairs);
+                },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 23. Template Spawn
+// ============================================================================
+
+void section23_TemplateSpawn(BenchmarkRunner& runner)
+{
+    beginSection(runner, "23. TEMPLATE SPAWN (Position + Velocity + Health)")
+          .contract("Spawn N entities from a JSON template into a fresh registry. legacy: per-entity JSON factories; per-entity: typed prototype, spawn() N times; bulk: one spawn(count).");
+
+    auto number = [](const fat_p::JsonValue& v, const char* key)
+    {
+        return std::get<fat_p::JsonObject>(v).at(key);
+    };
+
+    const char* json = R"({
+        "components": {
+            "Position": { "x": 1.0, "y": 2.0 },
+            "Velocity": { "dx": 0.5, "dy": -0.5 },
+            "Health":   { "current": 50, "max": 50 }
+        }
+    })";
+
+    fatp_ecs::TemplateRegistry legacy;
+    legacy.registerComponent("Position", [&](fatp_ecs::Registry& r, fatp_ecs::Entity e, const fat_p::JsonValue& v) {
+        r.add<Position>(e, static_cast<float>(std::get<double>(number(v, "x"))), static_cast<float>(std::get<double>(number(v, "y"))));
+    });
+    legacy.registerComponent("Velocity", [&](fatp_ecs::Registry& r, fatp_ecs::Entity e, const fat_p::JsonValue& v) {
+        r.add<Velocity>(e, static_cast<float>(std::get<double>(number(v, "dx"))), static_cast<float>(std::get<double>(number(v, "dy"))));
+    });
+    legacy.registerComponent("Health", [&](fatp_ecs::Registry& r, fatp_ecs::Entity e, const fat_p::JsonValue& v) {
+        r.add<Health>(e, static_cast<int>(std::get<int64_t>(number(v, "current"))), static_cast<int>(std::get<int64_t>(number(v, "max"))));
+    });
+    legacy.addTemplate("unit", json);
+
+    fatp_ecs::TemplateRegistry typed;
+    typed.registerComponent<Position>("Position", [&](const fat_p::JsonValue& v) {
+        return Position{static_cast<float>(std::get<double>(number(v, "x"))), static_cast<float>(std::get<double>(number(v, "y")))};
+    });
+    typed.registerComponent<Velocity>("Velocity", [&](const fat_p::JsonValue& v) {
+        return Velocity{static_cast<float>(std::get<double>(number(v, "dx"))), static_cast<float>(std::get<double>(number(v, "dy")))};
+    });
+    typed.registerComponent<Health>("Health", [&](const fat_p::JsonValue& v) {
+        return Health{static_cast<int>(std::get<int64_t>(number(v, "current"))), static_cast<int>(std::get<int64_t>(number(v, "max")))};
+    });
+    typed.addTemplate("unit", json);
+
+    for (auto N : {1'000u, 10'000u, 100'000u})
+    {
+        std::unique_ptr<fatp_ecs::Registry> reg;
+        std::vector<fatp_ecs::Entity> out(N);
+        auto fresh = [&] { reg = std::make_unique<fatp_ecs::Registry>(); };
+
+        roundRobinCompare(runner, "N=" + std::to_string(N),
+            {"legacy", "per-entity", "bulk"},
+            {fresh, fresh, fresh},
+            {
+                [&] { for (std::size_t i = 0; i < N; ++i) snk(legacy.spawn(*reg, "unit").get()); },
+                [&] { for (std::size_t i = 0; i < N; ++i) snk(typed.spawn(*reg, "unit").get()); },
+                [&] { snk(typed.spawn(*reg, "unit", N, out.data())); },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 24. Hierarchy Propagation
+// ============================================================================
+
+struct LocalXform { float x = 0.0f; float y = 0.0f; float c = 1.0f; float s = 0.0f; };
+struct WorldXform { float x = 0.0f; float y = 0.0f; float c = 1.0f; float s = 0.0f; };
+struct ParentRef  { fatp_ecs::Entity parent = fatp_ecs::NullEntity; };
+
+inline void composeXform(const WorldXform* p, const LocalXform& l, WorldXform& w)
+{
+    if (p == nullptr)
+    {
+        w = {l.x, l.y, l.c, l.s};
+        return;
+    }
+    w.x = p->x + p->c * l.x - p->s * l.y;
+    w.y = p->y + p->s * l.x + p->c * l.y;
+    w.c = p->c * l.c - p->s * l.s;
+    w.s = p->s * l.c + p->c * l.s;
+}
+
+void section24_Hierarchy(BenchmarkRunner& runner)
+{
+    beginSection(runner, "24. HIERARCHY PROPAGATION (random scene graph, 16 roots)")
+          .contract("World = parent World * Local for every node, parents first. parent-ref: ParentRef component + get<> per node over a precomputed BFS list; hierarchy: Hierarchy::propagate; sorted: after sortStorage; parallel: per-level parallel_for. reparent: 100 cross-level moves + propagate. ns/op per node.");
+
+    const std::size_t hw = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    fatp_ecs::Scheduler sched(hw);
+
+    for (auto N : {10'000u, 100'000u})
+    {
+        // Components are added in shuffled order so dense arrays do not
+        // accidentally follow the tree.
+        auto build = [N](fatp_ecs::Registry& reg, fatp_ecs::Hierarchy& h, std::vector<fatp_ecs::Entity>& nodes)
+        {
+            std::mt19937 rng(11);
+            std::uniform_real_distribution<float> off(-5.0f, 5.0f);
+            std::uniform_real_distribution<float> ang(-0.3f, 0.3f);
+            nodes.resize(N);
+            reg.create(nodes.begin(), nodes.end());
+            for (std::size_t i = 16; i < N; ++i)
+            {
+                h.setParent(nodes[i], nodes[rng() % i]);
+            }
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                h.setParent(nodes[i], fatp_ecs::NullEntity);
+            }
+            std::vector<fatp_ecs::Entity> shuffled = nodes;
+            std::shuffle(shuffled.begin(), shuffled.end(), rng);
+            for (auto e : shuffled)
+            {
+                const float a = ang(rng);
+                reg.add<LocalXform>(e, off(rng), off(rng), std::cos(a), std::sin(a));
+                reg.add<WorldXform>(e);
+                reg.add<ParentRef>(e, h.parentOf(e));
+            }
+        };
+
+        fatp_ecs::Registry reg;
+        fatp_ecs::Hierarchy h(reg);
+        std::vector<fatp_ecs::Entity> nodes;
+        build(reg, h, nodes);
+
+        fatp_ecs::Registry sortedReg;
+        fatp_ecs::Hierarchy sortedH(sortedReg);
+        std::vector<fatp_ecs::Entity> sortedNodes;
+        build(sortedReg, sortedH, sortedNodes);
+        sortedH.sortStorage<LocalXform>();
+        sortedH.sortStorage<WorldXform>();
+
+        std::vector<fatp_ecs::Entity> bfs;
+        h.each([&](fatp_ecs::Entity e, fatp_ecs::Entity) { bfs.push_back(e); });
+
+        std::mt19937 moveRng(12);
+
+        roundRobinCompare(runner, "N=" + std::to_string(N),
+            {"parent-ref", "hierarchy", "sorted", "parallel", "reparent"},
+            {[] {}, [] {}, [] {}, [] {}, [] {}},
+            {
+                [&] {
+                    for (auto e : bfs)
+                    {
+                        const auto parent = reg.get<ParentRef>(e).parent;
+                        const WorldXform* pw = parent == fatp_ecs::NullEntity ? nullptr : &reg.get<WorldXform>(parent);
+                        composeXform(pw, reg.get<LocalXform>(e), reg.get<WorldXform>(e));
+                    }
+                    snk(reg.get<WorldXform>(bfs.back()).x);
+                },
+                [&] {
+                    h.propagate<LocalXform, WorldXform>(composeXform);
+                    snk(reg.get<WorldXform>(bfs.back()).x);
+                },
+                [&] {
+                    sortedH.propagate<LocalXform, WorldXform>(composeXform);
+                    snk(sortedReg.get<WorldXform>(sortedNodes.back()).x);
+                },
+                [&] {
+                    sortedH.propagate<LocalXform, WorldXform>(sched, composeXform);
+                    snk(sortedReg.get<WorldXform>(sortedNodes.back()).x);
+                },
+                [&] {
+                    for (int i = 0; i < 100; ++i)
+                    {
+                        const std::size_t c = 16 + moveRng() % (N - 16);
+                        h.setParent(nodes[c], nodes[moveRng() % c]);
+                    }
+                    h.propagate<LocalXform, WorldXform>(composeXform);
+                    snk(reg.get<WorldXform>(bfs.back()).x);
+                },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 25. Cross-Registry Migration
+// ============================================================================
+
+void section25_Migration(BenchmarkRunner& runner)
+{
+    beginSection(runner, "25. MIGRATION (Position + Velocity + Health)")
+          .contract("Move N entities with all components from a streamed-in registry into a live one. per-entity: create + add<T>(get<T>) per component + destroy; merge: merge(src, dst).");
+
+    for (auto N : {1'000u, 10'000u, 100'000u})
+    {
+        std::unique_ptr<fatp_ecs::Registry> src;
+        std::unique_ptr<fatp_ecs::Registry> dst;
+        auto fresh = [&]
+        {
+            src = std::make_unique<fatp_ecs::Registry>();
+            dst = std::make_unique<fatp_ecs::Registry>();
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                const auto e = src->create();
+                src->add<Position>(e, static_cast<float>(i), 0.0f);
+                src->add<Velocity>(e, 1.0f, -1.0f);
+                src->add<Health>(e, 50, 50);
+            }
+        };
+
+        roundRobinCompare(runner, "N=" + std::to_string(N),
+            {"per-entity", "merge"},
+            {fresh, fresh},
+            {
+                [&]
+                {
+                    for (const auto e : src->allEntities())
+                    {
+                        const auto moved = dst->create();
+                        dst->add<Position>(moved, src->get<Position>(e));
+                        dst->add<Velocity>(moved, src->get<Velocity>(e));
+                        dst->add<Health>(moved, src->get<Health>(e));
+                        src->destroy(e);
+                    }
+                    snk(dst->entityCount());
+                },
+                [&] { snk(fatp_ecs::merge(*src, *dst).size()); },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 26. Archetype Storage vs Sparse Sets
+// ============================================================================
+
+template <int I> struct ShapeTag { int v = I; };
+
+template <typename R>
+void populateShapes(R& reg, std::size_t n)
+{
+    // Position + Velocity + Health on every entity, plus one of 16 tag
+    // combinations: 16 archetypes, while every sparse store stays full.
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto e = reg.create();
+        reg.template add<Position>(e, 1.f, 2.f);
+        reg.template add<Velocity>(e, 0.1f, 0.2f);
+        reg.template add<Health>(e, 100, 100);
+        if (i & 1) reg.template add<ShapeTag<0>>(e);
+        if (i & 2) reg.template add<ShapeTag<1>>(e);
+        if (i & 4) reg.template add<ShapeTag<2>>(e);
+        if (i & 8) reg.template add<ShapeTag<3>>(e);
+    }
+}
+
+void section26_Archetype(BenchmarkRunner& runner)
+{
+    beginSection(runner, "26. ARCHETYPE STORAGE vs SPARSE SETS")
+          .contract("Same workloads on Registry (sparse) and ArchetypeRegistry (tables). add3: create + 3 adds; iter3: sections 10 shape; frag: section 11 shape; shapes-iter3: P+V+H split over 16 tag archetypes; toggle: add+remove one tag on every entity.");
+
+    for (auto N : {10'000u, 100'000u})
+    {
+        std::unique_ptr<fatp_ecs::Registry> sReg;
+        std::unique_ptr<fatp_ecs::ArchetypeRegistry> aReg;
+        auto freshBoth = [&] { sReg = std::make_unique<fatp_ecs::Registry>(); aReg = std::make_unique<fatp_ecs::ArchetypeRegistry>(); };
+
+        roundRobinCompare(runner, "add3 N=" + std::to_string(N),
+            {"sparse", "archetype"},
+            {freshBoth, freshBoth},
+            {
+                [&] { for (std::size_t i = 0; i < N; ++i) { auto e = sReg->create(); sReg->add<Position>(e, 1.f, 2.f); sReg->add<Velocity>(e, 0.1f, 0.2f); sReg->add<Health>(e, 100, 100); } },
+                [&] { for (std::size_t i = 0; i < N; ++i) { auto e = aReg->create(); aReg->add<Position>(e, 1.f, 2.f); aReg->add<Velocity>(e, 0.1f, 0.2f); aReg->add<Health>(e, 100, 100); } },
+            },
+            N);
+
+        auto fill3 = [&]
+        {
+            freshBoth();
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                auto s = sReg->create(); sReg->add<Position>(s, 1.f, 2.f); sReg->add<Velocity>(s, 0.1f, 0.2f); sReg->add<Health>(s, 100, 100);
+                auto a = aReg->create(); aReg->add<Position>(a, 1.f, 2.f); aReg->add<Velocity>(a, 0.1f, 0.2f); aReg->add<Health>(a, 100, 100);
+            }
+        };
+        roundRobinCompare(runner, "iter3 N=" + std::to_string(N),
+            {"sparse", "archetype"},
+            {fill3, fill3},
+            {
+                [&] { sReg->view<Position, Velocity, Health>().each([](fatp_ecs::Entity, Position& p, Velocity& v, Health& h) { p.x += v.dx; h.hp -= 1; snk(p.x); snk(h.hp); }); },
+                [&] { aReg->view<Position, Velocity, Health>().each([](fatp_ecs::Entity, Position& p, Velocity& v, Health& h) { p.x += v.dx; h.hp -= 1; snk(p.x); snk(h.hp); }); },
+            },
+            N);
+
+        auto fillFrag = [&]
+        {
+            freshBoth();
+            std::vector<fatp_ecs::Entity> sTmp(2 * N);
+            std::vector<fatp_ecs::Entity> aTmp(2 * N);
+            for (std::size_t i = 0; i < 2 * N; ++i)
+            {
+                sTmp[i] = sReg->create(); sReg->add<Position>(sTmp[i], 1.f, 2.f);
+                aTmp[i] = aReg->create(); aReg->add<Position>(aTmp[i], 1.f, 2.f);
+            }
+            for (std::size_t i = 1; i < 2 * N; i += 2) { sReg->destroy(sTmp[i]); aReg->destroy(aTmp[i]); }
+        };
+        roundRobinCompare(runner, "frag N=" + std::to_string(N),
+            {"sparse", "archetype"},
+            {fillFrag, fillFrag},
+            {
+                [&] { sReg->view<Position>().each([](fatp_ecs::Entity, Position& p) { p.x += 1.0f; snk(p.x); }); },
+                [&] { aReg->view<Position>().each([](fatp_ecs::Entity, Position& p) { p.x += 1.0f; snk(p.x); }); },
+            },
+            N);
+
+        auto fillShapes = [&] { freshBoth(); populateShapes(*sReg, N); populateShapes(*aReg, N); };
+        roundRobinCompare(runner, "shapes-iter3 N=" + std::to_string(N),
+            {"sparse", "archetype"},
+            {fillShapes, fillShapes},
+            {
+                [&] { sReg->view<Position, Velocity, Health>(fatp_ecs::Exclude<ShapeTag<3>>{}).each([](fatp_ecs::Entity, Position& p, Velocity& v, Health& h) { p.x += v.dx; h.hp -= 1; snk(p.x); snk(h.hp); }); },
+                [&] { aReg->view<Position, Velocity, Health>(fatp_ecs::Exclude<ShapeTag<3>>{}).each([](fatp_ecs::Entity, Position& p, Velocity& v, Health& h) { p.x += v.dx; h.hp -= 1; snk(p.x); snk(h.hp); }); },
+            },
+            N / 2);
+
+        std::vector<fatp_ecs::Entity> sAll;
+        std::vector<fatp_ecs::Entity> aAll;
+        auto fillToggle = [&]
+        {
+            fill3();
+            sAll.clear();
+            aAll.clear();
+            sReg->view<Position>().each([&](fatp_ecs::Entity e, Position&) { sAll.push_back(e); });
+            aReg->view<Position>().each([&](fatp_ecs::Entity e, Position&) { aAll.push_back(e); });
+        };
+        roundRobinCompare(runner, "toggle N=" + std::to_string(N),
+            {"sparse", "archetype"},
+            {fillToggle, fillToggle},
+            {
+                [&] { for (auto e : sAll) { sReg->add<ShapeTag<0>>(e); sReg->remove<ShapeTag<0>>(e); } },
+                [&] { for (auto e : aAll) { aReg->add<ShapeTag<0>>(e); aReg->remove<ShapeTag<0>>(e); } },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 27. Sharded Registry Parallel Spawn
+// ============================================================================
+
+void section27_ShardedSpawn(BenchmarkRunner& runner)
+{
+    beginSection(runner, "27. PARALLEL SPAWN (create + Position + Velocity)")
+          .contract("T workers on a T-thread Scheduler spawn N entities in total. mutex: one Registry behind a std::mutex; cmdbuf: one CommandBuffer per worker, flushed serially; sharded: ShardedRegistry, worker t spawns into shard t. ns/op is per entity, wall clock.");
+
+    constexpr std::size_t N = 200'000;
+    for (std::size_t T : scalingThreadCounts())
+    {
+        fatp_ecs::Scheduler sched(T);
+        const std::size_t perWorker = N / T;
+
+        std::unique_ptr<fatp_ecs::Registry> reg;
+        std::vector<fatp_ecs::CommandBuffer> buffers;
+        std::unique_ptr<fatp_ecs::ShardedRegistry> sharded;
+        std::mutex mutex;
+
+        roundRobinCompare(runner, "T=" + std::to_string(T) + " N=" + std::to_string(N),
+            {"mutex", "cmdbuf", "sharded"},
+            {
+                [&] { reg = std::make_unique<fatp_ecs::Registry>(); },
+                [&]
+                {
+                    reg = std::make_unique<fatp_ecs::Registry>();
+                    buffers.clear();
+                    buffers.resize(T);
+                },
+                [&] { sharded = std::make_unique<fatp_ecs::ShardedRegistry>(T); },
+            },
+            {
+                [&]
+                {
+                    sched.parallel_for(T,
+                        [&](std::size_t begin, std::size_t end)
+                        {
+                            for (std::size_t i = begin * perWorker; i < end * perWorker; ++i)
+                            {
+                                std::lock_guard<std::mutex> lock(mutex);
+                                const auto e = reg->create();
+                                reg->add<Position>(e, static_cast<float>(i), 0.0f);
+                                reg->add<Velocity>(e, 1.0f, 1.0f);
+                            }
+                        },
+                        1);
+                    snk(reg->entityCount());
+                },
+                [&]
+                {
+                    sched.parallel_for(T,
+                        [&](std::size_t begin, std::size_t end)
+                        {
+                            for (std::size_t w = begin; w < end; ++w)
+                            {
+                                for (std::size_t i = w * perWorker; i < (w + 1) * perWorker; ++i)
+                                {
+                                    buffers[w].create(
+                                        [i](fatp_ecs::Registry& r, fatp_ecs::Entity e)
+                                        {
+                                            r.add<Position>(e, static_cast<float>(i), 0.0f);
+                                            r.add<Velocity>(e, 1.0f, 1.0f);
+                                        });
+                                }
+                            }
+                        },
+                        1);
+                    for (auto& buffer : buffers)
+                    {
+                        buffer.flush(*reg);
+                    }
+                    snk(reg->entityCount());
+                },
+                [&]
+                {
+                    sched.parallel_for(T,
+                        [&](std::size_t begin, std::size_t end)
+                        {
+                            for (std::size_t w = begin; w < end; ++w)
+                            {
+                                for (std::size_t i = w * perWorker; i < (w + 1) * perWorker; ++i)
+                                {
+                                    const auto e = sharded->create(w);
+                                    sharded->add<Position>(e, static_cast<float>(i), 0.0f);
+                                    sharded->add<Velocity>(e, 1.0f, 1.0f);
+                                }
+                            }
+                        },
+                        1);
+                    snk(sharded->entityCount());
+                },
+            },
+            perWorker * T);
+    }
+}
+
+// ============================================================================
+// 28. Lock-Free Read Storage
+// ============================================================================
+
+// Sums hp over c[0, n) on every worker of sched, one chunk each. With
+// ChunkLock, each chunk holds c.readLock() and reads through data().
+template <bool ChunkLock = false, typename Container>
+static void parallelSumHp(fatp_ecs::Scheduler& sched, const Container& c, std::size_t n)
+{
+    std::atomic<uint64_t> total{0};
+    sched.parallel_for(n,
+        [&](std::size_t begin, std::size_t end)
+        {
+            uint64_t sum = 0;
+            if constexpr (ChunkLock)
+            {
+                [[maybe_unused]] auto g = c.readLock();
+                const Health* data = c.data();
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    sum += static_cast<uint64_t>(data[i].hp);
+                }
+            }
+            else
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    sum += static_cast<uint64_t>(c[i].hp);
+                }
+            }
+            total.fetch_add(sum, std::memory_order_relaxed);
+        },
+        1'024);
+    snk(total.load());
+}
+
+void section28_LockFreeRead(BenchmarkRunner& runner)
+{
+    beginSection(runner, "28. LOCK-FREE READ STORAGE (Health, element reads by index)")
+          .contract("Readers on a hardware_concurrency Scheduler sum hp through container operator[]. vector: DefaultStoragePolicy; shared-mutex: ConcurrentStoragePolicy<SharedMutexPolicy>; lock-free: LockFreeReadStoragePolicy. +writer: one extra thread appends N elements (growth included) while the readers run. ConcurrentStoragePolicy's operator[] returns a reference after dropping its lock, so under a writer its readers must hold readLock() per chunk; vector is not safe at all and is skipped.");
+
+    using VecC  = fatp_ecs::DefaultStoragePolicy<Health>::container_type;
+    using LockC = fatp_ecs::ConcurrentStoragePolicy<fat_p::SharedMutexPolicy>::Policy<Health>::container_type;
+    using FreeC = fatp_ecs::LockFreeReadStoragePolicy<>::Policy<Health>::container_type;
+
+    fatp_ecs::Scheduler sched(std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+    constexpr std::size_t N = 100'000;
+
+    VecC vec;
+    LockC locked;
+    FreeC lockFree;
+    auto fill = [](auto& c)
+    {
+        c.clear();
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            c.push_back(Health{static_cast<int>(i), 100});
+        }
+    };
+
+    roundRobinCompare(runner, "read N=" + std::to_string(N),
+        {"vector", "shared-mutex", "lock-free"},
+        {[&] { fill(vec); }, [&] { fill(locked); }, [&] { fill(lockFree); }},
+        {
+            [&] { parallelSumHp(sched, vec, N); },
+            [&] { parallelSumHp(sched, std::as_const(locked), N); },
+            [&] { parallelSumHp(sched, std::as_const(lockFree), N); },
+        },
+        N);
+
+    // Readers stay within the first N elements while the writer doubles the
+    // container, forcing at least one reallocation under the readers.
+    auto startWriter = [](auto& c)
+    {
+        return std::thread([&c]
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                c.push_back(Health{static_cast<int>(N + i), 100});
+            }
+        });
+    };
+
+    roundRobinCompare(runner, "read N=" + std::to_string(N) + " +writer",
+        {"shared-mutex (chunk lock)", "lock-free"},
+        {
+            [&] { fill(locked); },
+            [&]
+            {
+                fill(lockFree);
+                fatp_ecs::StorageEpoch::advance();
+                lockFree.reclaim();
+            },
+        },
+        {
+            [&]
+            {
+                std::thread writer = startWriter(locked);
+                parallelSumHp<true>(sched, std::as_const(locked), N);
+                writer.join();
+            },
+            [&]
+            {
+                std::thread writer = startWriter(lockFree);
+                parallelSumHp(sched, std::as_const(lockFree), N);
+                writer.join();
+            },
+        },
+        N);
+}
+
+// ============================================================================
+// 29. Parallel Process Ticking
+// ============================================================================
+
+// Independent tween: eases value toward 1 over duration seconds.
+struct BenchTween : fatp_ecs::Process<BenchTween, float>
+{
+    static constexpr bool kIndependent = true;
+
+    explicit BenchTween(float duration) : mDuration(duration) {}
+
+    void onUpdate(float dt, void*&)
+    {
+        mElapsed += dt;
+        const float t = std::min(mElapsed / mDuration, 1.0f);
+        mValue = t * t * (3.0f - 2.0f * t);
+        if (t >= 1.0f) succeed();
+    }
+
+    float mDuration;
+    float mElapsed = 0.0f;
+    float mValue = 0.0f;
+};
+
+void section29_ProcessParallel(BenchmarkRunner& runner)
+{
+    beginSection(runner, "29. PROCESS SCHEDULER (kIndependent tweens)")
+          .contract("update: ProcessScheduler::update on the calling thread; parallel: updateParallel on a hardware_concurrency ThreadPool. tick: N long-running tweens, one frame. churn: attach N one-frame tweens (arena-allocated), tick, retire.");
+
+    fat_p::ThreadPool pool(std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+
+    for (auto N : {10'000u, 50'000u})
+    {
+        fatp_ecs::ProcessScheduler<float> serial;
+        fatp_ecs::ProcessScheduler<float> parallel;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            serial.attach<BenchTween>(1.0e9f);
+            parallel.attach<BenchTween>(1.0e9f);
+        }
+
+        roundRobinCompare(runner, "tick N=" + std::to_string(N),
+            {"update", "parallel"},
+            {[] {}, [] {}},
+            {
+                [&] { serial.update(0.016f); snk(serial.size()); },
+                [&] { parallel.updateParallel(pool, 0.016f); snk(parallel.size()); },
+            },
+            N);
+
+        fatp_ecs::ProcessScheduler<float> churn;
+        auto attachWave = [&]
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                churn.attach<BenchTween>(0.001f);
+            }
+        };
+        roundRobinCompare(runner, "churn N=" + std::to_string(N),
+            {"update", "parallel"},
+            {[] {}, [] {}},
+            {
+                [&] { attachWave(); churn.update(0.016f); snk(churn.size()); },
+                [&] { attachWave(); churn.updateParallel(pool, 0.016f); snk(churn.size()); },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 30. Process Sleep Queue
+// ============================================================================
+
+// Periodic timer that checks its deadline every tick.
+struct BenchScanTimer : fatp_ecs::Process<BenchScanTimer, float>
+{
+    explicit BenchScanTimer(float period) : mPeriod(period) {}
+
+    void onUpdate(float dt, void*&)
+    {
+        mElapsed += dt;
+        if (mElapsed >= mPeriod)
+        {
+            mElapsed -= mPeriod;
+            ++mFires;
+        }
+    }
+
+    float mPeriod;
+    float mElapsed = 0.0f;
+    std::size_t mFires = 0;
+};
+
+// Periodic timer that parks in the sleep queue between firings.
+struct BenchParkedTimer : fatp_ecs::Process<BenchParkedTimer, float>
+{
+    explicit BenchParkedTimer(float period) : mPeriod(period) {}
+
+    void onUpdate(float, void*&)
+    {
+        ++mFires;
+        sleepFor(mPeriod);
+    }
+
+    float mPeriod;
+    std::size_t mFires = 0;
+};
+
+void section30_ProcessSleep(BenchmarkRunner& runner)
+{
+    beginSection(runner, "30. PROCESS SLEEP QUEUE (idle timers)")
+          .contract("N perpetual timers, periods spread over 1..30 s, one 60 Hz frame per sample. scan: every timer ticks and compares its deadline. parked: timers call sleepFor(period) and sit in the sleep queue until due.");
+
+    constexpr float kFrame = 1.0f / 60.0f;
+
+    for (auto N : {10'000u, 100'000u})
+    {
+        fatp_ecs::ProcessScheduler<float> scan;
+        fatp_ecs::ProcessScheduler<float> parked;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const float period = 1.0f + static_cast<float>(i % 30);
+            scan.attach<BenchScanTimer>(period);
+            parked.attach<BenchParkedTimer>(period);
+        }
+        // First tick parks every timer; measure the steady state after it.
+        scan.update(kFrame);
+        parked.update(kFrame);
+
+        roundRobinCompare(runner, "update N=" + std::to_string(N),
+            {"scan", "parked"},
+            {[] {}, [] {}},
+            {
+                [&] { scan.update(kFrame); snk(scan.size()); },
+                [&] { parked.update(kFrame); snk(parked.sleepingCount()); },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 31. Key Sort
+// ============================================================================
+
+void section31_SortByKey(BenchmarkRunner& runner)
+{
+    beginSection(runner, "31. KEY SORT (sort<Position>(cmp) vs sort_by_key<Position>)")
+          .contract("N entities, random Position.x. cmp: comparator sort. by-key: radix sort of extracted x. parallel: by-key on a hardware_concurrency Scheduler. Each sample sorts a freshly shuffled store.");
+
+    fatp_ecs::Scheduler sched(std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+
+    for (auto N : {100'000u, 1'000'000u})
+    {
+        std::unique_ptr<fatp_ecs::Registry> reg;
+
+        std::mt19937 rng(static_cast<unsigned>(runner.config().seed));
+        std::uniform_real_distribution<float> dist(0.f, 1000.f);
+        std::vector<float> xs(N);
+        for (auto& x : xs) x = dist(rng);
+        auto byX = [](const Position& a, const Position& b) { return a.x < b.x; };
+        auto keyX = [](const Position& p) { return p.x; };
+
+        auto setup = [&] {
+            reg = std::make_unique<fatp_ecs::Registry>();
+            for (std::size_t i = 0; i < N; ++i) reg->add<Position>(reg->create(), xs[i], 0.f);
+        };
+
+        roundRobinCompare(runner, "sort N=" + std::to_string(N),
+            {"cmp", "by-key", "parallel"},
+            {setup, setup, setup},
+            {
+                [&] { reg->sort<Position>(byX); snk(reg->storage<Position>()->dataAt(0).x); },
+                [&] { reg->sort_by_key<Position>(keyX); snk(reg->storage<Position>()->dataAt(0).x); },
+                [&] { reg->sort_by_key<Position>(keyX, sched); snk(reg->storage<Position>()->dataAt(0).x); },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 32. Incremental Sort
+// ============================================================================
+
+void section32_IncrementalSort(BenchmarkRunner& runner)
+{
+    beginSection(runner, "32. INCREMENTAL SORT (nearly-sorted Position.x)")
+          .contract("N entities sorted by Position.x, then D% of them get a new random x. full: sort<Position>(cmp). incremental: sort<Position>(cmp, SortMode::Incremental). by-key: sort_by_key<Position>. Each sample re-sorts a freshly disturbed store.");
+
+    constexpr unsigned N = 100'000;
+    auto byX = [](const Position& a, const Position& b) { return a.x < b.x; };
+    auto keyX = [](const Position& p) { return p.x; };
+
+    for (unsigned disorder : {0u, 1u, 5u, 25u})
+    {
+        std::mt19937 rng(static_cast<unsigned>(runner.config().seed) + disorder);
+        std::uniform_real_distribution<float> dist(0.f, 1000.f);
+        std::vector<float> xs(N);
+        for (std::size_t i = 0; i < N; ++i) xs[i] = 1000.f * static_cast<float>(i) / N;
+        for (auto& x : xs)
+        {
+            if (rng() % 100 < disorder) x = dist(rng);
+        }
+
+        std::unique_ptr<fatp_ecs::Registry> reg;
+        auto setup = [&] {
+            reg = std::make_unique<fatp_ecs::Registry>();
+            for (std::size_t i = 0; i < N; ++i) reg->add<Position>(reg->create(), xs[i], 0.f);
+        };
+
+        roundRobinCompare(runner, "disorder=" + std::to_string(disorder) + "% N=" + std::to_string(N),
+            {"full", "incremental", "by-key"},
+            {setup, setup, setup},
+            {
+                [&] { reg->sort<Position>(byX); snk(reg->storage<Position>()->dataAt(0).x); },
+                [&] { reg->sort<Position>(byX, fatp_ecs::SortMode::Incremental); snk(reg->storage<Position>()->dataAt(0).x); },
+                [&] { reg->sort_by_key<Position>(keyX); snk(reg->storage<Position>()->dataAt(0).x); },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 33. Multi-Store Align
+// ============================================================================
+
+void section33_Align(BenchmarkRunner& runner)
+{
+    beginSection(runner, "33. ALIGN (align<Position, Velocity, Health, Work>())")
+          .contract("N entities with all four components, each store filled in a different shuffled order, Position sorted by x. pairwise: three sort<Position, F>() calls. align: one align<Position, Velocity, Health, Work>(). iterate: view<Position, Velocity, Health, Work>().each before and after align.");
+
+    for (auto N : {10'000u, 100'000u})
+    {
+        std::mt19937 rng(static_cast<unsigned>(runner.config().seed));
+        std::uniform_real_distribution<float> dist(0.f, 1000.f);
+        std::vector<float> xs(N);
+        for (auto& x : xs) x = dist(rng);
+        std::vector<std::vector<std::size_t>> fillOrder(4, std::vector<std::size_t>(N));
+        for (auto& order : fillOrder)
+        {
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::shuffle(order.begin(), order.end(), rng);
+        }
+        auto byX = [](const Position& a, const Position& b) { return a.x < b.x; };
+
+        auto build = [&](fatp_ecs::Registry& reg) {
+            std::vector<fatp_ecs::Entity> ents(N);
+            for (auto& e : ents) e = reg.create();
+            for (auto i : fillOrder[0]) reg.add<Position>(ents[i], xs[i], 0.f);
+            for (auto i : fillOrder[1]) reg.add<Velocity>(ents[i], 0.1f, 0.2f);
+            for (auto i : fillOrder[2]) reg.add<Health>(ents[i], 100, 100);
+            for (auto i : fillOrder[3]) reg.add<Work>(ents[i], 1.0f);
+            reg.sort<Position>(byX);
+        };
+
+        std::unique_ptr<fatp_ecs::Registry> reg;
+        auto setup = [&] {
+            reg = std::make_unique<fatp_ecs::Registry>();
+            build(*reg);
+        };
+        roundRobinCompare(runner, "align 3 followers N=" + std::to_string(N),
+            {"pairwise", "align"},
+            {setup, setup},
+            {
+                [&] {
+                    reg->sort<Position, Velocity>();
+                    reg->sort<Position, Health>();
+                    reg->sort<Position, Work>();
+                    snk(reg->storage<Work>()->dataAt(0).v);
+                },
+                [&] {
+                    reg->align<Position, Velocity, Health, Work>();
+                    snk(reg->storage<Work>()->dataAt(0).v);
+                },
+            },
+            N);
+
+        fatp_ecs::Registry unaligned;
+        fatp_ecs::Registry aligned;
+        build(unaligned);
+        build(aligned);
+        aligned.align<Position, Velocity, Health, Work>();
+        auto iterate = [](fatp_ecs::Registry& r) {
+            float sum = 0.f;
+            r.view<Position, Velocity, Health, Work>().each(
+                [&](fatp_ecs::Entity, Position& p, const Velocity& v, const Health& h, const Work& w) {
+                    p.x += v.dx * w.v;
+                    sum += static_cast<float>(h.hp);
+                });
+            snk(sum);
+        };
+        roundRobinCompare(runner, "iterate 4 components N=" + std::to_string(N),
+            {"unaligned", "aligned"},
+            {[] {}, [] {}},
+            {
+                [&] { iterate(unaligned); },
+                [&] { iterate(aligned); },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// 34. Compiled Runtime Query
+// ============================================================================
+
+void section34_CompiledQuery(BenchmarkRunner& runner)
+{
+    beginSection(runner, "34. COMPILED QUERY (Position + Velocity + Health, exclude tag)")
+          .contract("N Position, N/2 Velocity, N/2 Health (overlapping on even entities), every 10th entity tagged. runtime: runtimeView() built and iterated per run. compiled: one compileQuery() reused. typed: view<Position, Velocity, Health>(Exclude<tag>). All count matches.");
+
+    for (auto N : {10'000u, 100'000u, 1'000'000u})
+    {
+        fatp_ecs::Registry reg;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            auto e = reg.create();
+            reg.add<Position>(e, 1.f, 2.f);
+            if (i % 2 == 0) reg.add<Velocity>(e, 0.1f, 0.2f);
+            if (i % 4 != 1) reg.add<Health>(e, 100, 100);
+            if (i % 10 == 0) reg.add<ShapeTag<0>>(e);
+        }
+        const fatp_ecs::TypeId include[] = {fatp_ecs::typeId<Position>(), fatp_ecs::typeId<Velocity>(),
+                                            fatp_ecs::typeId<Health>()};
+        const fatp_ecs::TypeId exclude[] = {fatp_ecs::typeId<ShapeTag<0>>()};
+        auto query = reg.compileQuery(include, 3, exclude, 1);
+
+        roundRobinCompare(runner, "N=" + std::to_string(N),
+            {"runtime", "compiled", "typed"},
+            {[] {}, [] {}, [] {}},
+            {
+                [&] {
+                    uint64_t n = 0;
+                    reg.runtimeView(include, 3, exclude, 1).each([&](fatp_ecs::Entity) { ++n; });
+                    snk(n);
+                },
+                [&] {
+                    uint64_t n = 0;
+                    query.each([&](fatp_ecs::Entity) { ++n; });
+                    snk(n);
+                },
+                [&] {
+                    uint64_t n = 0;
+                    reg.view<Position, Velocity, Health>(fatp_ecs::Exclude<ShapeTag<0>>{})
+                        .each([&](fatp_ecs::Entity, Position&, Velocity&, Health&) { ++n; });
+                    snk(n);
+                },
+            },
+            N);
+    }
+}
+
+void section35_Reflection(BenchmarkRunner& runner)
+{
+    beginSection(runner, "35. REFLECTED ACCESS (Position by name)")
+          .contract("N entities with Position; Position reflected with fields x, y. Field read: sum of y over a fixed entity list via typed tryGet<Position>() vs tryGetRaw(tid) + FieldInfo offset (TypeId and field resolved once). Export: copy every Position out via each() vs one memcpy of rawComponents(). Sums and byte counts match.");
+
+    for (auto N : {10'000u, 100'000u, 1'000'000u})
+    {
+        fatp_ecs::Registry reg;
+        reg.reflect<Position>("Position").field("x", &Position::x).field("y", &Position::y);
+        std::vector<fatp_ecs::Entity> entities;
+        entities.reserve(N);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            auto e = reg.create();
+            reg.add<Position>(e, static_cast<float>(i), 1.f);
+            entities.push_back(e);
+        }
+        const fatp_ecs::ComponentInfo* info = reg.reflection().find("Position");
+        const fatp_ecs::FieldInfo* fieldY = info->field("y");
+        std::vector<Position> out(N);
+
+        roundRobinCompare(runner, "field read N=" + std::to_string(N),
+            {"typed", "raw"},
+            {[] {}, [] {}},
+            {
+                [&] {
+                    float sum = 0.f;
+                    for (auto e : entities) sum += reg.tryGet<Position>(e)->y;
+                    snk(sum);
+                },
+                [&] {
+                    float sum = 0.f;
+                    for (auto e : entities)
+                    {
+                        float y;
+                        std::memcpy(&y, fieldY->in(reg.tryGetRaw(info->type, e)), sizeof(y));
+                        sum += y;
+                    }
+                    snk(sum);
+                },
+            },
+            N);
+
+        roundRobinCompare(runner, "export N=" + std::to_string(N),
+            {"each", "raw memcpy"},
+            {[] {}, [] {}},
+            {
+                [&] {
+                    std::size_t i = 0;
+                    reg.view<Position>().each([&](fatp_ecs::Entity, Position& p) { out[i++] = p; });
+                    snk(out[N - 1].x);
+                },
+                [&] {
+                    const fatp_ecs::RawComponentSpan span = reg.rawComponents(info->type);
+                    std::memcpy(out.data(), span.data, span.count * span.stride);
+                    snk(out[N - 1].x);
+                },
+            },
+            N);
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    int compareExit = 0;
+    if (fatp_ecs::bench::runCompareFromArgs(argc, argv, compareExit))
+    {
+        return compareExit;
+    }
+
+    std::string jsonPath;
+    bool wantCounters = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--perf-counters") == 0)
+        {
+            wantCounters = true;
+        }
+    }
+
+    fatp_ecs::bench::PerfCounters counters;
+    if (wantCounters)
+    {
+        if (counters.open())
+        {
+            gCounters = &counters;
+        }
+        else
+        {
+            std::cout << "Hardware counters unavailable: " << counters.unavailableReason()
+                      << " -- continuing with timings only\n";
+        }
+    }
+
+    auto runner = makeRunner("fatp_ecs vs EnTT");
+    gReport.setSuite("fatp_ecs vs EnTT");
+    gReport.setConfig("warmup_runs", static_cast<double>(runner.config().warmupRuns));
+    gReport.setConfig("measured_runs", static_cast<double>(runner.config().measuredRuns));
+    gReport.setConfig("seed", static_cast<double>(runner.config().seed));
+
+    std::cout << "\nCompetitors:\n";
+    std::cout << "  [x] fatp_ecs (primary, 64-bit entities)\n";
+    std::cout << "  [x] EnTT (32-bit entities)\n";
+    std::cout << "  [x] EnTT (64-bit entities)\n";
+    std::cout << "\nDesign Invariants:\n";
+    std::cout << "  1. Round-robin execution with randomized order per run\n";
+    std::cout << "  2. Setup/teardown outside timed regions\n";
+    std::cout << "  3. All libraries observe same distribution of machine states\n";
+    std::cout << "  4. Medians are the primary reported statistic\n";
+    std::cout << "\nEntity size: fatp=64-bit, entt-32=32-bit, entt-64=64-bit\n";
+    if (fatp_ecs::AllocationTracker::installed())
+    {
+        std::cout << "Allocation tracking: ON (allocs/op from one untimed pass per library)\n";
+    }
+    if (gCounters != nullptr)
+    {
+        std::cout << "Hardware counters: ON (per entity, median of 3 untimed passes, main thread)\n";
+    }
+    std::cout.flush();
+
+    section1_Create(runner);
+    section2_Destroy(runner);
+    section3_Add1(runner);
+    section4_Add3(runner);
+    section5_Remove(runner);
+    section6_Get(runner);
+    section7_Iter1(runner);
+    section8_Iter2(runner);
+    section9_Sparse(runner);
+    section10_Iter3(runner);
+    section11_Frag(runner);
+    section12_Churn(runner);
+    section13_FrameScratch(runner);
+    section14_Scaling(runner);
+    section15_OwningGroup(runner);
+    section16_NonOwningGroupChurn(runner);
+    section17_Observer(runner);
+    section18_RuntimeView(runner);
+    section19_CommandBuffer(runner);
+    section20_Sort(runner);
+    section21_Snapshot(runner);
+    section22_Spatial(runner);
+    section23_TemplateSpawn(runner);
+    section24_Hierarchy(runner);
+    section25_Migration(runner);
+    section26_Archetype(runner);
+    section27_ShardedSpawn(runner);
+    section28_LockFreeRead(runner);
+    section29_ProcessParallel(runner);
+    section30_ProcessSleep(runner);
+    section31_SortByKey(runner);
+    section32_IncrementalSort(runner);
+    section33_Align(runner);
+    section34_CompiledQuery(runner);
+    section35_Reflection(runner);
+
+    std::cout << "\nDone. (sink=" << gSink << ")\n";
+
+    if (!jsonPath.empty())
+    {
+        if (!gReport.write(jsonPath))
+        {
+            return 2;
+        }
+        std::cout << "JSON results (" << gReport.caseCount() << " cases) written to "
+                  << jsonPath << "\n";
+    }
     return 0;
 }
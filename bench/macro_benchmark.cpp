@@ -0,0 +1,342 @@
+// macro_benchmark.cpp — End-to-end frame benchmark on the SpaceBattleSim demo
+//
+// The micro-benchmarks in benchmark.cpp time one operation at a time. This
+// target runs the demo's full frame instead: AI state machines, movement,
+// turret targeting, collision, damage, cleanup, wave spawning, command-buffer
+// flushes and Scheduler batching, all interacting.
+//
+// Each scale pre-populates the arena with P enemies and sizes spawn waves to
+// replace the enemies that leave, so the live population stays near P. The
+// run is headless and seeded: the same seed and scale produce the same
+// simulation at any thread count (see the checksum line). Systems that share
+// a Scheduler batch record into separate command buffers, which the frame
+// flushes in a fixed order.
+//
+// Reported per scale:
+//   - frame time p50 / p95 / p99 / max / mean (warmup frames excluded)
+//   - per-system p50 / p95 / p99 / max from Scheduler profiling. Systems in
+//     the same batch overlap, so their times do not sum to the frame time.
+//
+// Build: cmake -B build -DFATP_ECS_BUILD_MACRO_BENCH=ON ...
+//        cmake --build build --config Release --target macro_benchmark
+//
+// Run:   macro_benchmark [--entities 10000,100000,1000000] [--frames N]
+//                        [--warmup N] [--threads N] [--seed N] [--json PATH]
+//        macro_benchmark --compare BASELINE.json CURRENT.json [--threshold PCT]
+//
+// --json writes frame and per-system times per scale in the BenchReport.h
+// format (ns per frame); --compare diffs two such files (see BenchReport.h).
+//
+// --frames defaults to 300 / 100 / 30 frames for scales below 100K / below
+// 1M / 1M and above.
+//
+// With -DFATP_ECS_TRACK_ALLOCATIONS=ON the header line also reports heap
+// allocations per measured frame (AllocationTracker.h), and the JSON frame
+// case carries it as allocs_per_op.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fatp_ecs/AllocationTracker.h>
+
+#include "BenchReport.h"
+#include "Simulation.h"
+
+#if defined(FATP_ECS_TRACK_ALLOCATIONS)
+FATP_ECS_INSTALL_ALLOCATION_TRACKER();
+#endif
+
+namespace
+{
+
+struct Percentiles
+{
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+};
+
+// Nearest-rank percentiles over a copy of the samples.
+Percentiles computePercentiles(std::vector<double> samples)
+{
+    Percentiles out;
+    if (samples.empty())
+    {
+        return out;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    auto rank = [&](double p)
+    {
+        const auto n = static_cast<double>(samples.size());
+        auto idx = static_cast<std::size_t>(p * n + 0.999999);
+        idx = std::clamp<std::size_t>(idx, 1, samples.size());
+        return samples[idx - 1];
+    };
+
+    out.p50 = rank(0.50);
+    out.p95 = rank(0.95);
+    out.p99 = rank(0.99);
+    out.max = samples.back();
+    double sum = 0.0;
+    for (double v : samples)
+    {
+        sum += v;
+    }
+    out.mean = sum / static_cast<double>(samples.size());
+    return out;
+}
+
+void printRow(const char* label, const Percentiles& p)
+{
+    std::printf("  %-14s %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+                label, p.p50, p.p95, p.p99, p.max, p.mean);
+}
+
+std::vector<int> parseScaleList(const char* arg)
+{
+    std::vector<int> scales;
+    std::string token;
+    for (const char* c = arg;; ++c)
+    {
+        if (*c == ',' || *c == '\0')
+        {
+            if (!token.empty())
+            {
+                scales.push_back(std::atoi(token.c_str()));
+                token.clear();
+            }
+            if (*c == '\0')
+            {
+                break;
+            }
+        }
+        else
+        {
+            token.push_back(*c);
+        }
+    }
+    return scales;
+}
+
+struct BenchOptions
+{
+    std::vector<int> scales{10'000, 100'000, 1'000'000};
+    int frames = 0; // 0 = per-scale default
+    int warmup = 10;
+    std::size_t threads = 4;
+    uint32_t seed = 42;
+    std::string jsonPath;
+};
+
+int defaultFrames(int population)
+{
+    if (population >= 1'000'000)
+    {
+        return 30;
+    }
+    if (population >= 100'000)
+    {
+        return 100;
+    }
+    return 300;
+}
+
+void runScale(const BenchOptions& opts, int population, fatp_ecs::bench::JsonReport& report)
+{
+    SimConfig config;
+    config.numThreads = opts.threads;
+    config.seed = opts.seed;
+    config.initialEnemies = population;
+    config.reportInterval = 0;
+
+    // Enemies cross the arena in roughly arenaWidth / enemySpeed frames;
+    // replace that outflow every spawnInterval frames.
+    const float outflowPerFrame =
+        static_cast<float>(population) * config.enemySpeed / config.arenaWidth;
+    config.waveSize = std::max(
+        config.waveSize,
+        static_cast<int>(outflowPerFrame * static_cast<float>(config.spawnInterval)));
+
+    const int frames = opts.frames > 0 ? opts.frames : defaultFrames(population);
+    config.totalFrames = opts.warmup + frames;
+
+    FrameTimer setupTimer;
+    setupTimer.start();
+    SpaceBattleSim sim(config);
+    const double setupMs = setupTimer.elapsedMs();
+
+    Scheduler& scheduler = sim.scheduler();
+    scheduler.setProfilingEnabled(true);
+    const std::size_t systemCount = scheduler.systemCount();
+
+    std::vector<double> frameMs;
+    std::vector<std::vector<double>> systemMs(systemCount);
+    frameMs.reserve(static_cast<std::size_t>(frames));
+    std::size_t entitySum = 0;
+    std::size_t entityPeak = 0;
+    uint64_t measuredAllocations = 0;
+
+    FrameTimer frameTimer;
+    for (int f = 0; f < config.totalFrames; ++f)
+    {
+        fatp_ecs::AllocationScope allocScope;
+        frameTimer.start();
+        sim.tick();
+        const double ms = frameTimer.elapsedMs();
+
+        if (f < opts.warmup)
+        {
+            continue;
+        }
+
+        measuredAllocations += allocScope.allocations();
+
+        frameMs.push_back(ms);
+        const auto& times = scheduler.lastSystemTimesNs();
+        for (std::size_t i = 0; i < systemCount && i < times.size(); ++i)
+        {
+            systemMs[i].push_back(static_cast<double>(times[i]) / 1.0e6);
+        }
+        const std::size_t alive = sim.registry().entityCount();
+        entitySum += alive;
+        entityPeak = std::max(entityPeak, alive);
+    }
+
+    std::printf("\n=== %d enemies | wave %d every %d frames | %zu threads | seed %u ===\n",
+                population, config.waveSize, config.spawnInterval,
+                opts.threads, opts.seed);
+    std::printf("  Setup: %.1f ms | frames: %d measured + %d warmup | "
+                "entities avg %zu, peak %zu\n",
+                setupMs, frames, opts.warmup,
+                frameMs.empty() ? std::size_t{0} : entitySum / frameMs.size(), entityPeak);
+
+    const bool tracked = fatp_ecs::AllocationTracker::installed();
+    const double allocsPerFrame =
+        frameMs.empty() ? 0.0
+                        : static_cast<double>(measuredAllocations) /
+                              static_cast<double>(frameMs.size());
+    if (tracked)
+    {
+        std::printf("  Heap allocations: %.1f per frame\n", allocsPerFrame);
+    }
+
+    std::printf("\n  %-14s %9s %9s %9s %9s %9s\n", "(ms)", "p50", "p95", "p99", "max", "mean");
+    printRow("frame", computePercentiles(frameMs));
+    for (std::size_t i = 0; i < systemCount; ++i)
+    {
+        printRow(scheduler.systemName(i).c_str(), computePercentiles(systemMs[i]));
+    }
+
+    // JSON: one case per scale for the frame, one per system, in ns.
+    auto toNs = [](std::vector<double> ms)
+    {
+        for (double& v : ms)
+        {
+            v *= 1.0e6;
+        }
+        return fatp_ecs::bench::summarize(std::move(ms));
+    };
+    const std::string scaleName = "N=" + std::to_string(population);
+    const auto n = static_cast<std::size_t>(population);
+    report.addResult(scaleName + " frame", n, "fatp_ecs", toNs(frameMs),
+                     tracked ? allocsPerFrame : -1.0);
+    for (std::size_t i = 0; i < systemCount; ++i)
+    {
+        report.addResult(scaleName + " " + scheduler.systemName(i), n, "fatp_ecs",
+                         toNs(systemMs[i]));
+    }
+
+    const auto& s = sim.stats();
+    std::printf("\n  Checksum: spawned=%d killed=%d bullets=%d score=%d\n",
+                s.totalSpawned, s.totalKilled, s.bulletsSpawned, sim.getCurrentScore());
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int compareExit = 0;
+    if (fatp_ecs::bench::runCompareFromArgs(argc, argv, compareExit))
+    {
+        return compareExit;
+    }
+
+    BenchOptions opts;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--entities") == 0 && i + 1 < argc)
+        {
+            opts.scales = parseScaleList(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            opts.frames = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+        {
+            opts.warmup = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            opts.threads = static_cast<std::size_t>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            opts.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            opts.jsonPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--help") == 0)
+        {
+            std::printf("Usage: macro_benchmark [options]\n");
+            std::printf("  --entities LIST  Comma-separated enemy populations (default: 10000,100000,1000000)\n");
+            std::printf("  --frames N       Measured frames per scale (default: 300/100/30 by scale)\n");
+            std::printf("  --warmup N       Unmeasured frames before measuring (default: 10)\n");
+            std::printf("  --threads N      Scheduler worker threads (default: 4)\n");
+            std::printf("  --seed N         Simulation RNG seed (default: 42)\n");
+            std::printf("  --json PATH      Also write results as JSON\n");
+            std::printf("  --compare BASE CUR [--threshold PCT] [--library NAME]\n");
+            std::printf("                   Diff two JSON results; exit 1 on regression\n");
+            return 0;
+        }
+    }
+
+    std::printf("=== fatp_ecs macro benchmark: SpaceBattleSim ===\n");
+
+    fatp_ecs::bench::JsonReport report("fatp_ecs macro benchmark: SpaceBattleSim");
+    report.beginSection("SpaceBattleSim frame time");
+    report.setConfig("threads", static_cast<double>(opts.threads));
+    report.setConfig("seed", static_cast<double>(opts.seed));
+    report.setConfig("warmup_frames", static_cast<double>(opts.warmup));
+
+    for (int population : opts.scales)
+    {
+        if (population > 0)
+        {
+            runScale(opts, population, report);
+        }
+    }
+
+    if (!opts.jsonPath.empty())
+    {
+        if (!report.write(opts.jsonPath))
+        {
+            return 2;
+        }
+        std::printf("\nJSON results written to %s\n", opts.jsonPath.c_str());
+    }
+
+    return 0;
+}
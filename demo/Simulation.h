@@ -46,6 +46,8 @@ struct SimConfig
     float bulletSpeed = 15.0f;
     int reportInterval = 50;     // Print stats every N frames
     std::size_t numThreads = 4;
+    uint32_t seed = 42;          // RNG seed; same seed + config => same run
+    int initialEnemies = 0;      // Enemies spread across the arena at startup
 };
 
 // =============================================================================
@@ -183,7 +185,7 @@ struct AIComponent
 };
 
 // =============================================================================
-// Collision Pair (for FrameAllocator)
+// Collision Pair (allocated from the Scheduler's per-thread FrameArena)
 // =============================================================================
 
 struct CollisionPair
@@ -243,7 +245,7 @@ public:
     explicit SpaceBattleSim(const SimConfig& config)
         : mConfig(config)
         , mScheduler(config.numThreads)
-        , mCollisionAllocator(512)
+        , mRng(config.seed)
     {
         setupComponentFactories();
         setupEntityTemplates();
@@ -251,6 +253,7 @@ public:
         setupEvents();
         spawnTurrets();
         spawnScoreEntity();
+        spawnInitialEnemies();
     }
 
     // Advance the simulation by one frame.
@@ -265,8 +268,10 @@ public:
         // --- System execution (parallel via Scheduler) ---
         mScheduler.run(mRegistry);
 
-        // --- Post-frame: flush deferred commands ---
-        mCommandBuffer.flush(mRegistry);
+        // --- Post-frame: flush deferred commands, in a fixed order ---
+        mTurretCommands.flush(mRegistry);
+        mDamageCommands.flush(mRegistry);
+        mCleanupCommands.flush(mRegistry);
 
         // --- Stats ---
         mStats.frame++;
@@ -275,9 +280,6 @@ public:
         {
             mStats.peakEntities = mStats.entityCount;
         }
-
-        // --- Frame allocator reset ---
-        mCollisionAllocator.releaseAll();
     }
 
     // Record a frame time measurement.
@@ -370,45 +372,45 @@ public:
     const EntityNames& names() const noexcept { return mNames; }
 
 private:
+    // Bullet-enemy contact distance; also the spatial index cell size.
+    static constexpr float kHitRadius = 20.0f;
+
     // =========================================================================
     // Setup
     // =========================================================================
 
     void setupComponentFactories()
     {
-        mTemplates.registerComponent("Position",
-            [](Registry& reg, Entity e, const fat_p::JsonValue& data)
+        // Typed parsers run once per template; spawning copies the results.
+        mTemplates.registerComponent<Position>("Position",
+            [](const fat_p::JsonValue& data)
             {
                 auto& obj = std::get<fat_p::JsonObject>(data);
-                float x = static_cast<float>(std::get<double>(obj.at("x")));
-                float y = static_cast<float>(std::get<double>(obj.at("y")));
-                reg.add<Position>(e, x, y);
+                return Position{static_cast<float>(std::get<double>(obj.at("x"))),
+                                static_cast<float>(std::get<double>(obj.at("y")))};
             });
 
-        mTemplates.registerComponent("Velocity",
-            [](Registry& reg, Entity e, const fat_p::JsonValue& data)
+        mTemplates.registerComponent<Velocity>("Velocity",
+            [](const fat_p::JsonValue& data)
             {
                 auto& obj = std::get<fat_p::JsonObject>(data);
-                float dx = static_cast<float>(std::get<double>(obj.at("dx")));
-                float dy = static_cast<float>(std::get<double>(obj.at("dy")));
-                reg.add<Velocity>(e, dx, dy);
+                return Velocity{static_cast<float>(std::get<double>(obj.at("dx"))),
+                                static_cast<float>(std::get<double>(obj.at("dy")))};
             });
 
-        mTemplates.registerComponent("Health",
-            [](Registry& reg, Entity e, const fat_p::JsonValue& data)
+        mTemplates.registerComponent<Health>("Health",
+            [](const fat_p::JsonValue& data)
             {
                 auto& obj = std::get<fat_p::JsonObject>(data);
-                int hp = static_cast<int>(std::get<int64_t>(obj.at("current")));
-                int maxHp = static_cast<int>(std::get<int64_t>(obj.at("max")));
-                reg.add<Health>(e, hp, maxHp);
+                return Health{static_cast<int>(std::get<int64_t>(obj.at("current"))),
+                              static_cast<int>(std::get<int64_t>(obj.at("max")))};
             });
 
-        mTemplates.registerComponent("DamageDealer",
-            [](Registry& reg, Entity e, const fat_p::JsonValue& data)
+        mTemplates.registerComponent<DamageDealer>("DamageDealer",
+            [](const fat_p::JsonValue& data)
             {
                 auto& obj = std::get<fat_p::JsonObject>(data);
-                int amount = static_cast<int>(std::get<int64_t>(obj.at("amount")));
-                reg.add<DamageDealer>(e, amount);
+                return DamageDealer{static_cast<int>(std::get<int64_t>(obj.at("amount")))};
             });
     }
 
@@ -487,6 +489,8 @@ private:
                         pos.x += vel.dx;
                         pos.y += vel.dy;
                     });
+                // Positions were written in place, which fires no signals.
+                mSpatial.refreshAll();
             },
             makeComponentMask<Position>(),
             makeComponentMask<Velocity>());
@@ -531,7 +535,7 @@ private:
                                 float ey = epos->y;
                                 int dmg = turret.damage;
                                 Entity tgt = nearest;
-                                mCommandBuffer.create(
+                                mTurretCommands.create(
                                     [tx, ty, ex, ey, dmg, tgt]
                                     (Registry& r, Entity bullet)
                                     {
@@ -558,31 +562,35 @@ private:
             makeComponentMask<Position, EnemyTag>());
 
         // --- Collision System ---
+        // Pairs are scratch: they live in the worker's frame arena and are
+        // discarded when Scheduler::run() resets the arenas. Candidates come
+        // from the spatial index instead of a scan over every enemy.
         mScheduler.addSystem("Collision",
-            [this](Registry& reg)
+            [this](Registry& reg, SystemContext& ctx)
             {
                 if (!mSystemToggle.isEnabled("collision")) { return; }
                 auto bullets = reg.view<BulletTag, Position, DamageDealer>();
-                auto enemies = reg.view<EnemyTag, Position, Health>();
+                FrameArena& scratch = ctx.arena();
                 bullets.each(
-                    [this, &enemies](Entity bulletEntity,
-                                     [[maybe_unused]] BulletTag& bullet,
-                                     Position& bpos,
-                                     [[maybe_unused]] DamageDealer& bdmg)
+                    [this, &reg, &scratch](Entity bulletEntity,
+                                           [[maybe_unused]] BulletTag& bullet,
+                                           Position& bpos,
+                                           [[maybe_unused]] DamageDealer& bdmg)
                     {
-                        enemies.each(
-                            [this, &bulletEntity, &bpos]
-                            ([[maybe_unused]] Entity enemyEntity,
-                             [[maybe_unused]] EnemyTag&,
-                             Position& epos,
-                             [[maybe_unused]] Health&)
+                        mSpatial.queryRadius(bpos.x, bpos.y, kHitRadius,
+                            [&](Entity enemyEntity)
                             {
+                                if (!reg.all_of<EnemyTag, Health>(enemyEntity))
+                                {
+                                    return;
+                                }
+                                const Position& epos = reg.get<Position>(enemyEntity);
                                 float dx = bpos.x - epos.x;
                                 float dy = bpos.y - epos.y;
                                 float dist = std::sqrt(dx * dx + dy * dy);
-                                if (dist < 20.0f)
+                                if (dist < kHitRadius)
                                 {
-                                    (void)mCollisionAllocator.acquire(
+                                    (void)scratch.make<CollisionPair>(
                                         bulletEntity, enemyEntity, dist);
                                 }
                             });
@@ -598,30 +606,31 @@ private:
             {
                 if (!mSystemToggle.isEnabled("damage")) { return; }
                 auto bullets = reg.view<BulletTag, Position, DamageDealer>();
-                auto enemies = reg.view<EnemyTag, Position, Health>();
                 bullets.each(
-                    [this, &reg, &enemies](Entity bulletEntity,
-                                           [[maybe_unused]] BulletTag&,
-                                           Position& bpos,
-                                           DamageDealer& bdmg)
+                    [this, &reg](Entity bulletEntity,
+                                 [[maybe_unused]] BulletTag&,
+                                 Position& bpos,
+                                 DamageDealer& bdmg)
                     {
-                        enemies.each(
-                            [this, &reg, &bulletEntity, &bpos, &bdmg]
-                            ([[maybe_unused]] Entity enemyEntity,
-                             [[maybe_unused]] EnemyTag&,
-                             Position& epos,
-                             Health& ehp)
+                        mSpatial.queryRadius(bpos.x, bpos.y, kHitRadius,
+                            [this, &reg, &bulletEntity, &bpos, &bdmg](Entity enemyEntity)
                             {
+                                if (!reg.all_of<EnemyTag, Health>(enemyEntity))
+                                {
+                                    return;
+                                }
+                                const Position& epos = reg.get<Position>(enemyEntity);
+                                Health& ehp = reg.get<Health>(enemyEntity);
                                 float dx = bpos.x - epos.x;
                                 float dy = bpos.y - epos.y;
                                 float dist = std::sqrt(dx * dx + dy * dy);
-                                if (dist < 20.0f)
+                                if (dist < kHitRadius)
                                 {
                                     ehp.hp = applyDamage(ehp.hp, bdmg.amount,
                                                          ehp.maxHp);
                                     if (reg.isAlive(bulletEntity))
                                     {
-                                        mCommandBuffer.destroy(bulletEntity);
+                                        mDamageCommands.destroy(bulletEntity);
                                     }
                                 }
                             });
@@ -641,7 +650,7 @@ private:
                     {
                         if (hp.hp <= 0)
                         {
-                            mCommandBuffer.destroy(e);
+                            mCleanupCommands.destroy(e);
                             ++mStats.totalKilled;
                         }
                     });
@@ -652,7 +661,7 @@ private:
                         if (pos.x < -50.0f || pos.x > mConfig.arenaWidth + 50.0f ||
                             pos.y < -50.0f || pos.y > mConfig.arenaHeight + 50.0f)
                         {
-                            mCommandBuffer.destroy(e);
+                            mCleanupCommands.destroy(e);
                         }
                     });
                 reg.view<EnemyTag, Position>().each(
@@ -661,7 +670,7 @@ private:
                     {
                         if (pos.x < 0.0f)
                         {
-                            mCommandBuffer.destroy(e);
+                            mCleanupCommands.destroy(e);
                         }
                     });
                 reg.view<Score>().each(
@@ -728,27 +737,75 @@ private:
 
         for (int i = 0; i < mConfig.waveSize; ++i)
         {
-            Entity enemy = mTemplates.spawn(mRegistry, "enemy");
-            if (enemy == NullEntity) { continue; }
-
             float yPos = spacing * static_cast<float>(i + 1) + yJitter(mRng);
             yPos = std::clamp(yPos, 10.0f, mConfig.arenaHeight - 10.0f);
+            const float xPos = mConfig.arenaWidth + xJitter(mRng);
+            const float dx = -mConfig.enemySpeed * speedJitter(mRng);
+            const float dy = dyJitter(mRng);
+            mPendingEnemies.push_back({xPos, yPos, dx, dy});
+        }
+        spawnPendingEnemies();
+        char waveName[32];
+        std::snprintf(waveName, sizeof(waveName), "wave_%d", waveNum);
+        (void)waveName;
+    }
+
+    // Pre-populate the arena (used to scale the simulation for benchmarks).
+    void spawnInitialEnemies()
+    {
+        std::uniform_real_distribution<float> xDist(0.0f, mConfig.arenaWidth);
+        std::uniform_real_distribution<float> yDist(10.0f, mConfig.arenaHeight - 10.0f);
+        std::uniform_real_distribution<float> speedJitter(0.7f, 1.3f);
+        std::uniform_real_distribution<float> dyJitter(-0.5f, 0.5f);
+
+        for (int i = 0; i < mConfig.initialEnemies; ++i)
+        {
+            const float xPos = xDist(mRng);
+            const float yPos = yDist(mRng);
+            const float dx = -mConfig.enemySpeed * speedJitter(mRng);
+            const float dy = dyJitter(mRng);
+            mPendingEnemies.push_back({xPos, yPos, dx, dy});
+        }
+        spawnPendingEnemies();
+    }
+
+    struct EnemySpawn
+    {
+        float x, y, dx, dy;
+    };
+
+    // Stamp every queued enemy from the compiled "enemy" template in one
+    // bulk spawn, then apply the per-enemy position and velocity.
+    void spawnPendingEnemies()
+    {
+        const std::size_t count = mPendingEnemies.size();
+        mSpawnedEntities.resize(count);
+        if (mTemplates.spawn(mRegistry, "enemy", count, mSpawnedEntities.data()) != count)
+        {
+            mPendingEnemies.clear();
+            return;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Entity enemy = mSpawnedEntities[i];
+            const EnemySpawn& params = mPendingEnemies[i];
 
             auto& pos = mRegistry.get<Position>(enemy);
-            pos.x = mConfig.arenaWidth + xJitter(mRng);
-            pos.y = yPos;
+            pos.x = params.x;
+            pos.y = params.y;
+            // Written in place, so tell the index the template position moved.
+            mSpatial.update(enemy, pos);
 
             auto& vel = mRegistry.get<Velocity>(enemy);
-            vel.dx = -mConfig.enemySpeed * speedJitter(mRng);
-            vel.dy = dyJitter(mRng);
+            vel.dx = params.dx;
+            vel.dy = params.dy;
 
             mRegistry.add<EnemyTag>(enemy);
             mRegistry.add<AIComponent>(enemy, enemy, 50, 50);
             ++mStats.totalSpawned;
         }
-        char waveName[32];
-        std::snprintf(waveName, sizeof(waveName), "wave_%d", waveNum);
-        (void)waveName;
+        mPendingEnemies.clear();
     }
 
     // =========================================================================
@@ -757,14 +814,25 @@ private:
 
     SimConfig mConfig;
     Registry mRegistry;
+    // Bullet/enemy proximity. It follows Position through component signals
+    // and the Movement system's refreshAll(), so the Scheduler's Position
+    // masks already order every index write before or after its readers
+    // (Collision, Damage).
+    SpatialHash<Position> mSpatial{mRegistry, kHitRadius};
     Scheduler mScheduler;
-    CommandBuffer mCommandBuffer;
+    // One buffer per recording system: Turret and Damage share a batch, and
+    // CommandBuffer is not thread-safe. tick() flushes them in a fixed order,
+    // so a seeded run is the same at any thread count.
+    CommandBuffer mTurretCommands;
+    CommandBuffer mDamageCommands;
+    CommandBuffer mCleanupCommands;
     TemplateRegistry mTemplates;
+    std::vector<EnemySpawn> mPendingEnemies;   // reused across waves
+    std::vector<Entity> mSpawnedEntities;
     EntityNames mNames;
     SystemToggle mSystemToggle;
-    FrameAllocator<CollisionPair> mCollisionAllocator;
     SimStats mStats;
     fat_p::CircularBuffer<double, 512> mFrameTimes;
     fat_p::ScopedConnection mDestroyConn;
-    std::mt19937 mRng{42};
+    std::mt19937 mRng;
 };
@@ -6,7 +6,9 @@
  * Uses all 19 FAT-P components. See Simulation.h for the shared core.
  */
 
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 #include "Simulation.h"
@@ -37,6 +39,10 @@ int main(int argc, char* argv[])
         {
             config.reportInterval = std::atoi(argv[++i]);
         }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
         else if (std::strcmp(argv[i], "--help") == 0)
         {
             std::printf("Usage: demo [options]\n");
@@ -45,6 +51,7 @@ int main(int argc, char* argv[])
             std::printf("  --threads N      Worker threads (default: 4)\n");
             std::printf("  --turrets N      Number of turrets (default: 4)\n");
             std::printf("  --report N       Report every N frames (default: 50)\n");
+            std::printf("  --seed N         RNG seed (default: 42)\n");
             return 0;
         }
     }
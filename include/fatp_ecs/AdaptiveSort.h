@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file AdaptiveSort.h
+ * @brief Sort modes and the disorder-adaptive ordering behind
+ *        Registry::sort<T>(comparator, SortMode::Incremental).
+ */
+
+// Overview:
+//
+// Depth and spatial orders drift only slightly between frames, and new
+// entities arrive at the tail of the store. Re-sorting from scratch costs
+// O(n log n) every frame regardless. The incremental mode instead:
+//
+//   1. Checks whether the store is already sorted (n - 1 comparisons, no
+//      allocation). If so it returns without touching the store.
+//   2. Splits the indices in one pass into a sorted "kept" run and a list of
+//      "strays": each index is pushed onto the kept stack unless it orders
+//      before the top, in which case both the top and the index become
+//      strays. Removing both sides of every descent keeps the kept run
+//      sorted with at most twice the minimum number of strays.
+//   3. Sorts the strays and merges them back into the kept run.
+//
+// Total work is O(n + s log s) for s strays: linear when a few percent of
+// the components moved or a handful of unsorted entities were appended.
+// Ties are broken by current dense index, so the result equals a stable
+// sort of the store.
+//
+// Registry then applies the order with permute(), which walks the
+// permutation's cycles in place: the minimal number of swaps, fixed points
+// untouched.
+//
+// FAT-P components used:
+//   (none — standard library only)
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fatp_ecs
+{
+
+/// @brief How Registry::sort<T>(comparator, mode) orders a store.
+enum class SortMode : uint8_t
+{
+    Full,        ///< Indirect std::sort of the whole store every call
+    Incremental, ///< Adaptive: cost tracks how far the store is from sorted
+};
+
+/**
+ * @brief Compute a stable sorted order of [0, n) for a nearly-sorted range.
+ *
+ * less(a, b) compares the elements at indices a and b. On return, order[i]
+ * is the index that belongs at position i.
+ *
+ * @return false (order untouched) if [0, n) is already sorted.
+ */
+template <typename Less>
+bool adaptiveSortOrder(std::size_t n, std::vector<std::uint32_t>& order, Less&& less)
+{
+    std::size_t sortedPrefix = 1;
+    while (sortedPrefix < n &&
+           !less(static_cast<std::uint32_t>(sortedPrefix),
+                 static_cast<std::uint32_t>(sortedPrefix - 1)))
+    {
+        ++sortedPrefix;
+    }
+    if (sortedPrefix >= n)
+    {
+        return false;
+    }
+
+    // Equal elements keep their current relative order.
+    auto before = [&](std::uint32_t a, std::uint32_t b)
+    {
+        if (less(a, b)) return true;
+        if (less(b, a)) return false;
+        return a < b;
+    };
+
+    std::vector<std::uint32_t> kept;
+    std::vector<std::uint32_t> strays;
+    kept.reserve(n);
+    for (std::size_t i = 0; i < sortedPrefix; ++i)
+    {
+        kept.push_back(static_cast<std::uint32_t>(i));
+    }
+    for (std::size_t i = sortedPrefix; i < n; ++i)
+    {
+        const auto index = static_cast<std::uint32_t>(i);
+        if (!kept.empty() && less(index, kept.back()))
+        {
+            strays.push_back(kept.back());
+            kept.pop_back();
+            strays.push_back(index);
+        }
+        else
+        {
+            kept.push_back(index);
+        }
+    }
+
+    std::sort(strays.begin(), strays.end(), before);
+    order.resize(n);
+    std::merge(kept.begin(), kept.end(), strays.begin(), strays.end(), order.begin(), before);
+    return true;
+}
+
+} // namespace fatp_ecs
@@ -0,0 +1,264 @@
+#pragma once
+
+/**
+ * @file AllocationTracker.h
+ * @brief Opt-in global heap-allocation counting for tests and benchmarks.
+ */
+
+// FAT-P components used:
+//   (none — standard library only)
+//
+// Steady-state ECS frames should not touch the heap: stores, command buffers
+// and arenas keep their capacity across frames, so once a workload has warmed
+// up every allocation is a regression. AllocationTracker makes that checkable.
+//
+// The counters live here; the hook is a replacement of the global operator
+// new/delete family, which the language only permits once per program. So
+// this header does not install anything by itself — exactly one translation
+// unit of a test or benchmark executable expands
+//
+//   FATP_ECS_INSTALL_ALLOCATION_TRACKER()
+//
+// at namespace scope. Library headers never do, and FatpEcs.h does not
+// include this file, so applications are unaffected unless they opt in.
+//
+// Counters are process-wide relaxed atomics: allocations made by Scheduler
+// worker threads on behalf of a frame are counted too. AllocationScope
+// measures the delta between its construction and the query, so concurrent
+// unrelated allocations (another test thread, a logging thread) show up in
+// it — measure on a quiet process.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <malloc.h> // _aligned_malloc / _aligned_free
+#endif
+
+namespace fatp_ecs
+{
+
+/// @brief Totals of heap traffic observed through the replaced operator new.
+struct AllocationStats
+{
+    uint64_t allocations = 0;   ///< Calls to any operator new
+    uint64_t deallocations = 0; ///< Calls to any operator delete (non-null)
+    uint64_t bytes = 0;         ///< Bytes requested from operator new
+};
+
+/**
+ * @brief Process-wide allocation counters fed by the replaced operator new.
+ *
+ * @note Thread-safety: All members are safe to call from any thread.
+ */
+class AllocationTracker
+{
+public:
+    /// @brief True if FATP_ECS_INSTALL_ALLOCATION_TRACKER() is linked in.
+    [[nodiscard]] static bool installed() noexcept
+    {
+        return sInstalled.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Current totals since process start.
+    [[nodiscard]] static AllocationStats snapshot() noexcept
+    {
+        AllocationStats s;
+        s.allocations = sAllocations.load(std::memory_order_relaxed);
+        s.deallocations = sDeallocations.load(std::memory_order_relaxed);
+        s.bytes = sBytes.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // Hooks called by the operators defined in the install macro.
+
+    static void markInstalled() noexcept
+    {
+        sInstalled.store(true, std::memory_order_relaxed);
+    }
+
+    static void recordAllocation(std::size_t size) noexcept
+    {
+        sAllocations.fetch_add(1, std::memory_order_relaxed);
+        sBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    static void recordDeallocation() noexcept
+    {
+        sDeallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    inline static std::atomic<bool> sInstalled{false};
+    inline static std::atomic<uint64_t> sAllocations{0};
+    inline static std::atomic<uint64_t> sDeallocations{0};
+    inline static std::atomic<uint64_t> sBytes{0};
+};
+
+/**
+ * @brief Measures heap traffic between construction and each query.
+ *
+ * @example
+ * @code
+ *   AllocationScope scope;
+ *   registry.view<Position, Velocity>().each(integrate);
+ *   assert(scope.allocations() == 0);
+ * @endcode
+ */
+class AllocationScope
+{
+public:
+    AllocationScope() noexcept
+        : mStart(AllocationTracker::snapshot())
+    {
+    }
+
+    /// @brief Restart the measurement from now.
+    void reset() noexcept
+    {
+        mStart = AllocationTracker::snapshot();
+    }
+
+    /// @brief Allocations, deallocations and bytes since construction/reset().
+    [[nodiscard]] AllocationStats delta() const noexcept
+    {
+        const AllocationStats now = AllocationTracker::snapshot();
+        AllocationStats d;
+        d.allocations = now.allocations - mStart.allocations;
+        d.deallocations = now.deallocations - mStart.deallocations;
+        d.bytes = now.bytes - mStart.bytes;
+        return d;
+    }
+
+    [[nodiscard]] uint64_t allocations() const noexcept
+    {
+        return delta().allocations;
+    }
+
+    [[nodiscard]] uint64_t bytes() const noexcept
+    {
+        return delta().bytes;
+    }
+
+private:
+    AllocationStats mStart;
+};
+
+namespace detail
+{
+
+inline void* trackedAlloc(std::size_t size)
+{
+    AllocationTracker::recordAllocation(size);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+inline void* trackedAlignedAlloc(std::size_t size, std::align_val_t align)
+{
+    AllocationTracker::recordAllocation(size);
+    const auto a = static_cast<std::size_t>(align);
+    // aligned_alloc requires size to be a multiple of the alignment.
+    const std::size_t rounded = (size == 0 ? a : (size + a - 1) / a * a);
+#if defined(_MSC_VER)
+    void* p = _aligned_malloc(rounded, a);
+#else
+    void* p = std::aligned_alloc(a, rounded);
+#endif
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+inline void trackedFree(void* p) noexcept
+{
+    if (p != nullptr)
+    {
+        AllocationTracker::recordDeallocation();
+        std::free(p);
+    }
+}
+
+inline void trackedAlignedFree(void* p) noexcept
+{
+    if (p != nullptr)
+    {
+        AllocationTracker::recordDeallocation();
+#if defined(_MSC_VER)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+} // namespace detail
+
+} // namespace fatp_ecs
+
+// Expand once, at global namespace scope, in one translation unit of the
+// executable. The nothrow forms are not replaced: their default definitions
+// forward to the throwing forms below, so they are counted as well.
+#define FATP_ECS_INSTALL_ALLOCATION_TRACKER()                                          \
+    void* operator new(std::size_t size)                                               \
+    {                                                                                  \
+        return ::fatp_ecs::detail::trackedAlloc(size);                                 \
+    }                                                                                  \
+    void* operator new[](std::size_t size)                                             \
+    {                                                                                  \
+        return ::fatp_ecs::detail::trackedAlloc(size);                                 \
+    }                                                                                  \
+    void* operator new(std::size_t size, std::align_val_t align)                       \
+    {                                                                                  \
+        return ::fatp_ecs::detail::trackedAlignedAlloc(size, align);                   \
+    }                                                                                  \
+    void* operator new[](std::size_t size, std::align_val_t align)                     \
+    {                                                                                  \
+        return ::fatp_ecs::detail::trackedAlignedAlloc(size, align);                   \
+    }                                                                                  \
+    void operator delete(void* p) noexcept                                             \
+    {                                                                                  \
+        ::fatp_ecs::detail::trackedFree(p);                                            \
+    }                                                                                  \
+    void operator delete[](void* p) noexcept                                           \
+    {                                                                                  \
+        ::fatp_ecs::detail::trackedFree(p);                                            \
+    }                                                                                  \
+    void operator delete(void* p, std::size_t) noexcept                                \
+    {                                                                                  \
+        ::fatp_ecs::detail::trackedFree(p);                                            \
+    }                                                                                  \
+    void operator delete[](void* p, std::size_t) noexcept                              \
+    {                                                                                  \
+        ::fatp_ecs::detail::trackedFree(p);                                            \
+    }                                                                                  \
+    void operator delete(void* p, std::align_val_t) noexcept                           \
+    {                                                                                  \
+        ::fatp_ecs::detail::trackedAlignedFree(p);                                     \
+    }                                                                                  \
+    void operator delete[](void* p, std::align_val_t) noexcept                         \
+    {                                                                                  \
+        ::fatp_ecs::detail::trackedAlignedFree(p);                                     \
+    }                                                                                  \
+    void operator delete(void* p, std::size_t, std::align_val_t) noexcept              \
+    {                                                                                  \
+        ::fatp_ecs::detail::trackedAlignedFree(p);                                     \
+    }                                                                                  \
+    void operator delete[](void* p, std::size_t, std::align_val_t) noexcept            \
+    {                                                                                  \
+        ::fatp_ecs::detail::trackedAlignedFree(p);                                     \
+    }                                                                                  \
+    namespace                                                                          \
+    {                                                                                  \
+    const bool kFatpEcsAllocationTrackerInstalled =                                    \
+        (::fatp_ecs::AllocationTracker::markInstalled(), true);                        \
+    }                                                                                  \
+    static_assert(true, "require a trailing semicolon")
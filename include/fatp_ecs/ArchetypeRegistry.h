@@ -0,0 +1,887 @@
+#pragma once
+
+/**
+ * @file ArchetypeRegistry.h
+ * @brief Archetype (table) storage: entities grouped by exact component set,
+ *        one contiguous column per component.
+ */
+
+// Overview:
+//
+// Registry stores each component type in its own sparse set. A view over
+// several types walks the smallest store and probes the others per entity,
+// and only one owning group per store can remove that probe. ArchetypeRegistry
+// is the opt-in alternative layout for workloads with many stable,
+// multi-component query shapes:
+//
+//   - A table (archetype) holds every entity with exactly one component set.
+//     Each component is a contiguous column; row i of every column belongs
+//     to entities[i].
+//   - view<Ts...>() visits every table whose set contains Ts (and none of
+//     the excluded types) and walks its columns linearly: no per-entity
+//     probe, for every query shape at once.
+//   - The list of matching tables is cached per query signature. Tables are
+//     only ever appended, so a cached query catches up by scanning just the
+//     tables created since it last ran.
+//   - add<T>() / remove<T>() move the entity's row to the neighbouring table.
+//     The target is cached on the source table (archetype graph edge), so
+//     after the first transition it is a single lookup. Rows are relocated
+//     with memcpy for trivially copyable types, move + destroy otherwise.
+//
+// Trade-off: adding or removing a component moves every component of the
+// entity, where a sparse set touches only one store. Prefer Registry for
+// data that changes shape every frame (tags toggled per tick), and this
+// layout for long-lived entities iterated by many queries.
+//
+// The API mirrors Registry's entity/component subset — create, destroy,
+// add, remove, has, get, tryGet, view(...).each(...) — so a system written
+// as a template over the registry type runs on either. Signals, groups,
+// observers, storage policies, snapshots, and sorting are Registry-only.
+//
+// Structural changes (create/destroy/add/remove) during view().each() are
+// not allowed; queue them in a CommandBuffer-style list instead.
+//
+// FAT-P components used:
+//   - FastHashMap: table lookup by component set, query cache, graph edges
+//   - BitSet (ComponentMask): table/query matching via isSubsetOf/intersects
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fat_p/FastHashMap.h>
+
+#include "ComponentMask.h"
+#include "Entity.h"
+#include "TypeId.h"
+#include "View.h"
+
+namespace fatp_ecs
+{
+
+namespace archetype_detail
+{
+
+// =============================================================================
+// ColumnType — type-erased per-component operations
+// =============================================================================
+
+struct ColumnType
+{
+    TypeId id;
+    std::size_t size;
+    std::size_t align;
+    bool trivial;
+
+    /// Move-construct *src into uninitialized dst, then destroy *src.
+    void (*relocate)(void* dst, void* src) noexcept;
+    void (*destroy)(void* p) noexcept;
+};
+
+template <typename T>
+const ColumnType& columnType() noexcept
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "ArchetypeRegistry components must be nothrow move constructible");
+
+    static const ColumnType type{
+        typeId<T>(),
+        sizeof(T),
+        alignof(T),
+        std::is_trivially_copyable_v<T>,
+        [](void* dst, void* src) noexcept
+        {
+            T* from = static_cast<T*>(src);
+            ::new (dst) T(std::move(*from));
+            from->~T();
+        },
+        [](void* p) noexcept { static_cast<T*>(p)->~T(); }};
+    return type;
+}
+
+// =============================================================================
+// Column — one component's contiguous array within a table
+// =============================================================================
+
+class Column
+{
+public:
+    explicit Column(const ColumnType& type) noexcept
+        : mType(&type)
+    {
+    }
+
+    Column(Column&& other) noexcept
+        : mType(other.mType)
+        , mData(std::exchange(other.mData, nullptr))
+        , mSize(std::exchange(other.mSize, 0))
+        , mCapacity(std::exchange(other.mCapacity, 0))
+    {
+    }
+
+    Column(const Column&) = delete;
+    Column& operator=(const Column&) = delete;
+    Column& operator=(Column&&) = delete;
+
+    ~Column()
+    {
+        clear();
+        deallocate(mData);
+    }
+
+    [[nodiscard]] const ColumnType& type() const noexcept { return *mType; }
+    [[nodiscard]] std::size_t size() const noexcept { return mSize; }
+    [[nodiscard]] void* data() noexcept { return mData; }
+
+    [[nodiscard]] void* at(std::size_t row) noexcept
+    {
+        return static_cast<std::byte*>(mData) + row * mType->size;
+    }
+
+    /// Reserve the slot one past the end. It is uninitialized until the
+    /// caller constructs into it, then commit() makes it part of the column.
+    [[nodiscard]] void* reserveBack()
+    {
+        if (mSize == mCapacity)
+        {
+            grow(mCapacity == 0 ? 8 : mCapacity * 2);
+        }
+        return at(mSize);
+    }
+
+    void commit() noexcept { ++mSize; }
+
+    /// Relocate row `row` of `other` (same type) onto the end of this column.
+    /// The source slot is left uninitialized; see eraseMovedOut().
+    void appendFrom(Column& other, std::size_t row)
+    {
+        void* dst = reserveBack();
+        relocate(dst, other.at(row));
+        commit();
+    }
+
+    /// Destroy the element at row and fill the hole with the last element.
+    void swapRemove(std::size_t row) noexcept
+    {
+        mType->destroy(at(row));
+        eraseMovedOut(row);
+    }
+
+    /// Fill row (already relocated away or destroyed) with the last element.
+    void eraseMovedOut(std::size_t row) noexcept
+    {
+        const std::size_t last = mSize - 1;
+        if (row != last)
+        {
+            relocate(at(row), at(last));
+        }
+        mSize = last;
+    }
+
+    void clear() noexcept
+    {
+        if (!mType->trivial)
+        {
+            for (std::size_t i = 0; i < mSize; ++i)
+            {
+                mType->destroy(at(i));
+            }
+        }
+        mSize = 0;
+    }
+
+private:
+    void relocate(void* dst, void* src) const noexcept
+    {
+        if (mType->trivial)
+        {
+            std::memcpy(dst, src, mType->size);
+        }
+        else
+        {
+            mType->relocate(dst, src);
+        }
+    }
+
+    void grow(std::size_t capacity)
+    {
+        void* fresh = ::operator new(capacity * mType->size, std::align_val_t{mType->align});
+        if (mType->trivial)
+        {
+            if (mSize > 0)
+            {
+                std::memcpy(fresh, mData, mSize * mType->size);
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < mSize; ++i)
+            {
+                mType->relocate(static_cast<std::byte*>(fresh) + i * mType->size, at(i));
+            }
+        }
+        deallocate(mData);
+        mData = fresh;
+        mCapacity = capacity;
+    }
+
+    void deallocate(void* p) const noexcept
+    {
+        if (p != nullptr)
+        {
+            ::operator delete(p, std::align_val_t{mType->align});
+        }
+    }
+
+    const ColumnType* mType;
+    void* mData = nullptr;
+    std::size_t mSize = 0;
+    std::size_t mCapacity = 0;
+};
+
+// =============================================================================
+// Table — all entities sharing one exact component set
+// =============================================================================
+
+struct Table
+{
+    ComponentMask mask;
+    std::vector<TypeId> types; ///< Sorted; types[i] is stored in columns[i].
+    std::vector<Column> columns;
+    std::vector<Entity> entities;
+
+    /// Archetype graph: table reached by adding / removing one type.
+    fat_p::FastHashMap<TypeId, uint32_t> addEdges;
+    fat_p::FastHashMap<TypeId, uint32_t> removeEdges;
+
+    [[nodiscard]] int columnOf(TypeId tid) const noexcept
+    {
+        const auto it = std::lower_bound(types.begin(), types.end(), tid);
+        if (it == types.end() || *it != tid)
+        {
+            return -1;
+        }
+        return static_cast<int>(it - types.begin());
+    }
+};
+
+inline uint64_t hashTypes(const std::vector<TypeId>& types) noexcept
+{
+    uint64_t key = 0xcbf29ce484222325ULL;
+    for (const TypeId tid : types)
+    {
+        key = (key ^ tid) * 0x100000001b3ULL;
+    }
+    return key;
+}
+
+} // namespace archetype_detail
+
+class ArchetypeRegistry;
+
+// =============================================================================
+// ArchetypeView — iteration over every table matching a query
+// =============================================================================
+
+template <typename IncludePack, typename ExcludePack>
+class ArchetypeView;
+
+/**
+ * @brief Query over an ArchetypeRegistry. Obtained from view<Ts...>().
+ *
+ * Holds a reference to the registry's cached table list for this query
+ * shape; cheap to create every frame.
+ */
+template <typename... Ts, typename... Xs>
+class ArchetypeView<std::tuple<Ts...>, std::tuple<Xs...>>
+{
+    static_assert(sizeof...(Ts) > 0, "ArchetypeView requires at least one component type");
+
+public:
+    ArchetypeView(std::vector<std::unique_ptr<archetype_detail::Table>>& tables,
+                  const std::vector<uint32_t>& matches) noexcept
+        : mTables(&tables)
+        , mMatches(&matches)
+    {
+    }
+
+    /**
+     * @brief Invoke func(Entity, Ts&...) for every matching entity.
+     *
+     * @note Complexity: O(matching tables + matching entities); column
+     *       pointers are resolved once per table.
+     */
+    template <typename Func>
+    void each(Func&& func)
+    {
+        for (const uint32_t index : *mMatches)
+        {
+            archetype_detail::Table& table = *(*mTables)[index];
+            const std::size_t n = table.entities.size();
+            if (n == 0)
+            {
+                continue;
+            }
+            const Entity* entities = table.entities.data();
+            std::tuple<Ts*...> columns{
+                static_cast<Ts*>(table.columns[static_cast<std::size_t>(
+                    table.columnOf(typeId<Ts>()))].data())...};
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                func(entities[i], std::get<Ts*>(columns)[i]...);
+            }
+        }
+    }
+
+    /// @brief Number of matching entities.
+    [[nodiscard]] std::size_t count() const noexcept
+    {
+        std::size_t total = 0;
+        for (const uint32_t index : *mMatches)
+        {
+            total += (*mTables)[index]->entities.size();
+        }
+        return total;
+    }
+
+    /// @brief Number of tables the query visits (including empty ones).
+    [[nodiscard]] std::size_t tableCount() const noexcept
+    {
+        return mMatches->size();
+    }
+
+private:
+    std::vector<std::unique_ptr<archetype_detail::Table>>* mTables;
+    const std::vector<uint32_t>* mMatches;
+};
+
+// =============================================================================
+// ArchetypeRegistry
+// =============================================================================
+
+/**
+ * @brief Entity/component registry backed by archetype tables.
+ *
+ * @code
+ *   ArchetypeRegistry world;
+ *   Entity e = world.create();
+ *   world.add<Position>(e, 0.0f, 0.0f);
+ *   world.add<Velocity>(e, 1.0f, 0.0f);
+ *   world.view<Position, Velocity>().each([](Entity, Position& p, Velocity& v) {
+ *       p.x += v.dx;
+ *   });
+ * @endcode
+ *
+ * @note Thread-safety: NOT thread-safe.
+ */
+class ArchetypeRegistry
+{
+public:
+    ArchetypeRegistry()
+    {
+        // Table 0: entities with no components.
+        mTables.push_back(std::make_unique<archetype_detail::Table>());
+        mTableLookup.insert(archetype_detail::hashTypes({}), std::vector<uint32_t>{0});
+    }
+
+    ArchetypeRegistry(const ArchetypeRegistry&) = delete;
+    ArchetypeRegistry& operator=(const ArchetypeRegistry&) = delete;
+    ArchetypeRegistry(ArchetypeRegistry&&) noexcept = default;
+    ArchetypeRegistry& operator=(ArchetypeRegistry&&) noexcept = default;
+
+    // =========================================================================
+    // Entity Lifecycle
+    // =========================================================================
+
+    [[nodiscard]] Entity create()
+    {
+        uint32_t slot = 0;
+        if (!mFreeSlots.empty())
+        {
+            slot = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(mRecords.size());
+            mRecords.push_back(Record{});
+        }
+
+        Record& record = mRecords[slot];
+        record.alive = true;
+        record.table = 0;
+        record.row = static_cast<uint32_t>(mTables[0]->entities.size());
+        const Entity entity = EntityTraits::make(slot, record.generation);
+        mTables[0]->entities.push_back(entity);
+        ++mAlive;
+        return entity;
+    }
+
+    bool destroy(Entity entity)
+    {
+        if (!isAlive(entity))
+        {
+            return false;
+        }
+        const uint32_t slot = EntityTraits::index(entity);
+        Record& record = mRecords[slot];
+        archetype_detail::Table& table = *mTables[record.table];
+        for (auto& column : table.columns)
+        {
+            column.swapRemove(record.row);
+        }
+        eraseEntityRow(table, record.row);
+
+        record.alive = false;
+        ++record.generation;
+        mFreeSlots.push_back(slot);
+        --mAlive;
+        return true;
+    }
+
+    [[nodiscard]] bool isAlive(Entity entity) const noexcept
+    {
+        const uint32_t slot = EntityTraits::index(entity);
+        return slot < mRecords.size() && mRecords[slot].alive &&
+               mRecords[slot].generation == EntityTraits::generation(entity);
+    }
+
+    [[nodiscard]] bool valid(Entity entity) const noexcept { return isAlive(entity); }
+
+    [[nodiscard]] std::size_t alive() const noexcept { return mAlive; }
+    [[nodiscard]] std::size_t entityCount() const noexcept { return mAlive; }
+
+    /// @brief Destroy every entity. Tables, edges and query caches are kept.
+    void clear()
+    {
+        for (auto& table : mTables)
+        {
+            for (auto& column : table->columns)
+            {
+                column.clear();
+            }
+            for (const Entity entity : table->entities)
+            {
+                Record& record = mRecords[EntityTraits::index(entity)];
+                record.alive = false;
+                ++record.generation;
+                mFreeSlots.push_back(EntityTraits::index(entity));
+            }
+            table->entities.clear();
+        }
+        mAlive = 0;
+    }
+
+    // =========================================================================
+    // Component Operations
+    // =========================================================================
+
+    /**
+     * @brief Add T to entity, constructed from args.
+     *
+     * Contract matches Registry::add(): if the entity already has T, the
+     * existing component is returned unchanged.
+     *
+     * @throws std::out_of_range if entity is not alive.
+     * @note Complexity: O(components on the entity) row relocation.
+     */
+    template <typename T, typename... Args>
+    T& add(Entity entity, Args&&... args)
+    {
+        Record& record = recordOf(entity);
+        const TypeId tid = typeId<T>();
+        archetype_detail::Table* from = mTables[record.table].get();
+        const int existing = from->columnOf(tid);
+        if (existing >= 0)
+        {
+            return *static_cast<T*>(
+                from->columns[static_cast<std::size_t>(existing)].at(record.row));
+        }
+
+        const uint32_t toIndex = addTarget(record.table, archetype_detail::columnType<T>());
+        from = mTables[record.table].get();
+        archetype_detail::Table& to = *mTables[toIndex];
+
+        // Build the value before touching any column: args may refer to
+        // components (this entity's, or another T in the target column) that
+        // the row move or a column growth would relocate.
+        T value = makeValue<T>(std::forward<Args>(args)...);
+        archetype_detail::Column& column =
+            to.columns[static_cast<std::size_t>(to.columnOf(tid))];
+        T* component = ::new (column.reserveBack()) T(std::move(value));
+        column.commit();
+
+        moveRow(record, *from, to, toIndex);
+        return *component;
+    }
+
+    /// @brief Alias for add().
+    template <typename T, typename... Args>
+    T& emplace(Entity entity, Args&&... args)
+    {
+        return add<T>(entity, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Remove T from entity.
+     * @return true if the entity had T.
+     */
+    template <typename T>
+    bool remove(Entity entity)
+    {
+        if (!isAlive(entity))
+        {
+            return false;
+        }
+        Record& record = mRecords[EntityTraits::index(entity)];
+        const TypeId tid = typeId<T>();
+        archetype_detail::Table* from = mTables[record.table].get();
+        const int column = from->columnOf(tid);
+        if (column < 0)
+        {
+            return false;
+        }
+
+        const uint32_t toIndex = removeTarget(record.table, tid);
+        from = mTables[record.table].get();
+        from->columns[static_cast<std::size_t>(column)].swapRemove(record.row);
+        moveRow(record, *from, *mTables[toIndex], toIndex);
+        return true;
+    }
+
+    template <typename T>
+    [[nodiscard]] bool has(Entity entity) const noexcept
+    {
+        if (!isAlive(entity))
+        {
+            return false;
+        }
+        return mTables[mRecords[EntityTraits::index(entity)].table]->columnOf(typeId<T>()) >= 0;
+    }
+
+    template <typename T>
+    [[nodiscard]] T* tryGet(Entity entity) noexcept
+    {
+        if (!isAlive(entity))
+        {
+            return nullptr;
+        }
+        const Record& record = mRecords[EntityTraits::index(entity)];
+        archetype_detail::Table& table = *mTables[record.table];
+        const int column = table.columnOf(typeId<T>());
+        if (column < 0)
+        {
+            return nullptr;
+        }
+        return static_cast<T*>(table.columns[static_cast<std::size_t>(column)].at(record.row));
+    }
+
+    template <typename T>
+    [[nodiscard]] T& get(Entity entity)
+    {
+        T* component = tryGet<T>(entity);
+        if (component == nullptr)
+        {
+            throw std::out_of_range("ArchetypeRegistry::get: entity does not have component");
+        }
+        return *component;
+    }
+
+    // =========================================================================
+    // Queries
+    // =========================================================================
+
+    /**
+     * @brief Query every entity that has all of Ts.
+     *
+     * The matching table list is cached per query shape and extended
+     * incrementally as new tables appear.
+     */
+    template <typename... Ts>
+    [[nodiscard]] ArchetypeView<std::tuple<Ts...>, std::tuple<>> view()
+    {
+        return ArchetypeView<std::tuple<Ts...>, std::tuple<>>(
+            mTables, matchingTables(makeComponentMask<Ts...>(), ComponentMask{},
+                                    queryKey<Ts...>(0)));
+    }
+
+    /// @brief Query every entity that has all of Ts and none of Xs.
+    template <typename... Ts, typename... Xs>
+    [[nodiscard]] ArchetypeView<std::tuple<Ts...>, std::tuple<Xs...>>
+    view(Exclude<Xs...> /*tag*/)
+    {
+        return ArchetypeView<std::tuple<Ts...>, std::tuple<Xs...>>(
+            mTables, matchingTables(makeComponentMask<Ts...>(), makeComponentMask<Xs...>(),
+                                    queryKey<Xs...>(queryKey<Ts...>(0) + 1)));
+    }
+
+    /// @brief Number of archetype tables (including the empty-set table).
+    [[nodiscard]] std::size_t tableCount() const noexcept
+    {
+        return mTables.size();
+    }
+
+private:
+    struct Record
+    {
+        uint32_t generation = 0;
+        uint32_t table = 0;
+        uint32_t row = 0;
+        bool alive = false;
+    };
+
+    struct Query
+    {
+        ComponentMask include;
+        ComponentMask exclude;
+        std::vector<uint32_t> tables;
+        std::size_t scanned = 0;
+    };
+
+    template <typename T, typename... Args>
+    static T makeValue(Args&&... args)
+    {
+        if constexpr (std::is_aggregate_v<T>)
+        {
+            return T{std::forward<Args>(args)...};
+        }
+        else
+        {
+            return T(std::forward<Args>(args)...);
+        }
+    }
+
+    Record& recordOf(Entity entity)
+    {
+        if (!isAlive(entity))
+        {
+            throw std::out_of_range("ArchetypeRegistry: entity is not alive");
+        }
+        return mRecords[EntityTraits::index(entity)];
+    }
+
+    static bool sameMask(const ComponentMask& a, const ComponentMask& b) noexcept
+    {
+        return a.isSubsetOf(b) && b.isSubsetOf(a);
+    }
+
+    template <typename... Ts>
+    static uint64_t queryKey(uint64_t seed) noexcept
+    {
+        uint64_t key = seed ^ 0xcbf29ce484222325ULL;
+        ((key = (key ^ typeId<Ts>()) * 0x100000001b3ULL), ...);
+        return key;
+    }
+
+    const std::vector<uint32_t>& matchingTables(const ComponentMask& include,
+                                                const ComponentMask& exclude, uint64_t key)
+    {
+        Query* query = nullptr;
+        std::vector<uint32_t>* bucket = mQueryLookup.find(key);
+        if (bucket != nullptr)
+        {
+            for (const uint32_t index : *bucket)
+            {
+                Query& candidate = *mQueries[index];
+                if (sameMask(candidate.include, include) && sameMask(candidate.exclude, exclude))
+                {
+                    query = &candidate;
+                    break;
+                }
+            }
+        }
+        if (query == nullptr)
+        {
+            const auto index = static_cast<uint32_t>(mQueries.size());
+            mQueries.push_back(std::make_unique<Query>(Query{include, exclude, {}, 0}));
+            query = mQueries.back().get();
+            if (bucket != nullptr)
+            {
+                bucket->push_back(index);
+            }
+            else
+            {
+                mQueryLookup.insert(key, std::vector<uint32_t>{index});
+            }
+        }
+        for (; query->scanned < mTables.size(); ++query->scanned)
+        {
+            const ComponentMask& mask = mTables[query->scanned]->mask;
+            if (include.isSubsetOf(mask) && !exclude.intersects(mask))
+            {
+                query->tables.push_back(static_cast<uint32_t>(query->scanned));
+            }
+        }
+        return query->tables;
+    }
+
+    /// Move the entity's components from `from` to the end of `to`, then
+    /// close the gap in `from`. The caller has already placed an added
+    /// component in `to`, or swap-removed a removed one from `from` (the one
+    /// column of `from` that `to` lacks).
+    void moveRow(Record& record, archetype_detail::Table& from, archetype_detail::Table& to,
+                 uint32_t toIndex)
+    {
+        // Both type lists are sorted: pair the columns with one merge walk.
+        const uint32_t row = record.row;
+        std::size_t t = 0;
+        for (std::size_t c = 0; c < from.columns.size(); ++c)
+        {
+            while (t < to.types.size() && to.types[t] < from.types[c])
+            {
+                ++t;
+            }
+            if (t < to.types.size() && to.types[t] == from.types[c])
+            {
+                to.columns[t].appendFrom(from.columns[c], row);
+                from.columns[c].eraseMovedOut(row);
+            }
+        }
+
+        const Entity entity = from.entities[row];
+        eraseEntityRow(from, row);
+        record.table = toIndex;
+        record.row = static_cast<uint32_t>(to.entities.size());
+        to.entities.push_back(entity);
+    }
+
+    void eraseEntityRow(archetype_detail::Table& table, uint32_t row)
+    {
+        const std::size_t last = table.entities.size() - 1;
+        if (row != last)
+        {
+            const Entity moved = table.entities[last];
+            table.entities[row] = moved;
+            mRecords[EntityTraits::index(moved)].row = row;
+        }
+        table.entities.pop_back();
+    }
+
+    uint32_t addTarget(uint32_t fromIndex, const archetype_detail::ColumnType& added)
+    {
+        if (const uint32_t* cached = mTables[fromIndex]->addEdges.find(added.id))
+        {
+            return *cached;
+        }
+
+        std::vector<TypeId> types = mTables[fromIndex]->types;
+        types.insert(std::upper_bound(types.begin(), types.end(), added.id), added.id);
+
+        std::vector<const archetype_detail::ColumnType*> columnTypes;
+        columnTypes.reserve(types.size());
+        for (const TypeId tid : types)
+        {
+            columnTypes.push_back(tid == added.id ? &added : columnTypeIn(fromIndex, tid));
+        }
+
+        const uint32_t toIndex = findOrCreateTable(types, columnTypes);
+        mTables[fromIndex]->addEdges.insert(added.id, toIndex);
+        mTables[toIndex]->removeEdges.insert(added.id, fromIndex);
+        return toIndex;
+    }
+
+    uint32_t removeTarget(uint32_t fromIndex, TypeId removed)
+    {
+        if (const uint32_t* cached = mTables[fromIndex]->removeEdges.find(removed))
+        {
+            return *cached;
+        }
+
+        std::vector<TypeId> types;
+        std::vector<const archetype_detail::ColumnType*> columnTypes;
+        for (const TypeId tid : mTables[fromIndex]->types)
+        {
+            if (tid != removed)
+            {
+                types.push_back(tid);
+                columnTypes.push_back(columnTypeIn(fromIndex, tid));
+            }
+        }
+
+        const uint32_t toIndex = findOrCreateTable(types, columnTypes);
+        mTables[fromIndex]->removeEdges.insert(removed, toIndex);
+        mTables[toIndex]->addEdges.insert(removed, fromIndex);
+        return toIndex;
+    }
+
+    const archetype_detail::ColumnType* columnTypeIn(uint32_t tableIndex, TypeId tid) const
+    {
+        const archetype_detail::Table& table = *mTables[tableIndex];
+        return &table.columns[static_cast<std::size_t>(table.columnOf(tid))].type();
+    }
+
+    uint32_t findOrCreateTable(const std::vector<TypeId>& types,
+                               const std::vector<const archetype_detail::ColumnType*>& columnTypes)
+    {
+        const uint64_t key = archetype_detail::hashTypes(types);
+        std::vector<uint32_t>* bucket = mTableLookup.find(key);
+        if (bucket != nullptr)
+        {
+            for (const uint32_t index : *bucket)
+            {
+                if (mTables[index]->types == types)
+                {
+                    return index;
+                }
+            }
+        }
+
+        auto table = std::make_unique<archetype_detail::Table>();
+        table->types = types;
+        table->columns.reserve(types.size());
+        for (std::size_t i = 0; i < types.size(); ++i)
+        {
+            assert(types[i] < kMaxComponentTypes &&
+                   "ArchetypeRegistry: TypeId exceeds kMaxComponentTypes");
+            table->mask.set(types[i]);
+            table->columns.emplace_back(*columnTypes[i]);
+        }
+
+        const auto index = static_cast<uint32_t>(mTables.size());
+        mTables.push_back(std::move(table));
+        if (bucket != nullptr)
+        {
+            bucket->push_back(index);
+        }
+        else
+        {
+            mTableLookup.insert(key, std::vector<uint32_t>{index});
+        }
+        return index;
+    }
+
+    // =========================================================================
+    // Data Members
+    // =========================================================================
+
+    /// @brief Per-slot location of each entity: table index and row.
+    std::vector<Record> mRecords;
+    std::vector<uint32_t> mFreeSlots;
+    std::size_t mAlive = 0;
+
+    /// @brief All tables ever created; indices are stable (never erased).
+    std::vector<std::unique_ptr<archetype_detail::Table>> mTables;
+
+    /// @brief Component-set hash -> tables with that hash (collisions resolved
+    /// by comparing the sorted type lists).
+    fat_p::FastHashMap<uint64_t, std::vector<uint32_t>> mTableLookup;
+
+    /// @brief Cached query shapes. Heap-allocated so that the table lists
+    /// views point into stay put as more shapes are added.
+    std::vector<std::unique_ptr<Query>> mQueries;
+
+    /// @brief Query-shape hash -> queries with that hash (collisions resolved
+    /// by comparing the include and exclude masks).
+    fat_p::FastHashMap<uint64_t, std::vector<uint32_t>> mQueryLookup;
+};
+
+} // namespace fatp_ecs
@@ -14,13 +14,23 @@
 //
 // CommandBuffer (std::vector backend) is NOT thread-safe; use one per thread.
 // ParallelCommandBuffer (mutex-protected) is thread-safe for concurrent recording.
+//
+// Allocation: a Command is a plain function pointer plus an optional payload
+// pointer. Component values (and create() callbacks) are constructed in a
+// FrameArena owned by the buffer; flush() and clear() rewind the arena
+// instead of freeing, and the command vector keeps its capacity. Once a
+// buffer has seen its peak frame, recording and flushing allocate nothing.
 
+#include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <memory>
 #include <mutex>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "Entity.h"
+#include "FrameArena.h"
 
 namespace fatp_ecs
 {
@@ -40,12 +50,16 @@ enum class CommandKind : uint8_t
     RemoveComponent,
 };
 
-/// @brief A single deferred command with type-erased apply function.
+/// @brief Signature of a command's apply thunk.
+using CommandFn = void (*)(Registry&, Entity, void* payload);
+
+/// @brief A single deferred command: apply thunk plus optional arena payload.
 struct Command
 {
     CommandKind kind;
     Entity entity{NullEntity};
-    std::function<void(Registry&)> apply;
+    CommandFn invoke = nullptr;
+    void* payload = nullptr; ///< Owned by the recording buffer's arena
 };
 
 // =============================================================================
@@ -57,6 +71,9 @@ struct Command
 class CommandBuffer
 {
 public:
+    /// @brief Block size of the payload arena (allocated on first payload).
+    static constexpr std::size_t kPayloadBlockSize = 4 * 1024;
+
     CommandBuffer() = default;
 
     // =========================================================================
@@ -73,45 +90,81 @@ public:
     template <typename T>
     static void removeComponent(Registry& reg, Entity entity);
 
+    // Apply thunks stored in Command::invoke.
+
+    static void invokeCreate(Registry& reg, Entity, void*)
+    {
+        createEntity(reg);
+    }
+
+    template <typename Func>
+    static void invokeCreateWith(Registry& reg, Entity, void* payload)
+    {
+        Entity e = createEntity(reg);
+        (*static_cast<Func*>(payload))(reg, e);
+    }
+
+    static void invokeDestroy(Registry& reg, Entity entity, void*)
+    {
+        destroyEntity(reg, entity);
+    }
+
+    template <typename T>
+    static void invokeAdd(Registry& reg, Entity entity, void* payload)
+    {
+        addComponent<T>(reg, entity, std::move(*static_cast<T*>(payload)));
+    }
+
+    template <typename T>
+    static void invokeRemove(Registry& reg, Entity entity, void*)
+    {
+        removeComponent<T>(reg, entity);
+    }
+
     // =========================================================================
     // Command recording
     // =========================================================================
 
+    /// @brief Records a deferred entity creation.
+    void create()
+    {
+        mCommands.push_back({CommandKind::Create, NullEntity, &invokeCreate, nullptr});
+    }
+
+    /// @brief Same as create(); kept for callers that pass a null callback.
+    void create(std::nullptr_t)
+    {
+        create();
+    }
+
     /**
-     * @brief Records a deferred entity creation.
+     * @brief Records a deferred entity creation with a callback.
      *
-     * @param onCreate Optional callback receiving the newly created Entity.
+     * @param onCreate Callable invoked as onCreate(Registry&, Entity) with the
+     *                 newly created entity during flush(). Stored in the
+     *                 buffer's arena, not in a std::function.
      */
-    void create(std::function<void(Registry&, Entity)> onCreate = nullptr)
+    template <typename Func>
+        requires std::is_invocable_v<std::decay_t<Func>&, Registry&, Entity>
+    void create(Func&& onCreate)
     {
-        Command c;
-        c.kind = CommandKind::Create;
-        if (onCreate)
+        if constexpr (std::is_constructible_v<bool, const std::decay_t<Func>&>)
         {
-            c.apply = [cb = std::move(onCreate)](Registry& reg) {
-                Entity e = createEntity(reg);
-                cb(reg, e);
-            };
-        }
-        else
-        {
-            c.apply = [](Registry& reg) {
-                createEntity(reg);
-            };
+            if (!static_cast<bool>(onCreate))
+            {
+                create();
+                return;
+            }
         }
-        mCommands.push_back(std::move(c));
+        using Fn = std::decay_t<Func>;
+        void* payload = payloads().template make<Fn>(std::forward<Func>(onCreate));
+        mCommands.push_back({CommandKind::Create, NullEntity, &invokeCreateWith<Fn>, payload});
     }
 
     /// @brief Records a deferred entity destruction.
     void destroy(Entity entity)
     {
-        Command c;
-        c.kind = CommandKind::Destroy;
-        c.entity = entity;
-        c.apply = [entity](Registry& reg) {
-            destroyEntity(reg, entity);
-        };
-        mCommands.push_back(std::move(c));
+        mCommands.push_back({CommandKind::Destroy, entity, &invokeDestroy, nullptr});
     }
 
     /**
@@ -125,14 +178,8 @@ public:
     template <typename T, typename... Args>
     void add(Entity entity, Args&&... args)
     {
-        auto component = std::make_shared<T>(std::forward<Args>(args)...);
-        Command c;
-        c.kind = CommandKind::AddComponent;
-        c.entity = entity;
-        c.apply = [entity, comp = std::move(component)](Registry& reg) {
-            addComponent<T>(reg, entity, std::move(*comp));
-        };
-        mCommands.push_back(std::move(c));
+        T* payload = makePayload<T>(payloads(), std::forward<Args>(args)...);
+        mCommands.push_back({CommandKind::AddComponent, entity, &invokeAdd<T>, payload});
     }
 
     /**
@@ -144,20 +191,19 @@ public:
     template <typename T>
     void remove(Entity entity)
     {
-        Command c;
-        c.kind = CommandKind::RemoveComponent;
-        c.entity = entity;
-        c.apply = [entity](Registry& reg) {
-            removeComponent<T>(reg, entity);
-        };
-        mCommands.push_back(std::move(c));
+        mCommands.push_back({CommandKind::RemoveComponent, entity, &invokeRemove<T>, nullptr});
     }
 
     // =========================================================================
     // Flush / Query
     // =========================================================================
 
-    /// @brief Applies all recorded commands to the registry, then clears.
+    /**
+     * @brief Applies all recorded commands to the registry, then clears.
+     *
+     * If a command throws, the buffer is still cleared (the remaining
+     * commands are discarded) and the exception propagates.
+     */
     void flush(Registry& registry);
 
     [[nodiscard]] std::size_t size() const noexcept
@@ -174,10 +220,38 @@ public:
     void clear() noexcept
     {
         mCommands.clear();
+        if (mPayloads)
+        {
+            mPayloads->reset();
+        }
+    }
+
+    /// @brief Constructs a T payload in @p arena (aggregates brace-initialized).
+    template <typename T, typename... Args>
+    [[nodiscard]] static T* makePayload(FrameArena& arena, Args&&... args)
+    {
+        if constexpr (std::is_constructible_v<T, Args&&...>)
+        {
+            return arena.make<T>(std::forward<Args>(args)...);
+        }
+        else
+        {
+            return arena.make<T>(T{std::forward<Args>(args)...});
+        }
     }
 
 private:
+    FrameArena& payloads()
+    {
+        if (!mPayloads)
+        {
+            mPayloads = std::make_unique<FrameArena>(kPayloadBlockSize);
+        }
+        return *mPayloads;
+    }
+
     std::vector<Command> mCommands;
+    std::unique_ptr<FrameArena> mPayloads; // heap-held so the buffer stays movable
 };
 
 // =============================================================================
@@ -188,53 +262,67 @@ private:
 // multiple worker threads. Flush is single-threaded (main thread between
 // frames). The mutex approach is simple and correct; for extremely high
 // contention a sharded design could be substituted.
+//
+// Recording and flushing use separate (command vector, payload arena) pairs
+// that flush() swaps under the lock, so commands recorded while a flush is
+// applying land in the other pair and both keep their capacity.
 
 /// @brief Thread-safe command buffer for multi-threaded system execution.
 /// @note Thread-safety: Recording is thread-safe. Flush must be single-threaded.
 class ParallelCommandBuffer
 {
 public:
-    ParallelCommandBuffer() = default;
+    ParallelCommandBuffer()
+        : mRecording(std::make_unique<Pending>())
+        , mFlushing(std::make_unique<Pending>())
+    {
+    }
+
+    /// @brief Records a deferred entity creation (thread-safe).
+    void create()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRecording->commands.push_back(
+            {CommandKind::Create, NullEntity, &CommandBuffer::invokeCreate, nullptr});
+    }
+
+    /// @brief Same as create(); kept for callers that pass a null callback.
+    void create(std::nullptr_t)
+    {
+        create();
+    }
 
     /**
-     * @brief Records a deferred entity creation (thread-safe).
+     * @brief Records a deferred entity creation with a callback (thread-safe).
      *
-     * @param onCreate Optional callback receiving the newly created Entity.
+     * @param onCreate Callable invoked as onCreate(Registry&, Entity) with the
+     *                 newly created entity during flush().
      */
-    void create(std::function<void(Registry&, Entity)> onCreate = nullptr)
+    template <typename Func>
+        requires std::is_invocable_v<std::decay_t<Func>&, Registry&, Entity>
+    void create(Func&& onCreate)
     {
-        Command c;
-        c.kind = CommandKind::Create;
-        if (onCreate)
+        if constexpr (std::is_constructible_v<bool, const std::decay_t<Func>&>)
         {
-            c.apply = [cb = std::move(onCreate)](Registry& reg) {
-                Entity e = CommandBuffer::createEntity(reg);
-                cb(reg, e);
-            };
-        }
-        else
-        {
-            c.apply = [](Registry& reg) {
-                CommandBuffer::createEntity(reg);
-            };
+            if (!static_cast<bool>(onCreate))
+            {
+                create();
+                return;
+            }
         }
-
+        using Fn = std::decay_t<Func>;
         std::lock_guard<std::mutex> lock(mMutex);
-        mCommands.push_back(std::move(c));
+        void* payload = mRecording->arena.make<Fn>(std::forward<Func>(onCreate));
+        mRecording->commands.push_back(
+            {CommandKind::Create, NullEntity, &CommandBuffer::invokeCreateWith<Fn>, payload});
     }
 
     /// @brief Records a deferred entity destruction (thread-safe).
     bool destroy(Entity entity)
     {
-        Command c;
-        c.kind = CommandKind::Destroy;
-        c.entity = entity;
-        c.apply = [entity](Registry& reg) {
-            CommandBuffer::destroyEntity(reg, entity);
-        };
-
         std::lock_guard<std::mutex> lock(mMutex);
-        mCommands.push_back(std::move(c));
+        mRecording->commands.push_back(
+            {CommandKind::Destroy, entity, &CommandBuffer::invokeDestroy, nullptr});
         return true;
     }
 
@@ -242,16 +330,10 @@ public:
     template <typename T, typename... Args>
     bool add(Entity entity, Args&&... args)
     {
-        auto component = std::make_shared<T>(std::forward<Args>(args)...);
-        Command c;
-        c.kind = CommandKind::AddComponent;
-        c.entity = entity;
-        c.apply = [entity, comp = std::move(component)](Registry& reg) {
-            CommandBuffer::addComponent<T>(reg, entity, std::move(*comp));
-        };
-
         std::lock_guard<std::mutex> lock(mMutex);
-        mCommands.push_back(std::move(c));
+        T* payload = CommandBuffer::makePayload<T>(mRecording->arena, std::forward<Args>(args)...);
+        mRecording->commands.push_back(
+            {CommandKind::AddComponent, entity, &CommandBuffer::invokeAdd<T>, payload});
         return true;
     }
 
@@ -259,52 +341,65 @@ public:
     template <typename T>
     bool remove(Entity entity)
     {
-        Command c;
-        c.kind = CommandKind::RemoveComponent;
-        c.entity = entity;
-        c.apply = [entity](Registry& reg) {
-            CommandBuffer::removeComponent<T>(reg, entity);
-        };
-
         std::lock_guard<std::mutex> lock(mMutex);
-        mCommands.push_back(std::move(c));
+        mRecording->commands.push_back(
+            {CommandKind::RemoveComponent, entity, &CommandBuffer::invokeRemove<T>, nullptr});
         return true;
     }
 
-    /// @brief Applies all recorded commands (single-threaded).
+    /**
+     * @brief Applies all recorded commands (single-threaded).
+     *
+     * If a command throws, the commands after it are discarded and the
+     * exception propagates; none of them is applied by a later flush().
+     */
     void flush(Registry& registry)
     {
-        std::vector<Command> commands;
         {
             std::lock_guard<std::mutex> lock(mMutex);
-            commands = std::move(mCommands);
-            mCommands.clear();
+            std::swap(mRecording, mFlushing);
         }
 
-        for (auto& cmd : commands)
+        try
         {
-            if (cmd.apply)
+            for (const Command& cmd : mFlushing->commands)
             {
-                cmd.apply(registry);
+                cmd.invoke(registry, cmd.entity, cmd.payload);
             }
         }
+        catch (...)
+        {
+            mFlushing->commands.clear();
+            mFlushing->arena.reset();
+            throw;
+        }
+        mFlushing->commands.clear();
+        mFlushing->arena.reset();
     }
 
     [[nodiscard]] std::size_t size() const
     {
         std::lock_guard<std::mutex> lock(mMutex);
-        return mCommands.size();
+        return mRecording->commands.size();
     }
 
     void clear()
     {
         std::lock_guard<std::mutex> lock(mMutex);
-        mCommands.clear();
+        mRecording->commands.clear();
+        mRecording->arena.reset();
     }
 
 private:
+    struct Pending
+    {
+        std::vector<Command> commands;
+        FrameArena arena{CommandBuffer::kPayloadBlockSize};
+    };
+
     mutable std::mutex mMutex;
-    std::vector<Command> mCommands;
+    std::unique_ptr<Pending> mRecording;
+    std::unique_ptr<Pending> mFlushing;
 };
 
 } // namespace fatp_ecs
@@ -29,14 +29,19 @@ namespace fatp_ecs
 
 inline void CommandBuffer::flush(Registry& registry)
 {
-    for (auto& cmd : mCommands)
+    try
     {
-        if (cmd.apply)
+        for (const Command& cmd : mCommands)
         {
-            cmd.apply(registry);
+            cmd.invoke(registry, cmd.entity, cmd.payload);
         }
     }
-    mCommands.clear();
+    catch (...)
+    {
+        clear();
+        throw;
+    }
+    clear();
 }
 
 // =============================================================================
@@ -0,0 +1,298 @@
+#pragma once
+
+/**
+ * @file CompiledQuery.h
+ * @brief Persistent, cached plan for a runtime include/exclude query.
+ */
+
+// FAT-P components used:
+// - SmallVector: Inline storage for the include/exclude slots and the
+//   per-call probe arrays (no heap allocation for <= 8 types per side).
+//
+// RuntimeView is built per call and, on every each(), re-selects its pivot
+// and probes the other stores through the virtual IComponentStore::has().
+// Scripting layers issue the same dynamic queries every frame, so
+// Registry::compileQuery() returns a CompiledQuery that keeps:
+//
+//   - the resolved store pointer for every TypeId (types not registered yet
+//     are resolved lazily on a later each(), once some entity has them; the
+//     lookup is retried only when the registry has gained a store, and never
+//     for kInvalidTypeId);
+//   - the chosen pivot, which is kept until another include store becomes
+//     less than half its size (hysteresis: iteration order stays stable
+//     while sizes drift, and the plan only changes when it pays off).
+//
+// Each each() call makes four virtual calls per store to read its dense and
+// sparse arrays (they may have been reallocated since the last call), then
+// iterates the pivot with inline sparse-array probes: no virtual call per
+// entity. Include probes run smallest store first so most rejections happen
+// on the first probe.
+//
+// Lifetime: a CompiledQuery refers to its Registry and must not outlive it
+// (or be used after the Registry is moved from). Do not add or remove
+// components of the queried types from inside each().
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include <fat_p/SmallVector.h>
+
+#include "ComponentStore.h"
+#include "Entity.h"
+#include "TypeId.h"
+
+namespace fatp_ecs
+{
+
+class Registry;
+
+// =============================================================================
+// CompiledQuery
+// =============================================================================
+
+/**
+ * @brief Reusable runtime query: entities with every include type and none
+ *        of the exclude types.
+ *
+ * Constructed by Registry::compileQuery(). Keep it across frames.
+ *
+ * @note Thread-safety: NOT thread-safe. each() updates the cached plan.
+ *
+ * @example
+ * @code
+ *   // Once, when the script system loads:
+ *   CompiledQuery movers = registry.compileQuery(
+ *       {typeId<Position>(), typeId<Velocity>()}, {typeId<Frozen>()});
+ *
+ *   // Every frame:
+ *   movers.each([&](Entity e) { script.call("move", e); });
+ * @endcode
+ */
+class CompiledQuery
+{
+public:
+    static constexpr std::size_t kNoPivot = std::numeric_limits<std::size_t>::max();
+
+    CompiledQuery() = default;
+
+    /**
+     * @brief Call func(Entity) for every matching entity.
+     *
+     * Iterates the pivot store's dense array in order.
+     */
+    template <typename Func>
+    void each(Func&& func)
+    {
+        if (!prepare())
+        {
+            return;
+        }
+
+        const IComponentStore* pivot = mInclude[mPivot].store;
+        const Entity*     ents = pivot->denseEntities();
+        const std::size_t cnt  = pivot->denseEntityCount();
+
+        for (std::size_t i = 0; i < cnt; ++i)
+        {
+            const Entity entity = ents[i];
+            if (matches(entity))
+            {
+                func(entity);
+            }
+        }
+    }
+
+    /// @brief Number of matching entities.
+    [[nodiscard]] std::size_t count()
+    {
+        std::size_t result = 0;
+        each([&result](Entity) { ++result; });
+        return result;
+    }
+
+    /// @brief True if no entity matches. Stops at the first match.
+    [[nodiscard]] bool empty()
+    {
+        if (!prepare())
+        {
+            return true;
+        }
+        const IComponentStore* pivot = mInclude[mPivot].store;
+        const Entity*     ents = pivot->denseEntities();
+        const std::size_t cnt  = pivot->denseEntityCount();
+        for (std::size_t i = 0; i < cnt; ++i)
+        {
+            if (matches(ents[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief True if entity currently matches the query.
+    [[nodiscard]] bool contains(Entity entity)
+    {
+        if (!prepare())
+        {
+            return false;
+        }
+        const IComponentStore* pivot = mInclude[mPivot].store;
+        return pivot->has(entity) && matches(entity);
+    }
+
+    [[nodiscard]] std::size_t includeCount() const noexcept { return mInclude.size(); }
+    [[nodiscard]] std::size_t excludeCount() const noexcept { return mExclude.size(); }
+
+    /**
+     * @brief Include slot currently driving iteration, or kNoPivot before
+     *        the first each() (or while an include type is unregistered).
+     */
+    [[nodiscard]] std::size_t pivotIndex() const noexcept { return mPivot; }
+
+    /// @brief Number of times the pivot has been chosen (1 after first use).
+    [[nodiscard]] std::size_t replanCount() const noexcept { return mReplans; }
+
+    /// @brief Types not registered yet, still waiting for their store.
+    [[nodiscard]] std::size_t pendingCount() const noexcept { return mUnresolved; }
+
+private:
+    friend class Registry;
+
+    struct Slot
+    {
+        TypeId           tid;
+        IComponentStore* store;
+    };
+
+    // Raw view of one store's sparse set, read once per call.
+    struct Probe
+    {
+        const uint32_t* sparseData = nullptr;
+        std::size_t     sparseSize = 0;
+        const Entity*   denseData  = nullptr;
+        std::size_t     denseSize  = 0;
+
+        Probe() = default;
+
+        explicit Probe(const IComponentStore* store) noexcept
+            : sparseData(store->sparseIndices())
+            , sparseSize(store->sparseIndexCount())
+            , denseData(store->denseEntities())
+            , denseSize(store->denseEntityCount())
+        {
+        }
+
+        [[nodiscard]] bool has(Entity entity) const noexcept
+        {
+            const uint32_t sparseIdx = EntityIndex::index(entity);
+            if (sparseIdx >= sparseSize) return false;
+            const uint32_t denseIdx = sparseData[sparseIdx];
+            if (denseIdx >= denseSize) return false;
+            return denseData[denseIdx] == entity;
+        }
+    };
+
+    Registry* mRegistry = nullptr;
+    fat_p::SmallVector<Slot, 8> mInclude;
+    fat_p::SmallVector<Slot, 8> mExclude;
+    std::size_t mUnresolved = 0;
+    std::size_t mStoresSeen = 0; // registry store count at the last resolve
+    std::size_t mPivot = kNoPivot;
+    std::size_t mReplans = 0;
+
+    // Rebuilt by prepare() on every call.
+    fat_p::SmallVector<Probe, 8> mIncludeProbes;
+    fat_p::SmallVector<Probe, 8> mExcludeProbes;
+
+    void addSlot(fat_p::SmallVector<Slot, 8>& slots, TypeId tid, IComponentStore* store)
+    {
+        slots.push_back(Slot{tid, store});
+        if (store == nullptr && tid != kInvalidTypeId)
+        {
+            ++mUnresolved;
+        }
+    }
+
+    /// Look up slots whose type was unregistered, if the registry has gained
+    /// a store since the last look. Defined in Registry.h.
+    void resolvePending();
+
+    /**
+     * @brief Resolve stores, update the pivot and rebuild the probes.
+     * @return false if the query cannot match anything.
+     */
+    bool prepare()
+    {
+        if (mUnresolved != 0 && mRegistry != nullptr)
+        {
+            resolvePending();
+        }
+        if (mInclude.empty())
+        {
+            return false;
+        }
+
+        std::size_t smallest = 0;
+        for (std::size_t i = 0; i < mInclude.size(); ++i)
+        {
+            if (mInclude[i].store == nullptr)
+            {
+                return false;
+            }
+            if (mInclude[i].store->size() < mInclude[smallest].store->size())
+            {
+                smallest = i;
+            }
+        }
+        if (mPivot == kNoPivot ||
+            mInclude[smallest].store->size() * 2 < mInclude[mPivot].store->size())
+        {
+            mPivot = smallest;
+            ++mReplans;
+        }
+
+        // Smallest store first: it rejects the most entities.
+        mIncludeProbes.clear();
+        for (std::size_t i = 0; i < mInclude.size(); ++i)
+        {
+            if (i == mPivot)
+            {
+                continue;
+            }
+            mIncludeProbes.push_back(Probe(mInclude[i].store));
+            for (std::size_t j = mIncludeProbes.size() - 1;
+                 j > 0 && mIncludeProbes[j].denseSize < mIncludeProbes[j - 1].denseSize; --j)
+            {
+                std::swap(mIncludeProbes[j], mIncludeProbes[j - 1]);
+            }
+        }
+
+        mExcludeProbes.clear();
+        for (const Slot& slot : mExclude)
+        {
+            if (slot.store != nullptr)
+            {
+                mExcludeProbes.push_back(Probe(slot.store));
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool matches(Entity entity) const noexcept
+    {
+        for (const Probe& probe : mIncludeProbes)
+        {
+            if (!probe.has(entity)) return false;
+        }
+        for (const Probe& probe : mExcludeProbes)
+        {
+            if (probe.has(entity)) return false;
+        }
+        return true;
+    }
+};
+
+} // namespace fatp_ecs
@@ -0,0 +1,282 @@
+#pragma once
+
+/**
+ * @file ComponentReflection.h
+ * @brief Name-keyed component metadata for scripting, tooling and export.
+ */
+
+// FAT-P components used:
+// - FastHashMap: Name -> info and TypeId -> info lookup
+//
+// TypeId values are process-local counters assigned on first use, so a
+// script, an editor or a file format cannot name a component by TypeId.
+// ComponentReflection binds a stable string name to each reflected
+// component type and records what generic code needs to handle it as
+// bytes: size, alignment, whether it may be copied with memcpy, and the
+// offset, size and scalar kind of each declared field.
+//
+// Registry owns one (Registry::reflect<T>(name), Registry::reflection()).
+// Name lookups are meant to happen once, when a query or binding is built:
+// Registry::runtimeView() and compileQuery() accept names and turn them
+// into TypeIds on the spot, and scripts keep the ComponentInfo pointer (or
+// its TypeId) for per-entity calls such as Registry::tryGetRaw().
+//
+// Infos are heap-allocated individually, so ComponentInfo pointers stay
+// valid while more types are reflected.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fat_p/FastHashMap.h>
+
+#include "Entity.h"
+#include "TypeId.h"
+
+namespace fatp_ecs
+{
+
+/// @brief Scalar interpretation of a reflected field's bytes.
+enum class FieldKind : uint8_t
+{
+    Bool,
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float32,
+    Float64,
+    Entity, ///< fatp_ecs::Entity handle
+    Other,  ///< Anything else: nested struct, array, pointer...
+};
+
+/// @brief FieldKind for a C++ field type.
+template <typename F>
+[[nodiscard]] constexpr FieldKind fieldKindOf() noexcept
+{
+    if constexpr (std::is_same_v<F, bool>) return FieldKind::Bool;
+    else if constexpr (std::is_same_v<F, Entity>) return FieldKind::Entity;
+    else if constexpr (std::is_floating_point_v<F> && sizeof(F) == 4) return FieldKind::Float32;
+    else if constexpr (std::is_floating_point_v<F> && sizeof(F) == 8) return FieldKind::Float64;
+    else if constexpr (std::is_integral_v<F> && std::is_signed_v<F>)
+    {
+        if constexpr (sizeof(F) == 1) return FieldKind::Int8;
+        else if constexpr (sizeof(F) == 2) return FieldKind::Int16;
+        else if constexpr (sizeof(F) == 4) return FieldKind::Int32;
+        else if constexpr (sizeof(F) == 8) return FieldKind::Int64;
+        else return FieldKind::Other;
+    }
+    else if constexpr (std::is_integral_v<F>)
+    {
+        if constexpr (sizeof(F) == 1) return FieldKind::UInt8;
+        else if constexpr (sizeof(F) == 2) return FieldKind::UInt16;
+        else if constexpr (sizeof(F) == 4) return FieldKind::UInt32;
+        else if constexpr (sizeof(F) == 8) return FieldKind::UInt64;
+        else return FieldKind::Other;
+    }
+    else return FieldKind::Other;
+}
+
+/// @brief One reflected data member.
+struct FieldInfo
+{
+    std::string name;
+    std::size_t offset = 0; ///< Byte offset inside the component
+    std::size_t size   = 0; ///< sizeof the member
+    FieldKind   kind   = FieldKind::Other;
+
+    /// @brief Address of this field inside the component at @p component.
+    [[nodiscard]] void* in(void* component) const noexcept
+    {
+        return static_cast<unsigned char*>(component) + offset;
+    }
+
+    [[nodiscard]] const void* in(const void* component) const noexcept
+    {
+        return static_cast<const unsigned char*>(component) + offset;
+    }
+};
+
+/// @brief Everything known about one reflected component type.
+struct ComponentInfo
+{
+    std::string name;
+    TypeId      type = 0;
+    std::size_t size = 0;
+    std::size_t alignment = 0;
+    bool        triviallyCopyable = false;
+    std::vector<FieldInfo> fields;
+
+    /// @brief Field by name, or nullptr.
+    [[nodiscard]] const FieldInfo* field(std::string_view fieldName) const noexcept
+    {
+        for (const FieldInfo& f : fields)
+        {
+            if (f.name == fieldName) return &f;
+        }
+        return nullptr;
+    }
+};
+
+/// @brief Untyped, zero-copy view of one component store (Registry::rawComponents()).
+struct RawComponentSpan
+{
+    void*         data     = nullptr; ///< Dense component array
+    const Entity* entities = nullptr; ///< Owner of each element of data
+    std::size_t   count    = 0;
+    std::size_t   stride   = 0;       ///< Bytes per component; 0 if the type is unknown
+};
+
+/**
+ * @brief Registry of reflected component types, keyed by name and TypeId.
+ *
+ * @note Thread-safety: NOT thread-safe.
+ *
+ * @example
+ * @code
+ *   registry.reflect<Position>("Position")
+ *       .field("x", &Position::x)
+ *       .field("y", &Position::y);
+ *
+ *   const ComponentInfo* pos = registry.reflection().find("Position");
+ *   const FieldInfo*     x   = pos->field("x");   // kind == Float32
+ * @endcode
+ */
+class ComponentReflection
+{
+public:
+    /// @brief Returned by reflect<T>(); declares T's fields.
+    template <typename T>
+    class Builder
+    {
+    public:
+        explicit Builder(ComponentInfo& info) noexcept : mInfo(&info) {}
+
+        /**
+         * @brief Record data member @p member under @p fieldName.
+         *
+         * T must be standard-layout (so offsets are meaningful) and default
+         * constructible: the offset is measured on one value-initialised T
+         * shared by every field() call for that type.
+         */
+        template <typename M>
+        Builder& field(std::string fieldName, M T::* member)
+        {
+            static_assert(std::is_standard_layout_v<T>,
+                          "ComponentReflection: field offsets need a standard-layout component");
+            static_assert(std::is_default_constructible_v<T>,
+                          "ComponentReflection: field offsets need a default-constructible component");
+            mInfo->fields.push_back(FieldInfo{std::move(fieldName), memberOffset(member),
+                                              sizeof(M), fieldKindOf<M>()});
+            return *this;
+        }
+
+        [[nodiscard]] const ComponentInfo& info() const noexcept { return *mInfo; }
+
+    private:
+        ComponentInfo* mInfo;
+
+        // A live object, so forming object.*member is well defined.
+        static const T& sample()
+        {
+            static const T object{};
+            return object;
+        }
+
+        template <typename M>
+        static std::size_t memberOffset(M T::* member)
+        {
+            const T& object = sample();
+            return static_cast<std::size_t>(
+                reinterpret_cast<const unsigned char*>(std::addressof(object.*member)) -
+                reinterpret_cast<const unsigned char*>(std::addressof(object)));
+        }
+    };
+
+    ComponentReflection() = default;
+
+    /**
+     * @brief Reflect T under @p name.
+     *
+     * Reflecting T again under the same name discards its recorded fields so
+     * they can be declared afresh.
+     *
+     * @throws std::invalid_argument if @p name is bound to another type or T
+     *         is already reflected under another name.
+     */
+    template <typename T>
+    Builder<T> reflect(std::string name)
+    {
+        const TypeId tid = typeId<T>();
+        const std::size_t* byName = mByName.find(name);
+        const std::size_t* byType = mByType.find(tid);
+        if (byName != nullptr || byType != nullptr)
+        {
+            if (byName == nullptr || byType == nullptr || *byName != *byType)
+            {
+                throw std::invalid_argument("ComponentReflection: name '" + name +
+                                            "' or its type is already reflected differently");
+            }
+            ComponentInfo& existing = *mInfos[*byName];
+            existing.fields.clear();
+            return Builder<T>(existing);
+        }
+
+        auto info = std::make_unique<ComponentInfo>();
+        info->name = name;
+        info->type = tid;
+        info->size = sizeof(T);
+        info->alignment = alignof(T);
+        info->triviallyCopyable = std::is_trivially_copyable_v<T>;
+
+        const std::size_t index = mInfos.size();
+        mInfos.push_back(std::move(info));
+        mByName.insert(std::move(name), index);
+        mByType.insert(tid, index);
+        return Builder<T>(*mInfos.back());
+    }
+
+    /// @brief Info for a reflected name, or nullptr.
+    [[nodiscard]] const ComponentInfo* find(std::string_view name) const
+    {
+        const std::size_t* index = mByName.find(std::string(name));
+        return index != nullptr ? mInfos[*index].get() : nullptr;
+    }
+
+    /// @brief Info for a reflected TypeId, or nullptr.
+    [[nodiscard]] const ComponentInfo* find(TypeId tid) const
+    {
+        const std::size_t* index = mByType.find(tid);
+        return index != nullptr ? mInfos[*index].get() : nullptr;
+    }
+
+    /// @brief Number of reflected types.
+    [[nodiscard]] std::size_t size() const noexcept { return mInfos.size(); }
+
+    /// @brief Call func(const ComponentInfo&) for every type, in reflection order.
+    template <typename Func>
+    void each(Func&& func) const
+    {
+        for (const auto& info : mInfos)
+        {
+            func(*info);
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<ComponentInfo>> mInfos;
+    fat_p::FastHashMap<std::string, std::size_t> mByName;
+    fat_p::FastHashMap<TypeId, std::size_t> mByType;
+};
+
+} // namespace fatp_ecs
@@ -31,13 +31,16 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <fat_p/SparseSet.h>
 
 #include "Entity.h"
+#include "EntityMap.h"
 #include "EventBus.h"
 #include "StoragePolicy.h"
 
@@ -64,8 +67,34 @@ public:
     [[nodiscard]] virtual const Entity* denseEntities() const noexcept = 0;
     [[nodiscard]] virtual std::size_t denseEntityCount() const noexcept = 0;
 
+    // Sparse array (entity index -> dense index) for type-erased membership
+    // probes that must not pay a virtual has() per entity (CompiledQuery).
+    [[nodiscard]] virtual const uint32_t* sparseIndices() const noexcept = 0;
+    [[nodiscard]] virtual std::size_t sparseIndexCount() const noexcept = 0;
+
+    // Untyped component access for reflection-driven code (scripts, export).
+    // rawComponents() is the dense component array, parallel to
+    // denseEntities(); rawComponent() is nullptr if entity lacks the component.
+    // componentSize() is sizeof the component, the stride of rawComponents().
+    [[nodiscard]] virtual std::size_t componentSize() const noexcept = 0;
+    [[nodiscard]] virtual void* rawComponents() noexcept = 0;
+    [[nodiscard]] virtual const void* rawComponents() const noexcept = 0;
+    [[nodiscard]] virtual void* rawComponent(Entity entity) noexcept = 0;
+
     virtual bool copyTo(Entity src, Entity dst, EventBus& events) = 0;
 
+    // Cross-registry bulk move (migrate() / merge()).
+    //
+    // createEmpty() returns a new, empty store of the same concrete type (same
+    // T and storage policy). moveTo() moves the components of from[0, count)
+    // into target, a store for the same T, erasing them here. Each entity e
+    // lands on map.translate(e). from == nullptr moves every component in the
+    // store. Returns the number of components moved.
+    [[nodiscard]] virtual std::unique_ptr<IComponentStore> createEmpty() const = 0;
+    virtual std::size_t moveTo(IComponentStore& target, const Entity* from, std::size_t count,
+                               const EntityMap& map, EventBus& sourceEvents,
+                               EventBus& targetEvents) = 0;
+
     IComponentStore() = default;
     IComponentStore(const IComponentStore&) = delete;
     IComponentStore& operator=(const IComponentStore&) = delete;
@@ -123,6 +152,10 @@ public:
     [[nodiscard]] virtual std::size_t getDenseIndexTyped(Entity entity) const noexcept = 0;
     virtual void swapDenseEntriesTyped(std::size_t i, std::size_t j) noexcept = 0;
 
+    // Sort support: move old dense index order[i] to i, for i in [0, size()).
+    // Consumes order (left as the identity).
+    virtual void permuteTyped(std::uint32_t* order) = 0;
+
     // Storage policy metadata
     [[nodiscard]] virtual std::size_t dataAlignmentTyped() const noexcept = 0;
 
@@ -154,6 +187,7 @@ public:
 
     [[nodiscard]] std::size_t getDenseIndex(Entity e) const noexcept { return getDenseIndexTyped(e); }
     void swapDenseEntries(std::size_t i, std::size_t j) noexcept { swapDenseEntriesTyped(i, j); }
+    void permute(std::uint32_t* order) { permuteTyped(order); }
 
     // Aliases for the typed CRUD (same names as ComponentStore<T,P> non-virtual methods)
     T* tryGet(Entity e) noexcept        { return tryGetComponent(e); }
@@ -229,6 +263,12 @@ public:
 
     [[nodiscard]] const Entity* denseEntities() const noexcept override { return mStorage.dense().data(); }
     [[nodiscard]] std::size_t denseEntityCount() const noexcept override { return mStorage.size(); }
+    [[nodiscard]] const uint32_t* sparseIndices() const noexcept override { return mStorage.sparse().data(); }
+    [[nodiscard]] std::size_t sparseIndexCount() const noexcept override { return mStorage.sparse().size(); }
+    [[nodiscard]] std::size_t componentSize() const noexcept override { return sizeof(T); }
+    [[nodiscard]] void* rawComponents() noexcept override { return componentDataPtr(); }
+    [[nodiscard]] const void* rawComponents() const noexcept override { return componentDataPtr(); }
+    [[nodiscard]] void* rawComponent(Entity entity) noexcept override { return mStorage.tryGet(entity); }
 
     bool copyTo(Entity src, Entity dst, EventBus& events) override
     {
@@ -252,6 +292,78 @@ public:
         }
     }
 
+    [[nodiscard]] std::unique_ptr<IComponentStore> createEmpty() const override
+    {
+        return std::make_unique<ComponentStore>();
+    }
+
+    std::size_t moveTo(IComponentStore& target, const Entity* from, std::size_t count,
+                       const EntityMap& map, EventBus& sourceEvents,
+                       EventBus& targetEvents) override
+    {
+        // Same concrete store (the usual case): place straight into its
+        // sparse set, no virtual call per entity. For trivially copyable T
+        // each placement is a plain sizeof(T) copy. A target using another
+        // storage policy for T goes through the typed virtual interface.
+        auto* same = dynamic_cast<ComponentStore*>(&target);
+        auto& typed = static_cast<TypedIComponentStore<T>&>(target);
+        auto place = [&](Entity entity, T&& value) -> T*
+        {
+            return same != nullptr ? same->mStorage.tryEmplace(entity, std::move(value))
+                                   : typed.addComponent(entity, std::move(value));
+        };
+
+        std::size_t moved = 0;
+        if (from == nullptr && !sourceEvents.hasRemovedListeners<T>())
+        {
+            // Whole store, nobody watching removals: walk the dense arrays in
+            // order and drop everything at the end instead of n swap-and-pop
+            // erases.
+            const std::size_t n = mStorage.size();
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const Entity to = map.translate(mStorage.dense()[i]);
+                T* placed = place(to, std::move(mStorage.dataAtUnchecked(i)));
+                if (placed != nullptr)
+                {
+                    targetEvents.emitComponentAdded<T>(to, *placed);
+                    ++moved;
+                }
+            }
+            mStorage.clear();
+            return moved;
+        }
+
+        // Removal listeners (owning groups, observers) may reorder the dense
+        // array, so the whole-store case walks a copy of it.
+        std::vector<Entity> all;
+        if (from == nullptr)
+        {
+            all = mStorage.dense();
+            from = all.data();
+            count = all.size();
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!mStorage.contains(from[i]))
+            {
+                continue;
+            }
+            // As in removeAndNotify(): listeners run while the component is
+            // still here. Fetch it after, since a group may have moved it.
+            sourceEvents.emitComponentRemoved<T>(from[i]);
+            const Entity to = map.translate(from[i]);
+            T* placed = place(to, std::move(*mStorage.tryGet(from[i])));
+            mStorage.erase(from[i]);
+            if (placed != nullptr)
+            {
+                targetEvents.emitComponentAdded<T>(to, *placed);
+                ++moved;
+            }
+        }
+        return moved;
+    }
+
     // =========================================================================
     // TypedIComponentStore<T> — T-typed virtual interface
     // =========================================================================
@@ -318,6 +430,11 @@ public:
         swapDenseEntries(i, j);
     }
 
+    void permuteTyped(std::uint32_t* order) override
+    {
+        permute(order);
+    }
+
     [[nodiscard]] std::size_t dataAlignmentTyped() const noexcept override
     {
         return dataAlignment();
@@ -384,6 +501,32 @@ public:
         mStorage.swapDenseEntries(i, j);
     }
 
+    /**
+     * @brief Reorder the store so the entry at old dense index order[i] ends
+     *        up at index i. order must be a permutation of [0, size()).
+     *
+     * Walks the permutation's cycles in place with swapDenseEntries(), which
+     * moves the dense entity, the component and the two sparse entries
+     * together; fixed points are never touched. order doubles as the
+     * visited marks, so nothing is allocated: on return order[i] == i.
+     */
+    void permute(std::uint32_t* order)
+    {
+        const std::size_t n = mStorage.size();
+        for (std::size_t start = 0; start < n; ++start)
+        {
+            std::size_t current = start;
+            while (order[current] != start)
+            {
+                const std::size_t next = order[current];
+                mStorage.swapDenseEntries(current, next);
+                order[current] = static_cast<std::uint32_t>(current);
+                current = next;
+            }
+            order[current] = static_cast<std::uint32_t>(current);
+        }
+    }
+
     static constexpr std::size_t dataAlignment() noexcept
     {
         if constexpr (requires { ContainerType::alignment; })
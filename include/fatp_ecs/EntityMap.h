@@ -0,0 +1,152 @@
+#pragma once
+
+/**
+ * @file EntityMap.h
+ * @brief Old-to-new entity translation for snapshot restore and registry
+ *        migration.
+ */
+
+// Overview:
+//
+// Whenever entities are recreated in another registry (RegistrySnapshotLoader,
+// migrate(), merge()) their handles change, and component fields holding
+// Entity references must be translated. EntityMap records old -> new.
+//
+// The mapped (old) entities were all alive at the same time in one
+// registry, so each occupies a distinct slot index. The map is therefore a
+// flat table indexed by the old slot index, storing the full old handle to
+// reject stale generations: translate() is one bounds check, one load, and
+// one compare, with no hashing.
+//
+// Old handles may come from an untrusted snapshot buffer, so the flat table
+// never grows past a small multiple of the number of entries. An index
+// beyond that bound (a sparse source registry, or a corrupt snapshot naming
+// slot 0xFFFFFFF0) goes to an overflow hash map instead, keeping memory
+// proportional to the entry count.
+//
+// FAT-P components used:
+//   - FastHashMap: overflow entries for slot indices beyond the flat table
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <fat_p/FastHashMap.h>
+
+#include "Entity.h"
+
+namespace fatp_ecs
+{
+
+/**
+ * @brief Maps old entity handles (snapshot or migration source) to freshly
+ *        created (new) handles.
+ *
+ * Passed by const-ref to every deserializeComponent<T>() callback so the user
+ * can remap cross-entity component fields. migrate() / merge() (Migration.h)
+ * return one for the same purpose.
+ *
+ * @example
+ * @code
+ *   loader.deserializeComponent<Parent>(dec,
+ *       [](fat_p::binary::Decoder& d, const EntityMap& remap) -> Parent {
+ *           Entity old = Entity(d.readRaw<uint64_t>());
+ *           return Parent{ remap.translate(old) };
+ *       });
+ * @endcode
+ *
+ * @note Thread-safety: NOT thread-safe.
+ */
+class EntityMap
+{
+public:
+    /// @brief Returns the new entity corresponding to oldEntity, or NullEntity
+    ///        if oldEntity was not part of the snapshot / migration.
+    /// @note Complexity: O(1); no hashing unless overflow entries exist.
+    [[nodiscard]] Entity translate(Entity oldEntity) const noexcept
+    {
+        const std::size_t slot = EntityTraits::index(oldEntity);
+        if (slot < mSlots.size() && mSlots[slot].oldEntity == oldEntity)
+        {
+            return mSlots[slot].newEntity;
+        }
+        if (!mOverflow.empty())
+        {
+            const Slot* entry = mOverflow.find(static_cast<uint64_t>(slot));
+            if (entry != nullptr && entry->oldEntity == oldEntity)
+            {
+                return entry->newEntity;
+            }
+        }
+        return NullEntity;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return mSize;
+    }
+
+    // Internal: called by RegistrySnapshotLoader and migrate(). A second
+    // entity with the same slot index replaces the first.
+    void insert(Entity oldEntity, Entity newEntity)
+    {
+        if (oldEntity == NullEntity)
+        {
+            return;
+        }
+        const std::size_t slot = EntityTraits::index(oldEntity);
+        const std::size_t limit = flatLimit();
+        if (slot >= mSlots.size() && slot < limit)
+        {
+            mSlots.resize(std::min(std::max(slot + 1, mSlots.size() * 2), limit));
+        }
+
+        if (slot < mSlots.size())
+        {
+            // An earlier entry for this slot may have overflowed before the
+            // table grew over it.
+            if (!mOverflow.empty() && mOverflow.erase(static_cast<uint64_t>(slot)))
+            {
+                --mSize;
+            }
+            if (mSlots[slot].oldEntity == NullEntity)
+            {
+                ++mSize;
+            }
+            mSlots[slot] = {oldEntity, newEntity};
+            return;
+        }
+
+        Slot* entry = mOverflow.find(static_cast<uint64_t>(slot));
+        if (entry != nullptr)
+        {
+            *entry = {oldEntity, newEntity};
+            return;
+        }
+        mOverflow.insert(static_cast<uint64_t>(slot), Slot{oldEntity, newEntity});
+        ++mSize;
+    }
+
+private:
+    struct Slot
+    {
+        Entity oldEntity = NullEntity;
+        Entity newEntity = NullEntity;
+    };
+
+    /// Flat slots always allowed, however few entries there are.
+    static constexpr std::size_t kMinFlatSlots = 4096;
+
+    /// Largest flat table size for the current entry count.
+    [[nodiscard]] std::size_t flatLimit() const noexcept
+    {
+        return std::max(kMinFlatSlots, 4 * (mSize + 1));
+    }
+
+    std::vector<Slot> mSlots;
+    fat_p::FastHashMap<uint64_t, Slot> mOverflow;
+    std::size_t mSize = 0;
+};
+
+} // namespace fatp_ecs
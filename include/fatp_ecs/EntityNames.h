@@ -2,25 +2,32 @@
 
 /**
  * @file EntityNames.h
- * @brief Named entity registry backed by StringPool and FlatMap.
+ * @brief Named entity registry backed by StringPool and FastHashMap.
  */
 
 // FAT-P components used:
 // - StringPool: Intern entity names for pointer-comparison equality
-// - FlatMap: Sorted name-to-entity mapping for debug/editor lookups
-// - FastHashMap: Entity-to-name reverse mapping for O(1) lookup by entity
+// - FastHashMap: Interned-name-to-entity and entity-to-name mappings
 //
 // EntityNames provides bidirectional name<->entity mapping. Names are interned
-// via StringPool so comparison is pointer equality (O(1) vs O(n) strcmp).
-// The FlatMap provides sorted iteration for debug UIs. FastHashMap provides
-// O(1) reverse lookup from entity to name.
+// via StringPool, so an interned pointer identifies a name: both maps are keyed
+// by pointer or entity and every lookup is an O(1) hash probe with no string
+// construction or comparison. findByName(string_view) costs one pool probe to
+// reach the interned pointer; callers that resolve the same names every frame
+// (scripting) can keep the pointer from setName()/intern() and use
+// findByInterned() to skip even that.
+//
+// Sorted-by-name iteration for debug/editor UIs comes from each(), which
+// builds a sorted index lazily on first use after a change. Nothing on the
+// lookup or rename path maintains ordering.
 
+#include <algorithm>
 #include <cstddef>
-#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <fat_p/FastHashMap.h>
-#include <fat_p/FlatMap.h>
 #include <fat_p/StringPool.h>
 
 #include "Entity.h"
@@ -31,7 +38,8 @@ namespace fatp_ecs
 /**
  * @brief Bidirectional name<->entity mapping with interned strings.
  *
- * @note Thread-safety: NOT thread-safe.
+ * @note Thread-safety: NOT thread-safe. each() mutates the lazy sorted index
+ *       even though it is const.
  */
 class EntityNames
 {
@@ -41,34 +49,49 @@ public:
     /**
      * @brief Assign a name to an entity.
      *
+     * Renaming replaces the entity's previous name.
+     *
      * @param entity The entity to name.
      * @param name   The name string (interned automatically).
      * @return The interned name pointer, or nullptr if the name is already taken.
+     *
+     * @note Complexity: O(1) expected, plus interning a name not seen before.
      */
     const char* setName(Entity entity, std::string_view name)
     {
         const char* interned = mPool.intern(name);
-        std::string key(interned);
 
         // Check if name is already assigned to a different entity
-        auto existingIt = mNameToEntity.find(key);
-        if (existingIt != mNameToEntity.end() && existingIt->second != entity)
+        auto* existing = mNameToEntity.find(interned);
+        if (existing != nullptr)
         {
-            return nullptr;
+            return *existing == entity ? interned : nullptr;
         }
 
         // Remove any previous name for this entity
         auto* oldName = mEntityToName.find(entity);
         if (oldName != nullptr)
         {
-            mNameToEntity.erase(std::string(*oldName));
+            mNameToEntity.erase(*oldName);
         }
 
-        mNameToEntity.insert_or_assign(key, entity);
+        mNameToEntity.insert_or_assign(interned, entity);
         mEntityToName.insert_or_assign(entity, interned);
+        mSortedDirty = true;
         return interned;
     }
 
+    /**
+     * @brief Intern @p name without assigning it, for use with findByInterned().
+     *
+     * The pointer stays valid for the lifetime of this EntityNames (clear()
+     * keeps the pool).
+     */
+    const char* intern(std::string_view name)
+    {
+        return mPool.intern(name);
+    }
+
     /// @brief Find an entity by name.
     [[nodiscard]] Entity findByName(std::string_view name) const
     {
@@ -77,13 +100,19 @@ public:
         {
             return NullEntity;
         }
-        std::string key(interned);
-        auto it = mNameToEntity.find(key);
-        if (it == mNameToEntity.end())
-        {
-            return NullEntity;
-        }
-        return it->second;
+        return findByInterned(interned);
+    }
+
+    /**
+     * @brief Find an entity by a pointer previously returned from setName(),
+     *        intern() or getName().
+     *
+     * @note Complexity: O(1) expected; a single pointer-keyed hash probe.
+     */
+    [[nodiscard]] Entity findByInterned(const char* interned) const
+    {
+        auto* entity = mNameToEntity.find(interned);
+        return entity != nullptr ? *entity : NullEntity;
     }
 
     /// @brief Get the name of an entity, or nullptr if unnamed.
@@ -105,11 +134,34 @@ public:
         {
             return false;
         }
-        mNameToEntity.erase(std::string(*name));
+        mNameToEntity.erase(*name);
         mEntityToName.erase(entity);
+        mSortedDirty = true;
         return true;
     }
 
+    /**
+     * @brief Visit every named entity in ascending name order.
+     *
+     * @p func is called as func(const char* name, Entity). The sorted index is
+     * rebuilt only when names changed since the last call, so repeated editor
+     * refreshes are O(n). Do not rename from inside @p func.
+     *
+     * @note Complexity: O(n log n) after a change, O(n) otherwise.
+     */
+    template <typename Func>
+    void each(Func&& func) const
+    {
+        if (mSortedDirty)
+        {
+            rebuildSorted();
+        }
+        for (const auto& [name, entity] : mSorted)
+        {
+            func(name, entity);
+        }
+    }
+
     /// @brief Number of named entities.
     [[nodiscard]] std::size_t size() const noexcept
     {
@@ -121,12 +173,34 @@ public:
     {
         mNameToEntity.clear();
         mEntityToName.clear();
+        mSorted.clear();
+        mSortedDirty = false;
     }
 
 private:
+    void rebuildSorted() const
+    {
+        mSorted.clear();
+        mSorted.reserve(mNameToEntity.size());
+        for (auto it = mNameToEntity.begin(); it != mNameToEntity.end(); ++it)
+        {
+            mSorted.emplace_back(it.key(), it.value());
+        }
+        std::sort(mSorted.begin(), mSorted.end(),
+                  [](const auto& a, const auto& b)
+                  {
+                      return std::string_view(a.first) < std::string_view(b.first);
+                  });
+        mSortedDirty = false;
+    }
+
     fat_p::StringPool<> mPool;
-    fat_p::FlatMap<std::string, Entity> mNameToEntity;
+    fat_p::FastHashMap<const char*, Entity> mNameToEntity;
     fat_p::FastHashMap<Entity, const char*> mEntityToName;
+
+    // Editor-only ordering, built on demand by each().
+    mutable std::vector<std::pair<const char*, Entity>> mSorted;
+    mutable bool mSortedDirty = false;
 };
 
 } // namespace fatp_ecs
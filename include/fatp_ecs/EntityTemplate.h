@@ -10,8 +10,17 @@
 // - FastHashMap: Template registry keyed by name
 //
 // EntityTemplate stores a parsed JSON object describing an entity archetype.
-// A ComponentFactory callback system lets users register per-component-type
-// deserializers that read from JsonValue and call registry.add<T>().
+// Per-component-type handlers are registered by JSON key name, either as a
+// typed parser (JsonValue -> T) or as a legacy ComponentFactory callback that
+// calls registry.add<T>() itself.
+//
+// Templates are compiled once, when added (and again when a handler is
+// registered later): each JSON component becomes an IPrototypeComponent.
+// Typed parsers produce a PrototypeComponent<T> holding a pre-constructed T,
+// so spawning is a bulk create() plus one Registry::insert<T>() per
+// component type — no JSON access or map lookup on the hot path. Legacy
+// factories cannot be pre-evaluated (they may have side effects) and still
+// run per entity from a stored copy of their JSON value.
 //
 // JSON format:
 // {
@@ -21,10 +30,15 @@
 //   }
 // }
 
+#include <cstddef>
 #include <functional>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <fat_p/FastHashMap.h>
 #include <fat_p/JsonLite.h>
@@ -44,6 +58,70 @@ class Registry;
 // entity. Users register one per component type name.
 using ComponentFactory = std::function<void(Registry&, Entity, const fat_p::JsonValue&)>;
 
+// =============================================================================
+// Prototype Components
+// =============================================================================
+
+/**
+ * @brief One compiled component of a template, able to stamp itself onto a
+ *        batch of freshly created entities.
+ */
+class IPrototypeComponent
+{
+public:
+    IPrototypeComponent() = default;
+    virtual ~IPrototypeComponent() = default;
+
+    IPrototypeComponent(const IPrototypeComponent&) = delete;
+    IPrototypeComponent& operator=(const IPrototypeComponent&) = delete;
+
+    /// @brief Add this component to entities[0, count).
+    virtual void insert(Registry& registry, const Entity* entities, std::size_t count) const = 0;
+};
+
+/// @brief A pre-constructed component value, copied into every spawned entity.
+template <typename T>
+class PrototypeComponent final : public IPrototypeComponent
+{
+public:
+    explicit PrototypeComponent(T value) : mValue(std::move(value)) {}
+
+    void insert(Registry& registry, const Entity* entities, std::size_t count) const override;
+
+    [[nodiscard]] const T& value() const noexcept { return mValue; }
+
+private:
+    T mValue;
+};
+
+/// @brief Legacy path: runs a ComponentFactory per entity on a stored JSON value.
+class FactoryPrototypeComponent final : public IPrototypeComponent
+{
+public:
+    FactoryPrototypeComponent(ComponentFactory factory, fat_p::JsonValue data)
+        : mFactory(std::move(factory))
+        , mData(std::move(data))
+    {
+    }
+
+    void insert(Registry& registry, const Entity* entities, std::size_t count) const override
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            mFactory(registry, entities[i], mData);
+        }
+    }
+
+private:
+    ComponentFactory mFactory;
+    fat_p::JsonValue mData;
+};
+
+// Turns one component's JSON value into its prototype. Runs at template
+// compile time, never during spawn.
+using ComponentCompiler =
+    std::function<std::shared_ptr<const IPrototypeComponent>(const fat_p::JsonValue&)>;
+
 // =============================================================================
 // EntityTemplate
 // =============================================================================
@@ -53,6 +131,10 @@ struct EntityTemplate
 {
     std::string name;
     fat_p::JsonObject components;
+
+    /// Compiled components, in JSON key order. Components with no registered
+    /// handler are skipped.
+    std::vector<std::shared_ptr<const IPrototypeComponent>> prototype;
 };
 
 // =============================================================================
@@ -76,12 +158,48 @@ public:
     /**
      * @brief Register a factory for a named component type.
      *
+     * The factory runs once per spawned entity. Prefer the typed overload
+     * below, which parses once and bulk-copies the result.
+     *
      * @param componentName The JSON key for this component (e.g., "Position").
      * @param factory       Callback that adds the component to an entity.
      */
     void registerComponent(std::string componentName, ComponentFactory factory)
     {
-        mFactories.insert_or_assign(std::move(componentName), std::move(factory));
+        setCompiler(std::move(componentName),
+                    [factory = std::move(factory)](const fat_p::JsonValue& data)
+                        -> std::shared_ptr<const IPrototypeComponent>
+                    {
+                        return std::make_shared<FactoryPrototypeComponent>(factory, data);
+                    });
+    }
+
+    /**
+     * @brief Register a typed parser for a named component type.
+     *
+     * @p parse turns the template's JSON value into a T once, when the
+     * template is compiled; spawn() then copies that value into each entity.
+     * Exceptions thrown by @p parse propagate from addTemplate() (or from
+     * this call, when it recompiles existing templates).
+     *
+     * @example
+     * @code
+     *   templates.registerComponent<Health>("Health",
+     *       [](const fat_p::JsonValue& v) { return Health{...}; });
+     * @endcode
+     */
+    template <typename T, typename Parse>
+        requires std::is_invocable_r_v<T, Parse&, const fat_p::JsonValue&>
+    void registerComponent(std::string componentName, Parse parse)
+    {
+        static_assert(std::is_copy_constructible_v<T>,
+                      "template components are copied into every spawned entity");
+        setCompiler(std::move(componentName),
+                    [parse = std::move(parse)](const fat_p::JsonValue& data) mutable
+                        -> std::shared_ptr<const IPrototypeComponent>
+                    {
+                        return std::make_shared<PrototypeComponent<T>>(parse(data));
+                    });
     }
 
     // =========================================================================
@@ -113,6 +231,7 @@ public:
         EntityTemplate tmpl;
         tmpl.name = name;
         tmpl.components = std::get<fat_p::JsonObject>(compIt->second);
+        compile(tmpl);
 
         mTemplates.insert_or_assign(std::move(name), std::move(tmpl));
         return true;
@@ -127,6 +246,23 @@ public:
      */
     Entity spawn(Registry& registry, const std::string& templateName) const;
 
+    /**
+     * @brief Spawn @p count entities from a named template.
+     *
+     * Creates all entities first, then inserts each prototype component into
+     * the whole batch. onComponentAdded therefore fires grouped by component
+     * type (all Positions, then all Healths, ...) rather than entity by
+     * entity as with repeated single spawn() calls.
+     *
+     * @param out Receives the created entities; must have room for @p count.
+     * @return Number of entities created: @p count, or 0 if the template is
+     *         not found.
+     *
+     * @note Complexity: O(count * components).
+     */
+    std::size_t spawn(Registry& registry, const std::string& templateName,
+                      std::size_t count, Entity* out) const;
+
     /// @brief Check if a template exists.
     [[nodiscard]] bool hasTemplate(const std::string& name) const
     {
@@ -142,12 +278,39 @@ public:
     /// @brief Number of registered component factories.
     [[nodiscard]] std::size_t factoryCount() const noexcept
     {
-        return mFactories.size();
+        return mCompilers.size();
     }
 
 private:
+    void setCompiler(std::string componentName, ComponentCompiler compiler)
+    {
+        mCompilers.insert_or_assign(std::move(componentName), std::move(compiler));
+
+        // Templates added before this handler must pick it up.
+        for (auto it = mTemplates.begin(); it != mTemplates.end(); ++it)
+        {
+            compile(it.value());
+        }
+    }
+
+    void compile(EntityTemplate& tmpl)
+    {
+        // Build aside so a throwing parser leaves the old prototype intact.
+        std::vector<std::shared_ptr<const IPrototypeComponent>> prototype;
+        prototype.reserve(tmpl.components.size());
+        for (const auto& [compName, compData] : tmpl.components)
+        {
+            auto* compiler = mCompilers.find(compName);
+            if (compiler != nullptr)
+            {
+                prototype.push_back((*compiler)(compData));
+            }
+        }
+        tmpl.prototype = std::move(prototype);
+    }
+
     fat_p::FastHashMap<std::string, EntityTemplate> mTemplates;
-    fat_p::FastHashMap<std::string, ComponentFactory> mFactories;
+    fat_p::FastHashMap<std::string, ComponentCompiler> mCompilers;
 };
 
 } // namespace fatp_ecs
@@ -15,27 +15,38 @@
 namespace fatp_ecs
 {
 
+template <typename T>
+void PrototypeComponent<T>::insert(Registry& registry, const Entity* entities,
+                                   std::size_t count) const
+{
+    registry.insert<T>(entities, entities + count, mValue);
+}
+
 inline Entity TemplateRegistry::spawn(Registry& registry,
                                       const std::string& templateName) const
+{
+    Entity entity = NullEntity;
+    spawn(registry, templateName, 1, &entity);
+    return entity;
+}
+
+inline std::size_t TemplateRegistry::spawn(Registry& registry, const std::string& templateName,
+                                           std::size_t count, Entity* out) const
 {
     auto* tmpl = mTemplates.find(templateName);
     if (tmpl == nullptr)
     {
-        return NullEntity;
+        return 0;
     }
 
-    Entity entity = registry.create();
+    registry.create(out, out + count);
 
-    for (const auto& [compName, compData] : tmpl->components)
+    for (const auto& component : tmpl->prototype)
     {
-        auto* factory = mFactories.find(compName);
-        if (factory != nullptr)
-        {
-            (*factory)(registry, entity, compData);
-        }
+        component->insert(registry, out, count);
     }
 
-    return entity;
+    return count;
 }
 
 } // namespace fatp_ecs
@@ -158,6 +158,14 @@ public:
         }
     }
 
+    /// @brief True if onComponentRemoved<T> has at least one listener.
+    template <typename T>
+    [[nodiscard]] bool hasRemovedListeners()
+    {
+        auto* pair = getSignalPair<T>();
+        return pair != nullptr && pair->onRemoved.slotCount() > 0;
+    }
+
     /// @brief Emit component-updated event if listeners exist for type T.
     template <typename T>
     void emitComponentUpdated(Entity entity, T& component)
@@ -14,6 +14,7 @@
 #include "Observer.h"
 #include "NonOwningGroup.h"
 #include "OwningGroup.h"
+#include "SlotRecycling.h"
 #include "Registry.h"
 #include "RuntimeView.h"
 #include "View.h"
@@ -27,6 +28,7 @@
 
 // Gameplay infrastructure (Phase 3)
 #include "FrameAllocator.h"
+#include "FrameArena.h"
 #include "EntityNames.h"
 #include "EntityTemplate.h"
 #include "EntityTemplate_Impl.h"
@@ -42,6 +44,21 @@
 
 // Process scheduler (Phase 4)
 #include "ProcessScheduler.h"
+
+// Spatial queries
+#include "SpatialHash.h"
+
+// Scene hierarchy
+#include "Hierarchy.h"
+
+// Cross-registry migration
+#include "Migration.h"
+
+// Archetype (table) storage mode
+#include "ArchetypeRegistry.h"
+
+// Sharded registry for concurrent structural changes
+#include "ShardedRegistry.h"
 // Note: Snapshot_Impl.h is included at the bottom of Snapshot.h, which is the
 // correct include point — Registry is fully defined by the time Snapshot.h is
 // reached here, so Snapshot_Impl.h can define the out-of-line methods.
@@ -0,0 +1,354 @@
+#pragma once
+
+/**
+ * @file FrameArena.h
+ * @brief Type-agnostic linear (bump) allocator for per-frame scratch memory.
+ */
+
+// FrameArena complements FrameAllocator<T>. FrameAllocator is one ObjectPool
+// per type and records every acquired pointer so releaseAll() can hand them
+// back one by one — O(n) per frame, one allocator per temporary type, and no
+// way to allocate variable-length scratch.
+//
+// FrameArena hands out memory from a list of large blocks by bumping an
+// offset. Any type, any alignment, any array length can share one arena.
+// reset() rewinds the offset to the start of the first block; the blocks
+// themselves are retained, so after the first few frames the arena reaches a
+// steady state with zero heap traffic.
+//
+// Destructors: trivially destructible objects cost nothing at reset(). For
+// types with a non-trivial destructor, make<T>() / make_array<T>() place a
+// small DestructorNode in the arena itself and push it onto an intrusive
+// list. reset() walks that list (newest first), so the reset cost is
+// O(number of non-trivial objects), and O(1) when there are none.
+//
+// Block growth: when the current block cannot satisfy a request, the arena
+// moves to the next retained block, or allocates a new one of
+// max(blockSize, size + align). Oversized requests therefore only fail when
+// the system is out of memory (or size + align does not fit in size_t, which
+// throws std::bad_alloc up front); they simply get a dedicated block that is
+// reused on subsequent frames.
+//
+// FAT-P components used:
+//   (none — self-contained; only standard library types)
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fatp_ecs
+{
+
+/**
+ * @brief Linear bump allocator with O(1) bulk reset.
+ *
+ * @note Thread-safety: NOT thread-safe. Use one arena per thread
+ *       (see Scheduler for per-worker arenas).
+ *
+ * @example
+ * @code
+ *   FrameArena arena;
+ *
+ *   // During the frame:
+ *   auto* pair  = arena.make<CollisionPair>(a, b, dist);
+ *   auto* hits  = arena.make_array<Entity>(count);
+ *   void* bytes = arena.allocate(256, 64);
+ *
+ *   // At frame end:
+ *   arena.reset();
+ * @endcode
+ */
+class FrameArena
+{
+public:
+    /// @brief Default size of each arena block in bytes.
+    static constexpr std::size_t kDefaultBlockSize = 64 * 1024;
+
+    /**
+     * @brief Construct an arena. No memory is allocated until first use.
+     *
+     * @param blockSize Size in bytes of each block the arena allocates.
+     */
+    explicit FrameArena(std::size_t blockSize = kDefaultBlockSize)
+        : mBlockSize(blockSize == 0 ? kDefaultBlockSize : blockSize)
+    {
+    }
+
+    ~FrameArena()
+    {
+        runDestructors();
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) = delete;
+    FrameArena& operator=(FrameArena&&) = delete;
+
+    // =========================================================================
+    // Allocation
+    // =========================================================================
+
+    /**
+     * @brief Allocate raw, uninitialized memory from the arena.
+     *
+     * @param size  Number of bytes.
+     * @param align Required alignment (power of two).
+     * @return Pointer to at least @p size bytes aligned to @p align.
+     *         Valid until the next reset().
+     * @throws std::bad_alloc if size + align overflows or a new block cannot
+     *         be allocated.
+     *
+     * @note Complexity: O(1) amortized.
+     */
+    [[nodiscard]] void* allocate(std::size_t size,
+                                 std::size_t align = alignof(std::max_align_t))
+    {
+        assert(align != 0 && (align & (align - 1)) == 0 &&
+               "FrameArena::allocate: alignment must be a power of two");
+
+        if (size == 0)
+        {
+            size = 1;
+        }
+        if (size > std::numeric_limits<std::size_t>::max() - align)
+        {
+            throw std::bad_alloc();
+        }
+
+        while (mCurrent < mBlocks.size())
+        {
+            void* p = tryBump(mBlocks[mCurrent], size, align);
+            if (p != nullptr)
+            {
+                return p;
+            }
+            // Current block exhausted — move to the next retained block.
+            ++mCurrent;
+            mOffset = 0;
+        }
+
+        mBlocks.push_back(makeBlock(std::max(mBlockSize, size + align)));
+        mCurrent = mBlocks.size() - 1;
+        mOffset = 0;
+
+        void* p = tryBump(mBlocks[mCurrent], size, align);
+        if (p == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    /**
+     * @brief Construct a T in arena memory.
+     *
+     * @tparam T    Object type.
+     * @tparam Args Constructor argument types.
+     * @param args  Arguments forwarded to T's constructor.
+     * @return Pointer to the constructed object. Valid until the next reset().
+     * @throws Anything T's constructor throws, or std::bad_alloc.
+     */
+    template <typename T, typename... Args>
+    [[nodiscard]] T* make(Args&&... args)
+    {
+        if constexpr (std::is_trivially_destructible_v<T>)
+        {
+            void* mem = allocate(sizeof(T), alignof(T));
+            return ::new (mem) T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            // The node is carved out before the object so that a throwing
+            // constructor never leaves a registered-but-unconstructed entry.
+            auto* node = static_cast<DestructorNode*>(
+                allocate(sizeof(DestructorNode), alignof(DestructorNode)));
+            void* mem = allocate(sizeof(T), alignof(T));
+            T* obj = ::new (mem) T(std::forward<Args>(args)...);
+            pushDestructor(node, obj, 1, &destroyRange<T>);
+            return obj;
+        }
+    }
+
+    /**
+     * @brief Allocate and value-initialize an array of @p count T objects.
+     *
+     * @tparam T Element type.
+     * @param count Number of elements (may be 0).
+     * @return Pointer to the first element. Valid until the next reset().
+     * @throws std::bad_array_new_length if count * sizeof(T) overflows.
+     * @throws Anything T's default constructor throws, or std::bad_alloc.
+     */
+    template <typename T>
+    [[nodiscard]] T* make_array(std::size_t count)
+    {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        if constexpr (std::is_trivially_destructible_v<T>)
+        {
+            void* mem = allocate(sizeof(T) * count, alignof(T));
+            T* first = static_cast<T*>(mem);
+            std::uninitialized_value_construct_n(first, count);
+            return first;
+        }
+        else
+        {
+            auto* node = static_cast<DestructorNode*>(
+                allocate(sizeof(DestructorNode), alignof(DestructorNode)));
+            void* mem = allocate(sizeof(T) * count, alignof(T));
+            T* first = static_cast<T*>(mem);
+            // Destroys already-constructed elements if one throws.
+            std::uninitialized_value_construct_n(first, count);
+            pushDestructor(node, first, count, &destroyRange<T>);
+            return first;
+        }
+    }
+
+    // =========================================================================
+    // Frame boundary
+    // =========================================================================
+
+    /**
+     * @brief Destroy tracked objects and rewind to the start of the first block.
+     *
+     * All pointers previously returned by this arena become invalid. Blocks
+     * are retained for reuse.
+     *
+     * @note Complexity: O(1) plus O(k) for k objects with non-trivial destructors.
+     */
+    void reset() noexcept
+    {
+        runDestructors();
+        mCurrent = 0;
+        mOffset = 0;
+        mBytesUsed = 0;
+    }
+
+    /// @brief Reset and free all blocks back to the heap.
+    void release() noexcept
+    {
+        reset();
+        mBlocks.clear();
+    }
+
+    // =========================================================================
+    // Queries
+    // =========================================================================
+
+    /// @brief Bytes handed out since the last reset (including alignment padding).
+    [[nodiscard]] std::size_t bytesUsed() const noexcept
+    {
+        return mBytesUsed;
+    }
+
+    /// @brief Total bytes owned across all blocks.
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        std::size_t total = 0;
+        for (const Block& b : mBlocks)
+        {
+            total += b.size;
+        }
+        return total;
+    }
+
+    /// @brief Number of blocks currently owned by the arena.
+    [[nodiscard]] std::size_t blockCount() const noexcept
+    {
+        return mBlocks.size();
+    }
+
+    /// @brief Size of newly allocated blocks in bytes.
+    [[nodiscard]] std::size_t blockSize() const noexcept
+    {
+        return mBlockSize;
+    }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    struct DestructorNode
+    {
+        void (*destroy)(void*, std::size_t) noexcept;
+        void* object;
+        std::size_t count;
+        DestructorNode* next;
+    };
+
+    template <typename T>
+    static void destroyRange(void* first, std::size_t count) noexcept
+    {
+        T* objects = static_cast<T*>(first);
+        // Reverse construction order, matching automatic storage semantics.
+        for (std::size_t i = count; i > 0; --i)
+        {
+            objects[i - 1].~T();
+        }
+    }
+
+    static Block makeBlock(std::size_t size)
+    {
+        return Block{std::unique_ptr<std::byte[]>(new std::byte[size]), size};
+    }
+
+    void* tryBump(Block& block, std::size_t size, std::size_t align) noexcept
+    {
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        const std::uintptr_t cursor = base + mOffset;
+        const std::uintptr_t aligned = (cursor + (align - 1)) & ~(std::uintptr_t{align} - 1);
+        const std::size_t padding = static_cast<std::size_t>(aligned - cursor);
+
+        if (padding > block.size - mOffset || size > block.size - mOffset - padding)
+        {
+            return nullptr;
+        }
+
+        mOffset += padding + size;
+        mBytesUsed += padding + size;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void pushDestructor(DestructorNode* node, void* object, std::size_t count,
+                        void (*destroy)(void*, std::size_t) noexcept) noexcept
+    {
+        node->destroy = destroy;
+        node->object = object;
+        node->count = count;
+        node->next = mDestructors;
+        mDestructors = node;
+    }
+
+    void runDestructors() noexcept
+    {
+        DestructorNode* node = mDestructors;
+        while (node != nullptr)
+        {
+            DestructorNode* next = node->next;
+            node->destroy(node->object, node->count);
+            node = next;
+        }
+        mDestructors = nullptr;
+    }
+
+    std::vector<Block> mBlocks;
+    std::size_t mBlockSize;
+    std::size_t mCurrent = 0;
+    std::size_t mOffset = 0;
+    std::size_t mBytesUsed = 0;
+    DestructorNode* mDestructors = nullptr;
+};
+
+} // namespace fatp_ecs
@@ -0,0 +1,626 @@
+#pragma once
+
+/**
+ * @file Hierarchy.h
+ * @brief Parent/child relationships laid out breadth-first for linear,
+ *        optionally parallel, transform propagation.
+ */
+
+// Overview:
+//
+// A user-level Parent{Entity} component makes every propagation step a
+// get<World>(parent) — a sparse lookup into a different part of the store
+// per node — and needs parents visited before children, which view order
+// does not give. Hierarchy keeps the relationship outside the component
+// stores, in two forms:
+//
+//   1. Link table, indexed by entity slot index: parent, first/last child,
+//      prev/next sibling. Re-parenting is O(1) relinking plus an O(depth)
+//      cycle check; forEachChild() walks the sibling list.
+//
+//   2. Flattened order: every node in breadth-first order, with the slot of
+//      its parent in a parallel array and per-depth [begin, end) offsets.
+//      Parents always precede children and siblings are contiguous, so
+//      propagate() is one forward walk reading the parent's result by slot
+//      index from the same pass. Nodes within one depth level are
+//      independent, which is what the parallel overload exploits.
+//
+// The flattened order is maintained lazily. Re-parenting a node to a parent
+// at the same depth as its old one (the common "move between siblings"
+// edit) patches its parent slot in place. Anything that changes depths —
+// inserting, removing, moving across levels — only marks the order stale;
+// the next propagate()/each() rebuilds it in O(n), however many edits were
+// made in between.
+//
+// sortStorage<T>() reorders T's dense array to the flattened order, after
+// which propagate() walks Local and World memory sequentially as well.
+//
+// Destroyed entities are removed automatically (onEntityDestroyed); their
+// children become roots. Registry::clear() fires no signals: call clear()
+// after it.
+//
+// FAT-P components used:
+//   - Signal / ScopedConnection: wiring to the registry's onEntityDestroyed
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <fat_p/Signal.h>
+
+#include "ComponentStore.h"
+#include "Entity.h"
+#include "Registry.h"
+#include "Scheduler.h"
+
+namespace fatp_ecs
+{
+
+/**
+ * @brief Scene-graph style parent/child relationships between entities.
+ *
+ * @example
+ * @code
+ *   Hierarchy scene(registry);
+ *   scene.setParent(wheel, car);
+ *   scene.setParent(car, NullEntity);   // make a root
+ *
+ *   scene.propagate<LocalTransform, WorldTransform>(
+ *       [](const WorldTransform* parent, const LocalTransform& local,
+ *          WorldTransform& world) {
+ *           world = parent ? compose(*parent, local) : toWorld(local);
+ *       });
+ * @endcode
+ *
+ * @note The hierarchy holds a connection to @p registry's signals and must
+ *       not outlive it. It is neither copyable nor movable.
+ * @note Thread-safety: NOT thread-safe. The parallel propagate() overload
+ *       runs the callback concurrently for nodes of one depth level; the
+ *       callback must only write the World it is given.
+ */
+class Hierarchy
+{
+public:
+    static constexpr uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+
+    explicit Hierarchy(Registry& registry)
+        : mRegistry(&registry)
+    {
+        mDestroyConn = registry.events().onEntityDestroyed.connect(
+            [this](Entity entity) { remove(entity); });
+    }
+
+    Hierarchy(const Hierarchy&) = delete;
+    Hierarchy& operator=(const Hierarchy&) = delete;
+    Hierarchy(Hierarchy&&) = delete;
+    Hierarchy& operator=(Hierarchy&&) = delete;
+
+    // =========================================================================
+    // Structure
+    // =========================================================================
+
+    /**
+     * @brief Make @p parent the parent of @p child, adding either to the
+     *        hierarchy if needed. NullEntity makes @p child a root.
+     *
+     * The child keeps its own subtree. A new child is appended after its
+     * existing siblings.
+     *
+     * @return false (and no change) if either entity is dead, if
+     *         @p child == @p parent, or if @p parent is a descendant of
+     *         @p child.
+     *
+     * @note Complexity: O(depth of @p parent).
+     */
+    bool setParent(Entity child, Entity parent)
+    {
+        if (!mRegistry->valid(child))
+        {
+            return false;
+        }
+        if (parent != NullEntity)
+        {
+            if (parent == child || !mRegistry->valid(parent))
+            {
+                return false;
+            }
+            for (Entity a = parent; a != NullEntity; a = parentOf(a))
+            {
+                if (a == child)
+                {
+                    return false;
+                }
+            }
+        }
+
+        // Parent first: ensure() may grow mNodes.
+        const bool parentAdded = parent != NullEntity && ensure(parent);
+        const bool childAdded = ensure(child);
+
+        Node& node = mNodes[EntityTraits::index(child)];
+        if (!childAdded && node.parent == parent)
+        {
+            return true;
+        }
+
+        bool inPlace = false;
+        if (!mOrderDirty && !childAdded && !parentAdded)
+        {
+            const uint32_t slot = mSlots[EntityTraits::index(child)];
+            const uint32_t parentSlot =
+                parent != NullEntity ? mSlots[EntityTraits::index(parent)] : kNoSlot;
+            const std::size_t newDepth = parent != NullEntity ? levelOf(parentSlot) + 1 : 0;
+            if (levelOf(slot) == newDepth)
+            {
+                mParentSlots[slot] = parentSlot;
+                inPlace = true;
+            }
+        }
+
+        unlink(child);
+        node.parent = parent;
+        link(child);
+        mOrderDirty = mOrderDirty || !inPlace;
+        return true;
+    }
+
+    /**
+     * @brief Remove @p entity from the hierarchy. Its children become roots,
+     *        keeping their own subtrees.
+     *
+     * Called automatically when the entity is destroyed.
+     *
+     * @return false if @p entity was not in the hierarchy.
+     *
+     * @note Complexity: O(children).
+     */
+    bool remove(Entity entity)
+    {
+        if (!contains(entity))
+        {
+            return false;
+        }
+        Entity child = mNodes[EntityTraits::index(entity)].firstChild;
+        while (child != NullEntity)
+        {
+            const Entity next = mNodes[EntityTraits::index(child)].nextSibling;
+            unlink(child);
+            mNodes[EntityTraits::index(child)].parent = NullEntity;
+            link(child);
+            child = next;
+        }
+        unlink(entity);
+        mNodes[EntityTraits::index(entity)] = Node{};
+        --mSize;
+        mOrderDirty = true;
+        return true;
+    }
+
+    /// @brief Remove every node. Call after Registry::clear().
+    void clear()
+    {
+        mNodes.clear();
+        mSlots.clear();
+        mOrder.clear();
+        mParentSlots.clear();
+        mLevels.clear();
+        mFirstRoot = NullEntity;
+        mLastRoot = NullEntity;
+        mSize = 0;
+        mOrderDirty = false;
+    }
+
+    // =========================================================================
+    // Queries
+    // =========================================================================
+
+    [[nodiscard]] bool contains(Entity entity) const noexcept
+    {
+        const auto index = EntityTraits::index(entity);
+        return entity != NullEntity && index < mNodes.size() && mNodes[index].entity == entity;
+    }
+
+    /// @brief Parent of @p entity, or NullEntity for roots and non-members.
+    [[nodiscard]] Entity parentOf(Entity entity) const noexcept
+    {
+        return contains(entity) ? mNodes[EntityTraits::index(entity)].parent : NullEntity;
+    }
+
+    /// @brief Number of direct children of @p entity.
+    [[nodiscard]] std::size_t childCount(Entity entity) const noexcept
+    {
+        return contains(entity) ? mNodes[EntityTraits::index(entity)].childCount : 0;
+    }
+
+    /**
+     * @brief Distance from @p entity to its root (roots are depth 0).
+     *
+     * @note Complexity: O(depth).
+     */
+    [[nodiscard]] std::size_t depth(Entity entity) const noexcept
+    {
+        std::size_t d = 0;
+        for (Entity a = parentOf(entity); a != NullEntity; a = parentOf(a))
+        {
+            ++d;
+        }
+        return d;
+    }
+
+    /// @brief Call func(Entity) for each direct child, in insertion order.
+    template <typename Func>
+    void forEachChild(Entity entity, Func&& func) const
+    {
+        if (!contains(entity))
+        {
+            return;
+        }
+        for (Entity c = mNodes[EntityTraits::index(entity)].firstChild; c != NullEntity;
+             c = mNodes[EntityTraits::index(c)].nextSibling)
+        {
+            func(c);
+        }
+    }
+
+    /**
+     * @brief Call func(Entity node, Entity parent) for every node, parents
+     *        before children (breadth-first). parent is NullEntity for roots.
+     *
+     * Do not modify the hierarchy from inside @p func.
+     */
+    template <typename Func>
+    void each(Func&& func) const
+    {
+        ensureOrder();
+        for (std::size_t slot = 0; slot < mOrder.size(); ++slot)
+        {
+            const uint32_t parentSlot = mParentSlots[slot];
+            func(mOrder[slot], parentSlot == kNoSlot ? NullEntity : mOrder[parentSlot]);
+        }
+    }
+
+    /// @brief Number of nodes.
+    [[nodiscard]] std::size_t size() const noexcept { return mSize; }
+
+    [[nodiscard]] bool empty() const noexcept { return mSize == 0; }
+
+    /// @brief Number of depth levels (0 when empty).
+    [[nodiscard]] std::size_t levelCount() const
+    {
+        ensureOrder();
+        return mLevels.empty() ? 0 : mLevels.size() - 1;
+    }
+
+    // =========================================================================
+    // Propagation
+    // =========================================================================
+
+    /**
+     * @brief Compute World for every node from its Local and its parent's
+     *        World, parents first.
+     *
+     * @p func is called as func(const World* parentWorld, const Local& local,
+     * World& world). parentWorld is nullptr for roots, and for nodes whose
+     * parent lacks Local or World. Nodes lacking either component are
+     * skipped.
+     *
+     * @note Complexity: O(n), plus O(n) to rebuild a stale order. Each node
+     *       costs two sparse lookups; after sortStorage<Local>() and
+     *       sortStorage<World>() those reads are sequential.
+     */
+    template <typename Local, typename World, typename Func>
+    void propagate(Func&& func)
+    {
+        auto stores = bindStores<Local, World>();
+        if (!stores.valid())
+        {
+            return;
+        }
+        propagateRange(stores, 0, mOrder.size(), func);
+    }
+
+    /**
+     * @brief Parallel propagate(): each depth level is split across
+     *        @p scheduler's threads, levels run in order.
+     *
+     * Worth it for wide hierarchies; levels narrower than @p minChunkSize
+     * run on the calling thread.
+     */
+    template <typename Local, typename World, typename Func>
+    void propagate(Scheduler& scheduler, Func&& func, std::size_t minChunkSize = 1024)
+    {
+        auto stores = bindStores<Local, World>();
+        if (!stores.valid())
+        {
+            return;
+        }
+        for (std::size_t level = 0; level + 1 < mLevels.size(); ++level)
+        {
+            const std::size_t begin = mLevels[level];
+            scheduler.parallel_for(mLevels[level + 1] - begin,
+                [&](std::size_t chunkBegin, std::size_t chunkEnd)
+                {
+                    propagateRange(stores, begin + chunkBegin, begin + chunkEnd, func);
+                },
+                minChunkSize);
+        }
+    }
+
+    /**
+     * @brief Reorder T's dense array so hierarchy members come first, in
+     *        breadth-first order. Entities with T outside the hierarchy
+     *        follow in their previous relative order.
+     *
+     * Call after structural edits settle (e.g. after loading a scene) to make
+     * propagate() stream through memory.
+     *
+     * @note Do NOT use on a store owned by an OwningGroup (see
+     *       Registry::sort).
+     * @note Complexity: O(n) swaps.
+     */
+    template <typename T>
+    void sortStorage()
+    {
+        ensureOrder();
+        auto* store = mRegistry->storage<T>();
+        if (store == nullptr)
+        {
+            return;
+        }
+        std::size_t next = 0;
+        for (Entity entity : mOrder)
+        {
+            const std::size_t index = store->getDenseIndex(entity);
+            if (index == store->size())
+            {
+                continue;
+            }
+            if (index != next)
+            {
+                store->swapDenseEntries(index, next);
+            }
+            ++next;
+        }
+    }
+
+private:
+    struct Node
+    {
+        Entity entity = NullEntity; // NullEntity when the slot is not a member
+        Entity parent = NullEntity;
+        Entity firstChild = NullEntity;
+        Entity lastChild = NullEntity;
+        Entity prevSibling = NullEntity;
+        Entity nextSibling = NullEntity;
+        uint32_t childCount = 0;
+    };
+
+    // Raw store pointers, resolved once per propagate() like View's caches.
+    template <typename T>
+    struct StoreCache
+    {
+        const uint32_t* sparse = nullptr;
+        std::size_t sparseSize = 0;
+        const Entity* dense = nullptr;
+        std::size_t denseSize = 0;
+        T* data = nullptr;
+
+        explicit StoreCache(TypedIComponentStore<T>* store) noexcept
+        {
+            if (store != nullptr)
+            {
+                sparse = store->sparsePtr();
+                sparseSize = store->sparseCount();
+                dense = store->densePtr();
+                denseSize = store->denseCount();
+                data = store->componentDataPtr();
+            }
+        }
+
+        [[nodiscard]] T* find(Entity entity) const noexcept
+        {
+            const auto s = EntityIndex::index(entity);
+            if (s >= sparseSize)
+            {
+                return nullptr;
+            }
+            const uint32_t d = sparse[s];
+            return d < denseSize && dense[d] == entity ? data + d : nullptr;
+        }
+    };
+
+    template <typename Local, typename World>
+    struct BoundStores
+    {
+        StoreCache<Local> local;
+        StoreCache<World> world;
+
+        [[nodiscard]] bool valid() const noexcept
+        {
+            return local.data != nullptr && world.data != nullptr;
+        }
+    };
+
+    template <typename Local, typename World>
+    BoundStores<Local, World> bindStores()
+    {
+        ensureOrder();
+        mWorldScratch.assign(mOrder.size(), nullptr);
+        return {StoreCache<Local>(mRegistry->storage<Local>()),
+                StoreCache<World>(mRegistry->storage<World>())};
+    }
+
+    template <typename Local, typename World, typename Func>
+    void propagateRange(const BoundStores<Local, World>& stores, std::size_t begin,
+                        std::size_t end, Func& func)
+    {
+        for (std::size_t slot = begin; slot < end; ++slot)
+        {
+            const Entity entity = mOrder[slot];
+            const Local* local = stores.local.find(entity);
+            World* world = stores.world.find(entity);
+            if (local == nullptr || world == nullptr)
+            {
+                continue;
+            }
+            const uint32_t parentSlot = mParentSlots[slot];
+            const World* parentWorld = parentSlot == kNoSlot
+                                           ? nullptr
+                                           : static_cast<const World*>(mWorldScratch[parentSlot]);
+            func(parentWorld, *local, *world);
+            mWorldScratch[slot] = world;
+        }
+    }
+
+    // Returns true if the entity was newly added (as a root).
+    bool ensure(Entity entity)
+    {
+        const auto index = EntityTraits::index(entity);
+        if (index >= mNodes.size())
+        {
+            mNodes.resize(static_cast<std::size_t>(index) + 1);
+        }
+        if (mNodes[index].entity == entity)
+        {
+            return false;
+        }
+        mNodes[index] = Node{};
+        mNodes[index].entity = entity;
+        link(entity);
+        ++mSize;
+        mOrderDirty = true;
+        return true;
+    }
+
+    // Append to the parent's child list (or the root list).
+    void link(Entity entity)
+    {
+        Node& node = mNodes[EntityTraits::index(entity)];
+        Entity* first = &mFirstRoot;
+        Entity* last = &mLastRoot;
+        if (node.parent != NullEntity)
+        {
+            Node& parent = mNodes[EntityTraits::index(node.parent)];
+            first = &parent.firstChild;
+            last = &parent.lastChild;
+            ++parent.childCount;
+        }
+        node.prevSibling = *last;
+        node.nextSibling = NullEntity;
+        if (*last != NullEntity)
+        {
+            mNodes[EntityTraits::index(*last)].nextSibling = entity;
+        }
+        else
+        {
+            *first = entity;
+        }
+        *last = entity;
+    }
+
+    void unlink(Entity entity)
+    {
+        Node& node = mNodes[EntityTraits::index(entity)];
+        Entity* first = &mFirstRoot;
+        Entity* last = &mLastRoot;
+        if (node.parent != NullEntity)
+        {
+            Node& parent = mNodes[EntityTraits::index(node.parent)];
+            first = &parent.firstChild;
+            last = &parent.lastChild;
+            --parent.childCount;
+        }
+        if (node.prevSibling != NullEntity)
+        {
+            mNodes[EntityTraits::index(node.prevSibling)].nextSibling = node.nextSibling;
+        }
+        else
+        {
+            *first = node.nextSibling;
+        }
+        if (node.nextSibling != NullEntity)
+        {
+            mNodes[EntityTraits::index(node.nextSibling)].prevSibling = node.prevSibling;
+        }
+        else
+        {
+            *last = node.prevSibling;
+        }
+        node.prevSibling = NullEntity;
+        node.nextSibling = NullEntity;
+    }
+
+    [[nodiscard]] std::size_t levelOf(uint32_t slot) const noexcept
+    {
+        const auto it = std::upper_bound(mLevels.begin(), mLevels.end(), slot);
+        return static_cast<std::size_t>(it - mLevels.begin()) - 1;
+    }
+
+    // Breadth-first relayout. Reuses the vectors' capacity.
+    void ensureOrder() const
+    {
+        if (!mOrderDirty)
+        {
+            return;
+        }
+        mOrder.clear();
+        mParentSlots.clear();
+        mLevels.clear();
+        mOrder.reserve(mSize);
+        mParentSlots.reserve(mSize);
+        if (mSlots.size() < mNodes.size())
+        {
+            mSlots.resize(mNodes.size(), kNoSlot);
+        }
+
+        auto push = [this](Entity entity, uint32_t parentSlot)
+        {
+            mSlots[EntityTraits::index(entity)] = static_cast<uint32_t>(mOrder.size());
+            mOrder.push_back(entity);
+            mParentSlots.push_back(parentSlot);
+        };
+
+        for (Entity r = mFirstRoot; r != NullEntity; r = mNodes[EntityTraits::index(r)].nextSibling)
+        {
+            push(r, kNoSlot);
+        }
+        mLevels.push_back(0);
+        std::size_t begin = 0;
+        while (begin < mOrder.size())
+        {
+            const std::size_t end = mOrder.size();
+            mLevels.push_back(static_cast<uint32_t>(end));
+            for (std::size_t slot = begin; slot < end; ++slot)
+            {
+                for (Entity c = mNodes[EntityTraits::index(mOrder[slot])].firstChild;
+                     c != NullEntity; c = mNodes[EntityTraits::index(c)].nextSibling)
+                {
+                    push(c, static_cast<uint32_t>(slot));
+                }
+            }
+            begin = end;
+        }
+        mOrderDirty = false;
+    }
+
+    Registry* mRegistry;
+    std::vector<Node> mNodes; // indexed by entity slot index
+    Entity mFirstRoot = NullEntity;
+    Entity mLastRoot = NullEntity;
+    std::size_t mSize = 0;
+
+    // Flattened breadth-first order, rebuilt lazily.
+    mutable std::vector<Entity> mOrder;
+    mutable std::vector<uint32_t> mParentSlots; // per slot; kNoSlot for roots
+    mutable std::vector<uint32_t> mLevels;      // level d is [mLevels[d], mLevels[d + 1])
+    mutable std::vector<uint32_t> mSlots;       // entity slot index -> position in mOrder
+    mutable bool mOrderDirty = false;
+
+    std::vector<const void*> mWorldScratch; // World* per slot during propagate()
+
+    fat_p::ScopedConnection mDestroyConn;
+};
+
+} // namespace fatp_ecs
@@ -0,0 +1,220 @@
+#pragma once
+
+/**
+ * @file KeySort.h
+ * @brief LSD radix sort of extracted keys, the engine behind
+ *        Registry::sort_by_key<T>().
+ */
+
+// Overview:
+//
+// Registry::sort<T>(comparator) sorts an index permutation with std::sort,
+// reading two components per comparison. sort_by_key<T>(keyFn) instead
+// calls keyFn once per component, maps each key to an unsigned integer
+// whose natural order matches the key's order (toRadixBits), and sorts the
+// (bits, dense index) pairs with a least-significant-digit radix sort:
+// one counting pass for all digit histograms, then one stable scatter per
+// 8-bit digit. A digit on which every key agrees (the high bytes of small
+// keys, say) is skipped.
+//
+// The parallel overload splits each pass into one chunk per pool thread:
+// chunk histograms are built concurrently, turned into per-chunk bucket
+// offsets on the calling thread, and the chunks scatter concurrently into
+// disjoint ranges. Chunk c's bucket offsets follow chunk c-1's, so the
+// result is identical to the serial sort.
+//
+// Key mapping:
+//   unsigned integers  unchanged
+//   signed integers    sign bit flipped
+//   float / double     negative: all bits flipped; positive: sign bit set
+// so -0.0 sorts before +0.0 and NaNs sort by their bit pattern.
+//
+// FAT-P components used:
+//   - ThreadPool (via Scheduler::parallel_for): parallel passes
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "Scheduler.h"
+
+namespace fatp_ecs
+{
+
+/// @brief Key types sort_by_key() accepts: integers (not bool), float, double.
+template <typename Key>
+concept RadixKey = (std::is_integral_v<Key> && !std::is_same_v<Key, bool>) ||
+                   std::is_same_v<Key, float> || std::is_same_v<Key, double>;
+
+/// @brief Unsigned integer type a RadixKey is mapped to.
+template <RadixKey Key>
+using RadixBits = std::conditional_t<(sizeof(Key) <= 4), std::uint32_t, std::uint64_t>;
+
+/// @brief Map key to an unsigned integer that orders the same way.
+template <RadixKey Key>
+[[nodiscard]] constexpr RadixBits<Key> toRadixBits(Key key) noexcept
+{
+    if constexpr (std::is_floating_point_v<Key>)
+    {
+        using Raw = std::conditional_t<(sizeof(Key) == 4), std::uint32_t, std::uint64_t>;
+        constexpr Raw kSign = Raw{1} << (sizeof(Raw) * 8 - 1);
+        const Raw raw = std::bit_cast<Raw>(key);
+        return static_cast<RadixBits<Key>>((raw & kSign) != 0 ? ~raw : (raw | kSign));
+    }
+    else if constexpr (std::is_signed_v<Key>)
+    {
+        using Raw = std::make_unsigned_t<Key>;
+        constexpr Raw kSign = static_cast<Raw>(Raw{1} << (sizeof(Raw) * 8 - 1));
+        return static_cast<RadixBits<Key>>(static_cast<Raw>(static_cast<Raw>(key) ^ kSign));
+    }
+    else
+    {
+        return static_cast<RadixBits<Key>>(key);
+    }
+}
+
+/**
+ * @brief Stable ascending LSD radix sort of keys, permuting order alongside.
+ *
+ * Only the low keyBytes bytes of each key are examined. keys and order must
+ * have the same length; both are sorted in place.
+ */
+template <typename Bits>
+void radixSortKeys(std::vector<Bits>& keys, std::vector<std::uint32_t>& order,
+                   std::size_t keyBytes)
+{
+    const std::size_t n = keys.size();
+    if (n <= 1)
+    {
+        return;
+    }
+
+    // All digit histograms in one read of the keys.
+    std::vector<std::array<std::size_t, 256>> counts(keyBytes);
+    for (auto& histogram : counts)
+    {
+        histogram.fill(0);
+    }
+    for (const Bits key : keys)
+    {
+        for (std::size_t pass = 0; pass < keyBytes; ++pass)
+        {
+            ++counts[pass][(key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    std::vector<Bits> keysOut(n);
+    std::vector<std::uint32_t> orderOut(n);
+    for (std::size_t pass = 0; pass < keyBytes; ++pass)
+    {
+        auto& offsets = counts[pass];
+        const unsigned shift = static_cast<unsigned>(pass * 8);
+        if (offsets[(keys[0] >> shift) & 0xFF] == n)
+        {
+            continue; // every key has the same digit here
+        }
+
+        std::size_t running = 0;
+        for (auto& offset : offsets)
+        {
+            const std::size_t count = offset;
+            offset = running;
+            running += count;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::size_t dst = offsets[(keys[i] >> shift) & 0xFF]++;
+            keysOut[dst] = keys[i];
+            orderOut[dst] = order[i];
+        }
+        keys.swap(keysOut);
+        order.swap(orderOut);
+    }
+}
+
+/**
+ * @brief Parallel radix sort on scheduler's pool; same result as the serial one.
+ *
+ * Falls back to the serial sort when keys has fewer than two chunks of
+ * minChunkSize elements.
+ */
+template <typename Bits>
+void radixSortKeys(std::vector<Bits>& keys, std::vector<std::uint32_t>& order,
+                   std::size_t keyBytes, Scheduler& scheduler, std::size_t minChunkSize)
+{
+    const std::size_t n = keys.size();
+    const std::size_t threads = std::max<std::size_t>(1, scheduler.pool().thread_count());
+    const std::size_t chunks =
+        std::min(threads, n / std::max<std::size_t>(1, minChunkSize));
+    if (chunks <= 1)
+    {
+        radixSortKeys(keys, order, keyBytes);
+        return;
+    }
+
+    const std::size_t chunkSize = (n + chunks - 1) / chunks;
+    std::vector<std::array<std::size_t, 256>> offsets(chunks);
+    std::vector<Bits> keysOut(n);
+    std::vector<std::uint32_t> orderOut(n);
+
+    for (std::size_t pass = 0; pass < keyBytes; ++pass)
+    {
+        const unsigned shift = static_cast<unsigned>(pass * 8);
+
+        scheduler.parallel_for(chunks, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t c = first; c < last; ++c)
+            {
+                auto& histogram = offsets[c];
+                histogram.fill(0);
+                const std::size_t end = std::min(n, (c + 1) * chunkSize);
+                for (std::size_t i = c * chunkSize; i < end; ++i)
+                {
+                    ++histogram[(keys[i] >> shift) & 0xFF];
+                }
+            }
+        }, 1);
+
+        // Bucket-major, chunk-minor prefix sum keeps the scatter stable.
+        std::size_t running = 0;
+        bool uniform = false;
+        for (std::size_t bucket = 0; bucket < 256 && !uniform; ++bucket)
+        {
+            const std::size_t bucketStart = running;
+            for (std::size_t c = 0; c < chunks; ++c)
+            {
+                const std::size_t count = offsets[c][bucket];
+                offsets[c][bucket] = running;
+                running += count;
+            }
+            uniform = running - bucketStart == n;
+        }
+        if (uniform)
+        {
+            continue; // every key has the same digit here
+        }
+
+        scheduler.parallel_for(chunks, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t c = first; c < last; ++c)
+            {
+                auto& cursor = offsets[c];
+                const std::size_t end = std::min(n, (c + 1) * chunkSize);
+                for (std::size_t i = c * chunkSize; i < end; ++i)
+                {
+                    const std::size_t dst = cursor[(keys[i] >> shift) & 0xFF]++;
+                    keysOut[dst] = keys[i];
+                    orderOut[dst] = order[i];
+                }
+            }
+        }, 1);
+        keys.swap(keysOut);
+        order.swap(orderOut);
+    }
+}
+
+} // namespace fatp_ecs
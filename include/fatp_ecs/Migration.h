@@ -0,0 +1,162 @@
+#pragma once
+
+/**
+ * @file Migration.h
+ * @brief Move entities and all their components from one registry to another.
+ */
+
+// Overview:
+//
+// Registry::copy() works inside one registry, and Snapshot round-trips every
+// component through a user callback and a byte buffer. migrate() and merge()
+// are the in-process path for moving live entities between registries, e.g.
+// a world sector streamed in on a background thread and then merged into
+// the live world on the main thread:
+//
+//   1. Every requested entity that is alive in src (duplicates dropped) gets
+//      a fresh entity in dst. The pairs go into the returned EntityMap, so
+//      components holding Entity references can be remapped afterwards.
+//   2. Store by store, IComponentStore::moveTo() moves the components of the
+//      whole batch: one virtual call per store, not one per entity. A store
+//      missing from dst is created with the same storage policy as in src.
+//   3. The src entities are released, firing onEntityDestroyed.
+//
+// Events follow destroy() on the src side and add() on the dst side:
+// onComponentRemoved (src) fires while the component is still in place,
+// onComponentAdded (dst) once it has landed, onEntityCreated (dst) before
+// any components arrive. Every emit short-circuits when nothing listens, so
+// an unobserved merge costs only the moves. Owning groups and observers on
+// both sides stay consistent through those signals.
+//
+// Components are moved, not copied, so move-only types migrate too. Both
+// registries must be quiescent for the duration of the call.
+//
+// FAT-P components used:
+//   (none — Registry internals plus EntityMap)
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "ComponentStore.h"
+#include "Entity.h"
+#include "EntityMap.h"
+#include "Registry.h"
+#include "TypeId.h"
+
+namespace fatp_ecs
+{
+
+/**
+ * @brief Move entities[0, count) and all their components from src to dst.
+ *
+ * Dead and repeated entities are skipped. Each moved entity is destroyed in
+ * src; its replacement in dst is recorded in the returned map.
+ *
+ * @return Old (src) to new (dst) entity mapping. Empty when src and dst are
+ *         the same registry.
+ *
+ * @note Complexity: O(count × stores in src) sparse lookups plus one
+ *       component move per (entity, component) pair.
+ * @note Thread-safety: NOT thread-safe. Neither registry may be in use
+ *       elsewhere during the call.
+ */
+inline EntityMap migrate(Registry& src, Registry& dst, const Entity* entities,
+                         std::size_t count)
+{
+    EntityMap map;
+    if (&src == &dst)
+    {
+        return map;
+    }
+
+    std::vector<Entity> from;
+    from.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Entity entity = entities[i];
+        if (!src.isAlive(entity) || map.translate(entity) != NullEntity)
+        {
+            continue;
+        }
+        map.insert(entity, dst.create());
+        from.push_back(entity);
+    }
+    if (from.empty())
+    {
+        return map;
+    }
+
+    // Moving every live entity means every component in every store moves,
+    // which lets the stores skip the per-entity lookups and erases.
+    const bool everything = from.size() == src.alive();
+
+    for (auto it = src.mStores.begin(); it != src.mStores.end(); ++it)
+    {
+        IComponentStore* source = it.value().get();
+        if (source->empty())
+        {
+            continue;
+        }
+
+        const TypeId tid = it.key();
+        IComponentStore* target = dst.getStoreById(tid);
+        if (target == nullptr)
+        {
+            auto store = source->createEmpty();
+            target = store.get();
+            dst.mStores.insert(tid, std::move(store));
+            if (tid < Registry::kStoreCacheSize)
+            {
+                dst.mStoreCache[tid] = target;
+            }
+            if (!src.isDefaultPolicy(tid))
+            {
+                if (tid < Registry::kStoreCacheSize)
+                {
+                    dst.mCustomPolicyMask[tid] = true;
+                }
+                else
+                {
+                    dst.mCustomPolicies.insert(tid, true);
+                }
+            }
+        }
+
+        source->moveTo(*target, everything ? nullptr : from.data(),
+                       everything ? 0 : from.size(), map, src.mEvents, dst.mEvents);
+    }
+
+    for (const Entity entity : from)
+    {
+        src.releaseEntity(entity);
+    }
+    return map;
+}
+
+/**
+ * @brief Move the entities in a contiguous range (vector, SmallVector,
+ *        array, ...) from src to dst. See the pointer overload.
+ */
+template <typename Range>
+EntityMap migrate(Registry& src, Registry& dst, const Range& entities)
+{
+    return migrate(src, dst, std::data(entities), std::size(entities));
+}
+
+/**
+ * @brief Move every live entity of src, with all its components, into dst.
+ *
+ * src is left empty of entities (its stores, groups, and listeners remain).
+ *
+ * @return Old (src) to new (dst) entity mapping.
+ *
+ * @note Thread-safety: NOT thread-safe.
+ */
+inline EntityMap merge(Registry& src, Registry& dst)
+{
+    const auto entities = src.allEntities();
+    return migrate(src, dst, entities.data(), entities.size());
+}
+
+} // namespace fatp_ecs
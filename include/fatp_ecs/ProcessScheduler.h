@@ -37,13 +37,60 @@
 // to update(delta, data) ticks all live processes. Completed processes are
 // removed; their successors (if any) are queued.
 //
+// Allocation: processes created through attach()/then() come from the
+// scheduler's ProcessArena, a set of free lists keyed by object size. All
+// processes of one type share a list, so a steady stream of timers or
+// tweens recycles the same few chunks instead of hitting the global heap.
+//
+// Parallel ticking: a process type that declares
+//   static constexpr bool kIndependent = true;
+// promises its ticks touch nothing shared with other processes (besides
+// data the caller made thread-safe). updateParallel(pool, ...) ticks those
+// processes on a fat_p::ThreadPool, in contiguous chunks, while the calling
+// thread ticks the rest in list order. Completion bookkeeping always runs
+// afterwards on the calling thread in list order: finished processes are
+// removed, survivors keep their relative order, and successors are appended
+// in the order of their predecessors. update() and updateParallel()
+// therefore leave identical process lists behind; only the hooks
+// (onUpdate, onSucceeded, ...) of independent processes run on workers.
+//
+// Coroutine processes: a function returning CoProcess<Delta, Data> is a
+// process written as straight-line code. attach(body()) or .then(body())
+// wraps it in a CoroutineProcess. The body starts on its first tick and may
+// suspend with
+//   co_await nextTick;                     // resume next tick; yields delta
+//   co_await seconds(2.0);                 // resume after 2.0 of summed delta
+//   co_await untilComponent<T>(reg, e);    // resume once e has T (or dies)
+// Finishing the body succeeds the process. Frames come from a thread-local
+// ProcessArena (coroutineFramePool()), so short behaviours spawned at a high
+// rate recycle frames instead of hitting the global heap. untilComponent is
+// polled once per tick.
+//
+// Sleeping: a process that calls sleepFor(d) from onUpdate() (or a coroutine
+// that awaits seconds(d)) is parked in the scheduler's sleep queue, a
+// min-heap keyed by wake time on the scheduler clock (the sum of all
+// deltas). Parked processes are not ticked at all until the clock reaches
+// their wake time, so update() costs O(awake + woken * log(sleeping)) and a
+// large population of idle timers is nearly free.
+//
 // FAT-P components used:
-//   (none — self-contained; only standard library types)
+//   - ThreadPool: updateParallel() worker chunks
 
+#include <algorithm>
+#include <concepts>
+#include <coroutine>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <fat_p/ThreadPool.h>
+
 namespace fatp_ecs
 {
 
@@ -60,6 +107,172 @@ enum class ProcessState : uint8_t
     Aborted,       ///< Externally aborted.
 };
 
+// =============================================================================
+// ProcessClock — type the scheduler clock accumulates in
+// =============================================================================
+
+/**
+ * @brief Accumulator for ProcessScheduler<Delta>::clock().
+ *
+ * Summing float deltas in a float stalls after long sessions (at 60 Hz a
+ * frame no longer moves a float clock after about 145 hours) and would
+ * leave sleepers parked forever. Floating-point deltas are therefore summed
+ * in at least double and integral ones in 64 bits; other Delta types
+ * (durations, fixed-point) are summed as themselves.
+ */
+template <typename Delta>
+struct ProcessClock
+{
+    using type = Delta;
+};
+
+template <std::floating_point Delta>
+struct ProcessClock<Delta>
+{
+    using type = std::common_type_t<Delta, double>;
+};
+
+template <std::signed_integral Delta>
+struct ProcessClock<Delta>
+{
+    using type = std::int64_t;
+};
+
+template <std::unsigned_integral Delta>
+struct ProcessClock<Delta>
+{
+    using type = std::uint64_t;
+};
+
+// =============================================================================
+// ProcessArena — size-class pool for process objects
+// =============================================================================
+
+/**
+ * @brief Pool allocator for process objects, one free list per size class.
+ *
+ * Blocks are carved from chunks of kBlocksPerChunk and never returned to the
+ * heap before the arena is destroyed, so a scheduler's steady-state churn
+ * allocates nothing. Types aligned beyond alignof(std::max_align_t) use the
+ * aligned global operator new instead.
+ *
+ * @note Thread-safety: NOT thread-safe. ProcessScheduler only allocates and
+ *       frees on the thread that calls attach()/update().
+ */
+class ProcessArena
+{
+public:
+    static constexpr std::size_t kGranule = alignof(std::max_align_t);
+    static constexpr std::size_t kBlocksPerChunk = 64;
+
+    ProcessArena() = default;
+    ProcessArena(const ProcessArena&) = delete;
+    ProcessArena& operator=(const ProcessArena&) = delete;
+
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t align)
+    {
+        if (align > kGranule)
+        {
+            return ::operator new(size, std::align_val_t{align});
+        }
+        const std::size_t cls = sizeClass(size);
+        if (cls >= mFree.size())
+        {
+            mFree.resize(cls + 1, nullptr);
+        }
+        if (mFree[cls] == nullptr)
+        {
+            refill(cls);
+        }
+        FreeBlock* block = mFree[cls];
+        mFree[cls] = block->next;
+        return block;
+    }
+
+    void deallocate(void* p, std::size_t size, std::size_t align) noexcept
+    {
+        if (align > kGranule)
+        {
+            ::operator delete(p, std::align_val_t{align});
+            return;
+        }
+        const std::size_t cls = sizeClass(size);
+        FreeBlock* block = ::new (p) FreeBlock{mFree[cls]};
+        mFree[cls] = block;
+    }
+
+    /// @brief Number of chunks obtained from the heap so far.
+    [[nodiscard]] std::size_t chunkCount() const noexcept { return mChunks.size(); }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    static std::size_t sizeClass(std::size_t size) noexcept
+    {
+        return (std::max(size, sizeof(FreeBlock)) + kGranule - 1) / kGranule;
+    }
+
+    void refill(std::size_t cls)
+    {
+        const std::size_t blockSize = cls * kGranule;
+        mChunks.push_back(std::make_unique<std::byte[]>(blockSize * kBlocksPerChunk));
+        std::byte* base = mChunks.back().get();
+        for (std::size_t i = kBlocksPerChunk; i-- > 0;)
+        {
+            mFree[cls] = ::new (base + i * blockSize) FreeBlock{mFree[cls]};
+        }
+    }
+
+    std::vector<FreeBlock*> mFree;
+    std::vector<std::unique_ptr<std::byte[]>> mChunks;
+};
+
+template <typename Delta, typename Data>
+class IProcess;
+
+/**
+ * @brief unique_ptr deleter for processes: returns arena-allocated processes
+ *        to their ProcessArena, deletes heap-allocated ones. Stateless, so a
+ *        ProcessPtr stays one pointer wide.
+ */
+template <typename Delta, typename Data>
+struct ProcessDeleter
+{
+    void operator()(IProcess<Delta, Data>* process) const noexcept
+    {
+        process->destroy();
+    }
+};
+
+template <typename Delta, typename Data>
+using ProcessPtr = std::unique_ptr<IProcess<Delta, Data>, ProcessDeleter<Delta, Data>>;
+
+/// @brief Construct a T in arena (or on the heap when arena is null).
+template <typename T, typename Delta, typename Data, typename... Args>
+ProcessPtr<Delta, Data> makeProcess(ProcessArena* arena, Args&&... args)
+{
+    if (arena == nullptr)
+    {
+        return ProcessPtr<Delta, Data>(new T(std::forward<Args>(args)...));
+    }
+    void* memory = arena->allocate(sizeof(T), alignof(T));
+    T* process = nullptr;
+    try
+    {
+        process = ::new (memory) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        arena->deallocate(memory, sizeof(T), alignof(T));
+        throw;
+    }
+    process->mArena = arena;
+    return ProcessPtr<Delta, Data>(process);
+}
+
 // =============================================================================
 // IProcess — type-erased base
 // =============================================================================
@@ -84,17 +297,43 @@ public:
     /// @brief True if the process completed successfully (not failed/aborted).
     [[nodiscard]] virtual bool succeeded() const noexcept = 0;
 
+    /// @brief True if the process type declares kIndependent (see updateParallel()).
+    [[nodiscard]] virtual bool independent() const noexcept = 0;
+
     /// @brief Attach a successor. Runs after this process succeeds.
-    virtual void setNext(std::unique_ptr<IProcess> next) = 0;
+    virtual void setNext(ProcessPtr<Delta, Data> next) = 0;
 
     /// @brief Take ownership of the successor (called by scheduler on completion).
-    [[nodiscard]] virtual std::unique_ptr<IProcess> takeNext() = 0;
+    [[nodiscard]] virtual ProcessPtr<Delta, Data> takeNext() = 0;
+
+    /// @brief Destroy this process and free its memory (arena or heap).
+    virtual void destroy() noexcept = 0;
+
+    /**
+     * @brief Consume a sleep request made by the last tick.
+     *
+     * Returns true and stores the duration in duration if the process wants
+     * to be parked; the scheduler then skips it until its clock has advanced
+     * by that much. The default never sleeps.
+     */
+    [[nodiscard]] virtual bool takeSleep(Delta& duration) noexcept
+    {
+        (void)duration;
+        return false;
+    }
 
     IProcess() = default;
     IProcess(const IProcess&) = delete;
     IProcess& operator=(const IProcess&) = delete;
     IProcess(IProcess&&) = delete;
     IProcess& operator=(IProcess&&) = delete;
+
+protected:
+    /// Arena the process was allocated from; null for heap allocation.
+    ProcessArena* mArena = nullptr;
+
+    template <typename T, typename D, typename X, typename... Args>
+    friend ProcessPtr<D, X> makeProcess(ProcessArena* arena, Args&&... args);
 };
 
 // =============================================================================
@@ -138,6 +377,10 @@ template <typename Derived, typename Delta, typename Data = void*>
 class Process : public IProcess<Delta, Data>
 {
 public:
+    /// @brief Shadow with true in Derived to let updateParallel() tick this
+    ///        type on worker threads.
+    static constexpr bool kIndependent = false;
+
     // =========================================================================
     // Lifecycle hooks — override in Derived
     // =========================================================================
@@ -168,6 +411,18 @@ public:
     /// @brief Signal failure. No successor will run.
     void fail() noexcept { mState = ProcessState::Failed; }
 
+    /**
+     * @brief Park until the scheduler clock has advanced by duration.
+     *
+     * The process stays Running but is not ticked until then. Ignored if
+     * the same tick also completes the process.
+     */
+    void sleepFor(Delta duration) noexcept
+    {
+        mSleep = duration;
+        mSleepRequested = true;
+    }
+
     // =========================================================================
     // Queries
     // =========================================================================
@@ -223,19 +478,343 @@ public:
         }
     }
 
-    void setNext(std::unique_ptr<IProcess<Delta, Data>> next) override
+    [[nodiscard]] bool independent() const noexcept override
+    {
+        return Derived::kIndependent;
+    }
+
+    void setNext(ProcessPtr<Delta, Data> next) override
     {
         mNext = std::move(next);
     }
 
-    [[nodiscard]] std::unique_ptr<IProcess<Delta, Data>> takeNext() override
+    [[nodiscard]] ProcessPtr<Delta, Data> takeNext() override
     {
         return std::move(mNext);
     }
 
+    [[nodiscard]] bool takeSleep(Delta& duration) noexcept override
+    {
+        if (!mSleepRequested)
+        {
+            return false;
+        }
+        mSleepRequested = false;
+        duration = mSleep;
+        return true;
+    }
+
+    void destroy() noexcept override
+    {
+        Derived* self = static_cast<Derived*>(this);
+        ProcessArena* arena = this->mArena;
+        if (arena == nullptr)
+        {
+            delete self;
+            return;
+        }
+        self->~Derived();
+        arena->deallocate(self, sizeof(Derived), alignof(Derived));
+    }
+
 private:
     ProcessState mState{ProcessState::Uninitialized};
-    std::unique_ptr<IProcess<Delta, Data>> mNext;
+    bool mSleepRequested{false};
+    Delta mSleep{};
+    ProcessPtr<Delta, Data> mNext;
+};
+
+// =============================================================================
+// Coroutine processes
+// =============================================================================
+
+/**
+ * @brief Thread-local pool that coroutine process frames are drawn from.
+ *
+ * Frames are allocated and freed on the thread that calls the coroutine
+ * function and the thread that ticks it, which for ProcessScheduler is the
+ * same main-loop thread. Frames must be destroyed before that thread exits.
+ */
+inline ProcessArena& coroutineFramePool() noexcept
+{
+    thread_local ProcessArena pool;
+    return pool;
+}
+
+/// @brief Awaitable: suspend until the next tick. co_await yields that tick's delta.
+struct NextTick
+{
+};
+
+inline constexpr NextTick nextTick{};
+
+/// @brief Awaitable returned by seconds().
+template <typename Duration>
+struct Sleep
+{
+    Duration duration;
+};
+
+/**
+ * @brief Awaitable: park the coroutine until the scheduler clock has advanced
+ *        by duration. Measured in the scheduler's Delta units.
+ */
+template <typename Duration>
+[[nodiscard]] constexpr Sleep<Duration> seconds(Duration duration) noexcept
+{
+    return Sleep<Duration>{duration};
+}
+
+/// @brief Awaitable returned by untilComponent().
+template <typename T, typename RegistryT, typename EntityT>
+struct UntilComponent
+{
+    const RegistryT* registry;
+    EntityT entity;
+};
+
+/**
+ * @brief Awaitable: suspend until entity has a T, checked once per tick.
+ *
+ * co_await yields true once the component is present, false if the entity
+ * was destroyed first. Works with any registry type exposing isAlive() and
+ * has<T>().
+ */
+template <typename T, typename RegistryT, typename EntityT>
+[[nodiscard]] UntilComponent<T, RegistryT, EntityT> untilComponent(const RegistryT& registry,
+                                                                  EntityT entity) noexcept
+{
+    return UntilComponent<T, RegistryT, EntityT>{&registry, entity};
+}
+
+/**
+ * @brief Return type of a coroutine process body.
+ *
+ * Owns the coroutine frame until attach()/then() hands it to a
+ * CoroutineProcess. The body is created suspended and first runs on the
+ * process's first tick.
+ *
+ * @code
+ *   fatp_ecs::CoProcess<float> attackSequence(Registry& reg, Entity e)
+ *   {
+ *       co_await fatp_ecs::seconds(2.0f);
+ *       startAnimation(e, "swing");
+ *       if (!co_await fatp_ecs::untilComponent<AnimationDone>(reg, e)) co_return;
+ *       clearAnimation(e);
+ *   }
+ *
+ *   sched.attach(attackSequence(reg, enemy)).then<Cooldown>(1.0f);
+ * @endcode
+ */
+template <typename Delta, typename Data>
+class CoroutineProcess;
+
+template <typename Delta, typename Data = void*>
+class CoProcess
+{
+public:
+    class promise_type
+    {
+    public:
+        CoProcess get_return_object() noexcept
+        {
+            return CoProcess(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { mException = std::current_exception(); }
+
+        static void* operator new(std::size_t size)
+        {
+            return coroutineFramePool().allocate(size, alignof(std::max_align_t));
+        }
+
+        static void operator delete(void* frame, std::size_t size) noexcept
+        {
+            coroutineFramePool().deallocate(frame, size, alignof(std::max_align_t));
+        }
+
+        struct TickAwaiter
+        {
+            promise_type* promise;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<>) const noexcept {}
+            Delta await_resume() const noexcept { return promise->mDelta; }
+        };
+
+        struct SleepAwaiter
+        {
+            promise_type* promise;
+            Delta duration;
+
+            bool await_ready() const noexcept { return !(Delta{} < duration); }
+            void await_suspend(std::coroutine_handle<>) const noexcept
+            {
+                promise->mSleep = duration;
+                promise->mSleepRequested = true;
+            }
+            void await_resume() const noexcept {}
+        };
+
+        template <typename T, typename RegistryT, typename EntityT>
+        struct ComponentAwaiter
+        {
+            promise_type* promise;
+            const RegistryT* registry;
+            EntityT entity;
+
+            static bool ready(const void* self)
+            {
+                const auto* awaiter = static_cast<const ComponentAwaiter*>(self);
+                return !awaiter->registry->isAlive(awaiter->entity) ||
+                       awaiter->registry->template has<T>(awaiter->entity);
+            }
+
+            bool await_ready() const { return ready(this); }
+            void await_suspend(std::coroutine_handle<>) noexcept
+            {
+                promise->mWaitReady = &ready;
+                promise->mWaitContext = this;
+            }
+            bool await_resume() const
+            {
+                return registry->isAlive(entity) && registry->template has<T>(entity);
+            }
+        };
+
+        TickAwaiter await_transform(NextTick) noexcept { return TickAwaiter{this}; }
+
+        template <typename Duration>
+        SleepAwaiter await_transform(Sleep<Duration> sleep) noexcept
+        {
+            return SleepAwaiter{this, static_cast<Delta>(sleep.duration)};
+        }
+
+        template <typename T, typename RegistryT, typename EntityT>
+        ComponentAwaiter<T, RegistryT, EntityT>
+        await_transform(UntilComponent<T, RegistryT, EntityT> until) noexcept
+        {
+            return ComponentAwaiter<T, RegistryT, EntityT>{this, until.registry, until.entity};
+        }
+
+    private:
+        friend class CoroutineProcess<Delta, Data>;
+
+        Delta mDelta{};
+        Delta mSleep{};
+        bool mSleepRequested = false;
+        // Polled wait condition and the awaiter it reads (lives in the frame).
+        bool (*mWaitReady)(const void*) = nullptr;
+        const void* mWaitContext = nullptr;
+        std::exception_ptr mException;
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    CoProcess(CoProcess&& other) noexcept
+        : mHandle(std::exchange(other.mHandle, nullptr))
+    {
+    }
+
+    CoProcess& operator=(CoProcess&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (mHandle)
+            {
+                mHandle.destroy();
+            }
+            mHandle = std::exchange(other.mHandle, nullptr);
+        }
+        return *this;
+    }
+
+    CoProcess(const CoProcess&) = delete;
+    CoProcess& operator=(const CoProcess&) = delete;
+
+    ~CoProcess()
+    {
+        if (mHandle)
+        {
+            mHandle.destroy();
+        }
+    }
+
+    /// @brief Give up ownership of the coroutine frame.
+    [[nodiscard]] Handle release() noexcept { return std::exchange(mHandle, nullptr); }
+
+private:
+    explicit CoProcess(Handle handle) noexcept
+        : mHandle(handle)
+    {
+    }
+
+    Handle mHandle;
+};
+
+/**
+ * @brief Process that drives a CoProcess body, one resume per tick.
+ *
+ * Created by ProcessScheduler::attach(CoProcess) and ProcessHandle::then(CoProcess).
+ * The body succeeds the process by returning. An exception escaping the body
+ * fails the process and is rethrown from the tick.
+ *
+ * @note Thread-safety: NOT thread-safe. Never independent: its frame belongs
+ *       to the thread-local coroutineFramePool() of the scheduler thread.
+ */
+template <typename Delta, typename Data>
+class CoroutineProcess : public Process<CoroutineProcess<Delta, Data>, Delta, Data>
+{
+public:
+    explicit CoroutineProcess(CoProcess<Delta, Data> body) noexcept
+        : mHandle(body.release())
+    {
+    }
+
+    ~CoroutineProcess() override
+    {
+        if (mHandle)
+        {
+            mHandle.destroy();
+        }
+    }
+
+    void onUpdate(Delta delta, Data& /*data*/)
+    {
+        auto& promise = mHandle.promise();
+        if (promise.mWaitReady != nullptr)
+        {
+            if (!promise.mWaitReady(promise.mWaitContext))
+            {
+                return;
+            }
+            promise.mWaitReady = nullptr;
+        }
+
+        promise.mDelta = delta;
+        mHandle.resume();
+
+        if (promise.mException)
+        {
+            this->fail();
+            std::rethrow_exception(std::exchange(promise.mException, nullptr));
+        }
+        if (mHandle.done())
+        {
+            this->succeed();
+        }
+        else if (promise.mSleepRequested)
+        {
+            promise.mSleepRequested = false;
+            this->sleepFor(promise.mSleep);
+        }
+    }
+
+private:
+    typename CoProcess<Delta, Data>::Handle mHandle;
 };
 
 // =============================================================================
@@ -260,8 +839,9 @@ template <typename Delta, typename Data>
 class ProcessHandle
 {
 public:
-    explicit ProcessHandle(IProcess<Delta, Data>* tail) noexcept
+    explicit ProcessHandle(IProcess<Delta, Data>* tail, ProcessArena* arena = nullptr) noexcept
         : mTail(tail)
+        , mArena(arena)
     {
     }
 
@@ -275,18 +855,25 @@ public:
     template <typename T, typename... Args>
     ProcessHandle then(Args&&... args)
     {
-        auto next = std::make_unique<T>(std::forward<Args>(args)...);
-        T* raw = next.get();
+        auto next = makeProcess<T, Delta, Data>(mArena, std::forward<Args>(args)...);
+        IProcess<Delta, Data>* raw = next.get();
         if (mTail != nullptr)
         {
             mTail->setNext(std::move(next));
         }
         mTail = raw;
-        return ProcessHandle(mTail);
+        return ProcessHandle(mTail, mArena);
+    }
+
+    /// @brief Attach a coroutine body as successor (see CoProcess).
+    ProcessHandle then(CoProcess<Delta, Data> body)
+    {
+        return then<CoroutineProcess<Delta, Data>>(std::move(body));
     }
 
 private:
     IProcess<Delta, Data>* mTail;
+    ProcessArena* mArena;
 };
 
 // =============================================================================
@@ -313,21 +900,44 @@ private:
  *   }
  * @endcode
  *
- * @note Thread-safety: NOT thread-safe. Drive from a single main-loop thread.
+ * @note Thread-safety: NOT thread-safe. Drive from a single main-loop thread;
+ *       updateParallel() fans out to a ThreadPool internally.
  */
 template <typename Delta, typename Data = void*>
 class ProcessScheduler
 {
 public:
-    using ProcessPtr = std::unique_ptr<IProcess<Delta, Data>>;
+    using ProcessPtr = fatp_ecs::ProcessPtr<Delta, Data>;
+
+    /// @brief Type of clock() and of sleepers' wake times (see ProcessClock).
+    using Clock = typename ProcessClock<Delta>::type;
+
+    /// @brief Minimum independent processes per updateParallel() chunk.
+    static constexpr std::size_t kMinParallelChunk = 256;
 
     ProcessScheduler() = default;
 
-    // Move-only: owns the process list.
+    // Move-only: owns the process list and the arena it lives in. The arena
+    // is heap-allocated, so moving the scheduler does not move any process.
     ProcessScheduler(const ProcessScheduler&) = delete;
     ProcessScheduler& operator=(const ProcessScheduler&) = delete;
-    ProcessScheduler(ProcessScheduler&&) = default;
-    ProcessScheduler& operator=(ProcessScheduler&&) = default;
+    ProcessScheduler(ProcessScheduler&&) noexcept = default;
+
+    ProcessScheduler& operator=(ProcessScheduler&& other) noexcept
+    {
+        if (this != &other)
+        {
+            // Processes first: they return their memory to the current arena.
+            mProcesses.clear();
+            mSleeping.clear();
+            mArena = std::move(other.mArena);
+            mProcesses = std::move(other.mProcesses);
+            mSleeping = std::move(other.mSleeping);
+            mClock = other.mClock;
+            mSleepSequence = other.mSleepSequence;
+        }
+        return *this;
+    }
 
     // =========================================================================
     // Process registration
@@ -343,10 +953,17 @@ public:
     template <typename T, typename... Args>
     ProcessHandle<Delta, Data> attach(Args&&... args)
     {
-        auto proc = std::make_unique<T>(std::forward<Args>(args)...);
-        T* raw = proc.get();
+        ProcessArena* pool = &arena();
+        ProcessPtr proc = makeProcess<T, Delta, Data>(pool, std::forward<Args>(args)...);
+        IProcess<Delta, Data>* raw = proc.get();
         mProcesses.push_back(std::move(proc));
-        return ProcessHandle<Delta, Data>(raw);
+        return ProcessHandle<Delta, Data>(raw, pool);
+    }
+
+    /// @brief Attach a coroutine body as a top-level process (see CoProcess).
+    ProcessHandle<Delta, Data> attach(CoProcess<Delta, Data> body)
+    {
+        return attach<CoroutineProcess<Delta, Data>>(std::move(body));
     }
 
     // =========================================================================
@@ -357,47 +974,148 @@ public:
      * @brief Tick all live processes once.
      *
      * Completed processes are removed. Successful processes have their
-     * successor (if any) queued for the next update call.
+     * successor (if any) queued for the next update call. Processes
+     * attached from inside a tick start on the next update call.
+     * Sleepers whose wake time the advanced clock has reached are ticked
+     * again from this call on.
+     *
+     * If a tick throws, the list is compacted up to the throwing process
+     * (which is kept) before the exception propagates.
      *
      * @param delta Time step passed to each process.
      * @param data  Shared context (default: nullptr).
      */
     void update(Delta delta, Data data = Data{})
     {
-        // Process in-place: swap-and-pop for O(1) removal without invalidating
-        // indices of unvisited elements. Successors are collected and appended
-        // after the main loop so they start ticking from the next update call.
-        std::vector<ProcessPtr> successors;
+        advanceClock(delta);
 
+        // Tick and compact in one pass; retire() does the same from the
+        // flags recorded by updateParallel().
+        const std::size_t count = mProcesses.size();
+        std::size_t kept = 0;
         std::size_t i = 0;
-        while (i < mProcesses.size())
+        try
         {
-            bool stillRunning = mProcesses[i]->tick(delta, data);
+            for (; i < count; ++i)
+            {
+                if (mProcesses[i]->tick(delta, data))
+                {
+                    settle(kept, i);
+                }
+                else
+                {
+                    finish(i);
+                }
+            }
+        }
+        catch (...)
+        {
+            for (; i < count; ++i)
+            {
+                keep(kept++, i);
+            }
+            closeGap(kept, count);
+            throw;
+        }
+        closeGap(kept, count);
+    }
 
-            if (!stillRunning)
+    /**
+     * @brief Tick all live processes once, independent ones on pool.
+     *
+     * Processes whose type declares kIndependent are split into contiguous
+     * chunks (at least kMinParallelChunk each) and ticked on pool; the
+     * calling thread ticks the remaining processes in list order, then the
+     * last chunk. Removal and successor queueing happen afterwards on the
+     * calling thread, exactly as in update(), so the resulting process list
+     * does not depend on thread timing.
+     *
+     * data is shared by reference across threads: anything an independent
+     * process touches through it must be thread-safe. Independent processes
+     * must not attach processes to this scheduler.
+     *
+     * If a tick throws, every chunk is still joined, processes that
+     * finished this frame are retired as in update(), and the first
+     * exception is rethrown. The throwing process and any process not
+     * ticked because of it stay listed.
+     *
+     * @note Thread-safety: call from one thread; pool may be shared.
+     */
+    void updateParallel(fat_p::ThreadPool& pool, Delta delta, Data data = Data{})
+    {
+        advanceClock(delta);
+
+        // Entries a throwing tick skips stay 1, so retire() keeps them.
+        const std::size_t count = mProcesses.size();
+        mRunning.assign(count, 1);
+        mParallel.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (mProcesses[i]->independent())
+            {
+                mParallel.push_back({mProcesses[i].get(), i});
+            }
+        }
+
+        const std::size_t workers = std::max<std::size_t>(1, pool.thread_count());
+        const std::size_t chunk = std::max(kMinParallelChunk,
+                                           (mParallel.size() + workers - 1) / workers);
+        const std::size_t chunks = (mParallel.size() + chunk - 1) / chunk;
+
+        auto tickRange = [this, delta, &data](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t j = begin; j < end; ++j)
             {
-                if (mProcesses[i]->succeeded())
+                const Ticket& ticket = mParallel[j];
+                mRunning[ticket.index] = ticket.process->tick(delta, data) ? 1 : 0;
+            }
+        };
+
+        std::exception_ptr failure;
+        mFutures.clear();
+        try
+        {
+            for (std::size_t c = 0; c + 1 < chunks; ++c)
+            {
+                mFutures.push_back(pool.submit([&tickRange, c, chunk]
+                                               { tickRange(c * chunk, (c + 1) * chunk); }));
+            }
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (!mProcesses[i]->independent())
                 {
-                    auto next = mProcesses[i]->takeNext();
-                    if (next != nullptr)
-                    {
-                        successors.push_back(std::move(next));
-                    }
+                    mRunning[i] = mProcesses[i]->tick(delta, data) ? 1 : 0;
                 }
-                // Swap-and-pop
-                mProcesses[i] = std::move(mProcesses.back());
-                mProcesses.pop_back();
-                // Do NOT increment i — re-check the swapped-in element.
             }
-            else
+            if (chunks > 0)
+            {
+                tickRange((chunks - 1) * chunk, mParallel.size());
+            }
+        }
+        catch (...)
+        {
+            failure = std::current_exception();
+        }
+        for (auto& future : mFutures)
+        {
+            try
+            {
+                future.get();
+            }
+            catch (...)
             {
-                ++i;
+                if (!failure)
+                {
+                    failure = std::current_exception();
+                }
             }
         }
+        mFutures.clear();
 
-        for (auto& s : successors)
+        retire(count);
+        if (failure)
         {
-            mProcesses.push_back(std::move(s));
+            std::rethrow_exception(failure);
         }
     }
 
@@ -413,21 +1131,171 @@ public:
         {
             proc->abort();
         }
+        for (auto& sleeper : mSleeping)
+        {
+            sleeper.process->abort();
+        }
         mProcesses.clear();
+        mSleeping.clear();
     }
 
     // =========================================================================
     // Queries
     // =========================================================================
 
-    /// @brief Number of live processes (not counting queued successors).
-    [[nodiscard]] std::size_t size() const noexcept { return mProcesses.size(); }
+    /// @brief Number of live processes, sleeping ones included (not counting
+    ///        queued successors).
+    [[nodiscard]] std::size_t size() const noexcept { return mProcesses.size() + mSleeping.size(); }
 
     /// @brief True if no processes are currently live.
-    [[nodiscard]] bool empty() const noexcept { return mProcesses.empty(); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /// @brief Number of processes parked in the sleep queue.
+    [[nodiscard]] std::size_t sleepingCount() const noexcept { return mSleeping.size(); }
+
+    /// @brief Scheduler clock: the sum of all deltas passed to update(), in Clock.
+    [[nodiscard]] Clock clock() const noexcept { return mClock; }
+
+    /// @brief The pool attach()/then() allocate from.
+    [[nodiscard]] ProcessArena& arena()
+    {
+        if (mArena == nullptr)
+        {
+            mArena = std::make_unique<ProcessArena>();
+        }
+        return *mArena;
+    }
 
 private:
+    struct Ticket
+    {
+        IProcess<Delta, Data>* process;
+        std::size_t index;
+    };
+
+    struct Sleeper
+    {
+        Clock wake;
+        std::uint64_t sequence;
+        ProcessPtr process;
+    };
+
+    // Heap order for mSleeping: earliest wake (then earliest sleep) on top.
+    struct WakesLater
+    {
+        bool operator()(const Sleeper& a, const Sleeper& b) const noexcept
+        {
+            if (a.wake < b.wake || b.wake < a.wake)
+            {
+                return b.wake < a.wake;
+            }
+            return a.sequence > b.sequence;
+        }
+    };
+
+    // Stable compaction of the first count entries by mRunning.
+    void retire(std::size_t count)
+    {
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (mRunning[i] != 0)
+            {
+                settle(kept, i);
+            }
+            else
+            {
+                finish(i);
+            }
+        }
+        closeGap(kept, count);
+    }
+
+    void keep(std::size_t to, std::size_t from)
+    {
+        if (to != from)
+        {
+            mProcesses[to] = std::move(mProcesses[from]);
+        }
+    }
+
+    // Keep a still-running process, or park it if its tick asked to sleep.
+    void settle(std::size_t& kept, std::size_t i)
+    {
+        Delta duration{};
+        if (!mProcesses[i]->takeSleep(duration))
+        {
+            keep(kept++, i);
+            return;
+        }
+        mSleeping.push_back({mClock + static_cast<Clock>(duration), mSleepSequence++,
+                             std::move(mProcesses[i])});
+        std::push_heap(mSleeping.begin(), mSleeping.end(), WakesLater{});
+    }
+
+    // Move sleepers whose wake time has come back into the tick list, in
+    // wake order (ties in the order they fell asleep).
+    void advanceClock(Delta delta)
+    {
+        mClock += static_cast<Clock>(delta);
+        while (!mSleeping.empty() && !(mClock < mSleeping.front().wake))
+        {
+            std::pop_heap(mSleeping.begin(), mSleeping.end(), WakesLater{});
+            mProcesses.push_back(std::move(mSleeping.back().process));
+            mSleeping.pop_back();
+        }
+    }
+
+    // Queue the successor of a finished process, then free it.
+    void finish(std::size_t i)
+    {
+        if (mProcesses[i]->succeeded())
+        {
+            ProcessPtr next = mProcesses[i]->takeNext();
+            if (next != nullptr)
+            {
+                mSuccessors.push_back(std::move(next));
+            }
+        }
+        mProcesses[i].reset();
+    }
+
+    // Slide entries attached during the tick (index >= count) down behind
+    // the kept ones, then append successors in the order of their
+    // predecessors.
+    void closeGap(std::size_t kept, std::size_t count)
+    {
+        if (kept != count)
+        {
+            const std::size_t late = mProcesses.size() - count;
+            for (std::size_t i = 0; i < late; ++i)
+            {
+                mProcesses[kept + i] = std::move(mProcesses[count + i]);
+            }
+            mProcesses.resize(kept + late);
+        }
+
+        for (auto& next : mSuccessors)
+        {
+            mProcesses.push_back(std::move(next));
+        }
+        mSuccessors.clear();
+    }
+
+    // Declared first so it is destroyed last: processes free into it.
+    std::unique_ptr<ProcessArena> mArena = std::make_unique<ProcessArena>();
     std::vector<ProcessPtr> mProcesses;
+
+    // Sleep queue: min-heap of parked processes keyed by wake time.
+    std::vector<Sleeper> mSleeping;
+    Clock mClock{};
+    std::uint64_t mSleepSequence = 0;
+
+    // Per-update scratch, kept to avoid reallocating every frame.
+    std::vector<uint8_t> mRunning;
+    std::vector<Ticket> mParallel;
+    std::vector<std::future<void>> mFutures;
+    std::vector<ProcessPtr> mSuccessors;
 };
 
 } // namespace fatp_ecs
@@ -6,7 +6,9 @@
  */
 
 // FAT-P components used:
-// - SlotMap: Entity allocator with generational safety
+// - SlotMap: Entity allocator with generational safety. Slot reuse order
+//   follows SlotMap's free list unless setSlotRecycling() selects a policy,
+//   in which case create() claims the chosen slot with insert_at().
 // - FastHashMap: Type-erased component store registry
 // - SparseSetWithData: Per-component-type storage (via ComponentStore<T>)
 // - StrongId: Type-safe Entity handles (via Entity.h)
@@ -18,26 +20,40 @@
 #include <any>
 #include <array>
 #include <cassert>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <typeindex>
 #include <typeinfo>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <fat_p/BinaryLite.h>
 #include <fat_p/FastHashMap.h>
 #include <fat_p/SlotMap.h>
 #include <fat_p/SmallVector.h>
 
+#include "AdaptiveSort.h"
+#include "CompiledQuery.h"
 #include "ComponentMask.h"
+#include "ComponentReflection.h"
 #include "ComponentStore.h"
 #include "Entity.h"
+#include "EntityMap.h"
 #include "EventBus.h"
+#include "KeySort.h"
 #include "Observer.h"
 #include "NonOwningGroup.h"
 #include "OwningGroup.h"
 #include "RuntimeView.h"
+#include "SlotRecycling.h"
 #include "StoragePolicy.h"
 #include "TypeId.h"
 #include "View.h"
@@ -206,7 +222,15 @@ public:
 
     [[nodiscard]] Entity create()
     {
-        EntityHandle handle = mEntities.insert_fast(uint8_t{0});
+        const bool tracked = mFreeSlots.policy() != SlotRecycling::Default;
+        uint32_t slot = 0;
+        EntityHandle handle = (tracked && mFreeSlots.acquire(slot))
+                                  ? mEntities.insert_at(slot, uint8_t{0})
+                                  : mEntities.insert_fast(uint8_t{0});
+        if (tracked)
+        {
+            mFreeSlots.claim(handle.index);
+        }
         Entity entity = EntityTraits::make(handle.index, handle.generation);
         if (mEvents.onEntityCreated.slotCount() > 0)
         {
@@ -241,6 +265,10 @@ public:
     {
         const uint32_t hint_index = EntityTraits::index(hint);
         EntityHandle handle = mEntities.insert_at(hint_index, uint8_t{0});
+        if (mFreeSlots.policy() != SlotRecycling::Default)
+        {
+            mFreeSlots.claim(handle.index);
+        }
         Entity entity = EntityTraits::make(handle.index, handle.generation);
         if (mEvents.onEntityCreated.slotCount() > 0)
         {
@@ -249,6 +277,29 @@ public:
         return entity;
     }
 
+    /**
+     * @brief Create one entity per element of [first, last), writing each
+     *        new handle through the iterator.
+     *
+     * Equivalent to EnTT's registry.create(first, last). Pair with
+     * insert<T>() to build many identical entities.
+     *
+     * @example
+     * @code
+     *   std::vector<Entity> wave(100);
+     *   registry.create(wave.begin(), wave.end());
+     *   registry.insert<Health>(wave.begin(), wave.end(), Health{50, 50});
+     * @endcode
+     */
+    template <typename It>
+    void create(It first, It last)
+    {
+        for (; first != last; ++first)
+        {
+            *first = create();
+        }
+    }
+
     bool destroy(Entity entity)
     {
         if (!isAlive(entity))
@@ -267,15 +318,65 @@ public:
             it.value()->removeAndNotify(entity, mEvents);
         }
 
-        if (mEvents.onEntityDestroyed.slotCount() > 0)
+        releaseEntity(entity);
+        return true;
+    }
+
+    /**
+     * @brief Choose the order in which destroyed entity slots are reused.
+     *
+     * Set this before creating entities for the policy to cover every slot.
+     * Switching later rebuilds the free set from the live entities; slots
+     * freed above the highest live index are then reused in SlotMap order
+     * until the tracker has seen them.
+     *
+     * @param policy Recycling order (see SlotRecycling).
+     *
+     * @note Complexity: O(1) for Default; O(live entities) otherwise.
+     *
+     * @example
+     * @code
+     *   Registry registry;
+     *   registry.setSlotRecycling(SlotRecycling::LowestIndex);
+     * @endcode
+     */
+    void setSlotRecycling(SlotRecycling policy)
+    {
+        mFreeSlots.reset(policy);
+        if (policy == SlotRecycling::Default)
         {
-            mEvents.onEntityDestroyed.emit(entity);
+            return;
         }
 
-        EntityHandle handle{EntityTraits::index(entity),
-                            EntityTraits::generation(entity)};
-        mEntities.erase(handle);
-        return true;
+        std::vector<bool> alive;
+        for (const auto& entry : mEntities.entries())
+        {
+            const uint32_t index = entry.handle.index;
+            if (index >= alive.size())
+            {
+                alive.resize(static_cast<std::size_t>(index) + 1, false);
+            }
+            alive[index] = true;
+            mFreeSlots.claim(index);
+        }
+
+        // Lifo hands out the last release first; release descending so the
+        // lowest hole is reused first under every policy.
+        const uint32_t high = mFreeSlots.highWater();
+        for (uint32_t i = 0; i < high; ++i)
+        {
+            const uint32_t index = (policy == SlotRecycling::Lifo) ? high - 1 - i : i;
+            if (!alive[index])
+            {
+                mFreeSlots.release(index);
+            }
+        }
+    }
+
+    /// @brief Current slot recycling policy.
+    [[nodiscard]] SlotRecycling slotRecycling() const noexcept
+    {
+        return mFreeSlots.policy();
     }
 
     [[nodiscard]] bool isAlive(Entity entity) const noexcept
@@ -355,6 +456,38 @@ public:
         return *inserted;
     }
 
+    /**
+     * @brief Add a copy of @p value to every entity in [first, last).
+     *
+     * Equivalent to EnTT's registry.insert<T>(first, last, value). The store
+     * and its policy dispatch are resolved once for the whole range instead
+     * of once per entity. Entities that already have T keep their component
+     * and fire no event, as with add<T>(); every insertion fires
+     * onComponentAdded<T>.
+     *
+     * @note Complexity: O(n) in the range length.
+     */
+    template <typename T, typename It>
+    void insert(It first, It last, const T& value = T{})
+    {
+        static_assert(std::is_copy_constructible_v<T>,
+                      "insert<T>() copies value into every entity");
+        auto* store = ensureStore<T>();
+        auto* concrete = isDefaultPolicy(typeId<T>())
+                             ? static_cast<ComponentStore<T>*>(store)
+                             : nullptr;
+        for (; first != last; ++first)
+        {
+            const Entity entity = *first;
+            T* inserted = concrete != nullptr ? concrete->emplace(entity, value)
+                                              : store->addComponent(entity, value);
+            if (inserted != nullptr)
+            {
+                mEvents.emitComponentAdded<T>(entity, *inserted);
+            }
+        }
+    }
+
     /**
      * @brief Replace an existing component with new value(s), firing onComponentUpdated.
      *
@@ -904,6 +1037,166 @@ public:
         return rv;
     }
 
+    /**
+     * @brief Compile a runtime query into a persistent CompiledQuery.
+     *
+     * Same matching rules as runtimeView(), but the result is meant to be
+     * kept and reused every frame: store pointers are resolved once (types
+     * registered later are picked up on a later each()), the pivot is kept
+     * until sizes shift substantially, and each() probes membership through
+     * raw sparse arrays instead of a virtual has() per store per entity.
+     *
+     * @param include TypeIds of components entities must have.
+     * @param exclude TypeIds of components entities must not have (may be empty).
+     * @return CompiledQuery bound to this registry; must not outlive it.
+     *
+     * @example
+     * @code
+     *   auto query = registry.compileQuery(
+     *       {typeId<Position>(), typeId<Velocity>()},
+     *       {typeId<Frozen>()});
+     *   // every frame:
+     *   query.each([](Entity e) { ... });
+     * @endcode
+     */
+    [[nodiscard]] CompiledQuery
+    compileQuery(std::initializer_list<TypeId> include,
+                 std::initializer_list<TypeId> exclude = {})
+    {
+        return compileQuery(include.begin(), include.size(), exclude.begin(), exclude.size());
+    }
+
+    /**
+     * @brief Span-based overload of compileQuery for pre-built TypeId arrays.
+     */
+    [[nodiscard]] CompiledQuery
+    compileQuery(const TypeId* includeBegin, std::size_t includeCount,
+                 const TypeId* excludeBegin = nullptr,
+                 std::size_t   excludeCount = 0)
+    {
+        CompiledQuery query;
+        query.mRegistry = this;
+        query.mStoresSeen = mStores.size();
+        for (std::size_t i = 0; i < includeCount; ++i)
+        {
+            query.addSlot(query.mInclude, includeBegin[i], getStoreById(includeBegin[i]));
+        }
+        for (std::size_t i = 0; i < excludeCount; ++i)
+        {
+            query.addSlot(query.mExclude, excludeBegin[i], getStoreById(excludeBegin[i]));
+        }
+        return query;
+    }
+
+    // =========================================================================
+    // Reflection
+    // =========================================================================
+
+    /**
+     * @brief Reflect component type T under a stable name.
+     *
+     * Records size, alignment and trivial copyability; chain field() calls on
+     * the result to record data members. See ComponentReflection.
+     *
+     * @throws std::invalid_argument if the name or T is already reflected
+     *         differently.
+     *
+     * @example
+     * @code
+     *   registry.reflect<Position>("Position")
+     *       .field("x", &Position::x)
+     *       .field("y", &Position::y);
+     * @endcode
+     */
+    template <typename T>
+    ComponentReflection::Builder<T> reflect(std::string name)
+    {
+        return mReflection.reflect<T>(std::move(name));
+    }
+
+    [[nodiscard]] const ComponentReflection& reflection() const noexcept
+    {
+        return mReflection;
+    }
+
+    /**
+     * @brief runtimeView() by reflected component names.
+     *
+     * Names are resolved to TypeIds here, once. An unknown include name makes
+     * the view match nothing; an unknown exclude name is ignored.
+     *
+     * @example
+     * @code
+     *   auto view = registry.runtimeView({"Position", "Velocity"}, {"Frozen"});
+     * @endcode
+     */
+    // Templated so that runtimeView({}) still selects the TypeId overload.
+    template <typename Name = std::string_view>
+        requires std::convertible_to<const Name&, std::string_view>
+    [[nodiscard]] RuntimeView
+    runtimeView(std::initializer_list<Name> include,
+                std::initializer_list<Name> exclude = {})
+    {
+        const auto includeIds = typeIdsByName(include);
+        const auto excludeIds = typeIdsByName(exclude);
+        return runtimeView(includeIds.data(), includeIds.size(),
+                           excludeIds.data(), excludeIds.size());
+    }
+
+    /**
+     * @brief compileQuery() by reflected component names.
+     *
+     * Names are resolved when the query is compiled; a name reflected later
+     * is not picked up. Unknown names behave as in runtimeView(names).
+     */
+    template <typename Name = std::string_view>
+        requires std::convertible_to<const Name&, std::string_view>
+    [[nodiscard]] CompiledQuery
+    compileQuery(std::initializer_list<Name> include,
+                 std::initializer_list<Name> exclude = {})
+    {
+        const auto includeIds = typeIdsByName(include);
+        const auto excludeIds = typeIdsByName(exclude);
+        return compileQuery(includeIds.data(), includeIds.size(),
+                            excludeIds.data(), excludeIds.size());
+    }
+
+    /**
+     * @brief Untyped pointer to entity's component of type @p tid, or nullptr.
+     *
+     * For scripts holding a ComponentInfo: read fields with
+     * info->field("x")->in(ptr). One virtual call, no name lookup.
+     */
+    [[nodiscard]] void* tryGetRaw(TypeId tid, Entity entity) noexcept
+    {
+        IComponentStore* store = getStoreById(tid);
+        return store != nullptr ? store->rawComponent(entity) : nullptr;
+    }
+
+    /**
+     * @brief Zero-copy view of every component of type @p tid.
+     *
+     * data[i * stride] belongs to entities[i]. stride is sizeof the
+     * component, taken from the store, so reflection is not required; the
+     * span is empty for a type with no store. Bytes may be copied out wholesale only if the type is trivially
+     * copyable. Invalidated by any add or remove of that type.
+     */
+    [[nodiscard]] RawComponentSpan rawComponents(TypeId tid) noexcept
+    {
+        IComponentStore* store = getStoreById(tid);
+        if (store == nullptr)
+        {
+            const ComponentInfo* info = mReflection.find(tid);
+            return RawComponentSpan{nullptr, nullptr, 0, info != nullptr ? info->size : 0};
+        }
+        if (store->empty())
+        {
+            return RawComponentSpan{nullptr, nullptr, 0, store->componentSize()};
+        }
+        return RawComponentSpan{store->rawComponents(), store->denseEntities(),
+                                store->denseEntityCount(), store->componentSize()};
+    }
+
     // =========================================================================
     // Observers
     // =========================================================================
@@ -1169,6 +1462,95 @@ public:
         sortStore(*store, std::forward<Comparator>(comparator));
     }
 
+    /**
+     * @brief sort<T>(comparator) with an explicit SortMode.
+     *
+     * SortMode::Incremental is for stores that are re-sorted every frame and
+     * stay nearly sorted in between (depth order, spatial order, a few
+     * entities appended at the tail). An already-sorted store costs n - 1
+     * comparisons and is not modified; otherwise the misplaced entries are
+     * sorted and merged back (AdaptiveSort.h) and only the entries that
+     * moved are relocated. The result is a stable sort. SortMode::Full is
+     * identical to sort<T>(comparator).
+     *
+     * @note Same group-ownership caveat as sort<T>(comparator).
+     *
+     * @example
+     * @code
+     *   // Every frame, after movement updated Depth:
+     *   registry.sort<Depth>([](const Depth& a, const Depth& b) { return a.z < b.z; },
+     *                        SortMode::Incremental);
+     * @endcode
+     */
+    template <typename T, typename Comparator>
+    void sort(Comparator&& comparator, SortMode mode)
+    {
+        if (mode == SortMode::Full)
+        {
+            sort<T>(std::forward<Comparator>(comparator));
+            return;
+        }
+        auto* store = getStore<T>();
+        if (store == nullptr || store->size() <= 1)
+        {
+            return;
+        }
+        sortStoreIncremental(*store, comparator);
+    }
+
+    /**
+     * @brief Sort component store T's dense array by an extracted key.
+     *
+     * keyFn maps each component to an integer or floating-point key
+     * (RadixKey). Keys are extracted once into a contiguous array and sorted
+     * ascending with a stable LSD radix sort (KeySort.h), and the resulting
+     * permutation is applied in one pass on the concrete store. Cost is
+     * O(n * sizeof(key)) with no per-comparison virtual calls; equal keys
+     * keep their previous relative order.
+     *
+     * @tparam T     Component type whose store is sorted.
+     * @tparam KeyFn Callable with signature Key(const T&).
+     *
+     * @note Same group-ownership caveat as sort<T>(comparator).
+     *
+     * @example
+     * @code
+     *   registry.sort_by_key<Position>([](const Position& p) {
+     *       return mortonCode(p.x, p.y);   // uint32_t
+     *   });
+     *   registry.sort_by_key<RenderDepth>([](const RenderDepth& d) { return -d.z; });
+     * @endcode
+     */
+    template <typename T, typename KeyFn>
+    void sort_by_key(KeyFn&& keyFn)
+    {
+        auto* store = getStore<T>();
+        if (store == nullptr || store->size() <= 1)
+        {
+            return;
+        }
+        sortStoreByKey(*store, keyFn, nullptr, 0);
+    }
+
+    /**
+     * @brief sort_by_key<T>() with key extraction and radix passes split
+     *        across scheduler's pool.
+     *
+     * The result is identical to the serial overload. keyFn is called
+     * concurrently and must be safe to call from several threads. Stores
+     * smaller than two chunks of minChunkSize sort serially.
+     */
+    template <typename T, typename KeyFn>
+    void sort_by_key(KeyFn&& keyFn, Scheduler& scheduler, std::size_t minChunkSize = 16384)
+    {
+        auto* store = getStore<T>();
+        if (store == nullptr || store->size() <= 1)
+        {
+            return;
+        }
+        sortStoreByKey(*store, keyFn, &scheduler, minChunkSize);
+    }
+
     /**
      * @brief Sort store B so its entities appear in the same relative order
      *        as they do in store A.
@@ -1215,6 +1597,49 @@ public:
         sortStoreToMatch(*pivotStore, *followStore);
     }
 
+    /**
+     * @brief Align several follower stores to Pivot in one traversal.
+     *
+     * Afterwards every entity that has Pivot and all of Fs... sits at the
+     * same dense index [0, k) in all of those stores, in Pivot's relative
+     * order. View<Pivot, Fs...> then reads every component array front to
+     * back instead of jumping through each store's sparse array.
+     *
+     * Unlike sort<A, B>(), Pivot itself is reordered too, but only by a
+     * stable partition: entities with every follower move to the front, the
+     * rest keep their relative order behind them. Within each follower,
+     * entities that share Pivot but not every follower come next, in Pivot
+     * order; entities absent from Pivot follow in unspecified order.
+     *
+     * Followers are looked up through raw sparse/dense pointers fetched once
+     * and swapped into place during the same walk of Pivot, so aligning N
+     * followers reads Pivot once instead of N times, with one virtual call
+     * per swap instead of two per entity per follower.
+     *
+     * @note Do NOT use on group-owned stores (see sort<T> caveat above).
+     * @note If any of the types is unregistered, this is a no-op.
+     *
+     * @example
+     * @code
+     *   registry.sort<Transform>(byDepth);
+     *   registry.align<Transform, Velocity, Sprite, Collider>();
+     *   // view<Transform, Velocity, Sprite, Collider>() now walks four
+     *   // arrays in lockstep.
+     * @endcode
+     */
+    template <typename Pivot, typename... Fs>
+    void align()
+    {
+        static_assert(sizeof...(Fs) > 0, "align: name at least one follower store");
+        auto* pivotStore = getStore<Pivot>();
+        if (pivotStore == nullptr || ((getStore<Fs>() == nullptr) || ...))
+        {
+            return;
+        }
+        std::tuple<AlignCursor<Fs>...> cursors{AlignCursor<Fs>(*getStore<Fs>())...};
+        alignStores(*pivotStore, cursors, std::index_sequence_for<Fs...>{});
+    }
+
     // =========================================================================
     // Bulk Operations
     // =========================================================================
@@ -1226,6 +1651,10 @@ public:
             it.value()->clear();
         }
         mEntities.clear();
+        if (mFreeSlots.policy() != SlotRecycling::Default)
+        {
+            mFreeSlots.releaseAll();
+        }
 
         // Reset group membership state. Component stores and entity allocator
         // are now empty, so group iterators must not walk stale indices.
@@ -1260,12 +1689,17 @@ public:
         {
             return; // type never registered — nothing to do
         }
-        // Collect entities first: modifying store during iteration is unsafe.
-        const auto& dense = store->dense();
-        std::vector<Entity> targets(dense.begin(), dense.end());
-        for (Entity entity : targets)
+        // Remove from the back: swap-and-pop of the last dense slot never
+        // moves an entity we have not visited yet, so no scratch copy of the
+        // dense array is needed. The bound is re-checked every step because
+        // onComponentRemoved listeners may remove further instances of T.
+        for (std::size_t i = store->dense().size(); i > 0; --i)
         {
-            remove<T>(entity); // fires onComponentRemoved
+            const auto& dense = store->dense();
+            if (i - 1 < dense.size())
+            {
+                remove<T>(dense[i - 1]); // fires onComponentRemoved
+            }
         }
     }
 
@@ -1328,8 +1762,8 @@ public:
      *
      * @return Number of components copied. 0 if src has no components or is not alive.
      *
-     * @note For cross-registry copy, use Snapshot/SnapshotLoader or manually
-     *       iterate allEntities() + component accessors.
+     * @note To move entities into another registry, use migrate() / merge()
+     *       (Migration.h); for a persistent copy, use Snapshot/SnapshotLoader.
      * @note Thread-safety: NOT thread-safe.
      */
     std::size_t copy(Entity src, Entity dst)
@@ -1485,6 +1919,32 @@ public:
     [[nodiscard]] ConstHandle constHandle(Entity entity) const noexcept;
 
 private:
+    /// Bulk cross-registry move; needs the store table and releaseEntity().
+    friend EntityMap migrate(Registry& src, Registry& dst, const Entity* entities,
+                             std::size_t count);
+
+    // =========================================================================
+    // Internal: Entity release
+    // =========================================================================
+
+    /// @brief Tail of destroy(): fire onEntityDestroyed and free the slot.
+    /// The entity must be alive and already stripped of all components.
+    void releaseEntity(Entity entity)
+    {
+        if (mEvents.onEntityDestroyed.slotCount() > 0)
+        {
+            mEvents.onEntityDestroyed.emit(entity);
+        }
+
+        EntityHandle handle{EntityTraits::index(entity),
+                            EntityTraits::generation(entity)};
+        mEntities.erase(handle);
+        if (mFreeSlots.policy() != SlotRecycling::Default)
+        {
+            mFreeSlots.release(handle.index);
+        }
+    }
+
     // =========================================================================
     // Internal: Store Management
     // =========================================================================
@@ -1578,58 +2038,100 @@ private:
      * @brief Indirect-sort a ComponentStore<T> by a comparator.
      *
      * 1. Build permutation perm[0..n-1] = {0, 1, ..., n-1}.
-     * 2. std::sort perm by comparator(data[perm[i]], data[perm[j]]).
-     * 3. Apply the permutation in-place using cycle decomposition:
-     *    each dense index is visited at most twice — once to start the cycle,
-     *    once to close it — so the total number of swapDenseEntries calls is O(n).
-     *
-     * The cycle-decomposition trick avoids the O(n²) swap count that a naive
-     * selection sort would incur.
+     * 2. std::sort perm by comparator(data[perm[i]], data[perm[j]]), reading
+     *    the component array through one pre-fetched raw pointer.
+     * 3. Apply the permutation in place with permute(), one swap per
+     *    misplaced entry.
      */
     template <typename T, typename Comparator>
     static void sortStore(TypedIComponentStore<T>& store, Comparator&& comparator)
     {
         const std::size_t n = store.size();
+        assert(n <= std::numeric_limits<std::uint32_t>::max() &&
+               "sort: store too large for 32-bit dense indices");
+        const T* data = store.componentDataPtr();
 
-        // Build permutation sorted by comparator applied to component data.
-        std::vector<std::size_t> perm(n);
-        for (std::size_t i = 0; i < n; ++i) perm[i] = i;
+        std::vector<std::uint32_t> perm(n);
+        for (std::size_t i = 0; i < n; ++i) perm[i] = static_cast<std::uint32_t>(i);
 
         std::sort(perm.begin(), perm.end(),
-                  [&](std::size_t a, std::size_t b) {
-                      return comparator(store.dataAtUnchecked(a),
-                                        store.dataAtUnchecked(b));
+                  [&](std::uint32_t a, std::uint32_t b) {
+                      return comparator(data[a], data[b]);
                   });
 
-        // Apply permutation via cycle decomposition.
-        // visited[i] = true once index i has been placed in its final position.
-        std::vector<bool> visited(n, false);
+        store.permute(perm.data());
+    }
 
-        for (std::size_t i = 0; i < n; ++i)
+    /**
+     * @brief Adaptive sort of a nearly-sorted ComponentStore<T> (see
+     *        sort(comparator, SortMode)).
+     *
+     * adaptiveSortOrder() returns early for a sorted store; otherwise
+     * permute() applies the order in place, leaving fixed points untouched.
+     */
+    template <typename T, typename Comparator>
+    static void sortStoreIncremental(TypedIComponentStore<T>& store, Comparator& comparator)
+    {
+        const std::size_t n = store.size();
+        assert(n <= std::numeric_limits<std::uint32_t>::max() &&
+               "sort: store too large for 32-bit dense indices");
+        const T* data = store.componentDataPtr();
+
+        std::vector<std::uint32_t> order;
+        const bool changed = adaptiveSortOrder(n, order,
+            [&](std::uint32_t a, std::uint32_t b) { return comparator(data[a], data[b]); });
+        if (!changed)
         {
-            if (visited[i] || perm[i] == i)
-            {
-                visited[i] = true;
-                continue;
-            }
+            return;
+        }
+
+        store.permute(order.data());
+    }
+
+    /**
+     * @brief Radix-sort a ComponentStore<T> by keyFn (see sort_by_key()).
+     *
+     * Extracts keys from the raw component array, radix-sorts (key, index)
+     * pairs, then applies the permutation in place with permute(). A null
+     * scheduler runs everything on the calling thread.
+     */
+    template <typename T, typename KeyFn>
+    static void sortStoreByKey(TypedIComponentStore<T>& store, KeyFn& keyFn,
+                               Scheduler* scheduler, std::size_t minChunkSize)
+    {
+        using Key = std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>;
+        static_assert(RadixKey<Key>,
+                      "sort_by_key: keyFn must return an integer (not bool), float or double");
+        using Bits = RadixBits<Key>;
+
+        const std::size_t n = store.size();
+        assert(n <= std::numeric_limits<std::uint32_t>::max() &&
+               "sort_by_key: store too large for 32-bit dense indices");
+        const T* data = store.componentDataPtr();
 
-            // Follow the cycle starting at i.
-            std::size_t current = i;
-            while (!visited[current])
+        std::vector<Bits> keys(n);
+        std::vector<std::uint32_t> order(n);
+        auto extract = [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
             {
-                const std::size_t next = perm[current];
-                visited[current] = true;
-                if (next != i && !visited[next])
-                {
-                    store.swapDenseEntries(current, next);
-                    current = next;
-                }
-                else
-                {
-                    break;
-                }
+                keys[i] = toRadixBits<Key>(keyFn(data[i]));
+                order[i] = static_cast<std::uint32_t>(i);
             }
+        };
+
+        if (scheduler != nullptr)
+        {
+            scheduler->parallel_for(n, extract, minChunkSize);
+            radixSortKeys(keys, order, sizeof(Key), *scheduler, minChunkSize);
+        }
+        else
+        {
+            extract(0, n);
+            radixSortKeys(keys, order, sizeof(Key));
         }
+
+        store.permute(order.data());
     }
 
     /**
@@ -1668,6 +2170,116 @@ private:
         }
     }
 
+    /**
+     * @brief One follower's side of align(): lookup pointers fetched once,
+     *        plus the next dense slot to fill.
+     *
+     * swapDenseEntries() never reallocates, so the pointers stay valid and
+     * observe every swap made through the store.
+     */
+    template <typename T>
+    struct AlignCursor
+    {
+        TypedIComponentStore<T>* store;
+        const uint32_t* sparseData;
+        std::size_t     sparseSize;
+        const Entity*   denseData;
+        std::size_t     denseSize;
+        std::size_t     next = 0;
+
+        explicit AlignCursor(TypedIComponentStore<T>& s) noexcept
+            : store(&s)
+            , sparseData(s.sparsePtr())
+            , sparseSize(s.sparseCount())
+            , denseData(s.densePtr())
+            , denseSize(s.denseCount())
+        {
+        }
+
+        /// Dense index of entity, or denseSize if absent.
+        [[nodiscard]] std::size_t find(Entity entity) const noexcept
+        {
+            const uint32_t sparseIdx = EntityIndex::index(entity);
+            if (sparseIdx >= sparseSize) return denseSize;
+            const uint32_t denseIdx = sparseData[sparseIdx];
+            if (denseIdx >= denseSize || denseData[denseIdx] != entity) return denseSize;
+            return denseIdx;
+        }
+
+        /// Swap the entry at denseIdx into the next slot.
+        void take(std::size_t denseIdx) noexcept
+        {
+            if (denseIdx != next)
+            {
+                store->swapDenseEntries(denseIdx, next);
+            }
+            ++next;
+        }
+    };
+
+    /**
+     * @brief Implementation of align(); follower I is std::get<I>(cursors).
+     *
+     * Pass 1 walks the pivot's dense array once. An entity found in every
+     * follower is swapped into each follower's next slot on the spot, so the
+     * fully shared block forms at [0, k) everywhere; other pivot entities are
+     * remembered. Pass 2 walks only those and moves each into the followers
+     * that have it. Finally the pivot is stably partitioned with permute(),
+     * which is skipped when the shared block is already its prefix.
+     */
+    template <typename Pivot, typename Cursors, std::size_t... Is>
+    static void alignStores(TypedIComponentStore<Pivot>& pivotStore, Cursors& cursors,
+                            std::index_sequence<Is...>)
+    {
+        const std::size_t pivotCount = pivotStore.size();
+        assert(pivotCount <= std::numeric_limits<std::uint32_t>::max() &&
+               "align: store too large for 32-bit dense indices");
+        const Entity* pivotEnts = pivotStore.densePtr();
+
+        std::vector<std::uint32_t> pivotOrder;
+        std::vector<std::uint32_t> partial;
+        pivotOrder.reserve(pivotCount);
+        std::array<std::size_t, sizeof...(Is)> found{};
+
+        for (std::size_t pi = 0; pi < pivotCount; ++pi)
+        {
+            const Entity entity = pivotEnts[pi];
+            const bool shared =
+                ((found[Is] = std::get<Is>(cursors).find(entity),
+                  found[Is] != std::get<Is>(cursors).denseSize) && ...);
+            if (shared)
+            {
+                (std::get<Is>(cursors).take(found[Is]), ...);
+                pivotOrder.push_back(static_cast<std::uint32_t>(pi));
+            }
+            else
+            {
+                partial.push_back(static_cast<std::uint32_t>(pi));
+            }
+        }
+
+        auto takeIfPresent = [](auto& cursor, Entity entity)
+        {
+            const std::size_t denseIdx = cursor.find(entity);
+            if (denseIdx != cursor.denseSize)
+            {
+                cursor.take(denseIdx);
+            }
+        };
+        for (const std::uint32_t pi : partial)
+        {
+            (takeIfPresent(std::get<Is>(cursors), pivotEnts[pi]), ...);
+        }
+
+        const std::size_t sharedCount = pivotOrder.size();
+        if (sharedCount != 0 && sharedCount != pivotCount &&
+            pivotOrder[sharedCount - 1] != sharedCount - 1)
+        {
+            pivotOrder.insert(pivotOrder.end(), partial.begin(), partial.end());
+            pivotStore.permute(pivotOrder.data());
+        }
+    }
+
     // =========================================================================
     // Observer trigger dispatch
     // =========================================================================
@@ -1758,6 +2370,10 @@ private:
     /// bytes (5x less memory, 5x less cache pressure on create).
     fat_p::SlotMap<uint8_t> mEntities;
 
+    /// @brief Free-slot order for non-default SlotRecycling policies.
+    /// Inactive (and never touched) under SlotRecycling::Default.
+    FreeSlotTracker mFreeSlots;
+
     fat_p::FastHashMap<TypeId, std::unique_ptr<IComponentStore>> mStores;
     EventBus mEvents;
 
@@ -1768,6 +2384,9 @@ private:
     /// @brief Flat array cache for O(1) component store lookup by TypeId.
     std::array<IComponentStore*, kStoreCacheSize> mStoreCache{};
 
+    /// @brief Name-keyed component metadata (reflect<T>(), name-based queries).
+    ComponentReflection mReflection;
+
     /// @brief Tracks TypeIds registered with a custom storage policy via useStorage<T,P>().
     /// TypeIds NOT in this set were created by ensureStore<T>() with DefaultStoragePolicy,
     /// so their IComponentStore* can be safely downcast to ComponentStore<T>*.
@@ -1786,9 +2405,26 @@ private:
     fat_p::FastHashMap<TypeId, bool> mOwnedTypes;
 
     // =========================================================================
-    // Store lookup by TypeId (used by runtimeView())
+    // Store lookup by TypeId (used by runtimeView() and CompiledQuery)
     // =========================================================================
 
+    friend class CompiledQuery;
+
+    /// TypeIds for reflected names; unknown names map to kInvalidTypeId.
+    template <typename Name>
+    [[nodiscard]] std::vector<TypeId>
+    typeIdsByName(std::initializer_list<Name> names) const
+    {
+        std::vector<TypeId> ids;
+        ids.reserve(names.size());
+        for (const Name& name : names)
+        {
+            const ComponentInfo* info = mReflection.find(name);
+            ids.push_back(info != nullptr ? info->type : kInvalidTypeId);
+        }
+        return ids;
+    }
+
     [[nodiscard]] IComponentStore* getStoreById(TypeId tid) noexcept
     {
         if (tid < kStoreCacheSize && mStoreCache[tid] != nullptr)
@@ -1809,4 +2445,36 @@ private:
     }
 };
 
+// =============================================================================
+// CompiledQuery — out-of-line (needs the complete Registry)
+// =============================================================================
+
+inline void CompiledQuery::resolvePending()
+{
+    // Stores are never removed, so an unchanged count means nothing new.
+    const std::size_t stores = mRegistry->mStores.size();
+    if (stores == mStoresSeen)
+    {
+        return;
+    }
+    mStoresSeen = stores;
+
+    auto resolve = [&](fat_p::SmallVector<Slot, 8>& slots)
+    {
+        for (Slot& slot : slots)
+        {
+            if (slot.store == nullptr && slot.tid != kInvalidTypeId)
+            {
+                slot.store = mRegistry->getStoreById(slot.tid);
+                if (slot.store != nullptr)
+                {
+                    --mUnresolved;
+                }
+            }
+        }
+    };
+    resolve(mInclude);
+    resolve(mExclude);
+}
+
 } // namespace fatp_ecs
@@ -15,33 +15,105 @@
 //    masks. The scheduler uses BitSet intersection to identify non-conflicting
 //    systems and runs them concurrently on the ThreadPool. Greedy batching:
 //    collect all runnable non-conflicting systems, submit, wait, repeat.
+//    The batch plan is computed once and cached until the system list
+//    changes. Single-system batches run inline, so a frame of serial batches
+//    allocates nothing; larger batches pay only for ThreadPool::submit.
 //
 // 2. Data-level (Scheduler::parallel_for): A single system's iteration is
 //    split across threads. The dense array is partitioned into chunks, each
 //    processed by a different worker. The calling thread processes the last
 //    chunk to avoid idle-waiting.
+//
+// Per-thread scratch (SystemContext::arena): the scheduler owns one
+// FrameArena per pool worker plus one for the driving thread. A thread is
+// bound to its arena on first use and remembers the binding in a small
+// thread_local cache of (schedulerId, arena) slots, so steady-state lookups
+// are a few compares and a load — no lock, no hashing — even for a thread
+// that alternates between several schedulers (e.g. a main thread that also
+// drives a second scheduler's parallel passes). Because each arena is only
+// ever touched by its own thread,
+// systems and parallel_for chunks can allocate scratch without
+// synchronization. All arenas are reset together at the end of run(), after
+// every system (and every chunk it spawned) has finished.
+//
+// Profiling (setProfilingEnabled): run() records each system's wall time
+// into a slot indexed by registration order. Each slot is written only by
+// the thread executing that system, so no synchronization is needed; the
+// driving thread reads them after run() returns. Disabled by default, in
+// which case run() takes no clock readings at all.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 #include <fat_p/ThreadPool.h>
 
 #include "ComponentMask.h"
 #include "Entity.h"
+#include "FrameArena.h"
 
 namespace fatp_ecs
 {
 
 class Registry;
+class Scheduler;
 
 template <typename IncludePack, typename ExcludePack>
 class ViewImpl;
 
+// =============================================================================
+// System Context
+// =============================================================================
+
+/**
+ * @brief Execution context handed to every system run by a Scheduler.
+ *
+ * Provides access to the owning scheduler (for parallel_for) and to the
+ * calling thread's FrameArena. The context is valid only for the duration
+ * of the system call.
+ *
+ * @note Thread-safety: arena() may be called concurrently from any thread
+ *       executing on behalf of the scheduler; each thread gets its own arena.
+ */
+class SystemContext
+{
+public:
+    explicit SystemContext(Scheduler& scheduler) noexcept
+        : mScheduler(scheduler)
+    {
+    }
+
+    /// @brief The scheduler running this system.
+    [[nodiscard]] Scheduler& scheduler() const noexcept
+    {
+        return mScheduler;
+    }
+
+    /**
+     * @brief Returns the calling thread's frame arena.
+     *
+     * Call this inside each parallel_for chunk rather than hoisting it out
+     * of the chunk: the arena is per-thread, not per-system. Memory is
+     * valid until the enclosing Scheduler::run() returns.
+     */
+    [[nodiscard]] FrameArena& arena() const;
+
+private:
+    Scheduler& mScheduler;
+};
+
 // =============================================================================
 // System Descriptor
 // =============================================================================
@@ -53,7 +125,7 @@ class ViewImpl;
 struct SystemDescriptor
 {
     std::string name;
-    std::function<void(Registry&)> execute;
+    std::function<void(Registry&, SystemContext&)> execute;
     ComponentMask writeMask;
     ComponentMask readMask;
 
@@ -85,35 +157,75 @@ public:
     /**
      * @brief Construct a scheduler with its own ThreadPool.
      *
-     * @param numThreads Number of worker threads (0 = hardware_concurrency).
+     * @param numThreads     Number of worker threads (0 = hardware_concurrency).
+     * @param arenaBlockSize Block size of each per-thread FrameArena.
      */
-    explicit Scheduler(std::size_t numThreads = 0)
+    explicit Scheduler(std::size_t numThreads = 0,
+                       std::size_t arenaBlockSize = FrameArena::kDefaultBlockSize)
         : mPool(numThreads, /*spin_us=*/500)
+        , mId(sNextId.fetch_add(1, std::memory_order_relaxed))
+        , mArenaBlockSize(arenaBlockSize)
     {
+        // One arena per worker plus one for the thread that drives run().
+        const std::size_t arenaCount = mPool.thread_count() + 1;
+        mArenas.reserve(arenaCount);
+        for (std::size_t i = 0; i < arenaCount; ++i)
+        {
+            mArenas.push_back(std::make_unique<FrameArena>(mArenaBlockSize));
+        }
     }
 
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+    Scheduler(Scheduler&&) = delete;
+    Scheduler& operator=(Scheduler&&) = delete;
+
     /**
      * @brief Register a system for scheduled execution.
      *
+     * @tparam Func Callable with signature void(Registry&, SystemContext&)
+     *              or void(Registry&).
      * @param name      Debug name for the system.
      * @param execute   The system function.
      * @param writeMask Components this system writes.
      * @param readMask  Components this system reads.
      */
+    template <typename Func>
     void addSystem(std::string name,
-                   std::function<void(Registry&)> execute,
+                   Func&& execute,
                    ComponentMask writeMask = {},
                    ComponentMask readMask = {})
     {
+        std::function<void(Registry&, SystemContext&)> fn;
+        if constexpr (std::is_invocable_v<Func&, Registry&, SystemContext&>)
+        {
+            fn = std::forward<Func>(execute);
+        }
+        else
+        {
+            static_assert(std::is_invocable_v<Func&, Registry&>,
+                          "System must be callable as void(Registry&, SystemContext&) "
+                          "or void(Registry&)");
+            fn = [f = std::forward<Func>(execute)](Registry& reg, SystemContext&) mutable {
+                f(reg);
+            };
+        }
+
         mSystems.push_back({
             std::move(name),
-            std::move(execute),
+            std::move(fn),
             std::move(writeMask),
             std::move(readMask),
         });
+        mPlanDirty = true;
     }
 
     /// @brief Execute all registered systems with dependency-based parallelism.
+    /// All per-thread frame arenas are reset once every system has finished.
+    ///
+    /// If a system throws, the rest of its batch still runs to completion,
+    /// later batches are skipped, the arenas are reset and the first
+    /// exception is rethrown.
     void run(Registry& registry)
     {
         if (mSystems.empty())
@@ -121,74 +233,40 @@ public:
             return;
         }
 
-        std::vector<bool> completed(mSystems.size(), false);
-        std::size_t completedCount = 0;
-
-        while (completedCount < mSystems.size())
+        SystemContext ctx(*this);
+        if (mProfiling)
         {
-            // Collect non-conflicting systems for this batch
-            std::vector<std::size_t> batch;
-            ComponentMask batchWriteMask;
-            ComponentMask batchReadMask;
-
-            for (std::size_t i = 0; i < mSystems.size(); ++i)
-            {
-                if (completed[i])
-                {
-                    continue;
-                }
-
-                const auto& sys = mSystems[i];
-
-                bool canRun = true;
-                if (sys.writeMask.intersects(batchReadMask) ||
-                    sys.writeMask.intersects(batchWriteMask))
-                {
-                    canRun = false;
-                }
-                if (canRun && sys.readMask.intersects(batchWriteMask))
-                {
-                    canRun = false;
-                }
-
-                if (canRun)
-                {
-                    batch.push_back(i);
-                    batchWriteMask |= sys.writeMask;
-                    batchReadMask |= sys.readMask;
-                }
-            }
+            mLastSystemNs.assign(mSystems.size(), 0);
+        }
+        if (mPlanDirty)
+        {
+            buildBatchPlan();
+        }
 
-            // Execute the batch
-            if (batch.size() == 1)
-            {
-                mSystems[batch[0]].execute(registry);
-            }
-            else
+        std::size_t begin = 0;
+        try
+        {
+            for (std::size_t end : mBatchEnds)
             {
-                std::vector<std::future<void>> futures;
-                futures.reserve(batch.size());
-
-                for (std::size_t idx : batch)
+                // Execute the batch
+                if (end - begin == 1)
                 {
-                    futures.push_back(
-                        mPool.submit([&registry, &sys = mSystems[idx]]() {
-                            sys.execute(registry);
-                        }));
+                    executeSystem(mBatchOrder[begin], registry, ctx);
                 }
-
-                for (auto& f : futures)
+                else
                 {
-                    f.get();
+                    runBatch(begin, end, registry, ctx);
                 }
+                begin = end;
             }
-
-            for (std::size_t idx : batch)
-            {
-                completed[idx] = true;
-            }
-            completedCount += batch.size();
         }
+        catch (...)
+        {
+            resetFrameArenas();
+            throw;
+        }
+
+        resetFrameArenas();
     }
 
     /**
@@ -262,6 +340,45 @@ public:
     void clearSystems() noexcept
     {
         mSystems.clear();
+        mLastSystemNs.clear();
+        mPlanDirty = true;
+    }
+
+    /// @brief Debug name of the system at registration index @p index.
+    [[nodiscard]] const std::string& systemName(std::size_t index) const
+    {
+        return mSystems.at(index).name;
+    }
+
+    // =========================================================================
+    // Profiling
+    // =========================================================================
+
+    /**
+     * @brief Enable or disable per-system timing in run().
+     *
+     * @note Thread-safety: NOT thread-safe. Do not call during run().
+     */
+    void setProfilingEnabled(bool enabled) noexcept
+    {
+        mProfiling = enabled;
+    }
+
+    [[nodiscard]] bool profilingEnabled() const noexcept
+    {
+        return mProfiling;
+    }
+
+    /**
+     * @brief Wall time of each system during the most recent profiled run().
+     *
+     * Indexed by registration order (see systemName()) and sized to the
+     * system count at that run. Empty if no profiled run has happened since
+     * construction or the last clearSystems().
+     */
+    [[nodiscard]] const std::vector<uint64_t>& lastSystemTimesNs() const noexcept
+    {
+        return mLastSystemNs;
     }
 
     /// @brief Direct access to the underlying ThreadPool.
@@ -270,9 +387,245 @@ public:
         return mPool;
     }
 
+    // =========================================================================
+    // Per-thread frame arenas
+    // =========================================================================
+
+    /**
+     * @brief Returns the calling thread's frame arena.
+     *
+     * The first call from a thread binds it to a free arena (under a lock).
+     * Each thread caches its bindings for the last kArenaCacheSlots
+     * schedulers it used; lookups that hit the cache are lock-free.
+     *
+     * @note Complexity: O(1) while a thread uses at most kArenaCacheSlots
+     *       schedulers; otherwise a miss costs a lock and a scan of the
+     *       scheduler's threads.
+     * @note Thread-safety: Safe to call concurrently from any thread.
+     */
+    [[nodiscard]] FrameArena& frameArena()
+    {
+        ArenaCache& cache = threadArenaCache();
+        for (const ArenaBinding& binding : cache.slots)
+        {
+            if (binding.schedulerId == mId)
+            {
+                return *binding.arena;
+            }
+        }
+
+        FrameArena* arena = bindCallingThread();
+        cache.slots[cache.next] = ArenaBinding{mId, arena};
+        cache.next = (cache.next + 1) % kArenaCacheSlots;
+        return *arena;
+    }
+
+    /// @brief Schedulers whose arena binding each thread keeps lock-free.
+    static constexpr std::size_t kArenaCacheSlots = 4;
+
+    /**
+     * @brief Reset every per-thread arena. Called automatically by run().
+     *
+     * Call manually when parallel_for is used outside run().
+     *
+     * @note Thread-safety: NOT thread-safe. No thread may be using an arena.
+     */
+    void resetFrameArenas() noexcept
+    {
+        for (auto& arena : mArenas)
+        {
+            arena->reset();
+        }
+    }
+
+    /// @brief Number of per-thread arenas currently owned.
+    [[nodiscard]] std::size_t frameArenaCount() const noexcept
+    {
+        return mArenas.size();
+    }
+
 private:
+    // Greedy batching: sweep the not-yet-scheduled systems in registration
+    // order, admitting each one that conflicts with nothing already in the
+    // batch; repeat until every system is placed. The plan depends only on
+    // the registered masks, so run() reuses it until the system list changes.
+    void buildBatchPlan()
+    {
+        mBatchOrder.clear();
+        mBatchEnds.clear();
+        mBatchOrder.reserve(mSystems.size());
+
+        std::vector<bool> scheduled(mSystems.size(), false);
+        while (mBatchOrder.size() < mSystems.size())
+        {
+            // Collect non-conflicting systems for this batch
+            ComponentMask batchWriteMask;
+            ComponentMask batchReadMask;
+
+            for (std::size_t i = 0; i < mSystems.size(); ++i)
+            {
+                if (scheduled[i])
+                {
+                    continue;
+                }
+
+                const auto& sys = mSystems[i];
+
+                bool canRun = true;
+                if (sys.writeMask.intersects(batchReadMask) ||
+                    sys.writeMask.intersects(batchWriteMask))
+                {
+                    canRun = false;
+                }
+                if (canRun && sys.readMask.intersects(batchWriteMask))
+                {
+                    canRun = false;
+                }
+
+                if (canRun)
+                {
+                    mBatchOrder.push_back(i);
+                    scheduled[i] = true;
+                    batchWriteMask |= sys.writeMask;
+                    batchReadMask |= sys.readMask;
+                }
+            }
+            mBatchEnds.push_back(mBatchOrder.size());
+        }
+
+        mFutures.reserve(mSystems.size());
+        mPlanDirty = false;
+    }
+
+    // Every task captures run()'s ctx, so all submitted tasks are joined
+    // before the first exception (from submit or from a system) propagates.
+    void runBatch(std::size_t begin, std::size_t end, Registry& registry, SystemContext& ctx)
+    {
+        std::exception_ptr failure;
+        mFutures.clear();
+        try
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const std::size_t idx = mBatchOrder[i];
+                mFutures.push_back(
+                    mPool.submit([this, &registry, &ctx, idx]() {
+                        executeSystem(idx, registry, ctx);
+                    }));
+            }
+        }
+        catch (...)
+        {
+            failure = std::current_exception();
+        }
+
+        for (auto& f : mFutures)
+        {
+            try
+            {
+                f.get();
+            }
+            catch (...)
+            {
+                if (!failure)
+                {
+                    failure = std::current_exception();
+                }
+            }
+        }
+        mFutures.clear();
+
+        if (failure)
+        {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    void executeSystem(std::size_t index, Registry& registry, SystemContext& ctx)
+    {
+        if (!mProfiling)
+        {
+            mSystems[index].execute(registry, ctx);
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        mSystems[index].execute(registry, ctx);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        mLastSystemNs[index] = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    struct ArenaBinding
+    {
+        uint64_t schedulerId = 0;
+        FrameArena* arena = nullptr;
+    };
+
+    // Per-thread bindings, replaced round-robin. Scheduler ids start at 1 so
+    // a default slot never matches. Ids (not addresses) are compared so a new
+    // Scheduler allocated at a destroyed one's address cannot inherit a
+    // stale binding.
+    struct ArenaCache
+    {
+        std::array<ArenaBinding, kArenaCacheSlots> slots{};
+        std::size_t next = 0;
+    };
+
+    static ArenaCache& threadArenaCache() noexcept
+    {
+        thread_local ArenaCache cache;
+        return cache;
+    }
+
+    FrameArena* bindCallingThread()
+    {
+        const std::thread::id self = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(mArenaMutex);
+
+        for (std::size_t i = 0; i < mArenaOwners.size(); ++i)
+        {
+            if (mArenaOwners[i] == self)
+            {
+                return mArenas[i].get();
+            }
+        }
+
+        // Threads beyond workers + driver (e.g. run() called from several
+        // threads over the scheduler's lifetime) get an extra arena. Arenas
+        // are heap-allocated so growing mArenas never moves a bound arena.
+        if (mArenaOwners.size() == mArenas.size())
+        {
+            mArenas.push_back(std::make_unique<FrameArena>(mArenaBlockSize));
+        }
+        mArenaOwners.push_back(self);
+        return mArenas[mArenaOwners.size() - 1].get();
+    }
+
+    inline static std::atomic<uint64_t> sNextId{1};
+
     fat_p::ThreadPool mPool;
     std::vector<SystemDescriptor> mSystems;
+    std::vector<uint64_t> mLastSystemNs;
+    bool mProfiling = false;
+
+    // Cached batch plan: mBatchOrder holds system indices grouped by batch;
+    // batch k is [mBatchEnds[k-1], mBatchEnds[k]).
+    std::vector<std::size_t> mBatchOrder;
+    std::vector<std::size_t> mBatchEnds;
+    std::vector<std::future<void>> mFutures;
+    bool mPlanDirty = true;
+
+    uint64_t mId;
+    std::size_t mArenaBlockSize;
+    std::vector<std::unique_ptr<FrameArena>> mArenas;
+    std::vector<std::thread::id> mArenaOwners;
+    std::mutex mArenaMutex;
 };
 
+inline FrameArena& SystemContext::arena() const
+{
+    return mScheduler.frameArena();
+}
+
 } // namespace fatp_ecs
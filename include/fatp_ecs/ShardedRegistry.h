@@ -0,0 +1,425 @@
+#pragma once
+
+/**
+ * @file ShardedRegistry.h
+ * @brief Registry split into N independent shards so that structural
+ *        changes can run concurrently, one worker per shard.
+ */
+
+// Overview:
+//
+// Registry is not thread-safe: create/destroy/add/remove from several
+// workers must be serialized or deferred through a CommandBuffer, and the
+// single-threaded flush becomes the bottleneck of spawn-heavy frames.
+// ShardedRegistry partitions the entity index space instead:
+//
+//   - Shard s is a complete Registry of its own: its own entity SlotMap,
+//     its own component stores, its own EventBus. Shards share no mutable
+//     state, so structural changes on different shards need no locking.
+//   - The top shardBits of an entity's 32-bit slot index name its shard;
+//     the remaining bits are the slot index inside that shard's Registry.
+//     A handle therefore routes itself: shardOf(e) is one shift, and every
+//     per-entity call (destroy, add, get, ...) forwards to that shard with
+//     the index bits rewritten. Generations pass through untouched.
+//   - view<Ts...>().each() visits the shards in order and hands out global
+//     handles. eachInShard(s, ...) iterates a single shard, which is the
+//     unit of work for Scheduler::parallel_for.
+//
+// The concurrency contract is per shard: any number of threads may make
+// structural changes at once as long as no two of them touch the same
+// shard. Views read every shard, so iteration across all shards must not
+// overlap with structural changes on any of them (the usual spawn phase /
+// iterate phase split).
+//
+// Signals, groups, observers, and storage policies are per shard; reach
+// them through shard(s), which speaks shard-local handles (toLocal /
+// toGlobal convert).
+//
+// FAT-P components used:
+//   (none — composes Registry instances)
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Entity.h"
+#include "Registry.h"
+#include "View.h"
+
+namespace fatp_ecs
+{
+
+class ShardedRegistry;
+
+// =============================================================================
+// ShardedView
+// =============================================================================
+
+template <typename IncludePack, typename ExcludePack>
+class ShardedView;
+
+/**
+ * @brief View over every shard of a ShardedRegistry.
+ *
+ * Each shard is iterated with the ordinary Registry view (smallest store
+ * as pivot, exclusions applied), so per-shard cost matches Registry.
+ * Entities passed to the callback are global handles.
+ *
+ * Obtained from ShardedRegistry::view(); cheap to create, holds no state
+ * besides the registry pointer.
+ */
+template <typename... Ts, typename... Xs>
+class ShardedView<std::tuple<Ts...>, std::tuple<Xs...>>
+{
+public:
+    explicit ShardedView(ShardedRegistry& registry) noexcept
+        : mRegistry(&registry)
+    {
+    }
+
+    /// @brief Call func(Entity, Ts&...) for every match, shard by shard.
+    template <typename Func>
+    void each(Func&& func);
+
+    /**
+     * @brief Call func(Entity, Ts&...) for every match in one shard.
+     *
+     * Different shards may be iterated concurrently.
+     */
+    template <typename Func>
+    void eachInShard(std::size_t shard, Func&& func);
+
+    /// @brief Number of matching entities across all shards.
+    [[nodiscard]] std::size_t count() const;
+
+private:
+    ShardedRegistry* mRegistry;
+};
+
+// =============================================================================
+// ShardedRegistry
+// =============================================================================
+
+/**
+ * @brief A registry partitioned into independent shards for concurrent
+ *        spawning and other structural changes.
+ *
+ * @example
+ * @code
+ *   ShardedRegistry world(scheduler.pool().thread_count());
+ *
+ *   // Spawn phase: worker s only touches shard s.
+ *   scheduler.parallel_for(world.shardCount(), [&](std::size_t begin, std::size_t end) {
+ *       for (std::size_t s = begin; s < end; ++s) {
+ *           for (int i = 0; i < 1000; ++i) {
+ *               Entity e = world.create(s);
+ *               world.add<Position>(e, 0.0f, 0.0f);
+ *           }
+ *       }
+ *   }, 1);
+ *
+ *   // Iterate phase: all shards.
+ *   world.view<Position>().each([](Entity, Position& p) { p.x += 1.0f; });
+ * @endcode
+ *
+ * @note Thread-safety: Calls that touch different shards may run
+ *       concurrently. Calls on the same shard, and whole-registry calls
+ *       (view().each(), count, alive, clear), are NOT thread-safe.
+ */
+class ShardedRegistry
+{
+public:
+    /// @brief Largest supported shard count.
+    static constexpr std::size_t kMaxShards = 256;
+
+    /**
+     * @brief Create a registry with shardCount shards.
+     *
+     * @throws std::invalid_argument if shardCount is 0 or above kMaxShards.
+     */
+    explicit ShardedRegistry(std::size_t shardCount)
+    {
+        if (shardCount == 0 || shardCount > kMaxShards)
+        {
+            throw std::invalid_argument("ShardedRegistry: shard count must be in [1, 256]");
+        }
+        while ((std::size_t{1} << mShardBits) < shardCount)
+        {
+            ++mShardBits;
+        }
+        mLocalBits = 32 - mShardBits;
+        mLocalMask = mShardBits == 0 ? ~uint32_t{0} : (uint32_t{1} << mLocalBits) - 1;
+        mShards.resize(shardCount);
+    }
+
+    ShardedRegistry(const ShardedRegistry&) = delete;
+    ShardedRegistry& operator=(const ShardedRegistry&) = delete;
+    ShardedRegistry(ShardedRegistry&&) noexcept = default;
+    ShardedRegistry& operator=(ShardedRegistry&&) noexcept = default;
+
+    // =========================================================================
+    // Shards and handle translation
+    // =========================================================================
+
+    [[nodiscard]] std::size_t shardCount() const noexcept
+    {
+        return mShards.size();
+    }
+
+    /// @brief Shard that owns entity. May be >= shardCount() for foreign handles.
+    [[nodiscard]] std::size_t shardOf(Entity entity) const noexcept
+    {
+        return mShardBits == 0 ? 0 : EntityTraits::index(entity) >> mLocalBits;
+    }
+
+    /// @brief The Registry backing one shard. It speaks shard-local handles.
+    [[nodiscard]] Registry& shard(std::size_t shard)
+    {
+        return mShards[shard].registry;
+    }
+
+    [[nodiscard]] const Registry& shard(std::size_t shard) const
+    {
+        return mShards[shard].registry;
+    }
+
+    /// @brief Convert a shard-local handle to the global handle.
+    /// @pre local's slot index fits the shard's index bits (create() checks).
+    [[nodiscard]] Entity toGlobal(std::size_t shard, Entity local) const noexcept
+    {
+        const uint32_t index = EntityTraits::index(local);
+        assert((index & ~mLocalMask) == 0 && "ShardedRegistry: shard index space exhausted");
+        return EntityTraits::make(
+            static_cast<uint32_t>(shard << mLocalBits) | index,
+            EntityTraits::generation(local));
+    }
+
+    /// @brief Convert a global handle to the handle used inside its shard.
+    [[nodiscard]] Entity toLocal(Entity entity) const noexcept
+    {
+        return EntityTraits::make(EntityTraits::index(entity) & mLocalMask,
+                                  EntityTraits::generation(entity));
+    }
+
+    // =========================================================================
+    // Entity Lifecycle
+    // =========================================================================
+
+    /**
+     * @brief Create an entity in the given shard.
+     *
+     * @throws std::length_error if the shard's slot indices no longer fit
+     *         in its share of the handle (2^(32 - shard bits) slots).
+     */
+    [[nodiscard]] Entity create(std::size_t shard)
+    {
+        Registry& registry = mShards[shard].registry;
+        return globalFromNew(shard, registry, registry.create());
+    }
+
+    /**
+     * @brief Create one entity per element of [first, last) in the given shard.
+     *
+     * @throws std::length_error as create(shard); entities already written
+     *         to the range stay alive.
+     */
+    template <typename It>
+    void create(std::size_t shard, It first, It last)
+    {
+        Registry& registry = mShards[shard].registry;
+        for (; first != last; ++first)
+        {
+            *first = globalFromNew(shard, registry, registry.create());
+        }
+    }
+
+    bool destroy(Entity entity)
+    {
+        Registry* registry = owner(entity);
+        return registry != nullptr && registry->destroy(toLocal(entity));
+    }
+
+    [[nodiscard]] bool isAlive(Entity entity) const noexcept
+    {
+        const std::size_t s = shardOf(entity);
+        return s < mShards.size() && mShards[s].registry.isAlive(toLocal(entity));
+    }
+
+    [[nodiscard]] bool valid(Entity entity) const noexcept { return isAlive(entity); }
+
+    /// @brief Live entities across all shards.
+    /// @note Complexity: O(shardCount).
+    [[nodiscard]] std::size_t alive() const noexcept
+    {
+        std::size_t total = 0;
+        for (const Shard& s : mShards)
+        {
+            total += s.registry.alive();
+        }
+        return total;
+    }
+
+    [[nodiscard]] std::size_t entityCount() const noexcept { return alive(); }
+
+    /// @brief Destroy every entity in every shard.
+    void clear()
+    {
+        for (Shard& s : mShards)
+        {
+            s.registry.clear();
+        }
+    }
+
+    // =========================================================================
+    // Component Operations
+    // =========================================================================
+
+    /**
+     * @brief Add T to entity, constructed from args. Same contract as
+     *        Registry::add().
+     *
+     * @throws std::out_of_range if entity does not belong to any shard.
+     */
+    template <typename T, typename... Args>
+    T& add(Entity entity, Args&&... args)
+    {
+        return ownerOrThrow(entity).template add<T>(toLocal(entity), std::forward<Args>(args)...);
+    }
+
+    /// @brief Alias for add().
+    template <typename T, typename... Args>
+    T& emplace(Entity entity, Args&&... args)
+    {
+        return add<T>(entity, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    bool remove(Entity entity)
+    {
+        Registry* registry = owner(entity);
+        return registry != nullptr && registry->template remove<T>(toLocal(entity));
+    }
+
+    template <typename T>
+    [[nodiscard]] bool has(Entity entity) const
+    {
+        const std::size_t s = shardOf(entity);
+        return s < mShards.size() && mShards[s].registry.template has<T>(toLocal(entity));
+    }
+
+    template <typename T>
+    [[nodiscard]] T* tryGet(Entity entity)
+    {
+        Registry* registry = owner(entity);
+        return registry == nullptr ? nullptr : registry->template tryGet<T>(toLocal(entity));
+    }
+
+    /// @throws std::out_of_range if entity does not have T.
+    template <typename T>
+    [[nodiscard]] T& get(Entity entity)
+    {
+        return ownerOrThrow(entity).template get<T>(toLocal(entity));
+    }
+
+    // =========================================================================
+    // Views
+    // =========================================================================
+
+    /// @brief View over entities with all of Ts, across every shard.
+    template <typename... Ts>
+    [[nodiscard]] ShardedView<std::tuple<Ts...>, std::tuple<>> view()
+    {
+        return ShardedView<std::tuple<Ts...>, std::tuple<>>(*this);
+    }
+
+    /// @brief View over entities with all of Ts and none of Xs, across every shard.
+    template <typename... Ts, typename... Xs>
+    [[nodiscard]] ShardedView<std::tuple<Ts...>, std::tuple<Xs...>>
+    view(Exclude<Xs...> /*tag*/)
+    {
+        return ShardedView<std::tuple<Ts...>, std::tuple<Xs...>>(*this);
+    }
+
+private:
+    // Global handle for an entity just created in shard. An index past the
+    // shard's bits would alias another shard, so undo the create and throw.
+    Entity globalFromNew(std::size_t shard, Registry& registry, Entity local)
+    {
+        if ((EntityTraits::index(local) & ~mLocalMask) != 0)
+        {
+            registry.destroy(local);
+            throw std::length_error("ShardedRegistry: shard index space exhausted");
+        }
+        return toGlobal(shard, local);
+    }
+
+    // Each shard on its own cache lines: workers hammering neighbouring
+    // shards must not false-share the SlotMap and store-cache headers.
+    struct alignas(64) Shard
+    {
+        Registry registry;
+    };
+
+    Registry* owner(Entity entity) noexcept
+    {
+        const std::size_t s = shardOf(entity);
+        return s < mShards.size() ? &mShards[s].registry : nullptr;
+    }
+
+    Registry& ownerOrThrow(Entity entity)
+    {
+        Registry* registry = owner(entity);
+        if (registry == nullptr)
+        {
+            throw std::out_of_range("ShardedRegistry: entity does not belong to any shard");
+        }
+        return *registry;
+    }
+
+    std::vector<Shard> mShards;
+    uint32_t mShardBits = 0;
+    uint32_t mLocalBits = 32;
+    uint32_t mLocalMask = ~uint32_t{0};
+};
+
+// =============================================================================
+// ShardedView — out-of-line members (need the complete ShardedRegistry)
+// =============================================================================
+
+template <typename... Ts, typename... Xs>
+template <typename Func>
+void ShardedView<std::tuple<Ts...>, std::tuple<Xs...>>::each(Func&& func)
+{
+    for (std::size_t s = 0; s < mRegistry->shardCount(); ++s)
+    {
+        eachInShard(s, func);
+    }
+}
+
+template <typename... Ts, typename... Xs>
+template <typename Func>
+void ShardedView<std::tuple<Ts...>, std::tuple<Xs...>>::eachInShard(std::size_t shard,
+                                                                     Func&& func)
+{
+    const ShardedRegistry& registry = *mRegistry;
+    mRegistry->shard(shard).template view<Ts...>(Exclude<Xs...>{}).each(
+        [&func, &registry, shard](Entity local, Ts&... components)
+        { func(registry.toGlobal(shard, local), components...); });
+}
+
+template <typename... Ts, typename... Xs>
+std::size_t ShardedView<std::tuple<Ts...>, std::tuple<Xs...>>::count() const
+{
+    std::size_t total = 0;
+    for (std::size_t s = 0; s < mRegistry->shardCount(); ++s)
+    {
+        total += mRegistry->shard(s).template view<Ts...>(Exclude<Xs...>{}).count();
+    }
+    return total;
+}
+
+} // namespace fatp_ecs
@@ -0,0 +1,274 @@
+#pragma once
+
+/**
+ * @file SlotRecycling.h
+ * @brief Entity slot recycling policies and the free-slot tracker behind them.
+ */
+
+// FAT-P components used:
+//   (none — standard library only)
+//
+// Which slot Registry::create() reuses decides how compact the entity index
+// space stays under churn. Every component store's sparse array is indexed by
+// entity slot, so a scattered index range means larger sparse arrays and
+// poorer locality when views probe them.
+//
+//   Default     — whatever fat_p::SlotMap's free list returns. No tracking
+//                 cost at all; this is the historical behaviour.
+//   Lifo        — most recently freed slot first. Reuses cache-warm slots.
+//   LowestIndex — lowest free index first, found by scanning a free bitmap.
+//                 Keeps live entities packed towards index 0, so sparse
+//                 arrays stop growing once the population is stable.
+//   Fifo        — oldest freed slot first. Maximizes the time between a
+//                 slot's destruction and its reuse (largest ABA distance).
+//
+// FreeSlotTracker keeps the free set for the non-default policies. The bitmap
+// is the single source of truth for "is this slot free"; the LIFO stack and
+// FIFO queue are orderings over it and are validated lazily on pop. That lets
+// Registry::create(hint) claim an arbitrary slot in O(1) without searching
+// the stack or queue — the stale entry is simply skipped when it surfaces.
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fatp_ecs
+{
+
+/// @brief Order in which Registry::create() reuses destroyed entity slots.
+enum class SlotRecycling : uint8_t
+{
+    Default,     ///< fat_p::SlotMap free-list order (no tracking overhead)
+    Lifo,        ///< Most recently freed slot first
+    LowestIndex, ///< Lowest free slot index first (compact index space)
+    Fifo,        ///< Least recently freed slot first (maximum ABA distance)
+};
+
+/**
+ * @brief Free-slot set with a configurable reuse order.
+ *
+ * Used internally by Registry when a non-default SlotRecycling policy is set.
+ *
+ * @note Thread-safety: NOT thread-safe.
+ */
+class FreeSlotTracker
+{
+public:
+    FreeSlotTracker() = default;
+
+    /// @brief Drop all tracked state and switch to @p policy.
+    void reset(SlotRecycling policy)
+    {
+        mPolicy = policy;
+        mBits.clear();
+        mOrder.clear();
+        mHead = 0;
+        mFreeCount = 0;
+        mScanWord = 0;
+        mHighWater = 0;
+    }
+
+    [[nodiscard]] SlotRecycling policy() const noexcept
+    {
+        return mPolicy;
+    }
+
+    /// @brief Number of slots currently known to be free.
+    [[nodiscard]] std::size_t freeCount() const noexcept
+    {
+        return mFreeCount;
+    }
+
+    /// @brief One past the highest slot index ever observed in use.
+    [[nodiscard]] uint32_t highWater() const noexcept
+    {
+        return mHighWater;
+    }
+
+    [[nodiscard]] bool isFree(uint32_t index) const noexcept
+    {
+        const std::size_t word = index / 64;
+        return word < mBits.size() && (mBits[word] >> (index % 64) & 1u) != 0;
+    }
+
+    /**
+     * @brief Record that @p index has been freed.
+     *
+     * @note Complexity: O(1) amortized.
+     */
+    void release(uint32_t index)
+    {
+        if (isFree(index))
+        {
+            return;
+        }
+        setBit(index);
+        ++mFreeCount;
+        if (mPolicy == SlotRecycling::LowestIndex)
+        {
+            mScanWord = std::min(mScanWord, static_cast<std::size_t>(index / 64));
+        }
+        else
+        {
+            mOrder.push_back(index);
+        }
+    }
+
+    /**
+     * @brief Record that @p index is in use (e.g. a hinted create()).
+     *
+     * @note Complexity: O(1).
+     */
+    void claim(uint32_t index) noexcept
+    {
+        if (index >= mHighWater)
+        {
+            mHighWater = index + 1;
+        }
+        if (isFree(index))
+        {
+            clearBit(index);
+            --mFreeCount;
+        }
+    }
+
+    /**
+     * @brief Pick the next slot to reuse according to the policy.
+     *
+     * @param[out] index Receives the chosen slot on success.
+     * @return false if no tracked slot is free.
+     *
+     * @note Complexity: O(1) amortized for Lifo/Fifo; O(words scanned) for
+     *       LowestIndex, amortized O(1) under steady churn.
+     */
+    [[nodiscard]] bool acquire(uint32_t& index) noexcept
+    {
+        if (mFreeCount == 0)
+        {
+            return false;
+        }
+
+        switch (mPolicy)
+        {
+        case SlotRecycling::LowestIndex:
+            while (mScanWord < mBits.size())
+            {
+                const uint64_t word = mBits[mScanWord];
+                if (word != 0)
+                {
+                    index = static_cast<uint32_t>(mScanWord * 64 +
+                                                  static_cast<std::size_t>(std::countr_zero(word)));
+                    clearBit(index);
+                    --mFreeCount;
+                    return true;
+                }
+                ++mScanWord;
+            }
+            return false;
+
+        case SlotRecycling::Lifo:
+            while (!mOrder.empty())
+            {
+                const uint32_t candidate = mOrder.back();
+                mOrder.pop_back();
+                if (isFree(candidate))
+                {
+                    index = candidate;
+                    clearBit(index);
+                    --mFreeCount;
+                    return true;
+                }
+            }
+            return false;
+
+        case SlotRecycling::Fifo:
+            while (mHead < mOrder.size())
+            {
+                const uint32_t candidate = mOrder[mHead++];
+                if (isFree(candidate))
+                {
+                    index = candidate;
+                    clearBit(index);
+                    --mFreeCount;
+                    compactQueue();
+                    return true;
+                }
+            }
+            compactQueue();
+            return false;
+
+        case SlotRecycling::Default:
+            break;
+        }
+        return false;
+    }
+
+    /// @brief Mark every slot below highWater() as free (Registry::clear()).
+    void releaseAll()
+    {
+        const uint32_t high = mHighWater;
+        const SlotRecycling policy = mPolicy;
+        reset(policy);
+        mHighWater = high;
+
+        // LIFO pops from the back, so push in descending order to hand out
+        // slot 0 first; FIFO pops from the front, so push ascending.
+        if (policy == SlotRecycling::Lifo)
+        {
+            for (uint32_t i = high; i > 0; --i)
+            {
+                release(i - 1);
+            }
+        }
+        else
+        {
+            for (uint32_t i = 0; i < high; ++i)
+            {
+                release(i);
+            }
+        }
+    }
+
+private:
+    void setBit(uint32_t index)
+    {
+        const std::size_t word = index / 64;
+        if (word >= mBits.size())
+        {
+            mBits.resize(word + 1, 0);
+        }
+        mBits[word] |= uint64_t{1} << (index % 64);
+    }
+
+    void clearBit(uint32_t index) noexcept
+    {
+        mBits[index / 64] &= ~(uint64_t{1} << (index % 64));
+    }
+
+    // Reclaim the consumed prefix of the FIFO queue once it dominates.
+    void compactQueue()
+    {
+        if (mHead == mOrder.size())
+        {
+            mOrder.clear();
+            mHead = 0;
+        }
+        else if (mHead > 1024 && mHead * 2 > mOrder.size())
+        {
+            mOrder.erase(mOrder.begin(), mOrder.begin() + static_cast<std::ptrdiff_t>(mHead));
+            mHead = 0;
+        }
+    }
+
+    SlotRecycling mPolicy = SlotRecycling::Default;
+    std::vector<uint64_t> mBits;   // bit i set => slot i free
+    std::vector<uint32_t> mOrder;  // LIFO stack / FIFO queue (may hold stale entries)
+    std::size_t mHead = 0;         // FIFO read position in mOrder
+    std::size_t mFreeCount = 0;
+    std::size_t mScanWord = 0;     // LowestIndex: no free bit below this word
+    uint32_t mHighWater = 0;
+};
+
+} // namespace fatp_ecs
@@ -57,7 +57,6 @@
 // FAT-P components used:
 //   - BinaryLite (Encoder/Decoder): little-endian serialization without the
 //     full FatPBinary stack. Each value carries a type tag for integrity.
-//   - FastHashMap: EntityMap lookup O(1) per component entry; discarded after restore.
 
 #include <cstddef>
 #include <cstdint>
@@ -67,10 +66,10 @@
 #include <vector>
 
 #include <fat_p/BinaryLite.h>
-#include <fat_p/FastHashMap.h>
 
 #include "ComponentStore.h"
 #include "Entity.h"
+#include "EntityMap.h"
 #include "TypeId.h"
 
 namespace fatp_ecs
@@ -78,53 +77,6 @@ namespace fatp_ecs
 
 class Registry;
 
-// =============================================================================
-// EntityMap -- old-to-new entity translation used during restore
-// =============================================================================
-
-/**
- * @brief Maps serialized (old) entity handles to freshly created (new) handles.
- *
- * Passed by const-ref to every deserializeComponent<T>() callback so the user
- * can remap cross-entity component fields.
- *
- * @example
- * @code
- *   loader.deserializeComponent<Parent>(dec,
- *       [](fat_p::binary::Decoder& d, const EntityMap& remap) -> Parent {
- *           Entity old = Entity(d.readRaw<uint64_t>());
- *           return Parent{ remap.translate(old) };
- *       });
- * @endcode
- *
- * @note Thread-safety: NOT thread-safe.
- */
-class EntityMap
-{
-public:
-    /// @brief Returns the new entity corresponding to oldEntity, or NullEntity
-    ///        if oldEntity was not part of the snapshot.
-    [[nodiscard]] Entity translate(Entity oldEntity) const noexcept
-    {
-        const Entity* found = mMap.find(oldEntity.get());
-        return found ? *found : NullEntity;
-    }
-
-    [[nodiscard]] std::size_t size() const noexcept
-    {
-        return mMap.size();
-    }
-
-    // Internal: called by RegistrySnapshotLoader during construction.
-    void insert(Entity oldEntity, Entity newEntity)
-    {
-        mMap.insert(oldEntity.get(), newEntity);
-    }
-
-private:
-    fat_p::FastHashMap<uint64_t, Entity> mMap;
-};
-
 // =============================================================================
 // RegistrySnapshot -- save side
 // =============================================================================
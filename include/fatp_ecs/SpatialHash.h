@@ -0,0 +1,557 @@
+#pragma once
+
+/**
+ * @file SpatialHash.h
+ * @brief Uniform-grid spatial index over a position component, maintained
+ *        incrementally from component lifecycle events.
+ */
+
+// Overview:
+//
+// SpatialHash<P> buckets every entity that has component P into square cells
+// of a fixed size, so radius, AABB and pair queries visit only the cells a
+// query touches instead of every entity. Only occupied cells exist: they are
+// found through a FastHashMap keyed by packed (cx, cy) cell coordinates, so
+// the world is unbounded and memory scales with the number of entities, not
+// with the area they cover.
+//
+// Maintenance is incremental:
+//   - onComponentAdded<P>   inserts the entity
+//   - onComponentUpdated<P> (patch/replace/emplace_or_replace) moves it
+//   - onComponentRemoved<P> (remove/erase/destroy/clear<P>) drops it
+//
+// Systems that write P in place through a view bypass those signals. They
+// call update(entity, p) per written entity, or refreshAll() once after the
+// loop, which walks the P store densely and only touches buckets whose cell
+// changed. Registry::clear() does not fire component signals; call
+// rebuild() after it.
+//
+// Each cell entry caches the entity's coordinates, so queries read one
+// contiguous array per cell and never go back to the registry. Results
+// therefore reflect positions as of the last insert/update/refresh.
+//
+// Per-entity bookkeeping is a vector indexed by entity slot index holding
+// (cell, position-in-cell), giving O(1) removal by swap-and-pop. Emptied
+// cells keep their capacity and are recycled through a free list, so an
+// index whose population has warmed up does not allocate when entities
+// move between cells.
+//
+// FAT-P components used:
+//   - FastHashMap: occupied cell lookup by packed cell coordinates
+//   - Signal / ScopedConnection: wiring to the registry's component signals
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <fat_p/FastHashMap.h>
+#include <fat_p/Signal.h>
+
+#include "Entity.h"
+#include "Registry.h"
+
+namespace fatp_ecs
+{
+
+/// @brief A 2D point extracted from a position component.
+struct SpatialPoint
+{
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+/**
+ * @brief Default point extractor: reads members named x and y.
+ *
+ * Specialize, or pass a custom Extract to SpatialHash, for components that
+ * store their coordinates differently.
+ */
+template <typename P>
+struct SpatialPointOf
+{
+    [[nodiscard]] SpatialPoint operator()(const P& component) const noexcept
+    {
+        return {static_cast<float>(component.x), static_cast<float>(component.y)};
+    }
+};
+
+/**
+ * @brief Incrementally maintained uniform-grid index over component P.
+ *
+ * @tparam P       Position component type.
+ * @tparam Extract Callable SpatialPoint(const P&).
+ *
+ * Pick a cell size close to the typical query radius: a radius query then
+ * visits at most 3x3 cells.
+ *
+ * @example
+ * @code
+ *   SpatialHash<Position> grid(registry, 32.0f);
+ *
+ *   registry.view<Position, Velocity>().each(
+ *       [](Entity, Position& p, Velocity& v) { p.x += v.dx; p.y += v.dy; });
+ *   grid.refreshAll();
+ *
+ *   grid.queryRadius(x, y, 20.0f, [&](Entity hit) { ... });
+ *   grid.queryPairs(20.0f, [&](Entity a, Entity b) { ... });
+ * @endcode
+ *
+ * @note The index holds connections to @p registry's signals and must not
+ *       outlive it. It is neither copyable nor movable.
+ * @note Thread-safety: Queries are const and may run concurrently with each
+ *       other. Anything that adds, updates or removes P — including the
+ *       signal handlers — must not overlap with queries. Query callbacks must
+ *       not add or remove P; defer with a CommandBuffer.
+ */
+template <typename P, typename Extract = SpatialPointOf<P>>
+class SpatialHash
+{
+public:
+    /**
+     * @brief Index every entity that currently has P and subscribe to P's
+     *        lifecycle signals.
+     *
+     * @param cellSize Edge length of a grid cell; must be positive.
+     */
+    SpatialHash(Registry& registry, float cellSize, Extract extract = Extract{})
+        : mRegistry(&registry)
+        , mCellSize(cellSize > 0.0f ? cellSize : 1.0f)
+        , mInvCellSize(1.0f / mCellSize)
+        , mExtract(std::move(extract))
+    {
+        EventBus& events = registry.events();
+        mConnections.reserve(3);
+        mConnections.push_back(events.onComponentAdded<P>().connect(
+            [this](Entity entity, P& component) { place(entity, mExtract(component)); }));
+        mConnections.push_back(events.onComponentUpdated<P>().connect(
+            [this](Entity entity, P& component) { place(entity, mExtract(component)); }));
+        mConnections.push_back(events.onComponentRemoved<P>().connect(
+            [this](Entity entity) { erase(entity); }));
+        rebuild();
+    }
+
+    SpatialHash(const SpatialHash&) = delete;
+    SpatialHash& operator=(const SpatialHash&) = delete;
+    SpatialHash(SpatialHash&&) = delete;
+    SpatialHash& operator=(SpatialHash&&) = delete;
+
+    // =========================================================================
+    // Maintenance
+    // =========================================================================
+
+    /**
+     * @brief Record that @p entity's P is now @p component.
+     *
+     * For systems that write P in place. Inserts the entity if it is not yet
+     * indexed.
+     *
+     * @note Complexity: O(1) amortized.
+     */
+    void update(Entity entity, const P& component)
+    {
+        place(entity, mExtract(component));
+    }
+
+    /**
+     * @brief Re-read @p entity's P from the registry, dropping it from the
+     *        index if it no longer has one.
+     */
+    void refresh(Entity entity)
+    {
+        const P* component = mRegistry->tryGet<P>(entity);
+        if (component == nullptr)
+        {
+            erase(entity);
+            return;
+        }
+        place(entity, mExtract(*component));
+    }
+
+    /**
+     * @brief Re-read every P in the registry.
+     *
+     * Walks the P store densely. Entities that stay in their cell only have
+     * their cached coordinates rewritten.
+     *
+     * @return Number of entities that changed cell (including new ones).
+     *
+     * @note Complexity: O(n) in the number of entities with P.
+     */
+    std::size_t refreshAll()
+    {
+        std::size_t moved = 0;
+        mRegistry->view<P>().each(
+            [this, &moved](Entity entity, P& component)
+            {
+                moved += place(entity, mExtract(component)) ? 1 : 0;
+            });
+        return moved;
+    }
+
+    /// @brief Drop everything and re-index all entities with P.
+    void rebuild()
+    {
+        mCellIndex.clear();
+        mFreeCells.clear();
+        for (std::size_t i = mCells.size(); i > 0; --i)
+        {
+            mCells[i - 1].entries.clear();
+            mFreeCells.push_back(static_cast<uint32_t>(i - 1));
+        }
+        mSlots.clear();
+        mSize = 0;
+        refreshAll();
+    }
+
+    // =========================================================================
+    // Queries
+    // =========================================================================
+
+    /**
+     * @brief Call func(Entity) for every indexed entity within @p radius of
+     *        (x, y), boundary included.
+     *
+     * @note Complexity: O(cells overlapped + entities in them).
+     */
+    template <typename Func>
+    void queryRadius(float x, float y, float radius, Func&& func) const
+    {
+        const float r2 = radius * radius;
+        forEachCellIn(x - radius, y - radius, x + radius, y + radius,
+            [&](const Cell& cell)
+            {
+                for (const Entry& e : cell.entries)
+                {
+                    const float dx = e.x - x;
+                    const float dy = e.y - y;
+                    if (dx * dx + dy * dy <= r2)
+                    {
+                        func(e.entity);
+                    }
+                }
+            });
+    }
+
+    /**
+     * @brief Call func(Entity) for every indexed entity inside the box
+     *        [minX, maxX] x [minY, maxY], boundary included.
+     */
+    template <typename Func>
+    void queryAabb(float minX, float minY, float maxX, float maxY, Func&& func) const
+    {
+        forEachCellIn(minX, minY, maxX, maxY,
+            [&](const Cell& cell)
+            {
+                for (const Entry& e : cell.entries)
+                {
+                    if (e.x >= minX && e.x <= maxX && e.y >= minY && e.y <= maxY)
+                    {
+                        func(e.entity);
+                    }
+                }
+            });
+    }
+
+    /**
+     * @brief Call func(Entity, Entity) once for every unordered pair of
+     *        indexed entities within @p radius of each other.
+     *
+     * Each cell is paired with itself and with the forward half of its
+     * neighbourhood, so no pair is reported twice.
+     *
+     * @note Complexity: O(sum over cells of entries x neighbouring entries).
+     */
+    template <typename Func>
+    void queryPairs(float radius, Func&& func) const
+    {
+        const float r2 = radius * radius;
+        const auto reach = static_cast<int32_t>(
+            std::min(std::ceil(radius * mInvCellSize), static_cast<float>(kMaxReach)));
+
+        auto test = [&](const Entry& a, const Entry& b)
+        {
+            const float dx = a.x - b.x;
+            const float dy = a.y - b.y;
+            if (dx * dx + dy * dy <= r2)
+            {
+                func(a.entity, b.entity);
+            }
+        };
+
+        for (const Cell& cell : mCells)
+        {
+            const auto& entries = cell.entries;
+            for (std::size_t i = 0; i < entries.size(); ++i)
+            {
+                for (std::size_t j = i + 1; j < entries.size(); ++j)
+                {
+                    test(entries[i], entries[j]);
+                }
+            }
+            if (entries.empty())
+            {
+                continue;
+            }
+
+            // Forward half-neighbourhood: (dx > 0, dy == 0) or dy > 0.
+            for (int32_t dy = 0; dy <= reach; ++dy)
+            {
+                for (int32_t dx = (dy == 0 ? 1 : -reach); dx <= reach; ++dx)
+                {
+                    const Cell* other = findCell(cell.cx + dx, cell.cy + dy);
+                    if (other == nullptr)
+                    {
+                        continue;
+                    }
+                    for (const Entry& a : entries)
+                    {
+                        for (const Entry& b : other->entries)
+                        {
+                            test(a, b);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // =========================================================================
+    // Introspection
+    // =========================================================================
+
+    /// @brief Number of indexed entities.
+    [[nodiscard]] std::size_t size() const noexcept { return mSize; }
+
+    [[nodiscard]] bool empty() const noexcept { return mSize == 0; }
+
+    /// @brief True if @p entity is indexed.
+    [[nodiscard]] bool contains(Entity entity) const noexcept
+    {
+        return find(entity) != nullptr;
+    }
+
+    /// @brief Number of occupied cells.
+    [[nodiscard]] std::size_t cellCount() const noexcept { return mCellIndex.size(); }
+
+    [[nodiscard]] float cellSize() const noexcept { return mCellSize; }
+
+private:
+    struct Entry
+    {
+        Entity entity;
+        float x;
+        float y;
+    };
+
+    struct Cell
+    {
+        int32_t cx = 0;
+        int32_t cy = 0;
+        std::vector<Entry> entries;
+    };
+
+    struct Slot
+    {
+        uint32_t cell;
+        uint32_t pos;
+    };
+
+    static constexpr uint32_t kNoCell = std::numeric_limits<uint32_t>::max();
+
+    // Cell coordinates are clamped so that far-away, infinite or NaN
+    // positions still land in a valid (edge) cell instead of overflowing.
+    static constexpr int32_t kCoordLimit = 1 << 30;
+
+    // Bound on the pair-query neighbourhood for radii far above the cell size.
+    static constexpr int32_t kMaxReach = 1 << 10;
+
+    [[nodiscard]] int32_t coord(float v) const noexcept
+    {
+        const float c = std::floor(v * mInvCellSize);
+        if (!(c > static_cast<float>(-kCoordLimit)))
+        {
+            return -kCoordLimit; // also NaN
+        }
+        if (c >= static_cast<float>(kCoordLimit))
+        {
+            return kCoordLimit;
+        }
+        return static_cast<int32_t>(c);
+    }
+
+    [[nodiscard]] static uint64_t cellKey(int32_t cx, int32_t cy) noexcept
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) |
+               static_cast<uint64_t>(static_cast<uint32_t>(cy));
+    }
+
+    [[nodiscard]] const Cell* findCell(int32_t cx, int32_t cy) const
+    {
+        const uint32_t* idx = mCellIndex.find(cellKey(cx, cy));
+        return idx == nullptr ? nullptr : &mCells[*idx];
+    }
+
+    [[nodiscard]] const Slot* find(Entity entity) const noexcept
+    {
+        const auto index = EntityTraits::index(entity);
+        if (index >= mSlots.size())
+        {
+            return nullptr;
+        }
+        const Slot& slot = mSlots[index];
+        if (slot.cell == kNoCell || mCells[slot.cell].entries[slot.pos].entity != entity)
+        {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    uint32_t acquireCell(int32_t cx, int32_t cy)
+    {
+        const uint64_t key = cellKey(cx, cy);
+        if (const uint32_t* idx = mCellIndex.find(key))
+        {
+            return *idx;
+        }
+        uint32_t idx;
+        if (!mFreeCells.empty())
+        {
+            idx = mFreeCells.back();
+            mFreeCells.pop_back();
+        }
+        else
+        {
+            idx = static_cast<uint32_t>(mCells.size());
+            mCells.emplace_back();
+        }
+        mCells[idx].cx = cx;
+        mCells[idx].cy = cy;
+        mCellIndex.insert(key, idx);
+        return idx;
+    }
+
+    // Returns an emptied cell (capacity kept) to the free list.
+    void releaseCell(uint32_t idx)
+    {
+        const Cell& cell = mCells[idx];
+        mCellIndex.erase(cellKey(cell.cx, cell.cy));
+        mFreeCells.push_back(idx);
+    }
+
+    // Insert or move. Returns true if the entity changed cell (or was new).
+    bool place(Entity entity, SpatialPoint point)
+    {
+        const int32_t cx = coord(point.x);
+        const int32_t cy = coord(point.y);
+
+        if (const Slot* slot = find(entity))
+        {
+            Cell& current = mCells[slot->cell];
+            if (current.cx == cx && current.cy == cy)
+            {
+                Entry& e = current.entries[slot->pos];
+                e.x = point.x;
+                e.y = point.y;
+                return false;
+            }
+            erase(entity);
+        }
+
+        const auto index = EntityTraits::index(entity);
+        if (index >= mSlots.size())
+        {
+            mSlots.resize(static_cast<std::size_t>(index) + 1, Slot{kNoCell, 0});
+        }
+        const uint32_t cellIdx = acquireCell(cx, cy);
+        auto& entries = mCells[cellIdx].entries;
+        mSlots[index] = Slot{cellIdx, static_cast<uint32_t>(entries.size())};
+        entries.push_back(Entry{entity, point.x, point.y});
+        ++mSize;
+        return true;
+    }
+
+    void erase(Entity entity)
+    {
+        const Slot* found = find(entity);
+        if (found == nullptr)
+        {
+            return;
+        }
+        const Slot slot = *found;
+        auto& entries = mCells[slot.cell].entries;
+        if (slot.pos + 1 != entries.size())
+        {
+            entries[slot.pos] = entries.back();
+            mSlots[EntityTraits::index(entries[slot.pos].entity)].pos = slot.pos;
+        }
+        entries.pop_back();
+        mSlots[EntityTraits::index(entity)].cell = kNoCell;
+        --mSize;
+        if (entries.empty())
+        {
+            releaseCell(slot.cell);
+        }
+    }
+
+    // Visit each occupied cell overlapping the box. When the box spans more
+    // cells than are occupied, scanning the occupied cells is cheaper.
+    template <typename Visit>
+    void forEachCellIn(float minX, float minY, float maxX, float maxY, Visit&& visit) const
+    {
+        const int32_t cx0 = coord(minX);
+        const int32_t cy0 = coord(minY);
+        const int32_t cx1 = coord(maxX);
+        const int32_t cy1 = coord(maxY);
+        if (cx1 < cx0 || cy1 < cy0)
+        {
+            return;
+        }
+
+        const auto spanX = static_cast<uint64_t>(static_cast<int64_t>(cx1) - cx0 + 1);
+        const auto spanY = static_cast<uint64_t>(static_cast<int64_t>(cy1) - cy0 + 1);
+        if (spanX * spanY > mCellIndex.size())
+        {
+            for (const Cell& cell : mCells)
+            {
+                if (!cell.entries.empty() && cell.cx >= cx0 && cell.cx <= cx1 &&
+                    cell.cy >= cy0 && cell.cy <= cy1)
+                {
+                    visit(cell);
+                }
+            }
+            return;
+        }
+
+        for (int32_t cy = cy0; cy <= cy1; ++cy)
+        {
+            for (int32_t cx = cx0; cx <= cx1; ++cx)
+            {
+                if (const Cell* cell = findCell(cx, cy))
+                {
+                    visit(*cell);
+                }
+            }
+        }
+    }
+
+    Registry* mRegistry;
+    float mCellSize;
+    float mInvCellSize;
+    Extract mExtract;
+
+    std::vector<Cell> mCells;                        // occupied + free cells
+    std::vector<uint32_t> mFreeCells;                // indices of released cells
+    fat_p::FastHashMap<uint64_t, uint32_t> mCellIndex; // packed (cx, cy) -> mCells index
+    std::vector<Slot> mSlots;                        // entity index -> (cell, pos)
+    std::size_t mSize = 0;
+
+    // Declared last so the signals are disconnected before anything else is
+    // torn down.
+    std::vector<fat_p::ScopedConnection> mConnections;
+};
+
+} // namespace fatp_ecs
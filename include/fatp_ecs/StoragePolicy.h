@@ -13,6 +13,7 @@
  *   DefaultStoragePolicy          std::vector<T>                      zero overhead
  *   AlignedStoragePolicy<N>       fat_p::AlignedVector<T, N>          SIMD/cache-line aligned
  *   ConcurrentStoragePolicy<Lock> std::vector<T> guarded by Lock      thread-safe component writes
+ *   LockFreeReadStoragePolicy<Lock> epoch-reclaimed buffer            readers never lock
  *
  * Custom policy requirements
  * --------------------------
@@ -35,12 +36,18 @@
  *
  * FAT-P headers used:
  *   AlignedVector.h       — AlignedStoragePolicy
- *   ConcurrencyPolicies.h — ConcurrentStoragePolicy
+ *   ConcurrencyPolicies.h — ConcurrentStoragePolicy, LockFreeReadStoragePolicy
  */
 
+#include <atomic>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <fat_p/AlignedVector.h>
@@ -197,4 +204,260 @@ struct ConcurrentStoragePolicy
 
 static_assert(StoragePolicy<ConcurrentStoragePolicy<fat_p::SingleThreadedPolicy>::Policy>);
 
+// =============================================================================
+// StorageEpoch — quiescent points for LockFreeReadStoragePolicy
+//
+// A LockFreeReadStoragePolicy buffer that outgrows its capacity is retired,
+// not freed: readers on other threads may still hold pointers into it.
+// Each retired buffer is tagged with the epoch current at retirement.
+// advance() declares that no reader holds a pointer obtained before the
+// call (e.g. after the frame's last parallel system has joined); buffers
+// tagged with an older epoch are then freed by their container on its next
+// growth, clear() or reclaim().
+// =============================================================================
+
+struct StorageEpoch
+{
+    [[nodiscard]] static uint64_t current() noexcept
+    {
+        return sEpoch.load(std::memory_order_acquire);
+    }
+
+    static void advance() noexcept
+    {
+        sEpoch.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+private:
+    inline static std::atomic<uint64_t> sEpoch{0};
+};
+
+// =============================================================================
+// LockFreeReadStoragePolicy<WriterLock> — readers never lock
+//
+// Usage: registry.useStorage<Health, LockFreeReadStoragePolicy<>::Policy>();
+//
+// ConcurrentStoragePolicy takes a lock on every element access. Here reads
+// (operator[], data(), size(), span()) are plain acquire loads:
+//
+//   - Growth copies the elements into a new buffer, publishes it with a
+//     release store, and retires the old buffer instead of freeing it. A
+//     reader still walking the old buffer sees valid (if stale) data.
+//   - Appends construct the element first, then publish the new size with a
+//     release store, so a reader never sees a half-built element.
+//   - span() loads size before data. Every buffer published before that
+//     size is at least that large, so the pair is always in bounds. Readers
+//     that run concurrently with appends must use span(), not begin()/end().
+//
+// Only structural changes take WriterLock (default: none, since Registry
+// serializes them already). Element writes are not synchronized: they
+// follow the Scheduler write-mask rules, and a write to an element during
+// growth may land in the retired copy. Retired buffers are freed after
+// StorageEpoch::advance(); until then they cost at most one extra capacity
+// in total (growth is geometric).
+//
+// Restricted to trivially copyable T: growth and retirement must not run
+// constructors or destructors under a concurrent reader.
+// =============================================================================
+
+template <typename WriterLock = fat_p::SingleThreadedPolicy>
+struct LockFreeReadStoragePolicy
+{
+    template <typename T>
+    struct Policy
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "LockFreeReadStoragePolicy requires trivially copyable components");
+
+        class container_type
+        {
+        public:
+            using value_type = T;
+
+            container_type() = default;
+            container_type(const container_type&) = delete;
+            container_type& operator=(const container_type&) = delete;
+
+            container_type(container_type&& o) noexcept
+                : mData(o.mData.exchange(nullptr, std::memory_order_relaxed))
+                , mSize(o.mSize.exchange(0, std::memory_order_relaxed))
+                , mCapacity(std::exchange(o.mCapacity, 0))
+                , mRetired(std::move(o.mRetired))
+            {
+            }
+
+            container_type& operator=(container_type&& o) noexcept
+            {
+                if (this != &o)
+                {
+                    release();
+                    mData.store(o.mData.exchange(nullptr, std::memory_order_relaxed),
+                                std::memory_order_release);
+                    mSize.store(o.mSize.exchange(0, std::memory_order_relaxed),
+                                std::memory_order_release);
+                    mCapacity = std::exchange(o.mCapacity, 0);
+                    mRetired = std::move(o.mRetired);
+                }
+                return *this;
+            }
+
+            ~container_type() { release(); }
+
+            // Structural mutations — serialized by WriterLock.
+            // [[maybe_unused]]: RAII guards are held for their destructor side-effect.
+            void push_back(T&& v)      { emplace_back(std::move(v)); }
+            void push_back(const T& v) { emplace_back(v); }
+
+            template <typename... Args>
+            T& emplace_back(Args&&... args)
+            {
+                [[maybe_unused]] auto g = mLock.lock();
+                const std::size_t n = mSize.load(std::memory_order_relaxed);
+                if (n == mCapacity)
+                {
+                    grow(n == 0 ? kInitialCapacity : n * 2);
+                }
+                T* slot = ::new (mData.load(std::memory_order_relaxed) + n)
+                    T(std::forward<Args>(args)...);
+                mSize.store(n + 1, std::memory_order_release);
+                return *slot;
+            }
+
+            void pop_back()
+            {
+                [[maybe_unused]] auto g = mLock.lock();
+                mSize.store(mSize.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+            }
+
+            void clear()
+            {
+                [[maybe_unused]] auto g = mLock.lock();
+                mSize.store(0, std::memory_order_release);
+                reclaimExpired();
+            }
+
+            /// @brief Free retired buffers older than StorageEpoch::current().
+            void reclaim()
+            {
+                [[maybe_unused]] auto g = mLock.lock();
+                reclaimExpired();
+            }
+
+            [[nodiscard]] std::size_t retiredCount() const noexcept { return mRetired.size(); }
+
+            // Reads — lock-free.
+            T&       back()       noexcept { return data()[size() - 1]; }
+            const T& back() const noexcept { return data()[size() - 1]; }
+
+            T&       operator[](std::size_t i) noexcept       { return data()[i]; }
+            const T& operator[](std::size_t i) const noexcept { return data()[i]; }
+
+            T*       data() noexcept       { return mData.load(std::memory_order_acquire); }
+            const T* data() const noexcept { return mData.load(std::memory_order_acquire); }
+
+            std::size_t size()  const noexcept { return mSize.load(std::memory_order_acquire); }
+            bool        empty() const noexcept { return size() == 0; }
+
+            /// @brief Consistent (data, size) pair for readers racing appends.
+            [[nodiscard]] std::span<T> span() noexcept
+            {
+                const std::size_t n = size();
+                return {data(), n};
+            }
+
+            [[nodiscard]] std::span<const T> span() const noexcept
+            {
+                const std::size_t n = size();
+                return {data(), n};
+            }
+
+            // Iteration — quiescent use only (see span()).
+            T*       begin() noexcept       { return data(); }
+            T*       end()   noexcept       { return data() + size(); }
+            const T* begin() const noexcept { return data(); }
+            const T* end()   const noexcept { return data() + size(); }
+
+        private:
+            static constexpr std::size_t kInitialCapacity = 16;
+
+            struct Retired
+            {
+                T*       buffer;
+                uint64_t epoch;
+            };
+
+            static T* allocate(std::size_t count)
+            {
+                return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+            }
+
+            static void deallocate(T* buffer) noexcept
+            {
+                ::operator delete(buffer, std::align_val_t{alignof(T)});
+            }
+
+            void grow(std::size_t capacity)
+            {
+                reclaimExpired();
+                T* fresh = allocate(capacity);
+                T* old = mData.load(std::memory_order_relaxed);
+                if (old != nullptr)
+                {
+                    std::memcpy(static_cast<void*>(fresh), old,
+                                mSize.load(std::memory_order_relaxed) * sizeof(T));
+                }
+                mData.store(fresh, std::memory_order_release);
+                mCapacity = capacity;
+                if (old != nullptr)
+                {
+                    mRetired.push_back({old, StorageEpoch::current()});
+                }
+            }
+
+            void reclaimExpired() noexcept
+            {
+                const uint64_t now = StorageEpoch::current();
+                std::size_t kept = 0;
+                for (const Retired& r : mRetired)
+                {
+                    if (r.epoch < now)
+                    {
+                        deallocate(r.buffer);
+                    }
+                    else
+                    {
+                        mRetired[kept++] = r;
+                    }
+                }
+                mRetired.resize(kept);
+            }
+
+            void release() noexcept
+            {
+                for (const Retired& r : mRetired)
+                {
+                    deallocate(r.buffer);
+                }
+                mRetired.clear();
+                if (T* buffer = mData.exchange(nullptr, std::memory_order_relaxed))
+                {
+                    deallocate(buffer);
+                }
+                mSize.store(0, std::memory_order_relaxed);
+                mCapacity = 0;
+            }
+
+            std::atomic<T*>          mData{nullptr};
+            std::atomic<std::size_t> mSize{0};
+            std::size_t              mCapacity = 0;
+            std::vector<Retired>     mRetired;
+            mutable WriterLock       mLock;
+        };
+
+        static container_type make() { return {}; }
+    };
+};
+
+static_assert(StoragePolicy<LockFreeReadStoragePolicy<>::Policy>);
+
 } // namespace fatp_ecs
@@ -13,6 +13,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <limits>
 
 #include "ComponentMask.h"
 
@@ -25,6 +26,9 @@ namespace fatp_ecs
 
 using TypeId = std::size_t;
 
+/// @brief A TypeId no type is ever assigned (e.g. an unknown reflected name).
+inline constexpr TypeId kInvalidTypeId = std::numeric_limits<TypeId>::max();
+
 namespace detail
 {
 
@@ -0,0 +1,513 @@
+/**
+ * @file test_allocation_tracking.cpp
+ * @brief Steady-state zero-allocation tests, using AllocationTracker.
+ *
+ * Each test warms a workload up (so stores, free lists and buffers reach
+ * their working capacity), then repeats it under an AllocationScope and
+ * asserts that no heap allocation happened.
+ *
+ * Verifies:
+ *   Tracker            — installed, counts new/delete, AllocationScope deltas
+ *   View iteration     — view<A>, view<A, B>, exclude views
+ *   Component access   — get / tryGet / has / patch
+ *   Churn              — create/add/remove/destroy within warmed capacity
+ *   clear<T>()         — no scratch copy of the dense array
+ *   RuntimeView        — construction and each()
+ *   CommandBuffer      — record + flush (create / destroy / add / remove)
+ *   ParallelCommandBuffer — record + flush
+ *   Scheduler::run()   — serial batches, and the cached batch plan
+ *   Groups / Observer  — owning group iteration, observer each + clear
+ *   EntityNames        — findByName / findByInterned / getName
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fatp_ecs/AllocationTracker.h"
+#include "fatp_ecs/FatpEcs.h"
+
+FATP_ECS_INSTALL_ALLOCATION_TRACKER();
+
+// =============================================================================
+// Test infrastructure
+// =============================================================================
+
+static int gPassed = 0;
+static int gFailed = 0;
+
+#define TEST_ASSERT(cond, msg)                                 \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            std::printf("  FAIL [%s]: %s\n", __func__, (msg)); \
+            ++gFailed;                                         \
+        }                                                      \
+        else                                                   \
+        {                                                      \
+            ++gPassed;                                         \
+        }                                                      \
+    } while (false)
+
+#define RUN_TEST(fn)                         \
+    do                                       \
+    {                                        \
+        std::printf("  Running: %s\n", #fn); \
+        fn();                                \
+    } while (false)
+
+using namespace fatp_ecs;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+struct Position
+{
+    float x{}, y{};
+};
+
+struct Velocity
+{
+    float dx{}, dy{};
+};
+
+struct Frozen
+{
+};
+
+// Non-trivial payload: exercises destructor handling in command buffers.
+struct Label
+{
+    std::string text;
+};
+
+static constexpr int kEntities = 1000;
+static constexpr int kWarmupFrames = 3;
+static constexpr int kMeasuredFrames = 10;
+
+static std::vector<Entity> populate(Registry& reg, int count)
+{
+    std::vector<Entity> ents;
+    ents.reserve(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        Entity e = reg.create();
+        reg.add<Position>(e, static_cast<float>(i), 0.0f);
+        if (i % 2 == 0)
+        {
+            reg.add<Velocity>(e, 1.0f, 1.0f);
+        }
+        if (i % 5 == 0)
+        {
+            reg.add<Frozen>(e);
+        }
+        ents.push_back(e);
+    }
+    return ents;
+}
+
+// Runs frame() kWarmupFrames times unmeasured, then kMeasuredFrames times
+// under an AllocationScope, and returns the allocations observed.
+template <typename Frame>
+static uint64_t steadyStateAllocations(Frame&& frame)
+{
+    for (int i = 0; i < kWarmupFrames; ++i)
+    {
+        frame();
+    }
+    AllocationScope scope;
+    for (int i = 0; i < kMeasuredFrames; ++i)
+    {
+        frame();
+    }
+    return scope.allocations();
+}
+
+// =============================================================================
+// Tracker
+// =============================================================================
+
+void test_tracker_counts_allocations()
+{
+    TEST_ASSERT(AllocationTracker::installed(), "tracker installed in this executable");
+
+    AllocationScope scope;
+    auto p = std::make_unique<int>(42);
+    auto v = std::make_unique<double[]>(16);
+    const AllocationStats d = scope.delta();
+    TEST_ASSERT(d.allocations == 2, "two allocations counted");
+    TEST_ASSERT(d.bytes >= sizeof(int) + 16 * sizeof(double), "bytes counted");
+
+    p.reset();
+    v.reset();
+    TEST_ASSERT(scope.delta().deallocations == 2, "two deallocations counted");
+
+    scope.reset();
+    TEST_ASSERT(scope.allocations() == 0, "reset() restarts the measurement");
+}
+
+// =============================================================================
+// Registry hot paths
+// =============================================================================
+
+void test_view_iteration_allocates_nothing()
+{
+    Registry reg;
+    populate(reg, kEntities);
+
+    float sink = 0.0f;
+    const uint64_t allocs = steadyStateAllocations([&] {
+        reg.view<Position>().each([&](Entity, Position& p) { sink += p.x; });
+        reg.view<Position, Velocity>().each([](Entity, Position& p, Velocity& v) {
+            p.x += v.dx;
+            p.y += v.dy;
+        });
+        reg.view<Position>(Exclude<Frozen>{}).each([&](Entity, Position& p) { sink += p.y; });
+    });
+    TEST_ASSERT(allocs == 0, "view iteration is allocation-free");
+    TEST_ASSERT(sink != 0.0f, "views did work");
+}
+
+void test_component_access_allocates_nothing()
+{
+    Registry reg;
+    const auto ents = populate(reg, kEntities);
+
+    std::size_t hits = 0;
+    const uint64_t allocs = steadyStateAllocations([&] {
+        for (Entity e : ents)
+        {
+            hits += reg.has<Velocity>(e) ? 1u : 0u;
+            if (auto* v = reg.tryGet<Velocity>(e))
+            {
+                v->dx += 1.0f;
+            }
+            reg.get<Position>(e).x += 1.0f;
+            reg.patch<Position>(e, [](Position& p) { p.y += 1.0f; });
+        }
+    });
+    TEST_ASSERT(allocs == 0, "get/tryGet/has/patch are allocation-free");
+    TEST_ASSERT(hits > 0, "accesses did work");
+}
+
+void test_churn_within_capacity_allocates_nothing()
+{
+    Registry reg;
+    populate(reg, kEntities);
+
+    std::vector<Entity> wave;
+    wave.reserve(256);
+    const uint64_t allocs = steadyStateAllocations([&] {
+        for (int i = 0; i < 256; ++i)
+        {
+            Entity e = reg.create();
+            reg.add<Position>(e, 1.0f, 2.0f);
+            reg.add<Velocity>(e, 3.0f, 4.0f);
+            wave.push_back(e);
+        }
+        for (std::size_t i = 0; i < wave.size(); i += 2)
+        {
+            reg.remove<Velocity>(wave[i]);
+        }
+        for (Entity e : wave)
+        {
+            reg.destroy(e);
+        }
+        wave.clear();
+    });
+    TEST_ASSERT(allocs == 0, "create/add/remove/destroy churn is allocation-free after warmup");
+    TEST_ASSERT(reg.entityCount() == static_cast<std::size_t>(kEntities), "population restored");
+}
+
+void test_clear_component_allocates_nothing()
+{
+    Registry reg;
+    const auto ents = populate(reg, kEntities);
+
+    const uint64_t allocs = steadyStateAllocations([&] {
+        for (Entity e : ents)
+        {
+            if (!reg.has<Frozen>(e))
+            {
+                reg.add<Frozen>(e);
+            }
+        }
+        reg.clear<Frozen>();
+    });
+    TEST_ASSERT(allocs == 0, "clear<T>() is allocation-free");
+    TEST_ASSERT(reg.view<Frozen>().count() == 0, "clear<T>() removed every instance");
+}
+
+void test_clear_component_fires_every_removal()
+{
+    Registry reg;
+    const auto ents = populate(reg, 100);
+
+    std::size_t removed = 0;
+    auto conn = reg.events().onComponentRemoved<Position>().connect([&](Entity) { ++removed; });
+    reg.clear<Position>();
+    TEST_ASSERT(removed == ents.size(), "onComponentRemoved fired once per entity");
+    TEST_ASSERT(reg.view<Position>().count() == 0, "store empty");
+}
+
+void test_runtime_view_allocates_nothing()
+{
+    Registry reg;
+    populate(reg, kEntities);
+
+    const TypeId include[] = {typeId<Position>(), typeId<Velocity>()};
+    const TypeId exclude[] = {typeId<Frozen>()};
+
+    std::size_t matched = 0;
+    const uint64_t allocs = steadyStateAllocations([&] {
+        auto rv = reg.runtimeView({typeId<Position>(), typeId<Velocity>()}, {typeId<Frozen>()});
+        rv.each([&](Entity) { ++matched; });
+
+        auto rv2 = reg.runtimeView(include, 2, exclude, 1);
+        matched += rv2.count();
+    });
+    TEST_ASSERT(allocs == 0, "runtimeView construction and each() are allocation-free");
+    TEST_ASSERT(matched > 0, "runtime views matched entities");
+}
+
+// =============================================================================
+// Command buffers
+// =============================================================================
+
+void test_command_buffer_allocates_nothing()
+{
+    Registry reg;
+    const auto ents = populate(reg, kEntities);
+    CommandBuffer cmd;
+
+    std::vector<Entity> spawned;
+    spawned.reserve(64);
+    const uint64_t allocs = steadyStateAllocations([&] {
+        for (std::size_t i = 0; i < ents.size(); i += 4)
+        {
+            cmd.add<Velocity>(ents[i], 2.0f, 2.0f);
+            cmd.add<Label>(ents[i], Label{});
+            cmd.remove<Frozen>(ents[i]);
+        }
+        for (int i = 0; i < 64; ++i)
+        {
+            cmd.create();
+        }
+        cmd.flush(reg);
+
+        reg.view<Label>().each([&](Entity e, Label&) { cmd.remove<Label>(e); });
+        cmd.flush(reg);
+    });
+    TEST_ASSERT(allocs == 0, "CommandBuffer record + flush is allocation-free after warmup");
+    TEST_ASSERT(cmd.empty(), "buffer drained");
+}
+
+void test_command_buffer_destroy_allocates_nothing()
+{
+    Registry reg;
+    populate(reg, kEntities);
+    CommandBuffer cmd;
+
+    std::vector<Entity> wave;
+    wave.reserve(128);
+    const uint64_t allocs = steadyStateAllocations([&] {
+        for (int i = 0; i < 128; ++i)
+        {
+            Entity e = reg.create();
+            reg.add<Position>(e, 0.0f, 0.0f);
+            wave.push_back(e);
+        }
+        for (Entity e : wave)
+        {
+            cmd.destroy(e);
+        }
+        cmd.flush(reg);
+        wave.clear();
+    });
+    TEST_ASSERT(allocs == 0, "deferred destroy is allocation-free after warmup");
+    TEST_ASSERT(reg.entityCount() == static_cast<std::size_t>(kEntities), "wave destroyed");
+}
+
+void test_command_buffer_clear_destroys_payloads()
+{
+    Registry reg;
+    Entity e = reg.create();
+    auto tracker = std::make_shared<int>(0);
+    {
+        CommandBuffer cmd;
+        cmd.add<std::shared_ptr<int>>(e, tracker);
+        TEST_ASSERT(tracker.use_count() == 2, "payload holds a copy");
+        cmd.clear();
+        TEST_ASSERT(tracker.use_count() == 1, "clear() destroys pending payloads");
+
+        cmd.add<std::shared_ptr<int>>(e, tracker);
+    }
+    TEST_ASSERT(tracker.use_count() == 1, "destructor destroys pending payloads");
+    TEST_ASSERT(!reg.has<std::shared_ptr<int>>(e), "nothing was applied");
+}
+
+void test_parallel_command_buffer_allocates_nothing()
+{
+    Registry reg;
+    const auto ents = populate(reg, kEntities);
+    ParallelCommandBuffer cmd;
+
+    const uint64_t allocs = steadyStateAllocations([&] {
+        for (std::size_t i = 0; i < ents.size(); i += 3)
+        {
+            cmd.add<Label>(ents[i], Label{});
+        }
+        cmd.flush(reg);
+        for (std::size_t i = 0; i < ents.size(); i += 3)
+        {
+            cmd.remove<Label>(ents[i]);
+        }
+        cmd.flush(reg);
+    });
+    TEST_ASSERT(allocs == 0, "ParallelCommandBuffer record + flush is allocation-free after warmup");
+    TEST_ASSERT(cmd.size() == 0, "buffer drained");
+}
+
+// =============================================================================
+// Scheduler, groups, observers
+// =============================================================================
+
+void test_scheduler_serial_run_allocates_nothing()
+{
+    Registry reg;
+    populate(reg, kEntities);
+    Scheduler scheduler(2);
+
+    // Every system writes Position, so each batch holds one system and runs
+    // on the calling thread.
+    const ComponentMask writesPos = makeComponentMask<Position>();
+    for (int s = 0; s < 4; ++s)
+    {
+        scheduler.addSystem("Move", [](Registry& r, SystemContext& ctx) {
+            auto* scratch = ctx.arena().make_array<float>(64);
+            scratch[0] = 1.0f;
+            r.view<Position, Velocity>().each([&](Entity, Position& p, Velocity& v) {
+                p.x += v.dx * scratch[0];
+            });
+        }, writesPos, writesPos);
+    }
+
+    const uint64_t allocs = steadyStateAllocations([&] { scheduler.run(reg); });
+    TEST_ASSERT(allocs == 0, "Scheduler::run with serial batches is allocation-free");
+
+    scheduler.setProfilingEnabled(true);
+    const uint64_t profiled = steadyStateAllocations([&] { scheduler.run(reg); });
+    TEST_ASSERT(profiled == 0, "profiling adds no allocations");
+}
+
+void test_scheduler_plan_tracks_system_changes()
+{
+    Registry reg;
+    Scheduler scheduler(2);
+    const ComponentMask writesPos = makeComponentMask<Position>();
+
+    int runs = 0;
+    scheduler.addSystem("A", [&](Registry&) { ++runs; }, writesPos);
+    scheduler.run(reg);
+    TEST_ASSERT(runs == 1, "one system ran");
+
+    scheduler.addSystem("B", [&](Registry&) { ++runs; }, writesPos);
+    scheduler.run(reg);
+    TEST_ASSERT(runs == 3, "system added after a run is scheduled");
+
+    scheduler.clearSystems();
+    scheduler.run(reg);
+    TEST_ASSERT(runs == 3, "cleared systems no longer run");
+
+    scheduler.addSystem("C", [&](Registry&) { runs += 10; });
+    scheduler.run(reg);
+    TEST_ASSERT(runs == 13, "new system after clear runs");
+}
+
+void test_owning_group_and_observer_allocate_nothing()
+{
+    Registry reg;
+    populate(reg, kEntities);
+    auto& group = reg.group<Position, Velocity>();
+    auto observer = reg.observe(OnUpdated<Position>{});
+
+    std::size_t seen = 0;
+    const uint64_t allocs = steadyStateAllocations([&] {
+        group.each([](Entity e, Position& p, Velocity& v) {
+            (void)e;
+            p.x += v.dx;
+        });
+        reg.view<Position>().each([&](Entity e, Position&) {
+            if (EntityTraits::index(e) % 7 == 0)
+            {
+                reg.patch<Position>(e, [](Position& p) { p.y += 1.0f; });
+            }
+        });
+        observer.each([&](Entity) { ++seen; });
+        observer.clear();
+    });
+    TEST_ASSERT(allocs == 0, "owning group iteration and observer each/clear are allocation-free");
+    TEST_ASSERT(seen > 0, "observer saw updates");
+}
+
+void test_entity_names_lookup_allocates_nothing()
+{
+    Registry reg;
+    EntityNames names;
+    std::vector<Entity> named;
+    for (int i = 0; i < 64; ++i)
+    {
+        Entity e = reg.create();
+        names.setName(e, "unit_" + std::to_string(i));
+        named.push_back(e);
+    }
+    const char* key = names.intern("unit_42");
+
+    std::size_t hits = 0;
+    const uint64_t allocs = steadyStateAllocations([&] {
+        hits += names.findByName("unit_7") == named[7] ? 1u : 0u;
+        hits += names.findByName("missing") == NullEntity ? 1u : 0u;
+        hits += names.findByInterned(key) == named[42] ? 1u : 0u;
+        const char* name = names.getName(named[3]);
+        hits += name != nullptr && std::strcmp(name, "unit_3") == 0 ? 1u : 0u;
+    });
+    TEST_ASSERT(allocs == 0, "name lookups are allocation-free");
+    TEST_ASSERT(hits == 4u * (kWarmupFrames + kMeasuredFrames), "every lookup resolved");
+}
+
+// =============================================================================
+// main
+// =============================================================================
+
+int main()
+{
+    std::printf("=== test_allocation_tracking ===\n");
+
+    RUN_TEST(test_tracker_counts_allocations);
+
+    RUN_TEST(test_view_iteration_allocates_nothing);
+    RUN_TEST(test_component_access_allocates_nothing);
+    RUN_TEST(test_churn_within_capacity_allocates_nothing);
+    RUN_TEST(test_clear_component_allocates_nothing);
+    RUN_TEST(test_clear_component_fires_every_removal);
+    RUN_TEST(test_runtime_view_allocates_nothing);
+
+    RUN_TEST(test_command_buffer_allocates_nothing);
+    RUN_TEST(test_command_buffer_destroy_allocates_nothing);
+    RUN_TEST(test_command_buffer_clear_destroys_payloads);
+    RUN_TEST(test_parallel_command_buffer_allocates_nothing);
+
+    RUN_TEST(test_scheduler_serial_run_allocates_nothing);
+    RUN_TEST(test_scheduler_plan_tracks_system_changes);
+    RUN_TEST(test_owning_group_and_observer_allocate_nothing);
+    RUN_TEST(test_entity_names_lookup_allocates_nothing);
+
+    std::printf("\n%d/%d tests passed\n", gPassed, gPassed + gFailed);
+    return gFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,450 @@
+/**
+ * @file test_archetype_registry.cpp
+ * @brief Tests for ArchetypeRegistry — archetype table storage.
+ *
+ * Verifies:
+ *   create / destroy / isAlive, including generation bumps on slot reuse
+ *   add / get / has / tryGet / remove keep values across table moves
+ *   add() on an existing component returns it unchanged
+ *   view() spans every matching table; Exclude filters; count()
+ *   Cached queries pick up tables created after their first use
+ *   Views stay valid while many other query shapes are cached
+ *   Non-trivial components are moved and destroyed exactly once
+ *   clear() destroys everything but keeps tables usable
+ *   Randomized add/remove/destroy matches Registry
+ *   A system templated on the registry type runs on both
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fatp_ecs/FatpEcs.h"
+
+// =============================================================================
+// Test infrastructure
+// =============================================================================
+
+static int gPassed = 0;
+static int gFailed = 0;
+
+#define TEST_ASSERT(cond, msg)                                 \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            std::printf("  FAIL [%s]: %s\n", __func__, (msg)); \
+            ++gFailed;                                         \
+        }                                                      \
+        else                                                   \
+        {                                                      \
+            ++gPassed;                                         \
+        }                                                      \
+    } while (false)
+
+#define RUN_TEST(fn)                         \
+    do                                       \
+    {                                        \
+        std::printf("  Running: %s\n", #fn); \
+        fn();                                \
+    } while (false)
+
+using namespace fatp_ecs;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+struct Position
+{
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Velocity
+{
+    float dx = 0.0f;
+    float dy = 0.0f;
+};
+
+struct Health
+{
+    int hp = 0;
+};
+
+struct Frozen
+{
+};
+
+struct Name
+{
+    std::string value;
+};
+
+template <int N>
+struct Tag
+{
+};
+
+static int gLiveTracked = 0;
+
+struct Tracked
+{
+    int id = 0;
+
+    explicit Tracked(int v) : id(v) { ++gLiveTracked; }
+    Tracked(const Tracked& other) : id(other.id) { ++gLiveTracked; }
+    Tracked(Tracked&& other) noexcept : id(other.id) { ++gLiveTracked; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) noexcept = default;
+    ~Tracked() { --gLiveTracked; }
+};
+
+template <typename R>
+static void integrate(R& registry)
+{
+    registry.template view<Position, Velocity>().each(
+        [](Entity, Position& p, const Velocity& v)
+        {
+            p.x += v.dx;
+            p.y += v.dy;
+        });
+}
+
+// =============================================================================
+// Entity lifecycle
+// =============================================================================
+
+void test_create_and_destroy()
+{
+    ArchetypeRegistry reg;
+    const Entity a = reg.create();
+    const Entity b = reg.create();
+    TEST_ASSERT(reg.alive() == 2, "two alive");
+    TEST_ASSERT(reg.isAlive(a) && reg.isAlive(b), "both alive");
+    TEST_ASSERT(!reg.isAlive(NullEntity), "NullEntity is not alive");
+
+    TEST_ASSERT(reg.destroy(a), "destroy live entity");
+    TEST_ASSERT(!reg.destroy(a), "destroy twice fails");
+    TEST_ASSERT(!reg.isAlive(a), "destroyed entity is dead");
+
+    const Entity c = reg.create();
+    TEST_ASSERT(EntityTraits::index(c) == EntityTraits::index(a), "slot reused");
+    TEST_ASSERT(c != a && !reg.isAlive(a), "stale handle stays dead after reuse");
+    TEST_ASSERT(reg.alive() == 2, "count after reuse");
+}
+
+// =============================================================================
+// Component operations
+// =============================================================================
+
+void test_components_survive_table_moves()
+{
+    ArchetypeRegistry reg;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 10; ++i)
+    {
+        const Entity e = reg.create();
+        reg.add<Position>(e, static_cast<float>(i), 0.0f);
+        if (i % 2 == 0)
+        {
+            reg.add<Velocity>(e, 1.0f, static_cast<float>(i));
+        }
+        entities.push_back(e);
+    }
+    reg.add<Health>(entities[4], 40);
+    TEST_ASSERT(reg.remove<Position>(entities[2]), "remove present component");
+    TEST_ASSERT(!reg.remove<Position>(entities[2]), "remove absent component");
+
+    bool intact = true;
+    for (int i = 0; i < 10; ++i)
+    {
+        const Entity e = entities[static_cast<std::size_t>(i)];
+        if (i != 2)
+        {
+            intact = intact && reg.get<Position>(e).x == static_cast<float>(i);
+        }
+        intact = intact && reg.has<Velocity>(e) == (i % 2 == 0);
+        if (i % 2 == 0)
+        {
+            intact = intact && reg.get<Velocity>(e).dy == static_cast<float>(i);
+        }
+    }
+    TEST_ASSERT(intact, "every value follows its entity");
+    TEST_ASSERT(!reg.has<Position>(entities[2]), "removed component gone");
+    TEST_ASSERT(reg.tryGet<Position>(entities[2]) == nullptr, "tryGet on removed is null");
+    TEST_ASSERT(reg.get<Health>(entities[4]).hp == 40, "third component added");
+
+    const Health& again = reg.add<Health>(entities[4], 99);
+    TEST_ASSERT(again.hp == 40, "add on existing component returns it unchanged");
+
+    bool threw = false;
+    try
+    {
+        (void)reg.get<Health>(entities[0]);
+    }
+    catch (const std::out_of_range&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "get on missing component throws");
+}
+
+void test_destroy_patches_moved_row()
+{
+    ArchetypeRegistry reg;
+    const Entity a = reg.create();
+    const Entity b = reg.create();
+    const Entity c = reg.create();
+    reg.add<Position>(a, 1.0f, 0.0f);
+    reg.add<Position>(b, 2.0f, 0.0f);
+    reg.add<Position>(c, 3.0f, 0.0f);
+
+    reg.destroy(a); // c fills a's row
+    TEST_ASSERT(reg.get<Position>(c).x == 3.0f, "moved entity still resolves");
+    TEST_ASSERT(reg.get<Position>(b).x == 2.0f, "untouched entity still resolves");
+    reg.remove<Position>(c);
+    TEST_ASSERT(reg.get<Position>(b).x == 2.0f, "row bookkeeping after remove");
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+void test_view_spans_tables()
+{
+    ArchetypeRegistry reg;
+    for (int i = 0; i < 12; ++i)
+    {
+        const Entity e = reg.create();
+        reg.add<Position>(e);
+        reg.add<Velocity>(e, 1.0f, 2.0f);
+        if (i % 3 == 0)
+        {
+            reg.add<Health>(e, i);
+        }
+        if (i % 4 == 0)
+        {
+            reg.add<Frozen>(e);
+        }
+    }
+
+    auto view = reg.view<Position, Velocity>();
+    TEST_ASSERT(view.count() == 12, "all twelve match");
+    TEST_ASSERT(view.tableCount() == 4, "four component sets hold Position+Velocity");
+
+    integrate(reg);
+    float sum = 0.0f;
+    reg.view<Position>().each([&](Entity, Position& p) { sum += p.x; });
+    TEST_ASSERT(sum == 12.0f, "each() reached every table");
+
+    int thawed = 0;
+    reg.view<Position>(Exclude<Frozen>{}).each([&](Entity, Position&) { ++thawed; });
+    TEST_ASSERT(thawed == 9, "Exclude skips frozen tables");
+    TEST_ASSERT(reg.view<Health>(Exclude<Frozen>{}).count() == 3, "Exclude with Health");
+}
+
+void test_cached_query_sees_new_tables()
+{
+    ArchetypeRegistry reg;
+    const Entity a = reg.create();
+    reg.add<Position>(a);
+    TEST_ASSERT(reg.view<Position>().count() == 1, "initial match");
+
+    const Entity b = reg.create();
+    reg.add<Health>(b, 5);
+    reg.add<Position>(b); // new table {Position, Health} after the query was cached
+    TEST_ASSERT(reg.view<Position>().count() == 2, "cached query extended");
+
+    const std::size_t tables = reg.tableCount();
+    const Entity c = reg.create();
+    reg.add<Health>(c, 1);
+    reg.add<Position>(c);
+    TEST_ASSERT(reg.tableCount() == tables, "existing table reused via graph edge");
+}
+
+template <std::size_t... Is>
+static std::size_t cacheManyShapes(ArchetypeRegistry& reg, std::index_sequence<Is...>)
+{
+    return (reg.view<Position, Tag<static_cast<int>(Is)>>().count() + ...);
+}
+
+void test_view_survives_new_query_shapes()
+{
+    ArchetypeRegistry reg;
+    for (int i = 0; i < 10; ++i)
+    {
+        const Entity e = reg.create();
+        reg.add<Position>(e, static_cast<float>(i), 0.0f);
+        reg.add<Velocity>(e, 1.0f, 0.0f);
+    }
+
+    auto held = reg.view<Position, Velocity>();
+    TEST_ASSERT(cacheManyShapes(reg, std::make_index_sequence<64>{}) == 0,
+                "tag shapes match nothing");
+
+    std::size_t seen = 0;
+    float sum = 0.0f;
+    held.each([&](Entity, Position& p, Velocity& v)
+    {
+        ++seen;
+        sum += p.x + v.dx;
+    });
+    TEST_ASSERT(seen == 10, "held view still iterates every entity");
+    TEST_ASSERT(sum == 55.0f, "held view reads the right columns");
+    TEST_ASSERT(held.count() == 10, "held view count");
+}
+
+// =============================================================================
+// Non-trivial components
+// =============================================================================
+
+void test_non_trivial_lifetimes()
+{
+    gLiveTracked = 0;
+    {
+        ArchetypeRegistry reg;
+        std::vector<Entity> entities;
+        for (int i = 0; i < 40; ++i)
+        {
+            const Entity e = reg.create();
+            reg.add<Tracked>(e, i);
+            reg.add<Name>(e, std::string(32, static_cast<char>('a' + i % 26)));
+            entities.push_back(e);
+        }
+        TEST_ASSERT(gLiveTracked == 40, "one live instance per entity");
+
+        for (int i = 0; i < 40; i += 3)
+        {
+            reg.add<Position>(entities[static_cast<std::size_t>(i)]);
+        }
+        for (int i = 0; i < 40; i += 5)
+        {
+            reg.destroy(entities[static_cast<std::size_t>(i)]);
+        }
+        TEST_ASSERT(gLiveTracked == 32, "moves neither leak nor double-destroy");
+
+        bool intact = true;
+        for (int i = 0; i < 40; ++i)
+        {
+            if (i % 5 == 0)
+            {
+                continue;
+            }
+            const Entity e = entities[static_cast<std::size_t>(i)];
+            intact = intact && reg.get<Tracked>(e).id == i;
+            intact = intact && reg.get<Name>(e).value ==
+                                   std::string(32, static_cast<char>('a' + i % 26));
+        }
+        TEST_ASSERT(intact, "values intact after moves");
+
+        reg.clear();
+        TEST_ASSERT(gLiveTracked == 0, "clear destroys components");
+        TEST_ASSERT(reg.alive() == 0, "clear destroys entities");
+        TEST_ASSERT(!reg.isAlive(entities[1]), "old handles dead after clear");
+
+        const Entity fresh = reg.create();
+        reg.add<Tracked>(fresh, 7);
+        TEST_ASSERT(reg.get<Tracked>(fresh).id == 7, "usable after clear");
+    }
+    TEST_ASSERT(gLiveTracked == 0, "registry destructor destroys components");
+}
+
+// =============================================================================
+// Differential test against Registry
+// =============================================================================
+
+void test_matches_registry()
+{
+    Registry sparse;
+    ArchetypeRegistry tables;
+    std::vector<Entity> sparseEntities;
+    std::vector<Entity> tableEntities;
+
+    std::mt19937 rng(1234);
+    for (int step = 0; step < 20000; ++step)
+    {
+        const unsigned op = rng() % 8;
+        if (op == 0 || sparseEntities.empty())
+        {
+            sparseEntities.push_back(sparse.create());
+            tableEntities.push_back(tables.create());
+            continue;
+        }
+        const std::size_t pick = rng() % sparseEntities.size();
+        const Entity s = sparseEntities[pick];
+        const Entity t = tableEntities[pick];
+        const auto value = static_cast<float>(step);
+        switch (op)
+        {
+        case 1: sparse.add<Position>(s, value, 0.0f); tables.add<Position>(t, value, 0.0f); break;
+        case 2: sparse.add<Velocity>(s, value, 1.0f); tables.add<Velocity>(t, value, 1.0f); break;
+        case 3: sparse.add<Health>(s, step); tables.add<Health>(t, step); break;
+        case 4: sparse.remove<Position>(s); tables.remove<Position>(t); break;
+        case 5: sparse.remove<Velocity>(s); tables.remove<Velocity>(t); break;
+        case 6: sparse.remove<Health>(s); tables.remove<Health>(t); break;
+        default:
+            if (rng() % 4 == 0)
+            {
+                sparse.destroy(s);
+                tables.destroy(t);
+                sparseEntities[pick] = sparseEntities.back();
+                tableEntities[pick] = tableEntities.back();
+                sparseEntities.pop_back();
+                tableEntities.pop_back();
+            }
+            break;
+        }
+    }
+
+    TEST_ASSERT(sparse.alive() == tables.alive(), "same live count");
+    bool same = true;
+    for (std::size_t i = 0; i < sparseEntities.size(); ++i)
+    {
+        const Entity s = sparseEntities[i];
+        const Entity t = tableEntities[i];
+        const Position* sp = sparse.tryGet<Position>(s);
+        const Position* tp = tables.tryGet<Position>(t);
+        same = same && (sp == nullptr) == (tp == nullptr) && (sp == nullptr || sp->x == tp->x);
+        const Health* sh = sparse.tryGet<Health>(s);
+        const Health* th = tables.tryGet<Health>(t);
+        same = same && (sh == nullptr) == (th == nullptr) && (sh == nullptr || sh->hp == th->hp);
+        same = same && sparse.has<Velocity>(s) == tables.has<Velocity>(t);
+    }
+    TEST_ASSERT(same, "per-entity state matches");
+
+    integrate(sparse);
+    integrate(tables);
+    double sparseSum = 0.0;
+    double tableSum = 0.0;
+    sparse.view<Position>(Exclude<Health>{}).each([&](Entity, Position& p) { sparseSum += p.x; });
+    tables.view<Position>(Exclude<Health>{}).each([&](Entity, Position& p) { tableSum += p.x; });
+    TEST_ASSERT(sparseSum == tableSum, "same system result through view()");
+    const std::size_t sparseCount = sparse.view<Position, Velocity>().count();
+    const std::size_t tableCount = tables.view<Position, Velocity>().count();
+    TEST_ASSERT(sparseCount == tableCount, "same query count");
+}
+
+int main()
+{
+    std::printf("=== test_archetype_registry ===\n");
+
+    RUN_TEST(test_create_and_destroy);
+
+    RUN_TEST(test_components_survive_table_moves);
+    RUN_TEST(test_destroy_patches_moved_row);
+
+    RUN_TEST(test_view_spans_tables);
+    RUN_TEST(test_cached_query_sees_new_tables);
+    RUN_TEST(test_view_survives_new_query_shapes);
+
+    RUN_TEST(test_non_trivial_lifetimes);
+    RUN_TEST(test_matches_registry);
+
+    std::printf("\n%d/%d tests passed\n", gPassed, gPassed + gFailed);
+    return gFailed == 0 ? 0 : 1;
+}
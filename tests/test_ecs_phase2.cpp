@@ -6,7 +6,7 @@
  * - EventBus: entity/component lifecycle signals
  * - ComponentMask: BitSet-based archetype matching
  * - CommandBuffer: deferred operations, flush, clear
- * - ParallelCommandBuffer: thread-safe deferred operations
+ * - ParallelCommandBuffer: thread-safe deferred operations, throwing flush
  * - Scheduler: system registration, dependency analysis, parallel execution
  * - Scheduler::parallel_for: data-level parallelism
  * - Integration: events + command buffer + scheduler working together
@@ -25,6 +25,7 @@
 #include <functional>
 #include <mutex>
 #include <numeric>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
@@ -477,6 +478,55 @@ void test_parallel_command_buffer_thread_safe()
     TEST_ASSERT(tagCount == 100, "tagCount == 100");
 }
 
+void test_parallel_command_buffer_throwing_flush()
+{
+    Registry reg;
+    ParallelCommandBuffer pcmd;
+
+    int created = 0;
+    pcmd.create([&](Registry&, Entity) { ++created; });
+    pcmd.create([](Registry&, Entity) { throw std::runtime_error("command failed"); });
+    pcmd.create([&](Registry&, Entity) { ++created; });
+
+    bool threw = false;
+    try
+    {
+        pcmd.flush(reg);
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "exception propagates out of flush");
+    TEST_ASSERT(created == 1, "commands before the throw applied once");
+    TEST_ASSERT(reg.entityCount() == 2, "two entities created before the throw");
+
+    // The failed batch must not come back through either buffer.
+    pcmd.create([&](Registry&, Entity) { created += 10; });
+    pcmd.flush(reg);
+    TEST_ASSERT(created == 11, "only the new command ran on the next flush");
+    pcmd.flush(reg);
+    TEST_ASSERT(created == 11, "nothing replays on a later flush");
+    TEST_ASSERT(reg.entityCount() == 3, "one entity per command actually applied");
+
+    CommandBuffer cmd;
+    int plain = 0;
+    cmd.create([&](Registry&, Entity) { ++plain; });
+    cmd.create([](Registry&, Entity) { throw std::runtime_error("command failed"); });
+    threw = false;
+    try
+    {
+        cmd.flush(reg);
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw && cmd.empty(), "CommandBuffer is cleared when a command throws");
+    cmd.flush(reg);
+    TEST_ASSERT(plain == 1, "CommandBuffer does not replay applied commands");
+}
+
 // =============================================================================
 // SCHEDULER TESTS
 // =============================================================================
@@ -622,6 +672,31 @@ void test_scheduler_empty_run()
     scheduler.run(reg); // Should not crash
 }
 
+void test_scheduler_profiling()
+{
+    Registry reg;
+    Scheduler scheduler(2);
+    scheduler.addSystem("Sleepy", [](Registry&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+    scheduler.addSystem("Quick", [](Registry&) {});
+
+    scheduler.run(reg);
+    TEST_ASSERT(!scheduler.profilingEnabled(), "profiling off by default");
+    TEST_ASSERT(scheduler.lastSystemTimesNs().empty(), "no timings when disabled");
+
+    scheduler.setProfilingEnabled(true);
+    scheduler.run(reg);
+    const auto& times = scheduler.lastSystemTimesNs();
+    TEST_ASSERT(times.size() == 2, "one timing per system");
+    TEST_ASSERT(times[0] >= 2'000'000, "Sleepy timing covers its sleep");
+    TEST_ASSERT(scheduler.systemName(0) == "Sleepy", "systemName(0)");
+    TEST_ASSERT(scheduler.systemName(1) == "Quick", "systemName(1)");
+
+    scheduler.clearSystems();
+    TEST_ASSERT(scheduler.lastSystemTimesNs().empty(), "clearSystems drops timings");
+}
+
 // =============================================================================
 // PARALLEL_FOR TESTS
 // =============================================================================
@@ -1042,6 +1117,7 @@ int main()
 
     std::printf("\n[Parallel Command Buffer]\n");
     RUN_TEST(test_parallel_command_buffer_thread_safe);
+    RUN_TEST(test_parallel_command_buffer_throwing_flush);
 
     std::printf("\n[Scheduler]\n");
     RUN_TEST(test_scheduler_basic_execution);
@@ -1049,6 +1125,7 @@ int main()
     RUN_TEST(test_scheduler_conflicting_sequential);
     RUN_TEST(test_scheduler_system_count);
     RUN_TEST(test_scheduler_empty_run);
+    RUN_TEST(test_scheduler_profiling);
 
     std::printf("\n[Parallel For]\n");
     RUN_TEST(test_parallel_for_basic);
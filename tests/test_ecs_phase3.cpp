@@ -7,7 +7,7 @@
  *
  * FAT-P components exercised:
  * - ObjectPool (FrameAllocator)
- * - StringPool + FlatMap (EntityNames)
+ * - StringPool + FastHashMap (EntityNames)
  * - JsonLite (EntityTemplate)
  * - FeatureManager (SystemToggle)
  * - CheckedArithmetic (SafeMath)
@@ -257,6 +257,54 @@ void test_entity_names_remove()
     TEST_ASSERT(names.size() == 0, "Size should be 0");
 }
 
+void test_entity_names_interned_lookup()
+{
+    Registry registry;
+    EntityNames names;
+
+    Entity e = registry.create();
+    const char* key = names.intern("boss");
+    TEST_ASSERT(names.findByInterned(key) == NullEntity, "Interning alone assigns nothing");
+
+    const char* assigned = names.setName(e, "boss");
+    TEST_ASSERT(assigned == key, "setName should return the same interned pointer");
+    TEST_ASSERT(names.findByInterned(key) == e, "findByInterned should resolve the entity");
+    TEST_ASSERT(names.setName(e, "boss") == key, "Re-assigning the same name is a no-op");
+    TEST_ASSERT(names.size() == 1, "Size should stay 1");
+
+    names.setName(e, "boss_phase2");
+    TEST_ASSERT(names.findByInterned(key) == NullEntity, "Old interned key should be released");
+}
+
+void test_entity_names_sorted_each()
+{
+    Registry registry;
+    EntityNames names;
+
+    Entity c = registry.create();
+    Entity a = registry.create();
+    Entity b = registry.create();
+    names.setName(c, "charlie");
+    names.setName(a, "alpha");
+    names.setName(b, "bravo");
+
+    std::vector<std::string> order;
+    names.each([&](const char* name, Entity) { order.emplace_back(name); });
+    TEST_ASSERT((order == std::vector<std::string>{"alpha", "bravo", "charlie"}),
+                "each should visit names in sorted order");
+
+    // The lazy index must notice renames and removals.
+    names.setName(c, "aardvark");
+    names.removeName(b);
+    order.clear();
+    std::vector<Entity> entities;
+    names.each([&](const char* name, Entity e) { order.emplace_back(name); entities.push_back(e); });
+    TEST_ASSERT((order == std::vector<std::string>{"aardvark", "alpha"}),
+                "each should reflect renames and removals");
+    TEST_ASSERT(entities.size() == 2 && entities[0] == c && entities[1] == a,
+                "each should pair names with their entities");
+}
+
 // =============================================================================
 // EntityTemplate Tests
 // =============================================================================
@@ -344,6 +392,136 @@ void test_entity_template_multiple_spawns()
     }
 }
 
+static Position parsePosition(const fat_p::JsonValue& data)
+{
+    auto& obj = std::get<fat_p::JsonObject>(data);
+    return Position{static_cast<float>(std::get<double>(obj.at("x"))),
+                    static_cast<float>(std::get<double>(obj.at("y")))};
+}
+
+void test_entity_template_typed_bulk_spawn()
+{
+    Registry registry;
+    TemplateRegistry templates;
+
+    int parseCalls = 0;
+    templates.registerComponent<Position>("Position",
+        [&parseCalls](const fat_p::JsonValue& data)
+        {
+            ++parseCalls;
+            return parsePosition(data);
+        });
+
+    templates.addTemplate("bullet", R"({
+        "components": {
+            "Position": { "x": 5.0, "y": 10.0 }
+        }
+    })");
+    TEST_ASSERT(parseCalls == 1, "Typed parser should run once, at addTemplate");
+
+    int added = 0;
+    auto conn = registry.events().onComponentAdded<Position>().connect(
+        [&added](Entity, Position&) { ++added; });
+
+    std::vector<Entity> bullets(64, NullEntity);
+    std::size_t spawned = templates.spawn(registry, "bullet", bullets.size(), bullets.data());
+    TEST_ASSERT(spawned == 64, "Bulk spawn should report 64 entities");
+    TEST_ASSERT(registry.entityCount() == 64, "Should have 64 entities");
+    TEST_ASSERT(parseCalls == 1, "Spawning must not re-parse JSON");
+    TEST_ASSERT(added == 64, "onComponentAdded should fire once per entity");
+    for (auto b : bullets)
+    {
+        TEST_ASSERT(registry.valid(b), "Each output entity should be alive");
+        TEST_ASSERT(registry.get<Position>(b).y == 10.0f, "Each bullet y should be 10.0");
+    }
+
+    // Instances are independent copies of the prototype.
+    registry.get<Position>(bullets[0]).x = 99.0f;
+    Entity next = templates.spawn(registry, "bullet");
+    TEST_ASSERT(registry.get<Position>(next).x == 5.0f, "Prototype must not alias instances");
+}
+
+void test_entity_template_bulk_spawn_missing()
+{
+    Registry registry;
+    TemplateRegistry templates;
+
+    Entity out[4] = {NullEntity, NullEntity, NullEntity, NullEntity};
+    TEST_ASSERT(templates.spawn(registry, "nonexistent", 4, out) == 0,
+                "Bulk spawn of a missing template should return 0");
+    TEST_ASSERT(registry.entityCount() == 0, "No entities should be created");
+}
+
+void test_entity_template_legacy_factory_bulk()
+{
+    Registry registry;
+    TemplateRegistry templates;
+
+    templates.registerComponent<Position>("Position", parsePosition);
+    templates.registerComponent("Health", [](Registry& reg, Entity e, const fat_p::JsonValue& data)
+    {
+        auto& obj = std::get<fat_p::JsonObject>(data);
+        reg.add<Health>(e, static_cast<int>(std::get<int64_t>(obj.at("current"))),
+                        static_cast<int>(std::get<int64_t>(obj.at("max"))));
+    });
+    TEST_ASSERT(templates.factoryCount() == 2, "Both handler kinds should count");
+
+    templates.addTemplate("orc", R"({
+        "components": {
+            "Position": { "x": 1.0, "y": 2.0 },
+            "Health": { "current": 80, "max": 90 }
+        }
+    })");
+
+    std::vector<Entity> orcs(10);
+    TEST_ASSERT(templates.spawn(registry, "orc", orcs.size(), orcs.data()) == 10,
+                "Bulk spawn should create 10 orcs");
+    for (auto o : orcs)
+    {
+        TEST_ASSERT(registry.get<Health>(o).hp == 80, "Factory component applied per entity");
+        TEST_ASSERT(registry.get<Position>(o).x == 1.0f, "Typed component applied per entity");
+    }
+}
+
+void test_entity_template_late_registration_recompiles()
+{
+    Registry registry;
+    TemplateRegistry templates;
+
+    templates.addTemplate("marker", R"({
+        "components": {
+            "Position": { "x": 3.0, "y": 4.0 }
+        }
+    })");
+
+    Entity before = templates.spawn(registry, "marker");
+    TEST_ASSERT(before != NullEntity, "Template without handlers still spawns");
+    TEST_ASSERT(!registry.has<Position>(before), "Unhandled component should be skipped");
+
+    templates.registerComponent<Position>("Position", parsePosition);
+    Entity after = templates.spawn(registry, "marker");
+    TEST_ASSERT(registry.has<Position>(after), "Late handler should recompile the template");
+    TEST_ASSERT(registry.get<Position>(after).y == 4.0f, "Recompiled value should match JSON");
+}
+
+void test_registry_bulk_create_insert()
+{
+    Registry registry;
+
+    std::vector<Entity> wave(32, NullEntity);
+    registry.create(wave.begin(), wave.end());
+    TEST_ASSERT(registry.entityCount() == 32, "create(first, last) should create 32 entities");
+
+    registry.insert<Health>(wave.begin(), wave.end(), Health{7, 9});
+    TEST_ASSERT(registry.view<Health>().count() == 32, "insert should cover the whole range");
+
+    // Existing components are kept, as with add<T>().
+    registry.get<Health>(wave[3]).hp = 1;
+    registry.insert<Health>(wave.begin(), wave.begin() + 4, Health{7, 9});
+    TEST_ASSERT(registry.get<Health>(wave[3]).hp == 1, "insert must not overwrite");
+    TEST_ASSERT(registry.get<Health>(wave[31]).maxHp == 9, "Inserted value should be copied");
+}
+
 // =============================================================================
 // SystemToggle Tests
 // =============================================================================
@@ -1077,11 +1255,18 @@ int main()
     RUN_TEST(test_entity_names_duplicate_name_rejected);
     RUN_TEST(test_entity_names_rename);
     RUN_TEST(test_entity_names_remove);
+    RUN_TEST(test_entity_names_interned_lookup);
+    RUN_TEST(test_entity_names_sorted_each);
 
     std::printf("\n[EntityTemplate]\n");
     RUN_TEST(test_entity_template_register_and_spawn);
     RUN_TEST(test_entity_template_missing_template);
     RUN_TEST(test_entity_template_multiple_spawns);
+    RUN_TEST(test_entity_template_typed_bulk_spawn);
+    RUN_TEST(test_entity_template_bulk_spawn_missing);
+    RUN_TEST(test_entity_template_legacy_factory_bulk);
+    RUN_TEST(test_entity_template_late_registration_recompiles);
+    RUN_TEST(test_registry_bulk_create_insert);
 
     std::printf("\n[SystemToggle]\n");
     RUN_TEST(test_system_toggle_basic);
@@ -0,0 +1,405 @@
+/**
+ * @file test_frame_arena.cpp
+ * @brief Tests for FrameArena — the linear per-frame allocator.
+ *
+ * Verifies:
+ *   allocate()          — alignment, zero-size requests, oversized blocks,
+ *                         bad_alloc when size + align overflows
+ *   make<T>()           — construction, trivial vs non-trivial destructors
+ *   make_array<T>()     — value-initialization, reverse destruction order,
+ *                         bad_array_new_length on size overflow
+ *   reset()             — block retention, destructor invocation, reuse
+ *   release()           — frees all blocks
+ *   Scale               — 100K objects across several frames
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "fatp_ecs/FatpEcs.h"
+
+// =============================================================================
+// Test infrastructure
+// =============================================================================
+
+static int gPassed = 0;
+static int gFailed = 0;
+
+#define TEST_ASSERT(cond, msg)                                 \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            std::printf("  FAIL [%s]: %s\n", __func__, (msg)); \
+            ++gFailed;                                         \
+        }                                                      \
+        else                                                   \
+        {                                                      \
+            ++gPassed;                                         \
+        }                                                      \
+    } while (false)
+
+#define RUN_TEST(fn)                         \
+    do                                       \
+    {                                        \
+        std::printf("  Running: %s\n", #fn); \
+        fn();                                \
+    } while (false)
+
+using namespace fatp_ecs;
+
+// =============================================================================
+// Helper types
+// =============================================================================
+
+struct CollisionPair
+{
+    Entity a;
+    Entity b;
+    float distance;
+};
+
+struct alignas(64) CacheLine
+{
+    float values[16];
+};
+
+// Records destruction order into an external log.
+struct Tracked
+{
+    std::vector<int>* log = nullptr;
+    int id = 0;
+
+    Tracked() = default;
+    Tracked(std::vector<int>* l, int i) : log(l), id(i) {}
+    ~Tracked()
+    {
+        if (log != nullptr)
+        {
+            log->push_back(id);
+        }
+    }
+};
+
+static int sCounterDtors = 0;
+
+struct Counter
+{
+    int value = 7;
+    ~Counter() { ++sCounterDtors; }
+};
+
+// =============================================================================
+// allocate()
+// =============================================================================
+
+void test_allocate_respects_alignment()
+{
+    FrameArena arena;
+    for (std::size_t align : {1u, 2u, 4u, 8u, 16u, 32u, 64u, 128u, 256u})
+    {
+        // Misalign the cursor first so padding is actually exercised.
+        (void)arena.allocate(1, 1);
+        void* p = arena.allocate(24, align);
+        TEST_ASSERT(reinterpret_cast<std::uintptr_t>(p) % align == 0,
+                    "pointer aligned to requested boundary");
+    }
+}
+
+void test_allocate_zero_size_returns_distinct_pointers()
+{
+    FrameArena arena;
+    void* a = arena.allocate(0, 1);
+    void* b = arena.allocate(0, 1);
+    TEST_ASSERT(a != nullptr && b != nullptr, "zero-size allocation non-null");
+    TEST_ASSERT(a != b, "zero-size allocations are distinct");
+}
+
+void test_allocate_grows_into_new_block()
+{
+    FrameArena arena(256);
+    TEST_ASSERT(arena.blockCount() == 0, "no blocks before first allocation");
+
+    (void)arena.allocate(200, 8);
+    TEST_ASSERT(arena.blockCount() == 1, "first block allocated lazily");
+
+    (void)arena.allocate(200, 8);
+    TEST_ASSERT(arena.blockCount() == 2, "overflow moves to a second block");
+}
+
+void test_allocate_oversized_request()
+{
+    FrameArena arena(128);
+    auto* big = static_cast<std::byte*>(arena.allocate(4096, 64));
+    TEST_ASSERT(big != nullptr, "oversized request succeeds");
+    TEST_ASSERT(reinterpret_cast<std::uintptr_t>(big) % 64 == 0, "oversized block aligned");
+    TEST_ASSERT(arena.capacity() >= 4096, "capacity covers oversized request");
+
+    // Touch every byte — ASan will flag any undersized block.
+    for (std::size_t i = 0; i < 4096; ++i)
+    {
+        big[i] = std::byte{0xAB};
+    }
+}
+
+// =============================================================================
+// make<T>() / make_array<T>()
+// =============================================================================
+
+void test_make_constructs_value()
+{
+    FrameArena arena;
+    Entity a = Entity(1);
+    Entity b = Entity(2);
+    auto* pair = arena.make<CollisionPair>(CollisionPair{a, b, 3.5f});
+    TEST_ASSERT(pair->a == a && pair->b == b, "entities forwarded");
+    TEST_ASSERT(pair->distance == 3.5f, "distance forwarded");
+
+    auto* line = arena.make<CacheLine>();
+    TEST_ASSERT(reinterpret_cast<std::uintptr_t>(line) % 64 == 0, "over-aligned type");
+}
+
+void test_make_array_value_initializes()
+{
+    FrameArena arena;
+    (void)arena.allocate(3, 1);
+    int* ints = arena.make_array<int>(1000);
+    bool allZero = true;
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        allZero = allZero && ints[i] == 0;
+    }
+    TEST_ASSERT(allZero, "make_array<int> value-initializes");
+    TEST_ASSERT(reinterpret_cast<std::uintptr_t>(ints) % alignof(int) == 0, "array aligned");
+
+    int* empty = arena.make_array<int>(0);
+    TEST_ASSERT(empty != nullptr, "zero-length array returns non-null");
+}
+
+void test_make_array_rejects_overflowing_count()
+{
+    FrameArena arena;
+    const std::size_t huge = std::numeric_limits<std::size_t>::max() / sizeof(int) + 1;
+
+    bool threw = false;
+    try
+    {
+        (void)arena.make_array<int>(huge);
+    }
+    catch (const std::bad_array_new_length&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "trivial array: count * sizeof(T) overflow throws");
+
+    threw = false;
+    try
+    {
+        (void)arena.make_array<std::string>(huge);
+    }
+    catch (const std::bad_array_new_length&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "non-trivial array: overflow throws");
+    TEST_ASSERT(arena.bytesUsed() == 0, "nothing allocated");
+}
+
+void test_allocate_rejects_size_plus_align_overflow()
+{
+    FrameArena arena;
+
+    // Passes make_array's count check, but size + align wraps.
+    bool threw = false;
+    try
+    {
+        (void)arena.make_array<std::uint64_t>(std::numeric_limits<std::size_t>::max() / 8);
+    }
+    catch (const std::bad_alloc&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "make_array: size + align overflow throws bad_alloc");
+
+    threw = false;
+    try
+    {
+        (void)arena.allocate(std::numeric_limits<std::size_t>::max(), 1);
+    }
+    catch (const std::bad_alloc&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "allocate: size + align overflow throws bad_alloc");
+    TEST_ASSERT(arena.bytesUsed() == 0, "nothing allocated");
+
+    void* p = arena.allocate(16);
+    TEST_ASSERT(p != nullptr, "arena usable after a failed request");
+}
+
+void test_trivial_types_do_not_register_destructors()
+{
+    FrameArena arena;
+    (void)arena.make<CollisionPair>();
+    const std::size_t used = arena.bytesUsed();
+    // A trivially-destructible allocation costs exactly sizeof(T) from an
+    // aligned cursor — no hidden destructor node.
+    TEST_ASSERT(used == sizeof(CollisionPair), "no destructor node for trivial type");
+}
+
+void test_reset_runs_destructors_in_reverse()
+{
+    std::vector<int> log;
+    FrameArena arena;
+
+    (void)arena.make<Tracked>(&log, 1);
+    (void)arena.make<Tracked>(&log, 2);
+    Tracked* arr = arena.make_array<Tracked>(3);
+    for (int i = 0; i < 3; ++i)
+    {
+        arr[i].log = &log;
+        arr[i].id = 10 + i;
+    }
+
+    TEST_ASSERT(log.empty(), "no destructors before reset");
+    arena.reset();
+
+    const std::vector<int> expected{12, 11, 10, 2, 1};
+    TEST_ASSERT(log == expected, "destructors run newest-first, arrays back-to-front");
+
+    arena.reset();
+    TEST_ASSERT(log.size() == expected.size(), "second reset does not re-run destructors");
+}
+
+void test_destructor_on_arena_destruction()
+{
+    sCounterDtors = 0;
+    {
+        FrameArena arena;
+        (void)arena.make<Counter>();
+        (void)arena.make_array<Counter>(4);
+    }
+    TEST_ASSERT(sCounterDtors == 5, "arena destructor runs pending destructors");
+}
+
+void test_make_non_trivial_std_string()
+{
+    FrameArena arena;
+    auto* s = arena.make<std::string>("a string long enough to defeat SSO on every library");
+    TEST_ASSERT(s->size() > 40, "std::string constructed in arena");
+    arena.reset(); // would leak under ASan if the destructor were skipped
+    TEST_ASSERT(arena.bytesUsed() == 0, "bytesUsed reset");
+}
+
+// =============================================================================
+// reset() / release()
+// =============================================================================
+
+void test_reset_retains_blocks_and_reuses_memory()
+{
+    FrameArena arena(1024);
+    void* first = arena.allocate(64, 16);
+    for (int i = 0; i < 100; ++i)
+    {
+        (void)arena.allocate(64, 16);
+    }
+    const std::size_t blocks = arena.blockCount();
+    const std::size_t cap = arena.capacity();
+    TEST_ASSERT(blocks > 1, "multiple blocks allocated");
+
+    arena.reset();
+    TEST_ASSERT(arena.blockCount() == blocks, "reset retains blocks");
+    TEST_ASSERT(arena.capacity() == cap, "reset retains capacity");
+    TEST_ASSERT(arena.bytesUsed() == 0, "reset clears bytesUsed");
+
+    void* again = arena.allocate(64, 16);
+    TEST_ASSERT(again == first, "first allocation after reset reuses first block");
+
+    for (int i = 0; i < 100; ++i)
+    {
+        (void)arena.allocate(64, 16);
+    }
+    TEST_ASSERT(arena.blockCount() == blocks, "steady-state frame allocates no new blocks");
+}
+
+void test_release_frees_blocks()
+{
+    FrameArena arena(512);
+    (void)arena.allocate(2000, 8);
+    TEST_ASSERT(arena.blockCount() == 1, "one block");
+    arena.release();
+    TEST_ASSERT(arena.blockCount() == 0, "release frees blocks");
+    TEST_ASSERT(arena.capacity() == 0, "release zeroes capacity");
+
+    void* p = arena.allocate(16, 8);
+    TEST_ASSERT(p != nullptr, "arena usable after release");
+}
+
+// =============================================================================
+// Scale
+// =============================================================================
+
+void test_scale_many_frames()
+{
+    FrameArena arena;
+    constexpr std::size_t kPerFrame = 100'000;
+    std::size_t blocksAfterFirst = 0;
+
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < kPerFrame; ++i)
+        {
+            auto* p = arena.make<CollisionPair>(
+                CollisionPair{Entity(i), Entity(i + 1), static_cast<float>(i)});
+            sum += p->distance;
+        }
+        TEST_ASSERT(sum > 0.0f, "frame produced data");
+        if (frame == 0)
+        {
+            blocksAfterFirst = arena.blockCount();
+        }
+        arena.reset();
+    }
+    TEST_ASSERT(arena.blockCount() == blocksAfterFirst, "block count stable across frames");
+}
+
+// =============================================================================
+// main
+// =============================================================================
+
+int main()
+{
+    std::printf("=== test_frame_arena ===\n");
+
+    // allocate()
+    RUN_TEST(test_allocate_respects_alignment);
+    RUN_TEST(test_allocate_zero_size_returns_distinct_pointers);
+    RUN_TEST(test_allocate_grows_into_new_block);
+    RUN_TEST(test_allocate_oversized_request);
+
+    // make / make_array
+    RUN_TEST(test_make_constructs_value);
+    RUN_TEST(test_make_array_value_initializes);
+    RUN_TEST(test_make_array_rejects_overflowing_count);
+    RUN_TEST(test_allocate_rejects_size_plus_align_overflow);
+    RUN_TEST(test_trivial_types_do_not_register_destructors);
+    RUN_TEST(test_reset_runs_destructors_in_reverse);
+    RUN_TEST(test_destructor_on_arena_destruction);
+    RUN_TEST(test_make_non_trivial_std_string);
+
+    // reset / release
+    RUN_TEST(test_reset_retains_blocks_and_reuses_memory);
+    RUN_TEST(test_release_frees_blocks);
+
+    // Scale
+    RUN_TEST(test_scale_many_frames);
+
+    std::printf("\n%d/%d tests passed\n", gPassed, gPassed + gFailed);
+    return gFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,416 @@
+/**
+ * @file test_hierarchy.cpp
+ * @brief Tests for Hierarchy — parent/child links and breadth-first
+ *        transform propagation.
+ *
+ * Verifies:
+ *   setParent / parentOf / childCount / depth / forEachChild
+ *   Cycles, self-parenting and dead entities are rejected
+ *   each() visits parents before children
+ *   propagate() matches a recursive reference on a random tree, including
+ *   after same-depth (in-place) and cross-depth re-parenting
+ *   Destroying or removing a node turns its children into roots
+ *   Nodes without Local/World are skipped
+ *   sortStorage<T>() lays the store out in hierarchy order
+ *   Parallel propagate() matches the serial pass
+ *   clear() after Registry::clear(); destroying the hierarchy disconnects
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "fatp_ecs/FatpEcs.h"
+
+// =============================================================================
+// Test infrastructure
+// =============================================================================
+
+static int gPassed = 0;
+static int gFailed = 0;
+
+#define TEST_ASSERT(cond, msg)                                 \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            std::printf("  FAIL [%s]: %s\n", __func__, (msg)); \
+            ++gFailed;                                         \
+        }                                                      \
+        else                                                   \
+        {                                                      \
+            ++gPassed;                                         \
+        }                                                      \
+    } while (false)
+
+#define RUN_TEST(fn)                         \
+    do                                       \
+    {                                        \
+        std::printf("  Running: %s\n", #fn); \
+        fn();                                \
+    } while (false)
+
+using namespace fatp_ecs;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+struct Local
+{
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct World
+{
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+static void compose(const World* parent, const Local& local, World& world)
+{
+    world.x = local.x + (parent != nullptr ? parent->x : 0.0f);
+    world.y = local.y + (parent != nullptr ? parent->y : 0.0f);
+}
+
+// World computed by walking the parent chain — the reference result.
+static World expectedWorld(Registry& reg, const Hierarchy& h, Entity e)
+{
+    World w;
+    for (Entity a = e; a != NullEntity; a = h.parentOf(a))
+    {
+        const Local& l = reg.get<Local>(a);
+        w.x += l.x;
+        w.y += l.y;
+    }
+    return w;
+}
+
+static bool matchesReference(Registry& reg, const Hierarchy& h, const std::vector<Entity>& nodes)
+{
+    for (Entity e : nodes)
+    {
+        const World want = expectedWorld(reg, h, e);
+        const World& got = reg.get<World>(e);
+        if (std::fabs(want.x - got.x) > 1e-3f || std::fabs(want.y - got.y) > 1e-3f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Random forest: node i's parent is a random earlier node (or none).
+static std::vector<Entity> buildRandomTree(Registry& reg, Hierarchy& h, std::size_t n,
+                                           unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> offset(-10.0f, 10.0f);
+    std::vector<Entity> nodes;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        Entity e = reg.create();
+        reg.add<Local>(e, offset(rng), offset(rng));
+        reg.add<World>(e);
+        Entity parent = NullEntity;
+        if (i > 0 && rng() % 8 != 0)
+        {
+            parent = nodes[rng() % nodes.size()];
+        }
+        h.setParent(e, parent);
+        nodes.push_back(e);
+    }
+    return nodes;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void test_links_and_queries()
+{
+    Registry reg;
+    Hierarchy h(reg);
+    Entity root = reg.create();
+    Entity a = reg.create();
+    Entity b = reg.create();
+    Entity c = reg.create();
+
+    TEST_ASSERT(h.setParent(a, root), "attach a");
+    TEST_ASSERT(h.setParent(b, root), "attach b");
+    TEST_ASSERT(h.setParent(c, a), "attach c");
+
+    TEST_ASSERT(h.size() == 4, "root added implicitly");
+    TEST_ASSERT(h.parentOf(a) == root && h.parentOf(c) == a, "parents");
+    TEST_ASSERT(h.parentOf(root) == NullEntity, "root has no parent");
+    TEST_ASSERT(h.childCount(root) == 2 && h.childCount(c) == 0, "child counts");
+    TEST_ASSERT(h.depth(root) == 0 && h.depth(c) == 2, "depths");
+    TEST_ASSERT(h.levelCount() == 3, "three levels");
+
+    std::vector<Entity> children;
+    h.forEachChild(root, [&](Entity e) { children.push_back(e); });
+    TEST_ASSERT(children.size() == 2 && children[0] == a && children[1] == b,
+                "children in insertion order");
+
+    TEST_ASSERT(h.setParent(c, b), "move c under b");
+    TEST_ASSERT(h.childCount(a) == 0 && h.childCount(b) == 1, "counts follow the move");
+    TEST_ASSERT(h.setParent(c, NullEntity), "make c a root");
+    TEST_ASSERT(h.depth(c) == 0 && h.childCount(b) == 0, "c is a root");
+}
+
+void test_rejects_invalid_links()
+{
+    Registry reg;
+    Hierarchy h(reg);
+    Entity a = reg.create();
+    Entity b = reg.create();
+    Entity c = reg.create();
+    h.setParent(b, a);
+    h.setParent(c, b);
+
+    TEST_ASSERT(!h.setParent(a, c), "descendant as parent is a cycle");
+    TEST_ASSERT(!h.setParent(a, a), "self-parenting rejected");
+    TEST_ASSERT(h.parentOf(a) == NullEntity, "rejected edit changes nothing");
+
+    Entity dead = reg.create();
+    reg.destroy(dead);
+    TEST_ASSERT(!h.setParent(dead, a), "dead child rejected");
+    TEST_ASSERT(!h.setParent(a, dead), "dead parent rejected");
+    TEST_ASSERT(h.size() == 3, "no nodes added by rejected edits");
+}
+
+void test_each_is_parents_first()
+{
+    Registry reg;
+    Hierarchy h(reg);
+    auto nodes = buildRandomTree(reg, h, 500, 1);
+
+    std::vector<char> seen(nodes.size() * 2, 0);
+    bool ordered = true;
+    std::size_t visited = 0;
+    h.each([&](Entity e, Entity parent) {
+        if (parent != NullEntity && !seen[EntityTraits::index(parent)])
+        {
+            ordered = false;
+        }
+        seen[EntityTraits::index(e)] = 1;
+        ++visited;
+    });
+    TEST_ASSERT(visited == nodes.size(), "every node visited once");
+    TEST_ASSERT(ordered, "parents visited before children");
+}
+
+void test_propagate_matches_reference()
+{
+    Registry reg;
+    Hierarchy h(reg);
+    auto nodes = buildRandomTree(reg, h, 2000, 2);
+
+    h.propagate<Local, World>(compose);
+    TEST_ASSERT(matchesReference(reg, h, nodes), "initial propagation");
+
+    // Re-parent at random: some moves stay within a level (patched in
+    // place), others change depths (relayout).
+    std::mt19937 rng(3);
+    for (int round = 0; round < 5; ++round)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            Entity child = nodes[rng() % nodes.size()];
+            Entity parent = rng() % 10 == 0 ? NullEntity : nodes[rng() % nodes.size()];
+            h.setParent(child, parent); // cycles are rejected, which is fine
+        }
+        h.propagate<Local, World>(compose);
+        TEST_ASSERT(matchesReference(reg, h, nodes), "propagation after re-parenting");
+    }
+}
+
+void test_same_depth_reparent_in_place()
+{
+    Registry reg;
+    Hierarchy h(reg);
+    Entity p1 = reg.create();
+    Entity p2 = reg.create();
+    Entity child = reg.create();
+    Entity grandchild = reg.create();
+    for (Entity e : {p1, p2, child, grandchild})
+    {
+        reg.add<World>(e);
+    }
+    reg.add<Local>(p1, 1.0f, 0.0f);
+    reg.add<Local>(p2, 100.0f, 0.0f);
+    reg.add<Local>(child, 0.0f, 1.0f);
+    reg.add<Local>(grandchild, 0.0f, 10.0f);
+    h.setParent(p1, NullEntity);
+    h.setParent(p2, NullEntity);
+    h.setParent(child, p1);
+    h.setParent(grandchild, child);
+    h.propagate<Local, World>(compose);
+    TEST_ASSERT(reg.get<World>(grandchild).x == 1.0f, "under p1");
+
+    TEST_ASSERT(h.setParent(child, p2), "move between roots");
+    h.propagate<Local, World>(compose);
+    TEST_ASSERT(reg.get<World>(child).x == 100.0f, "child follows p2");
+    TEST_ASSERT(reg.get<World>(grandchild).x == 100.0f &&
+                    reg.get<World>(grandchild).y == 11.0f,
+                "subtree follows p2");
+}
+
+void test_destroy_and_remove_orphan_children()
+{
+    Registry reg;
+    Hierarchy h(reg);
+    Entity root = reg.create();
+    Entity mid = reg.create();
+    Entity leaf = reg.create();
+    for (Entity e : {root, mid, leaf})
+    {
+        reg.add<Local>(e, 1.0f, 0.0f);
+        reg.add<World>(e);
+    }
+    h.setParent(mid, root);
+    h.setParent(leaf, mid);
+
+    reg.destroy(mid);
+    TEST_ASSERT(!h.contains(mid), "destroyed node removed");
+    TEST_ASSERT(h.parentOf(leaf) == NullEntity, "its child became a root");
+    TEST_ASSERT(h.childCount(root) == 0, "parent lost the child");
+    h.propagate<Local, World>(compose);
+    TEST_ASSERT(reg.get<World>(leaf).x == 1.0f, "orphan propagates as a root");
+
+    TEST_ASSERT(h.remove(root), "explicit remove");
+    TEST_ASSERT(!h.remove(root), "second remove is a no-op");
+    TEST_ASSERT(h.size() == 1, "only leaf remains");
+
+    // A recycled slot must not be mistaken for the destroyed node.
+    Entity recycled = reg.create();
+    TEST_ASSERT(!h.contains(recycled), "recycled entity is not a member");
+}
+
+void test_missing_components_are_skipped()
+{
+    Registry reg;
+    Hierarchy h(reg);
+    Entity root = reg.create();
+    Entity bare = reg.create(); // no Local / World
+    Entity leaf = reg.create();
+    reg.add<Local>(root, 5.0f, 0.0f);
+    reg.add<World>(root);
+    reg.add<Local>(leaf, 1.0f, 0.0f);
+    reg.add<World>(leaf);
+    h.setParent(bare, root);
+    h.setParent(leaf, bare);
+
+    int calls = 0;
+    h.propagate<Local, World>([&](const World* parent, const Local& l, World& w) {
+        ++calls;
+        compose(parent, l, w);
+    });
+    TEST_ASSERT(calls == 2, "bare node skipped");
+    TEST_ASSERT(reg.get<World>(leaf).x == 1.0f, "child of a skipped node sees no parent");
+}
+
+void test_sort_storage_follows_hierarchy_order()
+{
+    Registry reg;
+    Hierarchy h(reg);
+    auto nodes = buildRandomTree(reg, h, 300, 4);
+    Entity outsider = reg.create();
+    reg.add<World>(outsider);
+
+    h.sortStorage<Local>();
+    h.sortStorage<World>();
+
+    std::vector<Entity> order;
+    h.each([&](Entity e, Entity) { order.push_back(e); });
+    const auto& dense = reg.storage<World>()->dense();
+    bool matches = dense.size() == order.size() + 1;
+    for (std::size_t i = 0; matches && i < order.size(); ++i)
+    {
+        matches = dense[i] == order[i];
+    }
+    TEST_ASSERT(matches, "members first, in breadth-first order");
+    TEST_ASSERT(dense.back() == outsider, "non-members at the tail");
+
+    h.propagate<Local, World>(compose);
+    TEST_ASSERT(matchesReference(reg, h, nodes), "propagation after sorting");
+}
+
+void test_parallel_propagate_matches_serial()
+{
+    Registry reg;
+    Hierarchy h(reg);
+    auto nodes = buildRandomTree(reg, h, 5000, 5);
+
+    h.propagate<Local, World>(compose);
+    std::vector<World> serial;
+    for (Entity e : nodes)
+    {
+        serial.push_back(reg.get<World>(e));
+        reg.get<World>(e) = World{};
+    }
+
+    Scheduler scheduler(2);
+    h.propagate<Local, World>(scheduler, compose, 16);
+    bool same = true;
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        const World& w = reg.get<World>(nodes[i]);
+        same = same && w.x == serial[i].x && w.y == serial[i].y;
+    }
+    TEST_ASSERT(same, "parallel result identical to serial");
+}
+
+void test_clear_after_registry_clear()
+{
+    Registry reg;
+    Hierarchy h(reg);
+    buildRandomTree(reg, h, 50, 6);
+    reg.clear();
+    h.clear();
+    TEST_ASSERT(h.empty() && h.levelCount() == 0, "hierarchy empty");
+
+    Entity a = reg.create();
+    Entity b = reg.create();
+    TEST_ASSERT(h.setParent(b, a) && h.depth(b) == 1, "usable after clear");
+}
+
+void test_destroying_hierarchy_disconnects()
+{
+    Registry reg;
+    Entity a = reg.create();
+    {
+        auto h = std::make_unique<Hierarchy>(reg);
+        h->setParent(reg.create(), a);
+    }
+    // Would write through a dangling pointer if still connected.
+    reg.destroy(a);
+    TEST_ASSERT(reg.alive() == 1, "registry unaffected");
+}
+
+int main()
+{
+    std::printf("=== test_hierarchy ===\n");
+
+    RUN_TEST(test_links_and_queries);
+    RUN_TEST(test_rejects_invalid_links);
+    RUN_TEST(test_each_is_parents_first);
+
+    RUN_TEST(test_propagate_matches_reference);
+    RUN_TEST(test_same_depth_reparent_in_place);
+    RUN_TEST(test_destroy_and_remove_orphan_children);
+    RUN_TEST(test_missing_components_are_skipped);
+    RUN_TEST(test_sort_storage_follows_hierarchy_order);
+    RUN_TEST(test_parallel_propagate_matches_serial);
+
+    RUN_TEST(test_clear_after_registry_clear);
+    RUN_TEST(test_destroying_hierarchy_disconnects);
+
+    std::printf("\n%d/%d tests passed\n", gPassed, gPassed + gFailed);
+    return gFailed == 0 ? 0 : 1;
+}
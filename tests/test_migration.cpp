@@ -0,0 +1,371 @@
+/**
+ * @file test_migration.cpp
+ * @brief Tests for migrate() / merge() — moving entities and their
+ *        components between registries.
+ *
+ * Verifies:
+ *   The returned EntityMap pairs every moved entity with its new handle
+ *   EntityMap stays small for far-apart (or hostile) slot indices
+ *   Components arrive intact in dst; the src entities are destroyed
+ *   Subset migration leaves the rest of src untouched
+ *   Dead, repeated and same-registry requests are ignored
+ *   Missing dst stores inherit the src storage policy
+ *   Non-trivial and move-only components are moved, not copied
+ *   Removed/added/destroyed signals fire on the right registry
+ *   Owning groups on both sides stay consistent
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fatp_ecs/FatpEcs.h"
+
+// =============================================================================
+// Test infrastructure
+// =============================================================================
+
+static int gPassed = 0;
+static int gFailed = 0;
+
+#define TEST_ASSERT(cond, msg)                                 \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            std::printf("  FAIL [%s]: %s\n", __func__, (msg)); \
+            ++gFailed;                                         \
+        }                                                      \
+        else                                                   \
+        {                                                      \
+            ++gPassed;                                         \
+        }                                                      \
+    } while (false)
+
+#define RUN_TEST(fn)                         \
+    do                                       \
+    {                                        \
+        std::printf("  Running: %s\n", #fn); \
+        fn();                                \
+    } while (false)
+
+using namespace fatp_ecs;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+struct Position
+{
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Velocity
+{
+    float dx = 0.0f;
+    float dy = 0.0f;
+};
+
+struct Name
+{
+    std::string value;
+};
+
+struct Owned
+{
+    std::unique_ptr<int> value;
+};
+
+struct Target
+{
+    Entity entity = NullEntity;
+};
+
+// =============================================================================
+// Mapping and component transfer
+// =============================================================================
+
+void test_merge_moves_everything()
+{
+    Registry src;
+    Registry dst;
+    const Entity existing = dst.create();
+    dst.add<Position>(existing, 100.0f, 100.0f);
+
+    std::vector<Entity> entities;
+    for (int i = 0; i < 50; ++i)
+    {
+        const Entity e = src.create();
+        src.add<Position>(e, static_cast<float>(i), static_cast<float>(-i));
+        if (i % 2 == 0)
+        {
+            src.add<Velocity>(e, 1.0f, static_cast<float>(i));
+        }
+        entities.push_back(e);
+    }
+
+    const EntityMap map = merge(src, dst);
+    TEST_ASSERT(map.size() == 50, "every entity mapped");
+    TEST_ASSERT(src.entityCount() == 0, "src emptied");
+    TEST_ASSERT(dst.entityCount() == 51, "dst gained 50 entities");
+    TEST_ASSERT(dst.get<Position>(existing).x == 100.0f, "existing dst entity untouched");
+
+    bool intact = true;
+    for (int i = 0; i < 50; ++i)
+    {
+        const Entity old = entities[static_cast<std::size_t>(i)];
+        const Entity moved = map.translate(old);
+        intact = intact && !src.isAlive(old) && dst.isAlive(moved);
+        intact = intact && dst.get<Position>(moved).x == static_cast<float>(i);
+        intact = intact && dst.get<Position>(moved).y == static_cast<float>(-i);
+        intact = intact && dst.has<Velocity>(moved) == (i % 2 == 0);
+        if (i % 2 == 0)
+        {
+            intact = intact && dst.get<Velocity>(moved).dy == static_cast<float>(i);
+        }
+    }
+    TEST_ASSERT(intact, "components arrive on the mapped entities");
+    TEST_ASSERT(src.storage<Position>()->size() == 0, "src Position store emptied");
+    TEST_ASSERT(dst.storage<Velocity>()->size() == 25, "dst Velocity store created");
+}
+
+void test_subset_migration()
+{
+    Registry src;
+    Registry dst;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 10; ++i)
+    {
+        const Entity e = src.create();
+        src.add<Position>(e, static_cast<float>(i), 0.0f);
+        entities.push_back(e);
+    }
+
+    const std::vector<Entity> subset{entities[1], entities[4], entities[7]};
+    const EntityMap map = migrate(src, dst, subset);
+    TEST_ASSERT(map.size() == 3, "three mapped");
+    TEST_ASSERT(src.entityCount() == 7, "seven stay in src");
+    TEST_ASSERT(dst.entityCount() == 3, "three arrive in dst");
+    TEST_ASSERT(dst.get<Position>(map.translate(entities[4])).x == 4.0f, "value follows entity");
+    TEST_ASSERT(src.get<Position>(entities[5]).x == 5.0f, "unmoved entity keeps its data");
+    TEST_ASSERT(map.translate(entities[5]) == NullEntity, "unmoved entity not mapped");
+    const Entity stale = EntityTraits::make(EntityTraits::index(entities[4]),
+                                            EntityTraits::generation(entities[4]) + 1);
+    TEST_ASSERT(map.translate(stale) == NullEntity, "other generation of a moved slot not mapped");
+}
+
+void test_map_remaps_references()
+{
+    Registry src;
+    Registry dst;
+    const Entity leader = src.create();
+    const Entity follower = src.create();
+    src.add<Target>(follower, leader);
+
+    const EntityMap map = merge(src, dst);
+    const Entity newFollower = map.translate(follower);
+    Target& target = dst.get<Target>(newFollower);
+    target.entity = map.translate(target.entity);
+    TEST_ASSERT(target.entity == map.translate(leader), "reference remapped");
+    TEST_ASSERT(dst.isAlive(target.entity), "remapped reference is alive in dst");
+}
+
+void test_entity_map_sparse_indices()
+{
+    // A corrupt snapshot can name any slot index; the flat table must not
+    // be sized from it.
+    EntityMap map;
+    const Entity low = EntityTraits::make(3, 1);
+    const Entity huge = EntityTraits::make(0xFFFFFFF0u, 2);
+    const Entity farA = EntityTraits::make(1'000'000u, 0);
+    map.insert(low, EntityTraits::make(0, 0));
+    map.insert(huge, EntityTraits::make(1, 0));
+    map.insert(farA, EntityTraits::make(2, 0));
+    TEST_ASSERT(map.size() == 3, "three entries");
+    TEST_ASSERT(map.translate(low) == EntityTraits::make(0, 0), "flat entry");
+    TEST_ASSERT(map.translate(huge) == EntityTraits::make(1, 0), "huge index entry");
+    TEST_ASSERT(map.translate(farA) == EntityTraits::make(2, 0), "far index entry");
+    TEST_ASSERT(map.translate(EntityTraits::make(0xFFFFFFF0u, 3)) == NullEntity,
+                "stale generation of an overflow slot");
+    TEST_ASSERT(map.translate(EntityTraits::make(5, 0)) == NullEntity, "unmapped slot");
+
+    // Replacing an overflow entry keeps the count.
+    map.insert(EntityTraits::make(1'000'000u, 4), EntityTraits::make(9, 0));
+    TEST_ASSERT(map.size() == 3, "replacement does not add an entry");
+    TEST_ASSERT(map.translate(farA) == NullEntity, "replaced handle no longer maps");
+
+    // Once enough entries exist the flat table grows over an overflowed slot.
+    EntityMap dense;
+    const Entity early = EntityTraits::make(5000, 0);
+    dense.insert(early, EntityTraits::make(0, 0));
+    for (uint32_t i = 0; i < 2000; ++i)
+    {
+        dense.insert(EntityTraits::make(i, 0), EntityTraits::make(i + 1, 0));
+    }
+    const Entity late = EntityTraits::make(5000, 1);
+    dense.insert(late, EntityTraits::make(7, 7));
+    TEST_ASSERT(dense.size() == 2001, "slot 5000 counted once");
+    TEST_ASSERT(dense.translate(late) == EntityTraits::make(7, 7), "late entry wins");
+    TEST_ASSERT(dense.translate(early) == NullEntity, "overflowed entry replaced");
+}
+
+void test_skips_invalid_requests()
+{
+    Registry src;
+    Registry dst;
+    const Entity a = src.create();
+    const Entity b = src.create();
+    src.add<Position>(a, 1.0f, 1.0f);
+    src.destroy(b);
+
+    const std::vector<Entity> request{a, b, a, NullEntity};
+    const EntityMap map = migrate(src, dst, request);
+    TEST_ASSERT(map.size() == 1, "only the live entity is mapped");
+    TEST_ASSERT(dst.entityCount() == 1, "duplicate not created twice");
+
+    const Entity c = src.create();
+    src.add<Position>(c, 2.0f, 2.0f);
+    const EntityMap self = merge(src, src);
+    TEST_ASSERT(self.size() == 0, "merging into itself is a no-op");
+    TEST_ASSERT(src.isAlive(c) && src.has<Position>(c), "self-merge leaves src intact");
+
+    const EntityMap none = migrate(src, dst, std::vector<Entity>{});
+    TEST_ASSERT(none.size() == 0, "empty request");
+}
+
+// =============================================================================
+// Storage and component types
+// =============================================================================
+
+void test_storage_policy_carries_over()
+{
+    Registry src;
+    Registry dst;
+    src.useAlignedStorage<Position, 64>();
+    const Entity e = src.create();
+    src.add<Position>(e, 3.0f, 4.0f);
+
+    const EntityMap map = merge(src, dst);
+    const auto* store = dst.storage<Position>();
+    TEST_ASSERT(store != nullptr && store->dataAlignmentTyped() == 64, "dst store is 64-byte aligned");
+    TEST_ASSERT(dst.get<Position>(map.translate(e)).y == 4.0f, "value preserved");
+
+    // A dst store that already exists keeps its own policy.
+    Registry src2;
+    const Entity f = src2.create();
+    src2.add<Position>(f, 5.0f, 6.0f);
+    const EntityMap map2 = merge(src2, dst);
+    TEST_ASSERT(dst.get<Position>(map2.translate(f)).x == 5.0f, "default -> aligned store");
+    TEST_ASSERT(dst.storage<Position>()->size() == 2, "both in the aligned store");
+}
+
+void test_non_trivial_components_move()
+{
+    Registry src;
+    Registry dst;
+    const Entity e = src.create();
+    src.add<Name>(e, std::string(64, 'n'));
+    src.add<Owned>(e, std::make_unique<int>(42));
+
+    const EntityMap map = merge(src, dst);
+    const Entity moved = map.translate(e);
+    TEST_ASSERT(dst.get<Name>(moved).value == std::string(64, 'n'), "string moved");
+    TEST_ASSERT(dst.get<Owned>(moved).value != nullptr, "move-only component moved");
+    TEST_ASSERT(*dst.get<Owned>(moved).value == 42, "move-only value intact");
+}
+
+// =============================================================================
+// Signals and groups
+// =============================================================================
+
+void test_signals_fire_on_each_side()
+{
+    Registry src;
+    Registry dst;
+    for (int i = 0; i < 8; ++i)
+    {
+        const Entity e = src.create();
+        src.add<Position>(e);
+    }
+
+    int removed = 0;
+    int destroyed = 0;
+    int added = 0;
+    int created = 0;
+    bool presentWhenRemoved = true;
+    auto c1 = src.events().onComponentRemoved<Position>().connect(
+        [&](Entity e)
+        {
+            ++removed;
+            presentWhenRemoved = presentWhenRemoved && src.has<Position>(e);
+        });
+    auto c2 = src.events().onEntityDestroyed.connect([&](Entity) { ++destroyed; });
+    auto c3 = dst.events().onComponentAdded<Position>().connect(
+        [&](Entity, Position&) { ++added; });
+    auto c4 = dst.events().onEntityCreated.connect([&](Entity) { ++created; });
+
+    (void)merge(src, dst);
+    TEST_ASSERT(removed == 8, "onComponentRemoved once per entity in src");
+    TEST_ASSERT(presentWhenRemoved, "component still present during onComponentRemoved");
+    TEST_ASSERT(destroyed == 8, "onEntityDestroyed once per entity in src");
+    TEST_ASSERT(added == 8, "onComponentAdded once per entity in dst");
+    TEST_ASSERT(created == 8, "onEntityCreated once per entity in dst");
+}
+
+void test_owning_groups_stay_consistent()
+{
+    Registry src;
+    Registry dst;
+    auto& srcGroup = src.group<Position, Velocity>();
+    auto& dstGroup = dst.group<Position, Velocity>();
+
+    std::vector<Entity> entities;
+    for (int i = 0; i < 20; ++i)
+    {
+        const Entity e = src.create();
+        src.add<Position>(e, static_cast<float>(i), 0.0f);
+        if (i % 4 != 0)
+        {
+            src.add<Velocity>(e, static_cast<float>(i), 0.0f);
+        }
+        entities.push_back(e);
+    }
+    TEST_ASSERT(srcGroup.size() == 15, "src group populated");
+
+    std::vector<Entity> half(entities.begin(), entities.begin() + 10);
+    const EntityMap map = migrate(src, dst, half);
+    TEST_ASSERT(srcGroup.size() == 8, "src group shrank");
+    TEST_ASSERT(dstGroup.size() == 7, "dst group filled");
+
+    bool matched = true;
+    dstGroup.each([&](Entity, Position& p, Velocity& v) { matched = matched && p.x == v.dx; });
+    TEST_ASSERT(matched, "dst group rows pair the right components");
+    srcGroup.each([&](Entity, Position& p, Velocity& v) { matched = matched && p.x == v.dx; });
+    TEST_ASSERT(matched, "src group rows pair the right components");
+    TEST_ASSERT(dst.get<Position>(map.translate(entities[0])).x == 0.0f,
+                "entity outside the group moved too");
+}
+
+int main()
+{
+    std::printf("=== test_migration ===\n");
+
+    RUN_TEST(test_merge_moves_everything);
+    RUN_TEST(test_subset_migration);
+    RUN_TEST(test_map_remaps_references);
+    RUN_TEST(test_entity_map_sparse_indices);
+    RUN_TEST(test_skips_invalid_requests);
+
+    RUN_TEST(test_storage_policy_carries_over);
+    RUN_TEST(test_non_trivial_components_move);
+
+    RUN_TEST(test_signals_fire_on_each_side);
+    RUN_TEST(test_owning_groups_stay_consistent);
+
+    std::printf("\n%d/%d tests passed\n", gPassed, gPassed + gFailed);
+    return gFailed == 0 ? 0 : 1;
+}
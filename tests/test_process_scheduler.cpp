@@ -23,12 +23,30 @@
  * 18.  Process with shared Data context
  * 19.  Process that never succeeds runs indefinitely
  * 20.  attach().then() chain: handle points to latest successor
+ * 21.  updateParallel() ticks kIndependent processes to completion
+ * 22.  updateParallel() leaves the same list order as update()
+ * 23.  Finished processes recycle arena blocks
+ * 24.  Coroutine body resumes once per tick; nextTick yields delta
+ * 25.  seconds() parks the coroutine until the scheduler clock catches up
+ * 26.  untilComponent resumes on add, yields false on destroy
+ * 27.  Coroutine processes chain with class-based processes both ways
+ * 28.  Finished coroutines recycle frames from the frame pool
+ * 29.  Exception in a coroutine body fails the process, list stays intact
+ * 30.  sleepFor() parks a process; it is not ticked until due
+ * 31.  Sleepers due on the same update wake in deadline, then sleep order
+ * 32.  A throwing tick in update() leaves no holes; nothing finishes twice
+ * 33.  updateParallel() retires finished processes before rethrowing
+ * 34.  The clock keeps advancing by small float deltas after long sessions
+ * 35.  Processes attached during update() first tick on the next update()
  */
 
 #include <fatp_ecs/FatpEcs.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdio>
+#include <stdexcept>
 #include <vector>
 #include <string>
 
@@ -117,6 +135,117 @@ struct DataProcess : Process<DataProcess, float, int>
     }
 };
 
+// Independent countdown: safe to tick on a worker thread.
+struct TweenProcess : Process<TweenProcess, float>
+{
+    static constexpr bool kIndependent = true;
+
+    std::atomic<int>* done{nullptr};
+    int remaining{0};
+    float value{0.f};
+    TweenProcess(std::atomic<int>& d, int ticks) : done(&d), remaining(ticks) {}
+    void onUpdate(float dt, void*&)
+    {
+        value += dt;
+        if (--remaining <= 0) succeed();
+    }
+    void onSucceeded() { done->fetch_add(1, std::memory_order_relaxed); }
+};
+
+// Main-thread process that logs its id on every tick.
+struct LogProcess : Process<LogProcess, float>
+{
+    std::vector<int>* log{nullptr};
+    int id{0};
+    int remaining{0};
+    LogProcess(std::vector<int>& l, int i, int ticks) : log(&l), id(i), remaining(ticks) {}
+    void onUpdate(float, void*&)
+    {
+        log->push_back(id);
+        if (--remaining <= 0) succeed();
+    }
+};
+
+// Periodic timer: logs id, then parks for period. Never finishes.
+struct ParkedTimer : Process<ParkedTimer, float>
+{
+    std::vector<int>* log{nullptr};
+    int id{0};
+    float period{0.f};
+    ParkedTimer(std::vector<int>& l, int i, float p) : log(&l), id(i), period(p) {}
+    void onUpdate(float, void*&)
+    {
+        log->push_back(id);
+        sleepFor(period);
+    }
+};
+
+// Throws from its first update, then finishes on the next tick.
+struct ThrowOnceProcess : Process<ThrowOnceProcess, float>
+{
+    static constexpr bool kIndependent = true;
+
+    std::atomic<int>* succeededCount{nullptr};
+    bool thrown{false};
+    explicit ThrowOnceProcess(std::atomic<int>& s) : succeededCount(&s) {}
+    void onUpdate(float, void*&)
+    {
+        if (!thrown)
+        {
+            thrown = true;
+            throw std::runtime_error("tick failed");
+        }
+        succeed();
+    }
+    void onSucceeded() { succeededCount->fetch_add(1, std::memory_order_relaxed); }
+};
+
+// Logs 1 and attaches a one-tick LogProcess (id 2) from inside its tick.
+struct SpawnProcess : Process<SpawnProcess, float>
+{
+    ProcessScheduler<float>* sched{nullptr};
+    std::vector<int>* log{nullptr};
+    SpawnProcess(ProcessScheduler<float>& s, std::vector<int>& l) : sched(&s), log(&l) {}
+    void onUpdate(float, void*&)
+    {
+        log->push_back(1);
+        sched->attach<LogProcess>(*log, 2, 1);
+        succeed();
+    }
+};
+
+struct Target
+{
+    int value{0};
+};
+
+// Logs id, then id + 10 * delta of the next tick, then finishes.
+static CoProcess<float> twoStepBody(std::vector<int>& log, int id)
+{
+    log.push_back(id);
+    const float delta = co_await nextTick;
+    log.push_back(id + 10 * static_cast<int>(delta));
+}
+
+static CoProcess<float> sleepBody(std::vector<int>& log, float duration)
+{
+    log.push_back(0);
+    co_await seconds(duration);
+    log.push_back(1);
+}
+
+static CoProcess<float> waitBody(std::vector<int>& log, const Registry& registry, Entity e)
+{
+    const bool present = co_await untilComponent<Target>(registry, e);
+    log.push_back(present ? 1 : 0);
+}
+
+static CoProcess<float> throwingBody()
+{
+    co_await nextTick;
+    throw 42;
+}
+
 // =============================================================================
 // Tests
 // =============================================================================
@@ -406,6 +535,351 @@ static void test_then_chain_handle()
     TEST_ASSERT(sched.empty(), "all done");
 }
 
+static void test_parallel_ticks_independent_processes()
+{
+    fat_p::ThreadPool pool(3);
+    std::atomic<int> done{0};
+    ProcessScheduler<float> sched;
+    for (int i = 0; i < 2000; ++i)
+    {
+        sched.attach<TweenProcess>(done, 1 + i % 4);
+    }
+
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        sched.updateParallel(pool, 0.25f);
+    }
+    TEST_ASSERT(done.load() == 2000, "every tween completed");
+    TEST_ASSERT(sched.empty(), "all tweens removed");
+}
+
+// Builds the same mixed workload: tweens whose successors log, interleaved
+// with loggers of varying length.
+static void fillMixed(ProcessScheduler<float>& sched, std::atomic<int>& done,
+                      std::vector<int>& log)
+{
+    for (int i = 0; i < 600; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            sched.attach<LogProcess>(log, i, 1 + i % 5);
+        }
+        else
+        {
+            sched.attach<TweenProcess>(done, 1 + i % 4).then<LogProcess>(log, 1000 + i, 2);
+        }
+    }
+}
+
+static void test_parallel_matches_serial_order()
+{
+    fat_p::ThreadPool pool(3);
+    std::atomic<int> doneSerial{0};
+    std::atomic<int> doneParallel{0};
+    std::vector<int> logSerial;
+    std::vector<int> logParallel;
+    ProcessScheduler<float> serial;
+    ProcessScheduler<float> parallel;
+    fillMixed(serial, doneSerial, logSerial);
+    fillMixed(parallel, doneParallel, logParallel);
+
+    for (int frame = 0; frame < 8; ++frame)
+    {
+        serial.update(1.f);
+        parallel.updateParallel(pool, 1.f);
+        TEST_ASSERT(serial.size() == parallel.size(), "same live count every frame");
+    }
+    TEST_ASSERT(serial.empty() && parallel.empty(), "both drained");
+    TEST_ASSERT(doneSerial.load() == 400 && doneParallel.load() == 400, "all tweens done");
+    TEST_ASSERT(logSerial == logParallel, "identical main-thread tick order");
+}
+
+static void test_arena_recycles_blocks()
+{
+    std::atomic<int> done{0};
+    ProcessScheduler<float> sched;
+    for (int i = 0; i < 1000; ++i)
+    {
+        sched.attach<TweenProcess>(done, 1);
+    }
+    const std::size_t chunks = sched.arena().chunkCount();
+    sched.update(1.f);
+    TEST_ASSERT(sched.empty(), "first wave done");
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        sched.attach<TweenProcess>(done, 1);
+    }
+    TEST_ASSERT(sched.arena().chunkCount() == chunks, "second wave reuses the first wave's blocks");
+    sched.update(1.f);
+    TEST_ASSERT(done.load() == 2000, "both waves completed");
+}
+
+static void test_coroutine_ticks()
+{
+    std::vector<int> log;
+    ProcessScheduler<float> sched;
+    sched.attach(twoStepBody(log, 1));
+    TEST_ASSERT(log.empty(), "body does not run before the first tick");
+
+    sched.update(1.f);
+    TEST_ASSERT(log.size() == 1 && log[0] == 1, "first tick runs to the first co_await");
+    TEST_ASSERT(sched.size() == 1, "still live");
+
+    sched.update(3.f);
+    TEST_ASSERT(log.size() == 2 && log[1] == 31, "nextTick yields the resuming tick's delta");
+    TEST_ASSERT(sched.empty(), "finished body succeeds and is removed");
+}
+
+static void test_coroutine_sleep()
+{
+    std::vector<int> log;
+    ProcessScheduler<float> sched;
+    sched.attach(sleepBody(log, 2.f));
+
+    sched.update(0.5f); // clock 0.5: runs to co_await, parks until 2.5
+    TEST_ASSERT(sched.sleepingCount() == 1, "parked in the sleep queue");
+    TEST_ASSERT(sched.size() == 1, "sleepers count as live");
+
+    sched.update(0.5f); // 1.0
+    sched.update(1.0f); // 2.0
+    TEST_ASSERT(log.size() == 1, "not resumed before its wake time");
+
+    sched.update(0.5f); // 2.5
+    TEST_ASSERT(log.size() == 2 && log[1] == 1, "resumed once the clock reaches the wake time");
+    TEST_ASSERT(sched.empty(), "done");
+    TEST_ASSERT(sched.clock() == 2.5f, "clock sums deltas");
+
+    sched.attach(sleepBody(log, 10.f));
+    sched.update(1.f);
+    sched.abortAll();
+    TEST_ASSERT(sched.empty(), "abortAll() drops sleepers too");
+}
+
+static void test_coroutine_until_component()
+{
+    Registry registry;
+    Entity a = registry.create();
+    Entity b = registry.create();
+    std::vector<int> log;
+    ProcessScheduler<float> sched;
+    sched.attach(waitBody(log, registry, a));
+    sched.attach(waitBody(log, registry, b));
+
+    sched.update(1.f);
+    sched.update(1.f);
+    TEST_ASSERT(log.empty(), "both still waiting");
+
+    registry.add<Target>(a, 5);
+    registry.destroy(b);
+    sched.update(1.f);
+    TEST_ASSERT(log.size() == 2, "both resumed");
+    TEST_ASSERT(log[0] == 1, "component added -> true");
+    TEST_ASSERT(log[1] == 0, "entity destroyed -> false");
+    TEST_ASSERT(sched.empty(), "both done");
+}
+
+static void test_coroutine_chaining()
+{
+    std::vector<int> log;
+    int count = 0;
+    ProcessScheduler<float> sched;
+    sched.attach(twoStepBody(log, 1)).then<CountProcess>(count, 1).then(twoStepBody(log, 2));
+
+    for (int i = 0; i < 5; ++i)
+    {
+        sched.update(1.f);
+    }
+    TEST_ASSERT(count == 1, "class successor of a coroutine ran");
+    TEST_ASSERT((log == std::vector<int>{1, 11, 2, 12}), "coroutine successor ran after it");
+    TEST_ASSERT(sched.empty(), "chain done");
+}
+
+static void test_coroutine_frame_pool_recycles()
+{
+    std::vector<int> log;
+    ProcessScheduler<float> sched;
+    auto wave = [&]
+    {
+        for (int i = 0; i < 500; ++i)
+        {
+            sched.attach(twoStepBody(log, i));
+        }
+        sched.update(1.f);
+        sched.update(1.f);
+    };
+
+    wave();
+    TEST_ASSERT(sched.empty(), "first wave done");
+    const std::size_t chunks = coroutineFramePool().chunkCount();
+    wave();
+    TEST_ASSERT(coroutineFramePool().chunkCount() == chunks, "second wave reuses frames");
+    TEST_ASSERT(log.size() == 2000, "both waves ran");
+}
+
+static void test_coroutine_exception()
+{
+    std::vector<std::string> trace;
+    ProcessScheduler<float> sched;
+    sched.attach(throwingBody()).then<TraceProcess>(trace);
+    sched.attach<TraceProcess>(trace, 3);
+
+    sched.update(1.f);
+    bool caught = false;
+    try
+    {
+        sched.update(1.f);
+    }
+    catch (int value)
+    {
+        caught = value == 42;
+    }
+    TEST_ASSERT(caught, "exception propagates out of update()");
+    TEST_ASSERT(sched.size() == 2, "both processes still listed");
+
+    sched.update(1.f);
+    sched.update(1.f);
+    TEST_ASSERT(sched.empty(), "failed coroutine removed, other process finished");
+    TEST_ASSERT(std::count(trace.begin(), trace.end(), "init") == 1, "failed coroutine's successor never ran");
+}
+
+static void test_clock_advances_after_long_sessions()
+{
+    // ~147 hours at 60 Hz: a float clock no longer moves by 1/60 here.
+    std::vector<int> log;
+    ProcessScheduler<float> sched;
+    sched.update(530'000.f);
+    sched.attach<ParkedTimer>(log, 7, 1.f);
+    sched.update(1.f / 60.f); // ticks once, parks for 1.0
+    TEST_ASSERT(log.size() == 1, "timer ticked");
+
+    for (int frame = 0; frame < 61; ++frame)
+    {
+        sched.update(1.f / 60.f);
+    }
+    TEST_ASSERT(log.size() == 2, "sleeper woke after one second of frames");
+    TEST_ASSERT(sched.clock() > 530'001.0, "clock kept advancing");
+}
+
+static void test_update_exception_compacts()
+{
+    std::atomic<int> done{0};
+    std::atomic<int> recovered{0};
+    ProcessScheduler<float> sched;
+    for (int i = 0; i < 8; ++i)
+    {
+        sched.attach<TweenProcess>(done, 1 + i % 2); // half finish on the first tick
+    }
+    sched.attach<ThrowOnceProcess>(recovered);
+    for (int i = 0; i < 8; ++i)
+    {
+        sched.attach<TweenProcess>(done, 1); // not ticked in the throwing frame
+    }
+
+    bool caught = false;
+    try
+    {
+        sched.update(1.f);
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    TEST_ASSERT(caught, "exception propagates out of update()");
+    TEST_ASSERT(done.load() == 4, "processes before the throw finished once");
+    TEST_ASSERT(sched.size() == 13, "finished processes removed, the rest kept");
+
+    sched.update(1.f);
+    TEST_ASSERT(done.load() == 16, "no hook fires twice; the rest finish");
+    TEST_ASSERT(recovered.load() == 1, "throwing process finishes on the next tick");
+    TEST_ASSERT(sched.empty(), "list drained without null entries");
+}
+
+static void test_attach_during_update_starts_next_update()
+{
+    std::vector<int> log;
+    ProcessScheduler<float> sched;
+    sched.attach<SpawnProcess>(sched, log);
+
+    sched.update(1.f);
+    TEST_ASSERT((log == std::vector<int>{1}), "spawned process not ticked in the same update");
+    TEST_ASSERT(sched.size() == 1, "spawned process is listed");
+
+    sched.update(1.f);
+    TEST_ASSERT((log == std::vector<int>{1, 2}), "spawned process ticks on the next update");
+    TEST_ASSERT(sched.empty(), "spawned process finished");
+}
+
+static void test_parallel_exception_retires_finished()
+{
+    fat_p::ThreadPool pool(3);
+    std::atomic<int> done{0};
+    std::atomic<int> recovered{0};
+    std::vector<std::string> trace;
+    ProcessScheduler<float> sched;
+    sched.attach<TraceProcess>(trace, 1); // main-thread process finishing this frame
+    for (int i = 0; i < 300; ++i)
+    {
+        sched.attach<TweenProcess>(done, 1);
+    }
+    sched.attach<ThrowOnceProcess>(recovered);
+
+    bool caught = false;
+    try
+    {
+        sched.updateParallel(pool, 1.f);
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    TEST_ASSERT(caught, "exception propagates out of updateParallel()");
+    TEST_ASSERT(std::count(trace.begin(), trace.end(), "succeeded") == 1, "hook fired once");
+    const int finished = done.load();
+    TEST_ASSERT(sched.size() == static_cast<std::size_t>(300 - finished + 1),
+                "finished processes retired before rethrow");
+
+    sched.updateParallel(pool, 1.f);
+    TEST_ASSERT(std::count(trace.begin(), trace.end(), "succeeded") == 1,
+                "finished process not ticked again");
+    TEST_ASSERT(done.load() == 300, "every tween succeeded exactly once");
+    TEST_ASSERT(recovered.load() == 1, "throwing process finished on the next frame");
+    TEST_ASSERT(sched.empty(), "all processes removed");
+}
+
+static void test_sleep_for_parks()
+{
+    std::vector<int> log;
+    ProcessScheduler<float> sched;
+    sched.attach<ParkedTimer>(log, 7, 3.f);
+
+    for (int i = 0; i < 7; ++i)
+    {
+        sched.update(1.f);
+    }
+    // Fires at clock 1, parks until 4, fires, parks until 7, fires.
+    TEST_ASSERT(log.size() == 3, "ticked only when due");
+    TEST_ASSERT(sched.sleepingCount() == 1 && sched.size() == 1, "parked again after firing");
+
+    sched.abortAll();
+    TEST_ASSERT(sched.empty(), "abortAll() removes the sleeper");
+}
+
+static void test_sleep_wake_order()
+{
+    std::vector<int> log;
+    ProcessScheduler<float> sched;
+    sched.attach<ParkedTimer>(log, 1, 4.f);
+    sched.attach<ParkedTimer>(log, 2, 2.f);
+    sched.attach<ParkedTimer>(log, 3, 4.f);
+    sched.update(1.f);
+    TEST_ASSERT((log == std::vector<int>{1, 2, 3}), "first tick in attach order");
+
+    log.clear();
+    sched.update(10.f); // all three are due
+    TEST_ASSERT((log == std::vector<int>{2, 1, 3}), "earliest deadline first, ties in sleep order");
+}
+
 // =============================================================================
 // main
 // =============================================================================
@@ -434,6 +908,21 @@ int main()
     RUN_TEST(test_typed_data_context);
     RUN_TEST(test_perpetual_process);
     RUN_TEST(test_then_chain_handle);
+    RUN_TEST(test_parallel_ticks_independent_processes);
+    RUN_TEST(test_parallel_matches_serial_order);
+    RUN_TEST(test_arena_recycles_blocks);
+    RUN_TEST(test_coroutine_ticks);
+    RUN_TEST(test_coroutine_sleep);
+    RUN_TEST(test_coroutine_until_component);
+    RUN_TEST(test_coroutine_chaining);
+    RUN_TEST(test_coroutine_frame_pool_recycles);
+    RUN_TEST(test_coroutine_exception);
+    RUN_TEST(test_update_exception_compacts);
+    RUN_TEST(test_parallel_exception_retires_finished);
+    RUN_TEST(test_sleep_for_parks);
+    RUN_TEST(test_sleep_wake_order);
+    RUN_TEST(test_clock_advances_after_long_sessions);
+    RUN_TEST(test_attach_during_update_starts_next_update);
 
     std::printf("\n%d/%d tests passed\n", sTestsPassed, sTestsPassed + sTestsFailed);
     return sTestsFailed == 0 ? 0 : 1;
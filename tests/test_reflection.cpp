@@ -0,0 +1,344 @@
+/**
+ * @file test_reflection.cpp
+ * @brief Tests for ComponentReflection and the name-based Registry API.
+ *
+ * Verifies:
+ *   reflect<T>() records size, alignment, copyability and field layout
+ *   Lookup by name and by TypeId; conflicting bindings throw
+ *   Re-reflecting a type replaces its fields
+ *   runtimeView() and compileQuery() by name match the TypeId versions
+ *   Unknown include names match nothing; unknown exclude names are ignored
+ *   tryGetRaw() + FieldInfo::in() read and write fields without the type
+ *   rawComponents() exposes the dense array for zero-copy export, with a
+ *   stride from the store even for unreflected types
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fatp_ecs/FatpEcs.h"
+
+// =============================================================================
+// Test infrastructure
+// =============================================================================
+
+static int gPassed = 0;
+static int gFailed = 0;
+
+#define TEST_ASSERT(cond, msg)                                 \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            std::printf("  FAIL [%s]: %s\n", __func__, (msg)); \
+            ++gFailed;                                         \
+        }                                                      \
+        else                                                   \
+        {                                                      \
+            ++gPassed;                                         \
+        }                                                      \
+    } while (false)
+
+#define RUN_TEST(fn)                         \
+    do                                       \
+    {                                        \
+        std::printf("  Running: %s\n", #fn); \
+        fn();                                \
+    } while (false)
+
+using namespace fatp_ecs;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+struct Position
+{
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Velocity
+{
+    float dx = 0.0f;
+    float dy = 0.0f;
+};
+
+struct Frozen
+{
+};
+
+struct Health
+{
+    int32_t  hp = 0;
+    uint8_t  armor = 0;
+    double   regen = 0.0;
+    Entity   lastHitBy = NullEntity;
+};
+
+struct Label
+{
+    std::string text;
+};
+
+void reflectAll(Registry& reg)
+{
+    reg.reflect<Position>("Position").field("x", &Position::x).field("y", &Position::y);
+    reg.reflect<Velocity>("Velocity").field("dx", &Velocity::dx).field("dy", &Velocity::dy);
+    reg.reflect<Frozen>("Frozen");
+}
+
+std::vector<Entity> sorted(std::vector<Entity> v)
+{
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+// =============================================================================
+// Metadata
+// =============================================================================
+
+void test_reflect_records_layout()
+{
+    Registry reg;
+    reg.reflect<Health>("Health")
+        .field("hp", &Health::hp)
+        .field("armor", &Health::armor)
+        .field("regen", &Health::regen)
+        .field("lastHitBy", &Health::lastHitBy);
+    reg.reflect<Label>("Label");
+
+    const ComponentInfo* health = reg.reflection().find("Health");
+    TEST_ASSERT(health != nullptr, "Health found by name");
+    TEST_ASSERT(health->type == typeId<Health>(), "TypeId recorded");
+    TEST_ASSERT(health->size == sizeof(Health), "size recorded");
+    TEST_ASSERT(health->alignment == alignof(Health), "alignment recorded");
+    TEST_ASSERT(health->triviallyCopyable, "Health is trivially copyable");
+    TEST_ASSERT(health->fields.size() == 4, "four fields");
+
+    const FieldInfo* regen = health->field("regen");
+    TEST_ASSERT(regen != nullptr, "regen field found");
+    TEST_ASSERT(regen->offset == offsetof(Health, regen), "regen offset");
+    TEST_ASSERT(regen->size == sizeof(double), "regen size");
+    TEST_ASSERT(regen->kind == FieldKind::Float64, "regen is Float64");
+    TEST_ASSERT(health->field("hp")->kind == FieldKind::Int32, "hp is Int32");
+    TEST_ASSERT(health->field("armor")->kind == FieldKind::UInt8, "armor is UInt8");
+    TEST_ASSERT(health->field("lastHitBy")->kind == FieldKind::Entity, "lastHitBy is Entity");
+    TEST_ASSERT(health->field("lastHitBy")->offset == offsetof(Health, lastHitBy),
+                "lastHitBy offset");
+    TEST_ASSERT(health->field("missing") == nullptr, "unknown field is nullptr");
+
+    const ComponentInfo* label = reg.reflection().find(typeId<Label>());
+    TEST_ASSERT(label != nullptr && label->name == "Label", "Label found by TypeId");
+    TEST_ASSERT(!label->triviallyCopyable, "Label is not trivially copyable");
+    TEST_ASSERT(reg.reflection().size() == 2, "two types reflected");
+}
+
+void test_reflect_lookup_and_conflicts()
+{
+    Registry reg;
+    reflectAll(reg);
+
+    TEST_ASSERT(reg.reflection().find("Nope") == nullptr, "unknown name is nullptr");
+    TEST_ASSERT(reg.reflection().find(typeId<Health>()) == nullptr, "unreflected type is nullptr");
+
+    bool threw = false;
+    try
+    {
+        reg.reflect<Health>("Position");
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "name bound to another type throws");
+
+    threw = false;
+    try
+    {
+        reg.reflect<Position>("Pos");
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "type bound to another name throws");
+
+    // Same binding again: fields are declared afresh.
+    const ComponentInfo* before = reg.reflection().find("Position");
+    reg.reflect<Position>("Position").field("x", &Position::x);
+    TEST_ASSERT(reg.reflection().find("Position") == before, "info pointer is stable");
+    TEST_ASSERT(before->fields.size() == 1, "re-reflect replaces fields");
+
+    std::vector<std::string> names;
+    reg.reflection().each([&](const ComponentInfo& info) { names.push_back(info.name); });
+    TEST_ASSERT(names == (std::vector<std::string>{"Position", "Velocity", "Frozen"}),
+                "each() in reflection order");
+}
+
+// =============================================================================
+// Name-based queries
+// =============================================================================
+
+void test_runtime_view_by_name()
+{
+    Registry reg;
+    reflectAll(reg);
+
+    std::vector<Entity> expected;
+    for (int i = 0; i < 20; ++i)
+    {
+        const Entity e = reg.create();
+        reg.add<Position>(e);
+        if (i % 2 == 0) reg.add<Velocity>(e);
+        if (i % 3 == 0) reg.add<Frozen>(e);
+        if (i % 2 == 0 && i % 3 != 0) expected.push_back(e);
+    }
+
+    std::vector<Entity> seen;
+    reg.runtimeView({"Position", "Velocity"}, {"Frozen"}).each([&](Entity e) { seen.push_back(e); });
+    TEST_ASSERT(sorted(seen) == sorted(expected), "name view matches expected set");
+
+    std::vector<Entity> byId;
+    reg.runtimeView({typeId<Position>(), typeId<Velocity>()}, {typeId<Frozen>()})
+        .each([&](Entity e) { byId.push_back(e); });
+    TEST_ASSERT(seen == byId, "name view iterates like the TypeId view");
+
+    std::size_t count = 0;
+    reg.runtimeView({"Position", "Unknown"}).each([&](Entity) { ++count; });
+    TEST_ASSERT(count == 0, "unknown include name matches nothing");
+
+    count = 0;
+    reg.runtimeView({"Position"}, {"Unknown"}).each([&](Entity) { ++count; });
+    TEST_ASSERT(count == 20, "unknown exclude name is ignored");
+}
+
+void test_compile_query_by_name()
+{
+    Registry reg;
+    reflectAll(reg);
+
+    std::vector<Entity> expected;
+    for (int i = 0; i < 30; ++i)
+    {
+        const Entity e = reg.create();
+        reg.add<Position>(e);
+        if (i % 3 != 0) reg.add<Velocity>(e);
+        if (i % 5 == 0) reg.add<Frozen>(e);
+        if (i % 3 != 0 && i % 5 != 0) expected.push_back(e);
+    }
+
+    CompiledQuery query = reg.compileQuery({"Position", "Velocity"}, {"Frozen"});
+    TEST_ASSERT(query.includeCount() == 2 && query.excludeCount() == 1, "slot counts");
+
+    std::vector<Entity> seen;
+    query.each([&](Entity e) { seen.push_back(e); });
+    TEST_ASSERT(sorted(seen) == sorted(expected), "compiled name query matches expected set");
+    TEST_ASSERT(query.count() == expected.size(), "count() agrees");
+
+    CompiledQuery unknown = reg.compileQuery({"Position", "Unknown"});
+    TEST_ASSERT(unknown.empty(), "unknown include name matches nothing");
+}
+
+// =============================================================================
+// Raw access
+// =============================================================================
+
+void test_raw_field_access()
+{
+    Registry reg;
+    reflectAll(reg);
+
+    const Entity e = reg.create();
+    const Entity bare = reg.create();
+    reg.add<Position>(e, 1.0f, 2.0f);
+
+    const ComponentInfo* pos = reg.reflection().find("Position");
+    const FieldInfo* y = pos->field("y");
+
+    void* raw = reg.tryGetRaw(pos->type, e);
+    TEST_ASSERT(raw == reg.tryGet<Position>(e), "raw pointer is the typed component");
+
+    float value = 0.0f;
+    std::memcpy(&value, y->in(raw), sizeof(value));
+    TEST_ASSERT(value == 2.0f, "read y through FieldInfo");
+
+    const float written = 7.5f;
+    std::memcpy(y->in(raw), &written, sizeof(written));
+    TEST_ASSERT(reg.get<Position>(e).y == 7.5f, "write y through FieldInfo");
+
+    TEST_ASSERT(reg.tryGetRaw(pos->type, bare) == nullptr, "missing component is nullptr");
+    TEST_ASSERT(reg.tryGetRaw(typeId<Health>(), e) == nullptr, "unregistered type is nullptr");
+}
+
+void test_raw_components_export()
+{
+    Registry reg;
+    reflectAll(reg);
+
+    const ComponentInfo* pos = reg.reflection().find("Position");
+    RawComponentSpan span = reg.rawComponents(pos->type);
+    TEST_ASSERT(span.count == 0 && span.data == nullptr, "empty before any Position");
+
+    std::vector<Entity> entities;
+    for (int i = 0; i < 10; ++i)
+    {
+        const Entity e = reg.create();
+        reg.add<Position>(e, static_cast<float>(i), static_cast<float>(-i));
+        entities.push_back(e);
+    }
+
+    span = reg.rawComponents(pos->type);
+    TEST_ASSERT(span.count == 10, "span covers every Position");
+    TEST_ASSERT(span.stride == sizeof(Position), "stride is component size");
+    TEST_ASSERT(span.data == static_cast<void*>(&reg.get<Position>(span.entities[0])),
+                "span aliases the dense array");
+
+    // Bulk export: one memcpy for the whole store.
+    std::vector<Position> exported(span.count);
+    std::memcpy(exported.data(), span.data, span.count * span.stride);
+    bool match = true;
+    for (std::size_t i = 0; i < span.count; ++i)
+    {
+        const Position& live = reg.get<Position>(span.entities[i]);
+        match = match && exported[i].x == live.x && exported[i].y == live.y;
+    }
+    TEST_ASSERT(match, "exported bytes match each entity's component");
+
+    const Entity h = reg.create();
+    reg.add<Health>(h);
+    const RawComponentSpan unreflected = reg.rawComponents(typeId<Health>());
+    TEST_ASSERT(unreflected.count == 1 && unreflected.stride == sizeof(Health),
+                "unreflected type: stride comes from the store");
+    TEST_ASSERT(unreflected.data == static_cast<void*>(&reg.get<Health>(h)),
+                "unreflected span aliases the dense array");
+
+    struct Unknown { int v; };
+    TEST_ASSERT(reg.rawComponents(typeId<Unknown>()).stride == 0, "no store, not reflected");
+}
+
+int main()
+{
+    std::printf("=== test_reflection ===\n");
+
+    std::printf("\n--- Metadata ---\n");
+    RUN_TEST(test_reflect_records_layout);
+    RUN_TEST(test_reflect_lookup_and_conflicts);
+
+    std::printf("\n--- Name-based queries ---\n");
+    RUN_TEST(test_runtime_view_by_name);
+    RUN_TEST(test_compile_query_by_name);
+
+    std::printf("\n--- Raw access ---\n");
+    RUN_TEST(test_raw_field_access);
+    RUN_TEST(test_raw_components_export);
+
+    std::printf("\n%d/%d tests passed\n", gPassed, gPassed + gFailed);
+    return gFailed == 0 ? 0 : 1;
+}
@@ -19,6 +19,16 @@
  * - TypeId round-trip: runtimeView matches compile-time view
  * - Large-scale: 1000 entities, alternating component presence
  * - Three-type include with exclude
+ *
+ * CompiledQuery (Registry::compileQuery):
+ * - Same results as runtimeView() for include/exclude combinations
+ * - Reused across frames: sees components added/removed since compile,
+ *   including store reallocation
+ * - Types registered after compile are resolved lazily (include and exclude),
+ *   and kInvalidTypeId is never waited on
+ * - Pivot is kept while sizes drift and re-picked when another include
+ *   store drops below half its size
+ * - contains(), count(), empty()
  */
 
 #include <fatp_ecs/FatpEcs.h>
@@ -406,6 +416,144 @@ void test_large_scale()
                 "large scale: counted should match expected non-excluded entities");
 }
 
+// =============================================================================
+// CompiledQuery
+// =============================================================================
+
+void test_compiled_matches_runtime_view()
+{
+    Registry reg;
+    for (int i = 0; i < 500; ++i)
+    {
+        Entity e = reg.create();
+        if (i % 2 == 0) reg.add<Position>(e);
+        if (i % 3 == 0) reg.add<Velocity>(e);
+        if (i % 5 == 0) reg.add<Frozen>(e);
+        if (i % 7 == 0) reg.add<Dead>(e);
+    }
+
+    auto view = reg.runtimeView({typeId<Position>(), typeId<Velocity>()},
+                                {typeId<Frozen>(), typeId<Dead>()});
+    auto query = reg.compileQuery({typeId<Position>(), typeId<Velocity>()},
+                                  {typeId<Frozen>(), typeId<Dead>()});
+
+    auto expected = collectEntities(view);
+    std::vector<Entity> visited;
+    query.each([&](Entity e) { visited.push_back(e); });
+    std::sort(expected.begin(), expected.end());
+    std::sort(visited.begin(), visited.end());
+    TEST_ASSERT(!visited.empty(), "some entities match");
+    TEST_ASSERT(visited == expected, "same entities as runtimeView");
+    TEST_ASSERT(query.count() == expected.size(), "count() agrees");
+    TEST_ASSERT(query.includeCount() == 2 && query.excludeCount() == 2, "accessors");
+}
+
+void test_compiled_reused_across_changes()
+{
+    Registry reg;
+    auto query = reg.compileQuery({typeId<Position>(), typeId<Velocity>()});
+
+    std::vector<Entity> entities;
+    for (int i = 0; i < 10; ++i)
+    {
+        Entity e = reg.create();
+        entities.push_back(e);
+        reg.add<Position>(e);
+        reg.add<Velocity>(e);
+    }
+    TEST_ASSERT(query.count() == 10, "sees entities added after compile");
+
+    // Grow well past the first allocation so dense/sparse arrays move.
+    for (int i = 0; i < 5000; ++i)
+    {
+        Entity e = reg.create();
+        reg.add<Position>(e);
+        if (i % 2 == 0) reg.add<Velocity>(e);
+    }
+    TEST_ASSERT(query.count() == 2510, "sees reallocated stores");
+
+    reg.remove<Velocity>(entities[0]);
+    reg.destroy(entities[1]);
+    TEST_ASSERT(query.count() == 2508, "sees removals");
+    TEST_ASSERT(!query.contains(entities[0]), "entity without Velocity excluded");
+    TEST_ASSERT(query.contains(entities[2]), "matching entity contained");
+}
+
+void test_compiled_lazy_resolution()
+{
+    Registry reg;
+    auto query = reg.compileQuery({typeId<Position>(), typeId<Health>()}, {typeId<Dead>()});
+
+    TEST_ASSERT(query.pendingCount() == 3, "nothing registered at compile");
+
+    Entity e1 = reg.create(); reg.add<Position>(e1);
+    TEST_ASSERT(query.empty(), "Health never registered: nothing matches");
+    TEST_ASSERT(query.pivotIndex() == CompiledQuery::kNoPivot, "no plan yet");
+    TEST_ASSERT(query.pendingCount() == 2, "Position resolved");
+
+    reg.add<Health>(e1);
+    Entity e2 = reg.create(); reg.add<Position>(e2); reg.add<Health>(e2);
+    TEST_ASSERT(query.count() == 2, "Health resolved once registered");
+    TEST_ASSERT(query.pendingCount() == 1, "only Dead pending");
+
+    reg.add<Dead>(e2);
+    std::vector<Entity> visited;
+    query.each([&](Entity e) { visited.push_back(e); });
+    TEST_ASSERT(visited.size() == 1 && visited[0] == e1, "Dead resolved as exclude");
+    TEST_ASSERT(query.pendingCount() == 0, "all resolved");
+
+    // An id no type has is skipped, not looked up on every call.
+    const TypeId include[] = {typeId<Position>()};
+    const TypeId exclude[] = {kInvalidTypeId};
+    auto invalid = reg.compileQuery(include, 1, exclude, 1);
+    TEST_ASSERT(invalid.pendingCount() == 0, "invalid id is not pending");
+    TEST_ASSERT(invalid.count() == 2, "invalid exclude filters nothing");
+}
+
+void test_compiled_pivot_hysteresis()
+{
+    Registry reg;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 100; ++i)
+    {
+        Entity e = reg.create();
+        entities.push_back(e);
+        reg.add<Position>(e);
+        if (i < 60) reg.add<Velocity>(e);
+    }
+    auto query = reg.compileQuery({typeId<Position>(), typeId<Velocity>()});
+    TEST_ASSERT(query.count() == 60, "60 match");
+    TEST_ASSERT(query.pivotIndex() == 1 && query.replanCount() == 1, "Velocity (smaller) drives");
+
+    // Position shrinks to 40: now the smaller store, but not below half of
+    // Velocity's 60, so the plan is kept.
+    for (int i = 40; i < 100; ++i) reg.remove<Position>(entities[static_cast<std::size_t>(i)]);
+    TEST_ASSERT(query.count() == 40, "40 match");
+    TEST_ASSERT(query.pivotIndex() == 1 && query.replanCount() == 1, "small drift: no replan");
+
+    // Position drops to 20 (< 60 / 2): the plan switches to Position.
+    for (int i = 20; i < 40; ++i) reg.remove<Position>(entities[static_cast<std::size_t>(i)]);
+    TEST_ASSERT(query.count() == 20, "20 match");
+    TEST_ASSERT(query.pivotIndex() == 0 && query.replanCount() == 2, "large shift: replanned");
+}
+
+void test_compiled_span_and_empty_include()
+{
+    Registry reg;
+    Entity e1 = reg.create(); reg.add<Position>(e1);
+    Entity e2 = reg.create(); reg.add<Position>(e2); reg.add<Frozen>(e2);
+
+    const TypeId include[] = {typeId<Position>()};
+    const TypeId exclude[] = {typeId<Frozen>()};
+    auto query = reg.compileQuery(include, 1, exclude, 1);
+    std::vector<Entity> visited;
+    query.each([&](Entity e) { visited.push_back(e); });
+    TEST_ASSERT(visited.size() == 1 && visited[0] == e1, "span overload filters");
+
+    auto none = reg.compileQuery(nullptr, 0);
+    TEST_ASSERT(none.empty() && none.count() == 0, "empty include list matches nothing");
+}
+
 // =============================================================================
 // Main
 // =============================================================================
@@ -443,6 +591,13 @@ int main()
     RUN_TEST(test_matches_compiletime_view);
     RUN_TEST(test_large_scale);
 
+    std::printf("\nCompiledQuery:\n");
+    RUN_TEST(test_compiled_matches_runtime_view);
+    RUN_TEST(test_compiled_reused_across_changes);
+    RUN_TEST(test_compiled_lazy_resolution);
+    RUN_TEST(test_compiled_pivot_hysteresis);
+    RUN_TEST(test_compiled_span_and_empty_include);
+
     std::printf("\n=== Results: %d passed, %d failed ===\n",
                 sTestsPassed, sTestsFailed);
 
@@ -0,0 +1,394 @@
+/**
+ * @file test_scheduler_context.cpp
+ * @brief Tests for SystemContext and the Scheduler's per-thread frame arenas.
+ *
+ * Verifies:
+ *   addSystem()          — both void(Registry&) and void(Registry&, SystemContext&)
+ *   SystemContext        — scheduler() back-reference, arena() per thread
+ *   Per-thread arenas    — distinct per worker, stable within a thread,
+ *                          reset at the end of run()
+ *   parallel_for         — lock-free scratch allocation inside chunks
+ *   Multiple schedulers  — a thread gets a different arena per scheduler,
+ *                          stable while it alternates between them
+ *   Exceptions           — run() joins the whole batch before rethrowing
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "fatp_ecs/FatpEcs.h"
+
+// =============================================================================
+// Test infrastructure
+// =============================================================================
+
+static int gPassed = 0;
+static int gFailed = 0;
+
+#define TEST_ASSERT(cond, msg)                                 \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            std::printf("  FAIL [%s]: %s\n", __func__, (msg)); \
+            ++gFailed;                                         \
+        }                                                      \
+        else                                                   \
+        {                                                      \
+            ++gPassed;                                         \
+        }                                                      \
+    } while (false)
+
+#define RUN_TEST(fn)                         \
+    do                                       \
+    {                                        \
+        std::printf("  Running: %s\n", #fn); \
+        fn();                                \
+    } while (false)
+
+using namespace fatp_ecs;
+
+// =============================================================================
+// Helper component types
+// =============================================================================
+
+struct Position
+{
+    float x{}, y{};
+};
+
+struct Velocity
+{
+    float dx{}, dy{};
+};
+
+struct Health
+{
+    int hp{};
+};
+
+struct CollisionPair
+{
+    Entity a;
+    Entity b;
+    float distance;
+};
+
+// =============================================================================
+// addSystem overloads
+// =============================================================================
+
+void test_add_system_accepts_both_signatures()
+{
+    Registry reg;
+    Scheduler scheduler(2);
+
+    int legacyRuns = 0;
+    int contextRuns = 0;
+    Scheduler* seen = nullptr;
+
+    scheduler.addSystem("Legacy", [&](Registry&) { ++legacyRuns; });
+    scheduler.addSystem("WithContext",
+        [&](Registry&, SystemContext& ctx)
+        {
+            ++contextRuns;
+            seen = &ctx.scheduler();
+        });
+
+    scheduler.run(reg);
+
+    TEST_ASSERT(legacyRuns == 1, "Registry&-only system ran");
+    TEST_ASSERT(contextRuns == 1, "context system ran");
+    TEST_ASSERT(seen == &scheduler, "ctx.scheduler() refers to the running scheduler");
+}
+
+// =============================================================================
+// Per-thread arenas
+// =============================================================================
+
+void test_arena_count_matches_workers_plus_driver()
+{
+    Scheduler scheduler(3);
+    TEST_ASSERT(scheduler.frameArenaCount() == scheduler.threadCount() + 1,
+                "one arena per worker plus the driving thread");
+}
+
+void test_arena_stable_within_thread()
+{
+    Scheduler scheduler(2);
+    FrameArena& a = scheduler.frameArena();
+    FrameArena& b = scheduler.frameArena();
+    TEST_ASSERT(&a == &b, "same thread gets the same arena");
+}
+
+void test_arenas_reset_after_run()
+{
+    Registry reg;
+    Scheduler scheduler(2);
+
+    std::size_t usedDuringRun = 0;
+    scheduler.addSystem("Alloc",
+        [&](Registry&, SystemContext& ctx)
+        {
+            (void)ctx.arena().make_array<float>(1024);
+            usedDuringRun = ctx.arena().bytesUsed();
+        });
+
+    scheduler.run(reg);
+
+    TEST_ASSERT(usedDuringRun >= 1024 * sizeof(float), "allocation visible during run");
+    TEST_ASSERT(scheduler.frameArena().bytesUsed() == 0, "driver arena reset after run");
+}
+
+void test_parallel_systems_get_distinct_arenas()
+{
+    Registry reg;
+    for (int i = 0; i < 10'000; ++i)
+    {
+        Entity e = reg.create();
+        reg.add<Position>(e, 0.0f, 0.0f);
+        reg.add<Velocity>(e, 1.0f, 1.0f);
+        reg.add<Health>(e, 100);
+    }
+
+    Scheduler scheduler(4);
+
+    std::mutex seenMutex;
+    std::set<FrameArena*> seenArenas;
+    std::atomic<int> mismatches{0};
+
+    auto writer = [&](Registry&, SystemContext& ctx)
+    {
+        FrameArena& arena = ctx.arena();
+        {
+            std::lock_guard<std::mutex> lock(seenMutex);
+            seenArenas.insert(&arena);
+        }
+        // Write a recognizable pattern and verify nobody else scribbled on it.
+        const std::size_t n = 4096;
+        auto* scratch = arena.make_array<std::size_t>(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            scratch[i] = i;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (scratch[i] != i)
+            {
+                mismatches.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // Non-conflicting (no masks) so they are batched together.
+    scheduler.addSystem("A", writer);
+    scheduler.addSystem("B", writer);
+    scheduler.addSystem("C", writer);
+    scheduler.addSystem("D", writer);
+
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        scheduler.run(reg);
+    }
+
+    TEST_ASSERT(mismatches.load() == 0, "no cross-thread arena corruption");
+    TEST_ASSERT(!seenArenas.empty(), "arenas observed");
+    TEST_ASSERT(seenArenas.size() <= scheduler.frameArenaCount(),
+                "no more arenas than threads");
+}
+
+void test_parallel_for_chunks_allocate_lock_free()
+{
+    Registry reg;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 100'000; ++i)
+    {
+        Entity e = reg.create();
+        reg.add<Position>(e, static_cast<float>(i), 0.0f);
+        entities.push_back(e);
+    }
+
+    Scheduler scheduler(4);
+    std::atomic<std::size_t> pairsMade{0};
+
+    scheduler.addSystem("Collision",
+        [&](Registry& r, SystemContext& ctx)
+        {
+            ctx.scheduler().parallel_for(entities.size(),
+                [&](std::size_t begin, std::size_t end)
+                {
+                    // Resolved per chunk: each worker uses its own arena.
+                    FrameArena& arena = ctx.arena();
+                    std::size_t local = 0;
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        const auto& p = r.get<Position>(entities[i]);
+                        auto* pair = arena.make<CollisionPair>(
+                            CollisionPair{entities[i], entities[i], p.x});
+                        local += (pair->a == entities[i]) ? 1 : 0;
+                    }
+                    pairsMade.fetch_add(local, std::memory_order_relaxed);
+                },
+                1024);
+        });
+
+    scheduler.run(reg);
+
+    TEST_ASSERT(pairsMade.load() == entities.size(), "every chunk allocated its pairs");
+    TEST_ASSERT(scheduler.frameArena().bytesUsed() == 0, "arenas reset after run");
+}
+
+void test_manual_reset_outside_run()
+{
+    Scheduler scheduler(2);
+    (void)scheduler.frameArena().allocate(128);
+    TEST_ASSERT(scheduler.frameArena().bytesUsed() >= 128, "allocation recorded");
+    scheduler.resetFrameArenas();
+    TEST_ASSERT(scheduler.frameArena().bytesUsed() == 0, "resetFrameArenas clears usage");
+}
+
+void test_thread_gets_distinct_arena_per_scheduler()
+{
+    Scheduler s1(1);
+    Scheduler s2(1);
+    FrameArena& a1 = s1.frameArena();
+    FrameArena& a2 = s2.frameArena();
+    TEST_ASSERT(&a1 != &a2, "different schedulers hand out different arenas");
+    TEST_ASSERT(&s1.frameArena() == &a1, "binding for s1 survives a lookup on s2");
+}
+
+void test_thread_alternating_schedulers_keeps_bindings()
+{
+    Scheduler s1(1);
+    Scheduler s2(1);
+    Scheduler s3(1);
+    FrameArena* a1 = &s1.frameArena();
+    FrameArena* a2 = &s2.frameArena();
+    FrameArena* a3 = &s3.frameArena();
+
+    bool stable = true;
+    for (int i = 0; i < 100; ++i)
+    {
+        stable = stable && &s1.frameArena() == a1;
+        stable = stable && &s2.frameArena() == a2;
+        stable = stable && &s3.frameArena() == a3;
+    }
+    TEST_ASSERT(stable, "each scheduler keeps its arena while a thread alternates");
+    TEST_ASSERT(a1 != a2 && a2 != a3 && a1 != a3, "one arena per scheduler");
+
+    // More schedulers than cache slots: evicted bindings are found again.
+    std::vector<std::unique_ptr<Scheduler>> many;
+    std::vector<FrameArena*> arenas;
+    for (std::size_t i = 0; i < Scheduler::kArenaCacheSlots + 2; ++i)
+    {
+        many.push_back(std::make_unique<Scheduler>(1));
+        arenas.push_back(&many.back()->frameArena());
+    }
+    stable = true;
+    for (int round = 0; round < 3; ++round)
+    {
+        for (std::size_t i = 0; i < many.size(); ++i)
+        {
+            stable = stable && &many[i]->frameArena() == arenas[i];
+        }
+    }
+    TEST_ASSERT(stable, "evicted binding resolves to the same arena");
+}
+
+void test_scheduler_destroyed_and_recreated()
+{
+    // A new scheduler must never inherit a stale thread binding, even when
+    // allocated at the address of a destroyed one.
+    for (int i = 0; i < 8; ++i)
+    {
+        auto scheduler = std::make_unique<Scheduler>(1);
+        FrameArena& arena = scheduler->frameArena();
+        (void)arena.allocate(64);
+        TEST_ASSERT(arena.bytesUsed() >= 64, "fresh arena usable");
+    }
+}
+
+void test_throwing_system_joins_batch()
+{
+    Registry reg;
+    Scheduler scheduler(2);
+
+    std::atomic<bool> thrown{false};
+    std::atomic<bool> siblingDone{false};
+    std::atomic<int> runs{0};
+
+    // No masks: both systems share one batch.
+    scheduler.addSystem("Thrower",
+        [&](Registry&, SystemContext&)
+        {
+            runs.fetch_add(1);
+            thrown.store(true);
+            throw std::runtime_error("system failed");
+        });
+    scheduler.addSystem("Slow",
+        [&](Registry&, SystemContext& ctx)
+        {
+            runs.fetch_add(1);
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+            while (!thrown.load() && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::yield();
+            }
+            // Still using ctx after the sibling threw.
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            (void)ctx.arena().make_array<int>(256);
+            siblingDone.store(true);
+        });
+
+    bool threw = false;
+    try
+    {
+        scheduler.run(reg);
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "system exception propagates from run()");
+    TEST_ASSERT(siblingDone.load(), "run() waited for the rest of the batch");
+    TEST_ASSERT(scheduler.frameArena().bytesUsed() == 0, "arenas reset after a throw");
+
+    scheduler.clearSystems();
+    scheduler.addSystem("Fine", [&](Registry&) { runs.fetch_add(1); });
+    scheduler.run(reg);
+    TEST_ASSERT(runs.load() == 3, "scheduler usable after a throw");
+}
+
+// =============================================================================
+// main
+// =============================================================================
+
+int main()
+{
+    std::printf("=== test_scheduler_context ===\n");
+
+    RUN_TEST(test_add_system_accepts_both_signatures);
+
+    RUN_TEST(test_arena_count_matches_workers_plus_driver);
+    RUN_TEST(test_arena_stable_within_thread);
+    RUN_TEST(test_arenas_reset_after_run);
+    RUN_TEST(test_parallel_systems_get_distinct_arenas);
+    RUN_TEST(test_parallel_for_chunks_allocate_lock_free);
+    RUN_TEST(test_manual_reset_outside_run);
+    RUN_TEST(test_thread_gets_distinct_arena_per_scheduler);
+    RUN_TEST(test_thread_alternating_schedulers_keeps_bindings);
+    RUN_TEST(test_scheduler_destroyed_and_recreated);
+    RUN_TEST(test_throwing_system_joins_batch);
+
+    std::printf("\n%d/%d tests passed\n", gPassed, gPassed + gFailed);
+    return gFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,363 @@
+/**
+ * @file test_sharded_registry.cpp
+ * @brief Tests for ShardedRegistry — concurrent structural changes across
+ *        independent shards.
+ *
+ * Verifies:
+ *   Handles encode their shard and round-trip through toLocal/toGlobal
+ *   Per-entity calls route to the owning shard; foreign handles are rejected
+ *   Views span every shard and report global handles; Exclude works
+ *   Concurrent create/add/destroy on distinct shards stays consistent
+ *   eachInShard() fans out over Scheduler::parallel_for
+ *   Shard count validation and single-shard handle compatibility
+ *   A full shard throws instead of handing out another shard's indices
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "fatp_ecs/FatpEcs.h"
+
+// =============================================================================
+// Test infrastructure
+// =============================================================================
+
+static int gPassed = 0;
+static int gFailed = 0;
+
+#define TEST_ASSERT(cond, msg)                                 \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            std::printf("  FAIL [%s]: %s\n", __func__, (msg)); \
+            ++gFailed;                                         \
+        }                                                      \
+        else                                                   \
+        {                                                      \
+            ++gPassed;                                         \
+        }                                                      \
+    } while (false)
+
+#define RUN_TEST(fn)                         \
+    do                                       \
+    {                                        \
+        std::printf("  Running: %s\n", #fn); \
+        fn();                                \
+    } while (false)
+
+using namespace fatp_ecs;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+struct Position
+{
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Velocity
+{
+    float dx = 0.0f;
+    float dy = 0.0f;
+};
+
+struct Frozen
+{
+};
+
+// =============================================================================
+// Handles and routing
+// =============================================================================
+
+void test_handles_encode_shard()
+{
+    ShardedRegistry reg(4);
+    TEST_ASSERT(reg.shardCount() == 4, "four shards");
+
+    const Entity a = reg.create(0);
+    const Entity b = reg.create(3);
+    const Entity c = reg.create(3);
+    TEST_ASSERT(reg.shardOf(a) == 0, "a in shard 0");
+    TEST_ASSERT(reg.shardOf(b) == 3 && reg.shardOf(c) == 3, "b, c in shard 3");
+    TEST_ASSERT(a != b && b != c, "handles distinct across and within shards");
+    TEST_ASSERT(reg.toGlobal(3, reg.toLocal(c)) == c, "toLocal/toGlobal round-trip");
+    TEST_ASSERT(reg.shard(3).isAlive(reg.toLocal(b)), "local handle alive in its shard");
+    TEST_ASSERT(reg.alive() == 3 && reg.shard(3).alive() == 2, "alive summed over shards");
+
+    TEST_ASSERT(reg.destroy(b), "destroy routes to shard 3");
+    TEST_ASSERT(!reg.isAlive(b) && reg.isAlive(c), "only b destroyed");
+    TEST_ASSERT(!reg.destroy(b), "double destroy rejected");
+
+    // The recycled slot gets a new generation; the stale handle stays dead.
+    const Entity d = reg.create(3);
+    TEST_ASSERT(reg.isAlive(d) && !reg.isAlive(b), "stale handle stays dead after reuse");
+}
+
+void test_components_route_to_owner()
+{
+    ShardedRegistry reg(3);
+    const Entity a = reg.create(1);
+    const Entity b = reg.create(2);
+    reg.add<Position>(a, 1.0f, 2.0f);
+    reg.emplace<Position>(b, 3.0f, 4.0f);
+    reg.add<Velocity>(b, 5.0f, 6.0f);
+
+    TEST_ASSERT(reg.get<Position>(a).y == 2.0f, "get from shard 1");
+    TEST_ASSERT(reg.get<Position>(b).x == 3.0f, "get from shard 2");
+    TEST_ASSERT(reg.has<Velocity>(b) && !reg.has<Velocity>(a), "has per entity");
+    TEST_ASSERT(reg.tryGet<Velocity>(a) == nullptr, "tryGet missing");
+    TEST_ASSERT(reg.shard(0).storage<Position>() == nullptr, "untouched shard has no store");
+    TEST_ASSERT(reg.remove<Velocity>(b) && !reg.has<Velocity>(b), "remove routes");
+
+    // Shard index 3 does not exist in a 3-shard registry (2 shard bits).
+    const Entity foreign = EntityTraits::make(3u << 30, 0);
+    TEST_ASSERT(!reg.isAlive(foreign) && !reg.has<Position>(foreign), "foreign handle not alive");
+    TEST_ASSERT(!reg.destroy(foreign) && reg.tryGet<Position>(foreign) == nullptr,
+                "foreign handle ignored");
+    bool threw = false;
+    try
+    {
+        reg.add<Position>(foreign);
+    }
+    catch (const std::out_of_range&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "add on foreign handle throws");
+}
+
+// =============================================================================
+// Views
+// =============================================================================
+
+void test_views_span_all_shards()
+{
+    ShardedRegistry reg(4);
+    std::vector<Entity> entities;
+    for (int i = 0; i < 40; ++i)
+    {
+        const Entity e = reg.create(static_cast<std::size_t>(i % 4));
+        reg.add<Position>(e, static_cast<float>(i), 0.0f);
+        if (i % 2 == 0)
+        {
+            reg.add<Velocity>(e, 1.0f, 0.0f);
+        }
+        if (i % 10 == 0)
+        {
+            reg.add<Frozen>(e);
+        }
+        entities.push_back(e);
+    }
+
+    TEST_ASSERT(reg.view<Position>().count() == 40, "single-type count");
+    const std::size_t moving = reg.view<Position, Velocity>().count();
+    TEST_ASSERT(moving == 20, "two-type count");
+    const std::size_t unfrozen = reg.view<Position, Velocity>(Exclude<Frozen>{}).count();
+    TEST_ASSERT(unfrozen == 16, "exclude count");
+
+    std::size_t visited = 0;
+    bool handlesMatch = true;
+    reg.view<Position, Velocity>().each(
+        [&](Entity e, Position& p, Velocity& v)
+        {
+            ++visited;
+            handlesMatch = handlesMatch && reg.isAlive(e) && reg.get<Position>(e).x == p.x;
+            p.x += v.dx;
+        });
+    TEST_ASSERT(visited == 20, "each visits every shard");
+    TEST_ASSERT(handlesMatch, "each hands out global handles");
+    TEST_ASSERT(reg.get<Position>(entities[2]).x == 3.0f, "writes land in the component");
+
+    std::size_t inShard1 = 0;
+    reg.view<Position>().eachInShard(1, [&](Entity e, Position&) {
+        inShard1 += reg.shardOf(e) == 1 ? 1 : 0;
+    });
+    TEST_ASSERT(inShard1 == 10, "eachInShard stays in its shard");
+}
+
+// =============================================================================
+// Concurrency
+// =============================================================================
+
+void test_concurrent_structural_changes()
+{
+    constexpr std::size_t kShards = 4;
+    constexpr int kPerShard = 5000;
+    ShardedRegistry reg(kShards);
+
+    std::vector<std::vector<Entity>> spawned(kShards);
+    std::vector<std::thread> workers;
+    for (std::size_t s = 0; s < kShards; ++s)
+    {
+        workers.emplace_back(
+            [&reg, &spawned, s]
+            {
+                for (int i = 0; i < kPerShard; ++i)
+                {
+                    const Entity e = reg.create(s);
+                    reg.add<Position>(e, static_cast<float>(s), static_cast<float>(i));
+                    if (i % 2 == 0)
+                    {
+                        reg.add<Velocity>(e);
+                    }
+                    spawned[s].push_back(e);
+                }
+                // Destroy every fifth entity of this shard while others spawn.
+                for (std::size_t i = 0; i < spawned[s].size(); i += 5)
+                {
+                    reg.destroy(spawned[s][i]);
+                }
+            });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    const std::size_t expected = kShards * (kPerShard - kPerShard / 5);
+    TEST_ASSERT(reg.alive() == expected, "alive count after concurrent spawn/destroy");
+    TEST_ASSERT(reg.view<Position>().count() == expected, "one Position per live entity");
+
+    std::unordered_set<Entity> unique;
+    bool consistent = true;
+    reg.view<Position>().each(
+        [&](Entity e, Position& p)
+        {
+            unique.insert(e);
+            consistent = consistent && reg.shardOf(e) == static_cast<std::size_t>(p.x);
+        });
+    TEST_ASSERT(unique.size() == expected, "handles unique across shards");
+    TEST_ASSERT(consistent, "each entity's data came from its own shard's worker");
+}
+
+void test_parallel_iteration_per_shard()
+{
+    ShardedRegistry reg(8);
+    for (std::size_t s = 0; s < reg.shardCount(); ++s)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            const Entity e = reg.create(s);
+            reg.add<Position>(e);
+            reg.add<Velocity>(e, 1.0f, 2.0f);
+        }
+    }
+
+    Scheduler scheduler(2);
+    auto view = reg.view<Position, Velocity>();
+    scheduler.parallel_for(
+        reg.shardCount(),
+        [&view](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t s = begin; s < end; ++s)
+            {
+                view.eachInShard(s, [](Entity, Position& p, Velocity& v) {
+                    p.x += v.dx;
+                    p.y += v.dy;
+                });
+            }
+        },
+        1);
+
+    bool updated = true;
+    reg.view<Position>().each([&](Entity, Position& p) {
+        updated = updated && p.x == 1.0f && p.y == 2.0f;
+    });
+    TEST_ASSERT(updated, "every shard integrated exactly once");
+}
+
+// =============================================================================
+// Construction
+// =============================================================================
+
+void test_shard_count_validation()
+{
+    bool zeroThrew = false;
+    try
+    {
+        ShardedRegistry reg(0);
+    }
+    catch (const std::invalid_argument&)
+    {
+        zeroThrew = true;
+    }
+    TEST_ASSERT(zeroThrew, "zero shards rejected");
+
+    bool tooManyThrew = false;
+    try
+    {
+        ShardedRegistry reg(ShardedRegistry::kMaxShards + 1);
+    }
+    catch (const std::invalid_argument&)
+    {
+        tooManyThrew = true;
+    }
+    TEST_ASSERT(tooManyThrew, "more than kMaxShards rejected");
+
+    // One shard uses the whole index space: handles equal Registry's.
+    ShardedRegistry single(1);
+    Registry plain;
+    const Entity s = single.create(0);
+    const Entity p = plain.create();
+    TEST_ASSERT(s == p && single.toLocal(s) == s, "single-shard handles are plain handles");
+
+    ShardedRegistry maxed(ShardedRegistry::kMaxShards);
+    const Entity last = maxed.create(ShardedRegistry::kMaxShards - 1);
+    TEST_ASSERT(maxed.shardOf(last) == ShardedRegistry::kMaxShards - 1, "top shard addressable");
+    maxed.clear();
+    TEST_ASSERT(!maxed.isAlive(last), "clear empties every shard");
+}
+
+void test_shard_index_exhaustion()
+{
+    // 256 shards leave 24 index bits per shard.
+    ShardedRegistry reg(ShardedRegistry::kMaxShards);
+    const std::size_t capacity = std::size_t{1} << 24;
+    std::vector<Entity> handles(capacity);
+    reg.create(5, handles.begin(), handles.end());
+    TEST_ASSERT(reg.shardOf(handles.back()) == 5, "last slot still encodes its shard");
+
+    bool threw = false;
+    try
+    {
+        (void)reg.create(5);
+    }
+    catch (const std::length_error&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "create past the shard's index bits throws length_error");
+    TEST_ASSERT(reg.shard(5).alive() == capacity, "the rejected entity was not kept");
+    TEST_ASSERT(reg.shard(6).alive() == 0, "no handle leaked into the next shard");
+
+    TEST_ASSERT(reg.destroy(handles[42]), "destroy frees a slot");
+    const Entity reused = reg.create(5);
+    TEST_ASSERT(reg.shardOf(reused) == 5 && reg.isAlive(reused), "freed slot is reusable");
+}
+
+int main()
+{
+    std::printf("=== test_sharded_registry ===\n");
+
+    RUN_TEST(test_handles_encode_shard);
+    RUN_TEST(test_components_route_to_owner);
+
+    RUN_TEST(test_views_span_all_shards);
+
+    RUN_TEST(test_concurrent_structural_changes);
+    RUN_TEST(test_parallel_iteration_per_shard);
+
+    RUN_TEST(test_shard_count_validation);
+    RUN_TEST(test_shard_index_exhaustion);
+
+    std::printf("\n%d/%d tests passed\n", gPassed, gPassed + gFailed);
+    return gFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,341 @@
+/**
+ * @file test_slot_recycling.cpp
+ * @brief Tests for Registry::setSlotRecycling() and FreeSlotTracker.
+ *
+ * Verifies:
+ *   Default      — behaviour unchanged, no tracking
+ *   Lifo         — most recently freed slot reused first
+ *   Fifo         — least recently freed slot reused first
+ *   LowestIndex  — lowest free slot reused first
+ *   Generations  — recycled slots still invalidate stale handles
+ *   create(hint) — hinted slots are removed from the free set
+ *   clear()      — all slots become free, reuse restarts at index 0
+ *   Policy switch with live entities rebuilds the free set
+ *   Churn at scale keeps the index space compact under LowestIndex
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "fatp_ecs/FatpEcs.h"
+
+// =============================================================================
+// Test infrastructure
+// =============================================================================
+
+static int gPassed = 0;
+static int gFailed = 0;
+
+#define TEST_ASSERT(cond, msg)                                 \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            std::printf("  FAIL [%s]: %s\n", __func__, (msg)); \
+            ++gFailed;                                         \
+        }                                                      \
+        else                                                   \
+        {                                                      \
+            ++gPassed;                                         \
+        }                                                      \
+    } while (false)
+
+#define RUN_TEST(fn)                         \
+    do                                       \
+    {                                        \
+        std::printf("  Running: %s\n", #fn); \
+        fn();                                \
+    } while (false)
+
+using namespace fatp_ecs;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+struct Position
+{
+    float x{}, y{};
+};
+
+static uint32_t slotOf(Entity e)
+{
+    return EntityTraits::index(e);
+}
+
+// Creates 8 entities (slots 0..7), destroys slots 1, 5, 3 in that order and
+// returns the slots handed out by the next three create() calls.
+static std::vector<uint32_t> reuseOrder(SlotRecycling policy)
+{
+    Registry reg;
+    reg.setSlotRecycling(policy);
+
+    std::vector<Entity> ents;
+    for (int i = 0; i < 8; ++i)
+    {
+        ents.push_back(reg.create());
+    }
+    reg.destroy(ents[1]);
+    reg.destroy(ents[5]);
+    reg.destroy(ents[3]);
+
+    std::vector<uint32_t> order;
+    for (int i = 0; i < 3; ++i)
+    {
+        order.push_back(slotOf(reg.create()));
+    }
+    return order;
+}
+
+// =============================================================================
+// Reuse order
+// =============================================================================
+
+void test_default_policy_is_default()
+{
+    Registry reg;
+    TEST_ASSERT(reg.slotRecycling() == SlotRecycling::Default, "Default out of the box");
+
+    Entity a = reg.create();
+    reg.destroy(a);
+    Entity b = reg.create();
+    TEST_ASSERT(reg.isAlive(b), "create after destroy works");
+    TEST_ASSERT(!reg.isAlive(a), "stale handle dead");
+}
+
+void test_lifo_order()
+{
+    const std::vector<uint32_t> expected{3, 5, 1};
+    TEST_ASSERT(reuseOrder(SlotRecycling::Lifo) == expected, "LIFO reuses newest free first");
+}
+
+void test_fifo_order()
+{
+    const std::vector<uint32_t> expected{1, 5, 3};
+    TEST_ASSERT(reuseOrder(SlotRecycling::Fifo) == expected, "FIFO reuses oldest free first");
+}
+
+void test_lowest_index_order()
+{
+    const std::vector<uint32_t> expected{1, 3, 5};
+    TEST_ASSERT(reuseOrder(SlotRecycling::LowestIndex) == expected,
+                "LowestIndex reuses lowest free first");
+}
+
+void test_fresh_slot_when_free_set_empty()
+{
+    for (SlotRecycling p : {SlotRecycling::Lifo, SlotRecycling::Fifo, SlotRecycling::LowestIndex})
+    {
+        Registry reg;
+        reg.setSlotRecycling(p);
+        Entity a = reg.create();
+        Entity b = reg.create();
+        TEST_ASSERT(slotOf(a) == 0 && slotOf(b) == 1, "fresh slots allocated in order");
+    }
+}
+
+// =============================================================================
+// Generations and hints
+// =============================================================================
+
+void test_recycled_slot_bumps_generation()
+{
+    for (SlotRecycling p : {SlotRecycling::Lifo, SlotRecycling::Fifo, SlotRecycling::LowestIndex})
+    {
+        Registry reg;
+        reg.setSlotRecycling(p);
+        Entity old = reg.create();
+        reg.add<Position>(old, 1.0f, 2.0f);
+        reg.destroy(old);
+
+        Entity fresh = reg.create();
+        TEST_ASSERT(slotOf(fresh) == slotOf(old), "slot reused");
+        TEST_ASSERT(fresh != old, "handle differs");
+        TEST_ASSERT(!reg.isAlive(old), "old handle invalid");
+        TEST_ASSERT(reg.isAlive(fresh), "new handle valid");
+        TEST_ASSERT(!reg.has<Position>(fresh), "no component leaks into reused slot");
+    }
+}
+
+void test_hint_claims_slot_from_free_set()
+{
+    for (SlotRecycling p : {SlotRecycling::Lifo, SlotRecycling::Fifo, SlotRecycling::LowestIndex})
+    {
+        Registry reg;
+        reg.setSlotRecycling(p);
+        std::vector<Entity> ents;
+        for (int i = 0; i < 6; ++i)
+        {
+            ents.push_back(reg.create());
+        }
+        reg.destroy(ents[2]);
+        reg.destroy(ents[4]);
+
+        Entity hinted = reg.create(ents[2]);
+        TEST_ASSERT(slotOf(hinted) == 2, "hint honoured");
+
+        Entity next = reg.create();
+        TEST_ASSERT(slotOf(next) == 4, "free set skips the hinted slot");
+
+        Entity fresh = reg.create();
+        TEST_ASSERT(slotOf(fresh) == 6, "then a fresh slot");
+        TEST_ASSERT(reg.entityCount() == 7, "entity count consistent");
+    }
+}
+
+// =============================================================================
+// clear() and policy switches
+// =============================================================================
+
+void test_clear_restarts_from_zero()
+{
+    for (SlotRecycling p : {SlotRecycling::Lifo, SlotRecycling::Fifo, SlotRecycling::LowestIndex})
+    {
+        Registry reg;
+        reg.setSlotRecycling(p);
+        for (int i = 0; i < 100; ++i)
+        {
+            (void)reg.create();
+        }
+        reg.clear();
+
+        bool ascending = true;
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            ascending = ascending && slotOf(reg.create()) == i;
+        }
+        TEST_ASSERT(ascending, "after clear(), slots reused from 0 upward");
+        TEST_ASSERT(slotOf(reg.create()) == 100, "then fresh slots");
+    }
+}
+
+void test_switch_policy_with_live_entities()
+{
+    Registry reg;
+    std::vector<Entity> ents;
+    for (int i = 0; i < 10; ++i)
+    {
+        ents.push_back(reg.create());
+    }
+    reg.destroy(ents[7]);
+    reg.destroy(ents[2]);
+
+    reg.setSlotRecycling(SlotRecycling::LowestIndex);
+    TEST_ASSERT(reg.slotRecycling() == SlotRecycling::LowestIndex, "policy reported");
+
+    TEST_ASSERT(slotOf(reg.create()) == 2, "rebuilt free set: lowest hole first");
+    TEST_ASSERT(slotOf(reg.create()) == 7, "then the next hole");
+    TEST_ASSERT(reg.entityCount() == 10, "count consistent");
+
+    reg.setSlotRecycling(SlotRecycling::Default);
+    TEST_ASSERT(reg.slotRecycling() == SlotRecycling::Default, "back to default");
+    Entity e = reg.create();
+    TEST_ASSERT(reg.isAlive(e), "default create works after switching back");
+}
+
+// =============================================================================
+// Scale
+// =============================================================================
+
+void test_churn_keeps_index_space_compact()
+{
+    constexpr std::size_t kLive = 10'000;
+    Registry reg;
+    reg.setSlotRecycling(SlotRecycling::LowestIndex);
+
+    std::vector<Entity> live;
+    for (std::size_t i = 0; i < kLive; ++i)
+    {
+        Entity e = reg.create();
+        reg.add<Position>(e, static_cast<float>(i), 0.0f);
+        live.push_back(e);
+    }
+
+    std::mt19937 rng(1234);
+    for (int round = 0; round < 20; ++round)
+    {
+        // Destroy a random half, then refill to kLive.
+        std::shuffle(live.begin(), live.end(), rng);
+        for (std::size_t i = 0; i < kLive / 2; ++i)
+        {
+            reg.destroy(live[i]);
+        }
+        live.erase(live.begin(), live.begin() + static_cast<std::ptrdiff_t>(kLive / 2));
+        while (live.size() < kLive)
+        {
+            Entity e = reg.create();
+            reg.add<Position>(e, 0.0f, 0.0f);
+            live.push_back(e);
+        }
+    }
+
+    uint32_t maxSlot = 0;
+    for (Entity e : live)
+    {
+        maxSlot = std::max(maxSlot, slotOf(e));
+    }
+    TEST_ASSERT(maxSlot < kLive, "live slots stay within [0, kLive)");
+    TEST_ASSERT(reg.storage<Position>()->sparseCount() <= kLive,
+                "sparse array does not grow past the live population");
+
+    std::size_t iterated = 0;
+    reg.view<Position>().each([&](Entity, Position&) { ++iterated; });
+    TEST_ASSERT(iterated == kLive, "view sees every live entity");
+}
+
+void test_fifo_maximizes_reuse_distance()
+{
+    constexpr std::size_t kN = 10'000;
+    Registry reg;
+    reg.setSlotRecycling(SlotRecycling::Fifo);
+
+    std::vector<Entity> ents;
+    for (std::size_t i = 0; i < kN; ++i)
+    {
+        ents.push_back(reg.create());
+    }
+    for (std::size_t i = 0; i < kN; ++i)
+    {
+        reg.destroy(ents[i]);
+    }
+
+    // Immediate destroy/create of one entity must not hand back the slot it
+    // just freed while older free slots are still queued.
+    Entity a = reg.create();
+    const uint32_t first = slotOf(a);
+    reg.destroy(a);
+    Entity b = reg.create();
+    TEST_ASSERT(first == 0, "oldest freed slot first");
+    TEST_ASSERT(slotOf(b) == 1, "just-freed slot goes to the back of the queue");
+}
+
+// =============================================================================
+// main
+// =============================================================================
+
+int main()
+{
+    std::printf("=== test_slot_recycling ===\n");
+
+    RUN_TEST(test_default_policy_is_default);
+    RUN_TEST(test_lifo_order);
+    RUN_TEST(test_fifo_order);
+    RUN_TEST(test_lowest_index_order);
+    RUN_TEST(test_fresh_slot_when_free_set_empty);
+
+    RUN_TEST(test_recycled_slot_bumps_generation);
+    RUN_TEST(test_hint_claims_slot_from_free_set);
+
+    RUN_TEST(test_clear_restarts_from_zero);
+    RUN_TEST(test_switch_policy_with_live_entities);
+
+    RUN_TEST(test_churn_keeps_index_space_compact);
+    RUN_TEST(test_fifo_maximizes_reuse_distance);
+
+    std::printf("\n%d/%d tests passed\n", gPassed, gPassed + gFailed);
+    return gFailed == 0 ? 0 : 1;
+}
@@ -17,7 +17,8 @@
  * 12. Non-trivial component type (std::string field)
  * 13. Unknown block skipped: loader with fewer registered types than snapshot
  * 14. Corrupt header magic: throws on construction
- * 15. Corrupt footer magic: finalize() throws
+ * 15. Hostile entity index: remap table not sized from it
+ * 16. Corrupt footer magic: finalize() throws
  */
 
 #include <fatp_ecs/FatpEcs.h>
@@ -621,7 +622,32 @@ static void test_corrupt_header_throws()
 }
 
 // =============================================================================
-// Test 15: Corrupt footer magic throws
+// Test 15: Hostile entity indices do not size the remap table
+// =============================================================================
+
+static void test_hostile_entity_index()
+{
+    std::vector<uint8_t> buf;
+    fat_p::binary::Encoder enc(buf);
+    enc.writeUint32(RegistrySnapshot::kHeaderMagic);
+    enc.writeUint8(RegistrySnapshot::kVersion);
+    enc.writeUint32(2u); // entity count
+    enc.writeUint64(EntityTraits::make(0xFFFFFFF0u, 1).get());
+    enc.writeUint64(EntityTraits::make(0u, 0).get());
+
+    Registry dst;
+    fat_p::binary::Decoder dec(buf);
+    auto loader = dst.snapshotLoader(dec);
+
+    const EntityMap& remap = loader.entityMap();
+    TEST_ASSERT(dst.entityCount() == 2, "both entities recreated");
+    TEST_ASSERT(remap.size() == 2, "both entities mapped");
+    TEST_ASSERT(dst.isAlive(remap.translate(EntityTraits::make(0xFFFFFFF0u, 1))),
+                "huge old index translates");
+}
+
+// =============================================================================
+// Test 16: Corrupt footer magic throws
 // =============================================================================
 
 static void test_corrupt_footer_throws()
@@ -677,6 +703,7 @@ int main()
     RUN_TEST(test_nontrivial_component);
     RUN_TEST(test_unknown_block_skipped);
     RUN_TEST(test_corrupt_header_throws);
+    RUN_TEST(test_hostile_entity_index);
     RUN_TEST(test_corrupt_footer_throws);
 
     std::printf("\n%d/%d tests passed\n", sTestsPassed, sTestsPassed + sTestsFailed);
@@ -24,6 +24,27 @@
  * - view<A, B>().each() visits in A's sorted order after sort<A, B>()
  * - Large-scale match-sort (1000 entities, partial overlap)
  *
+ * sort_by_key<T>(keyFn):
+ * - Signed integer and float keys (negatives, -0.0/+0.0) sort ascending
+ * - Equal keys keep their previous relative order (stable)
+ * - Entity→component mapping survives the permutation
+ * - Parallel overload matches the serial result (64-bit keys)
+ * - Non-nothrow-movable components sort correctly
+ * - sort<T>(comparator) and sort_by_key<T> agree
+ *
+ * sort<T>(comparator, SortMode::Incremental):
+ * - Already-sorted store is left untouched
+ * - Jittered, tail-appended and reversed stores match a stable full sort
+ * - Few moved entries keep the entity mapping intact
+ * - Non-nothrow-movable components sort correctly
+ *
+ * align<Pivot, Fs...>():
+ * - Entities with every component share dense indices [0, k) in all stores
+ * - Partially shared and non-pivot entities are ordered as documented
+ * - Single follower matches sort<A, B>()
+ * - Unregistered follower: no-op
+ * - Large-scale randomized alignment keeps the entity mapping intact
+ *
  * Interaction:
  * - sort<T> then view<T>: correct entity+component pairs
  * - sort<A, B> then view<A, B>: both components from same entity per call
@@ -32,6 +53,7 @@
 #include <fatp_ecs/FatpEcs.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cassert>
 #include <cstdio>
 #include <numeric>
@@ -73,6 +95,20 @@ static int sTestsFailed = 0;
 struct Value  { int v = 0; };
 struct Score  { float s = 0.0f; };
 struct Marker { uint8_t id = 0; };
+struct Depth  { float z = 0.0f; };
+struct Key64  { uint64_t k = 0; uint32_t tag = 0; };
+
+// Move constructor may throw; permute() only swaps, so it still sorts.
+struct Guarded
+{
+    int v = 0;
+    Guarded() = default;
+    explicit Guarded(int value) : v(value) {}
+    Guarded(const Guarded&) = default;
+    Guarded(Guarded&& other) noexcept(false) : v(other.v) {}
+    Guarded& operator=(const Guarded&) = default;
+    Guarded& operator=(Guarded&&) = default;
+};
 
 // =============================================================================
 // sort<T>(comparator)
@@ -387,6 +423,474 @@ void test_match_sort_large_scale()
                 "Score should be in ascending order after match-sort");
 }
 
+// =============================================================================
+// sort_by_key<T>(keyFn)
+// =============================================================================
+
+void test_sort_by_key_signed_ints()
+{
+    Registry reg;
+    const int values[] = {5, -3, 1000, -70000, 0, 42, -1, 7};
+    for (int v : values)
+    {
+        reg.add<Value>(reg.create(), v);
+    }
+
+    reg.sort_by_key<Value>([](const Value& x) { return x.v; });
+
+    std::vector<int> order;
+    reg.view<Value>().each([&](Entity, const Value& x) { order.push_back(x.v); });
+    TEST_ASSERT(order.size() == 8, "8 elements");
+    TEST_ASSERT(std::is_sorted(order.begin(), order.end()), "ascending, negatives first");
+}
+
+void test_sort_by_key_floats()
+{
+    Registry reg;
+    const float values[] = {2.5f, -0.0f, -1.0e6f, 0.0f, 1.0e-30f, -3.25f, 1.0e6f, -1.0e-30f};
+    for (float z : values)
+    {
+        reg.add<Depth>(reg.create(), z);
+    }
+
+    reg.sort_by_key<Depth>([](const Depth& d) { return d.z; });
+
+    std::vector<float> order;
+    reg.view<Depth>().each([&](Entity, const Depth& d) { order.push_back(d.z); });
+    TEST_ASSERT(std::is_sorted(order.begin(), order.end()), "ascending float order");
+    TEST_ASSERT(order.front() == -1.0e6f && order.back() == 1.0e6f, "extremes at the ends");
+    TEST_ASSERT(std::signbit(order[3]) && !std::signbit(order[4]), "-0.0 before +0.0");
+}
+
+void test_sort_by_key_stable()
+{
+    Registry reg;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 200; ++i)
+    {
+        Entity e = reg.create();
+        entities.push_back(e);
+        reg.add<Key64>(e, Key64{static_cast<uint64_t>(i % 4), static_cast<uint32_t>(i)});
+    }
+
+    reg.sort_by_key<Key64>([](const Key64& k) { return k.k; });
+
+    std::vector<Key64> order;
+    reg.view<Key64>().each([&](Entity, const Key64& k) { order.push_back(k); });
+    for (std::size_t i = 1; i < order.size(); ++i)
+    {
+        const bool keyOrdered = order[i - 1].k < order[i].k;
+        const bool tieOrdered = order[i - 1].k == order[i].k && order[i - 1].tag < order[i].tag;
+        TEST_ASSERT(keyOrdered || tieOrdered, "ties keep insertion order");
+    }
+}
+
+void test_sort_by_key_preserves_mapping()
+{
+    Registry reg;
+    std::mt19937 rng(7);
+    std::vector<Entity> entities;
+    for (int i = 0; i < 1000; ++i)
+    {
+        Entity e = reg.create();
+        entities.push_back(e);
+        reg.add<Value>(e, static_cast<int>(rng() % 100000));
+        reg.add<Score>(e, static_cast<float>(i));
+    }
+    // Destroy some so the dense array is not in creation order.
+    for (int i = 0; i < 1000; i += 7)
+    {
+        reg.destroy(entities[static_cast<std::size_t>(i)]);
+    }
+
+    reg.sort_by_key<Value>([](const Value& v) { return v.v; });
+
+    std::vector<int> order;
+    bool mappingOk = true;
+    reg.view<Value>().each([&](Entity e, const Value& v) {
+        order.push_back(v.v);
+        mappingOk = mappingOk && reg.get<Value>(e).v == v.v;
+    });
+    TEST_ASSERT(std::is_sorted(order.begin(), order.end()), "ascending");
+    TEST_ASSERT(mappingOk, "get<Value>(e) agrees with the view after sort");
+    for (std::size_t i = 0; i < entities.size(); ++i)
+    {
+        if (i % 7 == 0) continue;
+        TEST_ASSERT(reg.has<Value>(entities[i]), "every live entity keeps its component");
+        TEST_ASSERT(reg.get<Score>(entities[i]).s == static_cast<float>(i), "other stores untouched");
+    }
+}
+
+void test_sort_by_key_parallel_matches_serial()
+{
+    constexpr int kN = 50000;
+    Registry serial;
+    Registry parallel;
+    std::mt19937_64 rng(99);
+    for (int i = 0; i < kN; ++i)
+    {
+        const Key64 k{rng() >> (i % 3 == 0 ? 40 : 0), static_cast<uint32_t>(i)};
+        serial.add<Key64>(serial.create(), k);
+        parallel.add<Key64>(parallel.create(), k);
+    }
+
+    Scheduler scheduler(4);
+    auto key = [](const Key64& k) { return k.k; };
+    serial.sort_by_key<Key64>(key);
+    parallel.sort_by_key<Key64>(key, scheduler, 1024);
+
+    std::vector<uint32_t> a;
+    std::vector<uint32_t> b;
+    serial.view<Key64>().each([&](Entity, const Key64& k) { a.push_back(k.tag); });
+    parallel.view<Key64>().each([&](Entity, const Key64& k) { b.push_back(k.tag); });
+    TEST_ASSERT(a.size() == static_cast<std::size_t>(kN), "all present");
+    TEST_ASSERT(a == b, "parallel order identical to serial");
+
+    std::vector<uint64_t> keys;
+    parallel.view<Key64>().each([&](Entity, const Key64& k) { keys.push_back(k.k); });
+    TEST_ASSERT(std::is_sorted(keys.begin(), keys.end()), "ascending 64-bit keys");
+}
+
+void test_sort_by_key_throwing_move()
+{
+    Registry reg;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 100; ++i)
+    {
+        Entity e = reg.create();
+        entities.push_back(e);
+        reg.add<Guarded>(e, Guarded((i * 37) % 100));
+    }
+
+    reg.sort_by_key<Guarded>([](const Guarded& g) { return g.v; });
+
+    std::vector<int> order;
+    reg.view<Guarded>().each([&](Entity, const Guarded& g) { order.push_back(g.v); });
+    TEST_ASSERT(order.size() == 100, "all present");
+    TEST_ASSERT(std::is_sorted(order.begin(), order.end()), "ascending via swap cycles");
+    for (int i = 0; i < 100; ++i)
+    {
+        TEST_ASSERT(reg.get<Guarded>(entities[static_cast<std::size_t>(i)]).v == (i * 37) % 100,
+                    "mapping intact");
+    }
+}
+
+void test_sort_by_key_agrees_with_comparator()
+{
+    Registry a;
+    Registry b;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 500; ++i)
+    {
+        const int v = static_cast<int>(rng() % 1000) - 500;
+        a.add<Value>(a.create(), v);
+        b.add<Value>(b.create(), v);
+    }
+
+    a.sort<Value>([](const Value& x, const Value& y) { return x.v < y.v; });
+    b.sort_by_key<Value>([](const Value& x) { return x.v; });
+
+    std::vector<int> orderA;
+    std::vector<int> orderB;
+    a.view<Value>().each([&](Entity, const Value& x) { orderA.push_back(x.v); });
+    b.view<Value>().each([&](Entity, const Value& x) { orderB.push_back(x.v); });
+    TEST_ASSERT(orderA == orderB, "same value order");
+}
+
+// =============================================================================
+// sort<T>(comparator, SortMode::Incremental)
+// =============================================================================
+
+namespace
+{
+
+auto byKey = [](const Key64& a, const Key64& b) { return a.k < b.k; };
+
+std::vector<uint32_t> tagOrder(Registry& reg)
+{
+    std::vector<uint32_t> tags;
+    reg.view<Key64>().each([&](Entity, const Key64& k) { tags.push_back(k.tag); });
+    return tags;
+}
+
+// Stable reference result for the current contents of reg's Key64 store.
+std::vector<uint32_t> stableReference(Registry& reg)
+{
+    std::vector<Key64> values;
+    reg.view<Key64>().each([&](Entity, const Key64& k) { values.push_back(k); });
+    std::stable_sort(values.begin(), values.end(), byKey);
+    std::vector<uint32_t> tags;
+    for (const Key64& k : values) tags.push_back(k.tag);
+    return tags;
+}
+
+} // namespace
+
+void test_incremental_sorted_noop()
+{
+    Registry reg;
+    std::vector<Entity> entities;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        Entity e = reg.create();
+        entities.push_back(e);
+        reg.add<Key64>(e, Key64{i / 3, i});
+    }
+
+    reg.sort<Key64>(byKey, SortMode::Incremental);
+
+    auto* store = reg.storage<Key64>();
+    for (std::size_t i = 0; i < entities.size(); ++i)
+    {
+        TEST_ASSERT(store->dense()[i] == entities[i], "dense order unchanged");
+    }
+}
+
+void test_incremental_jitter_matches_stable()
+{
+    for (int percent : {1, 5, 25, 100})
+    {
+        Registry reg;
+        std::mt19937 rng(static_cast<unsigned>(percent));
+        std::vector<Entity> entities;
+        for (uint32_t i = 0; i < 2000; ++i)
+        {
+            Entity e = reg.create();
+            entities.push_back(e);
+            reg.add<Key64>(e, Key64{i * 4, i});
+        }
+        // Move `percent`% of the keys by a random amount, some far.
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            if (static_cast<int>(rng() % 100) < percent)
+            {
+                reg.get<Key64>(entities[i]).k = rng() % 8000;
+            }
+        }
+
+        const std::vector<uint32_t> expected = stableReference(reg);
+        reg.sort<Key64>(byKey, SortMode::Incremental);
+        TEST_ASSERT(tagOrder(reg) == expected, "matches stable_sort");
+    }
+}
+
+void test_incremental_appended_tail()
+{
+    Registry reg;
+    std::mt19937 rng(11);
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        reg.add<Key64>(reg.create(), Key64{i * 10, i});
+    }
+    for (uint32_t i = 1000; i < 1050; ++i)
+    {
+        reg.add<Key64>(reg.create(), Key64{rng() % 10000, i});
+    }
+
+    const std::vector<uint32_t> expected = stableReference(reg);
+    reg.sort<Key64>(byKey, SortMode::Incremental);
+    TEST_ASSERT(tagOrder(reg) == expected, "tail merged into place");
+}
+
+void test_incremental_reversed()
+{
+    Registry reg;
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+        reg.add<Key64>(reg.create(), Key64{(500 - i) / 2, i});
+    }
+
+    const std::vector<uint32_t> expected = stableReference(reg);
+    reg.sort<Key64>(byKey, SortMode::Incremental);
+    TEST_ASSERT(tagOrder(reg) == expected, "worst case still correct and stable");
+}
+
+void test_incremental_few_moved_preserves_mapping()
+{
+    Registry reg;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 1000; ++i)
+    {
+        Entity e = reg.create();
+        entities.push_back(e);
+        reg.add<Value>(e, i);
+        reg.add<Score>(e, static_cast<float>(i));
+    }
+    // Swap a few neighbours: far fewer than a quarter of the entries move.
+    for (int i = 10; i < 1000; i += 100)
+    {
+        reg.get<Value>(entities[static_cast<std::size_t>(i)]).v = i + 1;
+        reg.get<Value>(entities[static_cast<std::size_t>(i + 1)]).v = i;
+    }
+
+    reg.sort<Value>([](const Value& a, const Value& b) { return a.v < b.v; },
+                    SortMode::Incremental);
+
+    std::vector<int> order;
+    bool mappingOk = true;
+    reg.view<Value>().each([&](Entity e, const Value& v) {
+        order.push_back(v.v);
+        mappingOk = mappingOk && reg.get<Value>(e).v == v.v;
+    });
+    TEST_ASSERT(order.size() == 1000, "all present");
+    TEST_ASSERT(std::is_sorted(order.begin(), order.end()), "ascending");
+    TEST_ASSERT(mappingOk, "get<Value>(e) agrees with the view");
+    auto* store = reg.storage<Value>();
+    TEST_ASSERT(store->dense()[10] == entities[11] && store->dense()[11] == entities[10],
+                "swapped neighbours exchanged");
+    TEST_ASSERT(store->dense()[500] == entities[500], "unmoved entries stay put");
+    TEST_ASSERT(reg.get<Score>(entities[10]).s == 10.0f, "other stores untouched");
+}
+
+void test_incremental_throwing_move()
+{
+    Registry reg;
+    for (int i = 0; i < 300; ++i)
+    {
+        reg.add<Guarded>(reg.create(), Guarded(i % 50 == 0 ? 300 - i : i));
+    }
+
+    reg.sort<Guarded>([](const Guarded& a, const Guarded& b) { return a.v < b.v; },
+                      SortMode::Incremental);
+
+    std::vector<int> order;
+    reg.view<Guarded>().each([&](Entity, const Guarded& g) { order.push_back(g.v); });
+    TEST_ASSERT(order.size() == 300, "all present");
+    TEST_ASSERT(std::is_sorted(order.begin(), order.end()), "ascending");
+}
+
+// =============================================================================
+// align<Pivot, Fs...>()
+// =============================================================================
+
+void test_align_shared_prefix()
+{
+    Registry reg;
+    // eA: all three. eB: Value + Score. eC: all three. eD: Value + Marker.
+    // eE: Score + Marker only.
+    Entity eE = reg.create(); reg.add<Score>(eE, 9.0f); reg.add<Marker>(eE, uint8_t{9});
+    Entity eD = reg.create(); reg.add<Value>(eD, 4); reg.add<Marker>(eD, uint8_t{4});
+    Entity eC = reg.create(); reg.add<Value>(eC, 3); reg.add<Score>(eC, 3.0f); reg.add<Marker>(eC, uint8_t{3});
+    Entity eB = reg.create(); reg.add<Value>(eB, 2); reg.add<Score>(eB, 2.0f);
+    Entity eA = reg.create(); reg.add<Value>(eA, 1); reg.add<Score>(eA, 1.0f); reg.add<Marker>(eA, uint8_t{1});
+
+    reg.sort<Value>([](const Value& a, const Value& b) { return a.v < b.v; });
+    reg.align<Value, Score, Marker>();
+
+    const auto& values  = reg.storage<Value>()->dense();
+    const auto& scores  = reg.storage<Score>()->dense();
+    const auto& markers = reg.storage<Marker>()->dense();
+
+    // Fully shared block, in Value order, at the same indices everywhere.
+    TEST_ASSERT(values[0] == eA && scores[0] == eA && markers[0] == eA, "eA at 0");
+    TEST_ASSERT(values[1] == eC && scores[1] == eC && markers[1] == eC, "eC at 1");
+    // Value: remaining entities keep their sorted relative order.
+    TEST_ASSERT(values[2] == eB && values[3] == eD, "pivot stably partitioned");
+    // Followers: partially shared next, then entities absent from Value.
+    TEST_ASSERT(scores[2] == eB && scores[3] == eE, "Score tail");
+    TEST_ASSERT(markers[2] == eD && markers[3] == eE, "Marker tail");
+
+    TEST_ASSERT(reg.get<Score>(eC).s == 3.0f && reg.get<Marker>(eD).id == 4, "mapping intact");
+}
+
+void test_align_single_follower_matches_sort()
+{
+    Registry a;
+    Registry b;
+    std::mt19937 rng(21);
+    for (int i = 0; i < 300; ++i)
+    {
+        const int v = static_cast<int>(rng() % 1000);
+        Entity ea = a.create();
+        Entity eb = b.create();
+        if (i % 5 != 0) { a.add<Value>(ea, v); b.add<Value>(eb, v); }
+        if (i % 3 != 0) { a.add<Score>(ea, static_cast<float>(i)); b.add<Score>(eb, static_cast<float>(i)); }
+    }
+    auto byV = [](const Value& x, const Value& y) { return x.v < y.v; };
+    a.sort<Value>(byV);
+    b.sort<Value>(byV);
+    a.sort<Value, Score>();
+    b.align<Value, Score>();
+
+    // Compare the shared block; sort<A, B>()'s swaps do not keep the tail's order.
+    std::vector<float> orderA;
+    std::vector<float> orderB;
+    a.view<Score>().each([&](Entity e, const Score& s) { if (a.has<Value>(e)) orderA.push_back(s.s); });
+    b.view<Score>().each([&](Entity e, const Score& s) { if (b.has<Value>(e)) orderB.push_back(s.s); });
+    TEST_ASSERT(!orderA.empty() && orderA == orderB, "same follower order as sort<A, B>()");
+}
+
+void test_align_unregistered_noop()
+{
+    Registry reg;
+    Entity e0 = reg.create(); reg.add<Value>(e0, 2); reg.add<Score>(e0, 2.0f);
+    Entity e1 = reg.create(); reg.add<Value>(e1, 1); reg.add<Score>(e1, 1.0f);
+
+    reg.sort<Value>([](const Value& a, const Value& b) { return a.v < b.v; });
+    reg.align<Value, Score, Marker>(); // Marker never registered
+
+    TEST_ASSERT(reg.storage<Score>()->dense()[0] == e0, "Score untouched");
+}
+
+void test_align_large_scale()
+{
+    Registry reg;
+    std::mt19937 rng(5);
+    std::vector<Entity> entities;
+    for (int i = 0; i < 2000; ++i)
+    {
+        Entity e = reg.create();
+        entities.push_back(e);
+        if (rng() % 10 != 0) reg.add<Value>(e, static_cast<int>(rng() % 100000));
+        if (rng() % 4 != 0)  reg.add<Score>(e, static_cast<float>(i));
+        if (rng() % 3 != 0)  reg.add<Depth>(e, static_cast<float>(-i));
+        if (rng() % 2 != 0)  reg.add<Marker>(e, static_cast<uint8_t>(i));
+    }
+    reg.sort<Value>([](const Value& a, const Value& b) { return a.v < b.v; });
+    reg.align<Value, Score, Depth, Marker>();
+
+    auto* values  = reg.storage<Value>();
+    auto* scores  = reg.storage<Score>();
+    auto* depths  = reg.storage<Depth>();
+    auto* markers = reg.storage<Marker>();
+
+    std::size_t shared = 0;
+    while (shared < values->size() && reg.has<Score>(values->dense()[shared]) &&
+           reg.has<Depth>(values->dense()[shared]) && reg.has<Marker>(values->dense()[shared]))
+    {
+        ++shared;
+    }
+    TEST_ASSERT(shared > 0, "some entities have all four components");
+    for (std::size_t i = 0; i < shared; ++i)
+    {
+        const Entity e = values->dense()[i];
+        TEST_ASSERT(scores->dense()[i] == e && depths->dense()[i] == e && markers->dense()[i] == e,
+                    "fully shared entity at the same index in every store");
+        if (i > 0)
+        {
+            TEST_ASSERT(values->dataAt(i - 1).v <= values->dataAt(i).v, "pivot order kept");
+        }
+    }
+    for (std::size_t i = shared; i < values->size(); ++i)
+    {
+        const Entity e = values->dense()[i];
+        TEST_ASSERT(!(reg.has<Score>(e) && reg.has<Depth>(e) && reg.has<Marker>(e)),
+                    "no fully shared entity after the block");
+    }
+
+    std::size_t visited = 0;
+    bool mappingOk = true;
+    reg.view<Value, Score, Depth, Marker>().each(
+        [&](Entity e, const Value&, const Score& s, const Depth& d, const Marker& m) {
+            ++visited;
+            const auto i = static_cast<std::size_t>(s.s);
+            mappingOk = mappingOk && entities[i] == e && d.z == -s.s &&
+                        m.id == static_cast<uint8_t>(i);
+        });
+    TEST_ASSERT(visited == shared, "view visits exactly the aligned block");
+    TEST_ASSERT(mappingOk, "components still belong to their entities");
+}
+
 // =============================================================================
 // Main
 // =============================================================================
@@ -414,6 +918,29 @@ int main()
     RUN_TEST(test_match_sort_view_pairs_correct);
     RUN_TEST(test_match_sort_large_scale);
 
+    std::printf("\nsort_by_key<T>(keyFn):\n");
+    RUN_TEST(test_sort_by_key_signed_ints);
+    RUN_TEST(test_sort_by_key_floats);
+    RUN_TEST(test_sort_by_key_stable);
+    RUN_TEST(test_sort_by_key_preserves_mapping);
+    RUN_TEST(test_sort_by_key_parallel_matches_serial);
+    RUN_TEST(test_sort_by_key_throwing_move);
+    RUN_TEST(test_sort_by_key_agrees_with_comparator);
+
+    std::printf("\nsort<T>(comparator, SortMode::Incremental):\n");
+    RUN_TEST(test_incremental_sorted_noop);
+    RUN_TEST(test_incremental_jitter_matches_stable);
+    RUN_TEST(test_incremental_appended_tail);
+    RUN_TEST(test_incremental_reversed);
+    RUN_TEST(test_incremental_few_moved_preserves_mapping);
+    RUN_TEST(test_incremental_throwing_move);
+
+    std::printf("\nalign<Pivot, Fs...>():\n");
+    RUN_TEST(test_align_shared_prefix);
+    RUN_TEST(test_align_single_follower_matches_sort);
+    RUN_TEST(test_align_unregistered_noop);
+    RUN_TEST(test_align_large_scale);
+
     std::printf("\n=== Results: %d passed, %d failed ===\n",
                 sTestsPassed, sTestsFailed);
     return sTestsFailed == 0 ? 0 : 1;
@@ -0,0 +1,458 @@
+/**
+ * @file test_spatial_hash.cpp
+ * @brief Tests for SpatialHash — incremental uniform-grid index.
+ *
+ * Verifies:
+ *   Construction indexes existing entities
+ *   add / patch / replace / remove / destroy / clear<P> keep the index current
+ *   update() and refreshAll() pick up in-place writes
+ *   rebuild() recovers after Registry::clear()
+ *   Radius, AABB and pair queries match brute force on random data
+ *   Pair queries report each pair once, including radius > cell size
+ *   Negative coordinates, cell boundaries and non-finite positions
+ *   Custom point extractor
+ *   Destroying the index disconnects its listeners
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "fatp_ecs/FatpEcs.h"
+
+// =============================================================================
+// Test infrastructure
+// =============================================================================
+
+static int gPassed = 0;
+static int gFailed = 0;
+
+#define TEST_ASSERT(cond, msg)                                 \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            std::printf("  FAIL [%s]: %s\n", __func__, (msg)); \
+            ++gFailed;                                         \
+        }                                                      \
+        else                                                   \
+        {                                                      \
+            ++gPassed;                                         \
+        }                                                      \
+    } while (false)
+
+#define RUN_TEST(fn)                         \
+    do                                       \
+    {                                        \
+        std::printf("  Running: %s\n", #fn); \
+        fn();                                \
+    } while (false)
+
+using namespace fatp_ecs;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+struct Position
+{
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Tag
+{
+};
+
+// Stores coordinates as an array instead of x/y members.
+struct Transform
+{
+    double t[2] = {0.0, 0.0};
+};
+
+struct TransformPoint
+{
+    SpatialPoint operator()(const Transform& tr) const noexcept
+    {
+        return {static_cast<float>(tr.t[0]), static_cast<float>(tr.t[1])};
+    }
+};
+
+template <typename Index>
+static std::vector<Entity> radius(const Index& index, float x, float y, float r)
+{
+    std::vector<Entity> out;
+    index.queryRadius(x, y, r, [&](Entity e) { out.push_back(e); });
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+static std::vector<Entity> bruteRadius(Registry& reg, float x, float y, float r)
+{
+    std::vector<Entity> out;
+    reg.view<Position>().each(
+        [&](Entity e, Position& p)
+        {
+            const float dx = p.x - x;
+            const float dy = p.y - y;
+            if (dx * dx + dy * dy <= r * r)
+            {
+                out.push_back(e);
+            }
+        });
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+using EntityPair = std::pair<Entity, Entity>;
+
+static EntityPair ordered(Entity a, Entity b)
+{
+    return a < b ? EntityPair{a, b} : EntityPair{b, a};
+}
+
+static std::vector<Entity> populate(Registry& reg, std::size_t count, float extent,
+                                    uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(-extent, extent);
+    std::vector<Entity> out;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Entity e = reg.create();
+        reg.add<Position>(e, coord(rng), coord(rng));
+        out.push_back(e);
+    }
+    return out;
+}
+
+// =============================================================================
+// Maintenance through signals
+// =============================================================================
+
+static void test_construction_indexes_existing()
+{
+    Registry reg;
+    Entity a = reg.create();
+    reg.add<Position>(a, 1.0f, 1.0f);
+    Entity b = reg.create();
+    reg.add<Tag>(b);
+
+    SpatialHash<Position> index(reg, 10.0f);
+
+    TEST_ASSERT(index.size() == 1, "one entity with Position");
+    TEST_ASSERT(index.contains(a), "a indexed");
+    TEST_ASSERT(!index.contains(b), "b has no Position");
+}
+
+static void test_signals_keep_index_current()
+{
+    Registry reg;
+    SpatialHash<Position> index(reg, 10.0f);
+
+    Entity e = reg.create();
+    reg.add<Position>(e, 5.0f, 5.0f);
+    TEST_ASSERT(index.contains(e), "added");
+    TEST_ASSERT(radius(index, 5.0f, 5.0f, 1.0f).size() == 1, "found at new position");
+
+    reg.patch<Position>(e, [](Position& p) { p.x = 95.0f; });
+    TEST_ASSERT(radius(index, 5.0f, 5.0f, 1.0f).empty(), "gone from old cell after patch");
+    TEST_ASSERT(radius(index, 95.0f, 5.0f, 1.0f).size() == 1, "found after patch");
+
+    reg.replace<Position>(e, -40.0f, 12.0f);
+    TEST_ASSERT(radius(index, -40.0f, 12.0f, 0.5f).size() == 1, "found after replace");
+
+    reg.remove<Position>(e);
+    TEST_ASSERT(!index.contains(e) && index.empty(), "removed");
+
+    reg.add<Position>(e, 0.0f, 0.0f);
+    reg.destroy(e);
+    TEST_ASSERT(index.empty(), "destroy drops entity");
+
+    populate(reg, 50, 100.0f, 3);
+    TEST_ASSERT(index.size() == 50, "50 indexed");
+    reg.clear<Position>();
+    TEST_ASSERT(index.empty() && index.cellCount() == 0, "clear<P> empties index and cells");
+}
+
+static void test_recycled_slot_is_not_confused()
+{
+    Registry reg;
+    SpatialHash<Position> index(reg, 10.0f);
+
+    Entity old = reg.create();
+    reg.add<Position>(old, 1.0f, 1.0f);
+    reg.destroy(old);
+
+    Entity fresh = reg.create(); // likely reuses old's slot
+    TEST_ASSERT(!index.contains(old), "destroyed handle not indexed");
+    TEST_ASSERT(!index.contains(fresh), "fresh entity without Position not indexed");
+
+    reg.add<Position>(fresh, 2.0f, 2.0f);
+    TEST_ASSERT(index.contains(fresh) && !index.contains(old), "only the live handle matches");
+}
+
+// =============================================================================
+// In-place writes
+// =============================================================================
+
+static void test_update_and_refresh_all()
+{
+    Registry reg;
+    auto entities = populate(reg, 200, 200.0f, 7);
+    SpatialHash<Position> index(reg, 16.0f);
+
+    // Move one entity in place and report it explicitly.
+    Position& p0 = reg.get<Position>(entities[0]);
+    p0 = {1000.0f, 1000.0f};
+    TEST_ASSERT(radius(index, 1000.0f, 1000.0f, 1.0f).empty(), "in-place write is invisible");
+    index.update(entities[0], p0);
+    TEST_ASSERT(radius(index, 1000.0f, 1000.0f, 1.0f).size() == 1, "visible after update()");
+
+    // Move everything through a view, then refresh once.
+    reg.view<Position>().each(
+        [](Entity, Position& p)
+        {
+            p.x += 3.0f;
+            p.y -= 7.0f;
+        });
+    const std::size_t moved = index.refreshAll();
+    TEST_ASSERT(moved > 0 && moved <= entities.size(), "some entities changed cell");
+    TEST_ASSERT(index.size() == entities.size(), "no duplicates after refreshAll");
+    TEST_ASSERT(radius(index, 0.0f, 0.0f, 120.0f) == bruteRadius(reg, 0.0f, 0.0f, 120.0f),
+                "matches brute force after refreshAll");
+    TEST_ASSERT(index.refreshAll() == 0, "second refresh moves nothing");
+}
+
+static void test_refresh_single_entity()
+{
+    Registry reg;
+    SpatialHash<Position> index(reg, 10.0f);
+    Entity e = reg.create();
+    reg.add<Position>(e, 0.0f, 0.0f);
+
+    reg.get<Position>(e).x = 55.0f;
+    index.refresh(e);
+    TEST_ASSERT(radius(index, 55.0f, 0.0f, 0.1f).size() == 1, "refresh re-reads position");
+}
+
+static void test_rebuild_after_registry_clear()
+{
+    Registry reg;
+    SpatialHash<Position> index(reg, 10.0f);
+    populate(reg, 30, 50.0f, 11);
+
+    reg.clear(); // fires no component signals
+    index.rebuild();
+    TEST_ASSERT(index.empty() && index.cellCount() == 0, "rebuild drops stale entries");
+
+    auto entities = populate(reg, 10, 50.0f, 12);
+    TEST_ASSERT(index.size() == 10, "signals still connected after rebuild");
+    TEST_ASSERT(radius(index, 0.0f, 0.0f, 100.0f).size() == 10, "all found");
+}
+
+// =============================================================================
+// Queries vs brute force
+// =============================================================================
+
+static void test_radius_matches_brute_force()
+{
+    Registry reg;
+    populate(reg, 2000, 500.0f, 21);
+    SpatialHash<Position> index(reg, 25.0f);
+
+    std::mt19937 rng(22);
+    std::uniform_real_distribution<float> coord(-550.0f, 550.0f);
+    std::uniform_real_distribution<float> rad(0.0f, 120.0f);
+    bool allMatch = true;
+    for (int q = 0; q < 200; ++q)
+    {
+        const float x = coord(rng);
+        const float y = coord(rng);
+        const float r = rad(rng);
+        allMatch = allMatch && radius(index, x, y, r) == bruteRadius(reg, x, y, r);
+    }
+    TEST_ASSERT(allMatch, "200 random radius queries match brute force");
+
+    // A radius covering far more cells than are occupied takes the scan path.
+    TEST_ASSERT(radius(index, 0.0f, 0.0f, 1.0e6f).size() == 2000, "huge radius finds all");
+}
+
+static void test_aabb_matches_brute_force()
+{
+    Registry reg;
+    populate(reg, 1000, 300.0f, 31);
+    SpatialHash<Position> index(reg, 20.0f);
+
+    std::mt19937 rng(32);
+    std::uniform_real_distribution<float> coord(-320.0f, 320.0f);
+    bool allMatch = true;
+    for (int q = 0; q < 100; ++q)
+    {
+        float x0 = coord(rng), x1 = coord(rng), y0 = coord(rng), y1 = coord(rng);
+        if (x1 < x0) std::swap(x0, x1);
+        if (y1 < y0) std::swap(y0, y1);
+
+        std::vector<Entity> got;
+        index.queryAabb(x0, y0, x1, y1, [&](Entity e) { got.push_back(e); });
+        std::sort(got.begin(), got.end());
+
+        std::vector<Entity> want;
+        reg.view<Position>().each(
+            [&](Entity e, Position& p)
+            {
+                if (p.x >= x0 && p.x <= x1 && p.y >= y0 && p.y <= y1)
+                {
+                    want.push_back(e);
+                }
+            });
+        std::sort(want.begin(), want.end());
+        allMatch = allMatch && got == want;
+    }
+    TEST_ASSERT(allMatch, "100 random AABB queries match brute force");
+
+    std::size_t inverted = 0;
+    index.queryAabb(10.0f, 10.0f, -10.0f, -10.0f, [&](Entity) { ++inverted; });
+    TEST_ASSERT(inverted == 0, "inverted box is empty");
+}
+
+static void test_pairs_match_brute_force()
+{
+    for (float r : {5.0f, 12.0f, 45.0f}) // below, near and above the cell size
+    {
+        Registry reg;
+        auto entities = populate(reg, 600, 150.0f, 41);
+        SpatialHash<Position> index(reg, 12.0f);
+
+        std::vector<EntityPair> got;
+        index.queryPairs(r, [&](Entity a, Entity b) { got.push_back(ordered(a, b)); });
+        std::sort(got.begin(), got.end());
+
+        std::vector<EntityPair> want;
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < entities.size(); ++j)
+            {
+                const Position& a = reg.get<Position>(entities[i]);
+                const Position& b = reg.get<Position>(entities[j]);
+                const float dx = a.x - b.x;
+                const float dy = a.y - b.y;
+                if (dx * dx + dy * dy <= r * r)
+                {
+                    want.push_back(ordered(entities[i], entities[j]));
+                }
+            }
+        }
+        std::sort(want.begin(), want.end());
+
+        TEST_ASSERT(std::adjacent_find(got.begin(), got.end()) == got.end(),
+                    "no pair reported twice");
+        TEST_ASSERT(got == want, "pairs match brute force");
+    }
+}
+
+// =============================================================================
+// Edge cases
+// =============================================================================
+
+static void test_boundaries_and_negative_coordinates()
+{
+    Registry reg;
+    SpatialHash<Position> index(reg, 10.0f);
+
+    Entity onEdge = reg.create();
+    reg.add<Position>(onEdge, 10.0f, 0.0f);   // first coordinate of cell (1, 0)
+    Entity negative = reg.create();
+    reg.add<Position>(negative, -0.5f, -0.5f); // cell (-1, -1)
+
+    TEST_ASSERT(radius(index, 9.0f, 0.0f, 1.0f).size() == 1, "boundary point found across cells");
+    TEST_ASSERT(radius(index, 0.0f, 0.0f, 0.75f).size() == 1, "reaches the negative cell");
+    TEST_ASSERT(radius(index, 7.0f, 4.0f, 5.0f).size() == 1, "radius is inclusive (3-4-5)");
+    TEST_ASSERT(index.cellCount() == 2, "two occupied cells");
+}
+
+static void test_non_finite_positions_are_contained()
+{
+    Registry reg;
+    SpatialHash<Position> index(reg, 10.0f);
+
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    Entity a = reg.create();
+    reg.add<Position>(a, inf, -inf);
+    Entity b = reg.create();
+    reg.add<Position>(b, nan, 1.0f);
+    Entity c = reg.create();
+    reg.add<Position>(c, 1.0e30f, 0.0f);
+    Entity d = reg.create();
+    reg.add<Position>(d, 0.0f, 0.0f);
+
+    TEST_ASSERT(index.size() == 4, "all indexed");
+    TEST_ASSERT(radius(index, 0.0f, 0.0f, 5.0f).size() == 1, "only the finite neighbour found");
+
+    reg.destroy(a);
+    reg.destroy(b);
+    reg.destroy(c);
+    TEST_ASSERT(index.size() == 1, "clamped entries removable");
+}
+
+static void test_custom_extractor()
+{
+    Registry reg;
+    SpatialHash<Transform, TransformPoint> index(reg, 4.0f);
+
+    Entity e = reg.create();
+    Transform tr;
+    tr.t[0] = 7.0;
+    tr.t[1] = -3.0;
+    reg.add<Transform>(e, tr);
+
+    std::size_t hits = 0;
+    index.queryRadius(7.0f, -3.0f, 0.1f, [&](Entity) { ++hits; });
+    TEST_ASSERT(hits == 1, "custom extractor used");
+}
+
+static void test_destroying_index_disconnects()
+{
+    Registry reg;
+    {
+        SpatialHash<Position> index(reg, 10.0f);
+        populate(reg, 5, 10.0f, 51);
+    }
+    // Would write through a dangling pointer if still connected.
+    auto more = populate(reg, 5, 10.0f, 52);
+    reg.destroy(more[0]);
+    TEST_ASSERT(reg.view<Position>().count() == 9, "registry unaffected");
+}
+
+int main()
+{
+    std::printf("=== test_spatial_hash ===\n");
+
+    RUN_TEST(test_construction_indexes_existing);
+    RUN_TEST(test_signals_keep_index_current);
+    RUN_TEST(test_recycled_slot_is_not_confused);
+
+    RUN_TEST(test_update_and_refresh_all);
+    RUN_TEST(test_refresh_single_entity);
+    RUN_TEST(test_rebuild_after_registry_clear);
+
+    RUN_TEST(test_radius_matches_brute_force);
+    RUN_TEST(test_aabb_matches_brute_force);
+    RUN_TEST(test_pairs_match_brute_force);
+
+    RUN_TEST(test_boundaries_and_negative_coordinates);
+    RUN_TEST(test_non_finite_positions_are_contained);
+    RUN_TEST(test_custom_extractor);
+    RUN_TEST(test_destroying_index_disconnects);
+
+    std::printf("\n%d/%d tests passed\n", gPassed, gPassed + gFailed);
+    return gFailed == 0 ? 0 : 1;
+}
@@ -6,18 +6,22 @@
  *   DefaultStoragePolicy  — baseline correctness (regression coverage)
  *   AlignedStoragePolicy  — correct alignment, full functional parity
  *   ConcurrentStoragePolicy — locking wrapper correctness
+ *   LockFreeReadStoragePolicy — epoch-retired growth, readers racing a writer
  *   Registry::useStorage<T, Policy>() — pre-registration API
  *   Registry::useAlignedStorage<T, N>() — convenience shorthand
  *   dataAlignment() introspection
  *   Policy-mismatch assertion (not tested here — would abort; documented)
  */
 
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <span>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <fat_p/ConcurrencyPolicies.h>
@@ -311,6 +315,103 @@ static void test_concurrent_policy_multithreaded_reads()
     }
 }
 
+// =============================================================================
+// LockFreeReadStoragePolicy
+// =============================================================================
+
+using LockFreeHealth = LockFreeReadStoragePolicy<>::Policy<Health>::container_type;
+
+static void test_lockfree_policy_basic_ops()
+{
+    ComponentStore<Health, LockFreeReadStoragePolicy<>::Policy> store;
+
+    for (uint32_t i = 0; i < 40; ++i)
+    {
+        store.emplace(Entity{i}, Health{i});
+    }
+    TEST_ASSERT(store.size() == 40, "size after growth (lock-free)");
+    TEST_ASSERT(store.get(Entity{33}).hp == 33, "value survives growth (lock-free)");
+
+    store.remove(Entity{5});
+    TEST_ASSERT(!store.has(Entity{5}), "e5 removed (lock-free)");
+    TEST_ASSERT(store.get(Entity{39}).hp == 39, "swapped-in value intact (lock-free)");
+
+    store.clear();
+    TEST_ASSERT(store.empty(), "empty after clear (lock-free)");
+}
+
+static void test_lockfree_policy_retires_old_buffers()
+{
+    LockFreeHealth c;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        c.push_back(Health{i});
+    }
+    TEST_ASSERT(c.retiredCount() == 0, "no retirement within first capacity");
+
+    const Health* old = c.data();
+    c.push_back(Health{16});
+    TEST_ASSERT(c.data() != old, "growth publishes a new buffer");
+    TEST_ASSERT(c.retiredCount() == 1, "old buffer retired, not freed");
+    TEST_ASSERT(old[15].hp == 15, "reader of the old buffer still sees valid data");
+
+    c.reclaim();
+    TEST_ASSERT(c.retiredCount() == 1, "reclaim keeps buffers of the current epoch");
+
+    StorageEpoch::advance();
+    c.reclaim();
+    TEST_ASSERT(c.retiredCount() == 0, "reclaim frees buffers after the epoch advances");
+    TEST_ASSERT(c[16].hp == 16 && c.size() == 17, "live buffer unaffected");
+}
+
+static void test_lockfree_policy_readers_race_writer()
+{
+    constexpr uint32_t kCount = 50'000;
+    LockFreeHealth c;
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> readers;
+    std::vector<bool> results(3, true);
+    for (int t = 0; t < 3; ++t)
+    {
+        readers.emplace_back([&c, &done, &results, t]() {
+            while (!done.load(std::memory_order_acquire))
+            {
+                const std::span<const Health> view = std::as_const(c).span();
+                for (std::size_t i = 0; i < view.size(); i += 97)
+                {
+                    if (view[i].hp != i)
+                    {
+                        results[t] = false;
+                        return;
+                    }
+                }
+                if (!view.empty() && view.back().hp != view.size() - 1)
+                {
+                    results[t] = false;
+                    return;
+                }
+            }
+        });
+    }
+
+    for (uint32_t i = 0; i < kCount; ++i)
+    {
+        c.push_back(Health{i});
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& th : readers)
+    {
+        th.join();
+    }
+
+    for (int t = 0; t < 3; ++t)
+    {
+        TEST_ASSERT(results[t], "reader saw only fully published elements");
+    }
+    TEST_ASSERT(c.size() == kCount, "writer appended everything");
+}
+
 // =============================================================================
 // Registry::useStorage / useAlignedStorage integration
 // =============================================================================
@@ -362,6 +463,21 @@ static void test_registry_use_concurrent_storage()
     TEST_ASSERT(reg.get<Health>(e).hp == 999, "concurrent storage via registry");
 }
 
+static void test_registry_use_lockfree_storage()
+{
+    Registry reg;
+    reg.useStorage<Health, LockFreeReadStoragePolicy<>::Policy>();
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        reg.add<Health>(reg.create(), Health{i});
+    }
+
+    uint32_t sum = 0;
+    reg.view<Health>().each([&](Entity, Health& h) { sum += h.hp; });
+    TEST_ASSERT(sum == 4950, "view over lock-free storage via registry");
+}
+
 static void test_registry_default_policy_unchanged()
 {
     // Entities added without useStorage() still work — DefaultStoragePolicy
@@ -439,10 +555,16 @@ int main()
     RUN_TEST(test_concurrent_policy_swap_with_back);
     RUN_TEST(test_concurrent_policy_multithreaded_reads);
 
+    // LockFreeReadStoragePolicy
+    RUN_TEST(test_lockfree_policy_basic_ops);
+    RUN_TEST(test_lockfree_policy_retires_old_buffers);
+    RUN_TEST(test_lockfree_policy_readers_race_writer);
+
     // Registry integration
     RUN_TEST(test_registry_use_aligned_storage);
     RUN_TEST(test_registry_use_aligned_storage_data_alignment);
     RUN_TEST(test_registry_use_concurrent_storage);
+    RUN_TEST(test_registry_use_lockfree_storage);
     RUN_TEST(test_registry_default_policy_unchanged);
     RUN_TEST(test_registry_view_works_with_aligned_storage);
     RUN_TEST(test_registry_entity_copy_with_aligned_storage);